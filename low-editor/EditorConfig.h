@@ -19,6 +19,13 @@ namespace LowEditor {
          */
         inline static const unsigned int EDITOR_FRAMERATE_LIMIT = 60;
 
+        /**
+         * @brief Interval of autosaving the edited scene, in seconds.
+         *
+         * The editor executable assigns this to LowEngine::Game::AutosaveInterval.
+         */
+        inline static constexpr float AUTOSAVE_INTERVAL = 120.0f;
+
         /**
          * @brief Default display name assigned to newly created projects.
          *
@@ -311,6 +311,10 @@ namespace LowEngine {
 				}
 				if (ImGui::MenuItem("Load Scene")) { game.LoadScene("default"); }
 				if (ImGui::MenuItem("Save Scene")) { game.SaveCurrentScene(); }
+				if (ImGui::MenuItem("Export Scene to JSON")) {
+					game.ExportCurrentSceneToJSON(game.ProjectDirectory / Config::SCENES_FOLDER_NAME
+					                              / (game.Scenes.GetCurrentScene()->Name + ".json"));
+				}
 
 				ImGui::EndMenu();
 			}
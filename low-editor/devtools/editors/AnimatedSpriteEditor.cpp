@@ -33,6 +33,7 @@ namespace LowEngine::Editors {
 			int drawOrder = asc->DrawOrder;
 			if (ImGui::DragInt("##DrawOrder", &drawOrder)) {
 				asc->DrawOrder = drawOrder;
+				asc->MarkChanged();
 			}
 
 			ImGui::Text("Texture:");
@@ -42,6 +42,7 @@ namespace LowEngine::Editors {
             float zoomFactor = cc->ZoomFactor;
             if (ImGui::DragFloat("##Zoom", &zoomFactor, 0.01f, 0, 0, "%.3f")) {
                 cc->ZoomFactor = zoomFactor;
+                cc->MarkChanged();
             }
         }
 	}
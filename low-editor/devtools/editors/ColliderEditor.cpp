@@ -102,7 +102,9 @@ namespace LowEngine::Editors {
 
             ImGui::Text("Draw collider overly: ");
             ImGui::SameLine();
-			ImGui::Checkbox("##DrawColliderOverlay", &cc->DrawCollisionOverlay);
+			if (ImGui::Checkbox("##DrawColliderOverlay", &cc->DrawCollisionOverlay)) {
+				cc->MarkChanged();
+			}
         }
 	}
 }
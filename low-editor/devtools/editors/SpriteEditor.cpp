@@ -35,6 +35,7 @@ namespace LowEngine::Editors {
             int drawOrder = sc->DrawOrder;
             if (ImGui::DragInt("##DrawOrder", &drawOrder)) {
                 sc->DrawOrder = drawOrder;
+                sc->MarkChanged();
             }
             
             float width = ImGui::CalcItemWidth();
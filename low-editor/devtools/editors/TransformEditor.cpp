@@ -32,23 +32,23 @@ namespace LowEngine::Editors {
         if (opened) {
             ImGui::Text("Position:");
             ImGui::SameLine();
-            float position[2] = { tc->Position.x, tc->Position.y };
+            float position[2] = { tc->GetPosition().x, tc->GetPosition().y };
             if (ImGui::DragFloat2("##Position", position, 1.0f, 0, 0, "%.3f")) {
-                tc->Position = { position[0], position[1] };
+                tc->SetPosition({ position[0], position[1] });
             }
 
             ImGui::Text("Rotation:");
             ImGui::SameLine();
-            float rotation = tc->Rotation.asDegrees();
+            float rotation = tc->GetRotation().asDegrees();
             if (ImGui::DragFloat("##Rotation", &rotation, 1.0f, 0, 0, "%.3f")) {
-                tc->Rotation = sf::degrees(rotation);
+                tc->SetRotation(sf::degrees(rotation));
             }
 
             ImGui::Text("Scale:");
             ImGui::SameLine();
-            float scale[2] = { tc->Scale.x, tc->Scale.y };
+            float scale[2] = { tc->GetScale().x, tc->GetScale().y };
             if (ImGui::DragFloat2("##Scale", scale, 0.1f, 0, 0, "%.3f")) {
-                tc->Scale = { scale[0], scale[1] };
+                tc->SetScale({ scale[0], scale[1] });
             }
         }
 	}
@@ -156,15 +156,12 @@ namespace LowEngine::Panels {
 
         ImGui::Separator();
 
-        auto entities = scene->GetEntities();
-        for (auto& entity : *entities) {
-            if (entity == nullptr) continue;
+        scene->ForEachEntity([&selectedEntityId](ECS::Entity& entity) {
+            std::string label = std::format("[{}] {}", ECS::GetEntityIndex(entity.Id), entity.GetName());
+            bool selected = selectedEntityId != static_cast<size_t>(-1) && entity.Id == selectedEntityId;
 
-            std::string label = std::format("[{}] {}", entity.get()->Id, entity.get()->Name);
-            bool selected = selectedEntityId != static_cast<size_t>(-1) && entity.get()->Id == selectedEntityId;
-
-            if (ImGui::Selectable(label.c_str(), selected)) { selectedEntityId = entity.get()->Id; }
-        }
+            if (ImGui::Selectable(label.c_str(), selected)) { selectedEntityId = entity.Id; }
+        });
 
         ImGui::End();
     }
@@ -181,15 +178,15 @@ namespace LowEngine::Panels {
 
         if (selectedEntityId != static_cast<size_t>(-1)) {
             auto entity = scene->GetEntity(selectedEntityId);
-            const std::string windowTitle = std::format("Properties: '{}'###Properties", entity->Name);
+            const std::string windowTitle = std::format("Properties: '{}'###Properties", entity->GetName());
             ImGui::Begin(windowTitle.c_str());
 
             ImGui::Text("Name:");
             ImGui::SameLine();
             char nameBuffer[255];
-            std::strncpy(nameBuffer, entity->Name.c_str(), 255);
+            std::strncpy(nameBuffer, std::string(entity->GetName()).c_str(), 255);
             if (ImGui::InputText("##Name", nameBuffer, 255, ImGuiInputTextFlags_EnterReturnsTrue)) {
-                entity->Name = nameBuffer;
+                entity->SetName(nameBuffer);
                 scene->Update(0.0f);
             }
 
@@ -229,8 +226,7 @@ namespace LowEngine::Panels {
             }
 
             sf::Vector2i mousePosDelta = mousePos - prevMousePos;
-            transform->Position.x -= mousePosDelta.x;
-            transform->Position.y -= mousePosDelta.y;
+            transform->Move({ -static_cast<float>(mousePosDelta.x), -static_cast<float>(mousePosDelta.y) });
 
             prevMousePos = mousePos;
         }
@@ -240,12 +236,14 @@ namespace LowEngine::Panels {
             auto camera = scene->GetComponent<ECS::CameraComponent>(cameraEntity->Id);
 
             camera->ZoomFactor = std::clamp(camera->ZoomFactor - 0.1f, 0.0f, 1000.0f);
+            camera->MarkChanged();
         }
         if (EditorAction::Action(MouseScrollAction::Down)->Started) {
             auto cameraEntity = scene->GetCurrentCamera();
             auto camera = scene->GetComponent<ECS::CameraComponent>(cameraEntity->Id);
 
             camera->ZoomFactor += 0.1;
+            camera->MarkChanged();
         }
     }
 
@@ -9,6 +9,7 @@ int main() {
     // initialize the game engine
     LowEngine::Game game;
 	game.Title = "LOWEditor";
+    game.AutosaveInterval = LowEditor::Config::AUTOSAVE_INTERVAL;
 
     // create temp background scene
     auto mainScene = game.Scenes.CreateScene("new scene");
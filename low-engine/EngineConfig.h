@@ -10,12 +10,66 @@ namespace LowEngine {
     class Config {
     public:
         /**
-         * @brief Default count of the component in the pool for each scene.
+         * @brief Count of the components in a single chunk of the Component Pool.
          *
-         * This value is used to reserve the Component Pool for each scene.
-         * Component Pool will automatically expand during the scene's lifetime.
+         * Component Pool allocates memory one chunk at a time. Chunks are never reallocated,
+         * so growing the pool doesn't move existing components.
          */
-        inline static const std::size_t DEFAULT_COMPONENT_POOL_SIZE = 1000;
+        inline static const std::size_t COMPONENT_POOL_CHUNK_SIZE = 256;
+
+        /**
+         * @brief Maximal number of Component types that can be registered.
+         *
+         * Every Entity stores a bitmask of attached Component types, this is the size of that mask.
+         */
+        static constexpr std::size_t MAX_COMPONENT_TYPES = 128;
+
+        /**
+         * @brief Maximal number of Entity slots in a single Memory.
+         *
+         * Entity Ids read from scene files are checked against it before any storage grows, so a corrupted Id
+         * is rejected instead of allocating every slot up to its index.
+         */
+        static constexpr std::size_t MAX_ENTITY_COUNT = std::size_t{1} << 20;
+
+        /**
+         * @brief Number of worker threads used to update Components.
+         *
+         * Value of 0 means one thread less than hardware threads, since the main thread also takes part in updates.
+         */
+        inline static const std::size_t WORKER_THREAD_COUNT = 0;
+
+        /**
+         * @brief Minimal number of Components updated by a single worker thread job.
+         *
+         * Used by pools of Components declaring ParallelSafeUpdate. Pools smaller than this are updated on one thread.
+         */
+        inline static const std::size_t PARALLEL_UPDATE_BATCH_SIZE = 256;
+
+        /**
+         * @brief Assumed size of CPU cache line, in bytes.
+         */
+        static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+        /**
+         * @brief Default number of ticks kept by a snapshot ring buffer.
+         */
+        inline static const std::size_t SNAPSHOT_RING_CAPACITY = 64;
+
+        /**
+         * @brief Default number of ticks between full snapshots in a snapshot ring buffer.
+         *
+         * Ticks in between are stored as deltas against the previous tick. Restoring a tick decodes up to
+         * this many deltas.
+         */
+        inline static const std::size_t SNAPSHOT_KEYFRAME_INTERVAL = 8;
+
+        /**
+         * @brief Width and height, in cells, of chunks tiles are packed in when a tile map layer is saved.
+         *
+         * Saved layers record their chunk size, so changing it doesn't break existing files.
+         */
+        inline static const int TILE_CHUNK_SIZE = 32;
 
         /**
          * @brief Layer ID used for drawing overlay elements.
@@ -70,6 +124,31 @@ namespace LowEngine {
          */
         inline static const std::string SCENE_FILE_EXTENSION = ".lowscene";
 
+        /**
+         * @brief Suffix added to the scene name for autosaved copies of the scene, e.g. "level.autosave.lowscene".
+         */
+        inline static const std::string AUTOSAVE_FILE_SUFFIX = ".autosave";
+
+        /**
+         * @brief Extension appended to the scene file name for its journal, e.g. "level.lowscene.journal".
+         *
+         * Saves append only the changes since the previous save to the journal, see SceneJournalFormat.
+         */
+        inline static const std::string SCENE_JOURNAL_FILE_EXTENSION = ".journal";
+
+        /**
+         * @brief Number of records in a scene journal after which the next save rewrites the whole scene.
+         */
+        inline static const std::size_t SCENE_JOURNAL_MAX_RECORDS = 64;
+
+        /**
+         * @brief Size of a scene journal, as a fraction of the scene file, after which the next save rewrites
+         * the whole scene.
+         *
+         * Compaction keeps loading time close to the one of a single scene file.
+         */
+        inline static const float SCENE_JOURNAL_COMPACTION_RATIO = 0.5f;
+
         /**
          * @brief Default name for the assets folder.
          */
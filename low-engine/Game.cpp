@@ -1,12 +1,45 @@
 #include "Game.h"
 
 #include <algorithm>
+#include <memory>
+#include <random>
+#include <span>
 
 #include "scene/Scene.h"
+#include "scene/SceneFile.h"
+#include "scene/SceneJournal.h"
+#include "utils/JsonStream.h"
+#include "utils/MappedFile.h"
 
 #include "log/LogMemoryBufferSink.h"
 
 namespace LowEngine {
+	namespace {
+		Threading::BackgroundWriter::Encoder EncodePrettyJSON(nlohmann::ordered_json json) {
+			return [json = std::move(json)](std::vector<std::byte>& content) {
+				std::string text = json.dump(4); // pretty print with 4 spaces
+				auto bytes = std::as_bytes(std::span(text));
+				content.assign(bytes.begin(), bytes.end());
+				return true;
+			};
+		}
+
+		uint64_t NewSaveId() {
+			static std::mt19937_64 rng(std::random_device{}());
+			uint64_t saveId;
+			do {
+				saveId = rng();
+			} while (saveId == 0);
+			return saveId;
+		}
+
+		std::filesystem::path GetJournalPath(const std::filesystem::path& sceneFilePath) {
+			std::filesystem::path journalPath = sceneFilePath;
+			journalPath += Config::SCENE_JOURNAL_FILE_EXTENSION;
+			return journalPath;
+		}
+	}
+
 	void Game::StartLog() {
 		auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_mt>("lowengine.log", true);
 		auto memorySink = std::make_shared<LogMemoryBufferSink>(_logContent);
@@ -69,13 +102,7 @@ namespace LowEngine {
 		return Window.isOpen();
 	}
 
-	bool Game::SaveProject(const std::string& filePath) {
-		std::ofstream file(filePath);
-		if (!file.is_open()) {
-			_log->error("Failed to open file for saving project: {}", filePath);
-			return false;
-		}
-
+	bool Game::SaveProject(const std::string& filePath, SaveCallback onSaved) {
 		_log->debug("Saving project to file: {}", filePath);
 
 		nlohmann::ordered_json projectJson;
@@ -84,19 +111,22 @@ namespace LowEngine {
 		projectJson["assets"] = Assets::SerializeToJSON(ProjectDirectory);
 		projectJson["inputActions"] = Input.SerializeActionsToJSON();
 
-		file << projectJson.dump(4); // pretty print with 4 spaces
-
-		file.close();
-		if (file.fail()) {
-			_log->error("Failed to write project data to file: {}", filePath);
-			return false;
-		}
-		_log->info("Project saved successfully to: {}", filePath);
+		_saveWriter.Write(filePath, EncodePrettyJSON(std::move(projectJson)),
+		                  [filePath, onSaved = std::move(onSaved)](bool success) {
+			if (success) {
+				_log->info("Project saved successfully to: {}", filePath);
+			} else {
+				_log->error("Failed to write project data to file: {}", filePath);
+			}
+			if (onSaved) onSaved(success);
+		});
 
 		return true;
 	}
 
 	bool Game::LoadProject(const std::string& filePath) {
+		// the file might be still being saved
+		WaitForSaves();
 		_log->info("Loading project from file: {}", filePath);
 
 		std::ifstream file(filePath);
@@ -104,8 +134,19 @@ namespace LowEngine {
 			_log->error("Failed to open file for loading project: {}", filePath);
 			return false;
 		}
-		nlohmann::ordered_json projectJson;
-		file >> projectJson;
+		// only sections used here are materialized, anything else in the file is skipped while parsing
+		nlohmann::ordered_json projectJson = nlohmann::ordered_json::object();
+		Utils::JsonStreamParser parser;
+		for (const char* section : {"/title", "/assets", "/inputActions", "/defaultSceneName"}) {
+			parser.OnValue(section, [&projectJson](std::string_view key, nlohmann::ordered_json& value) {
+				projectJson[std::string(key)] = std::move(value);
+				return true;
+			});
+		}
+		if (!parser.Parse(file)) {
+			_log->error("Failed to parse project file {}: {}", filePath, parser.GetError());
+			return false;
+		}
 
 		if (projectJson.contains("title")) {
 			Title = projectJson["title"].get<std::string>();
@@ -162,34 +203,162 @@ namespace LowEngine {
 		return true;
 	}
 
-	bool Game::SaveCurrentScene() {
-		std::filesystem::path sceneFilePath = ProjectDirectory / Config::SCENES_FOLDER_NAME;
-		std::filesystem::create_directories(sceneFilePath);
-		sceneFilePath /= Scenes.GetCurrentScene()->Name + Config::SCENE_FILE_EXTENSION;
-		
-		std::ofstream file(sceneFilePath);
-		if (!file.is_open()) {
-			_log->error("Failed to open file for saving scene: {}", sceneFilePath.string());
+	bool Game::SaveCurrentScene(SaveCallback onSaved) {
+		Scene& scene = *Scenes.GetCurrentScene();
+		std::filesystem::path sceneFilePath = ProjectDirectory / Config::SCENES_FOLDER_NAME
+		                                      / (scene.Name + Config::SCENE_FILE_EXTENSION);
+		return SaveSceneToFile(scene, sceneFilePath, _sceneSave, _autosave, std::move(onSaved));
+	}
+
+	bool Game::AutosaveCurrentScene() {
+		Scene& scene = *Scenes.GetCurrentScene();
+		std::filesystem::path sceneFilePath = ProjectDirectory / Config::SCENES_FOLDER_NAME
+		                                      / (scene.Name + Config::AUTOSAVE_FILE_SUFFIX
+		                                         + Config::SCENE_FILE_EXTENSION);
+		return SaveSceneToFile(scene, sceneFilePath, _autosave, _sceneSave, nullptr);
+	}
+
+	bool Game::SaveSceneToFile(Scene& scene, const std::filesystem::path& filePath, SceneSaveState& state,
+	                           SceneSaveState& other, SaveCallback onSaved) {
+		std::error_code error;
+		std::filesystem::create_directories(filePath.parent_path(), error);
+		if (error) {
+			_log->error("Failed to create directory for saving scene: {} ({})", filePath.string(), error.message());
 			return false;
 		}
 
-		_log->debug("Saving scene to file: {}", sceneFilePath.string());
+		if (state.SceneId != scene.GetInstanceId() || state.Path != filePath) {
+			state = SceneSaveState();
+			state.SceneId = scene.GetInstanceId();
+			state.Path = filePath;
+		}
 
-		auto sceneJson = Scenes.GetCurrentScene()->SerializeToJSON();
+		// edits of Components that don't track their changes can't be journaled, so both files are written whole
+		const bool changesTracked = scene.CanSerializeChanges();
+		if (!changesTracked && other.SceneId == scene.GetInstanceId()) {
+			other.SaveId = 0;
+			other.PendingRecords.clear();
+		}
 
-		file << sceneJson.dump(4); // pretty print with 4 spaces
+		// serialized scene or its changes are the snapshot: they don't refer to the scene, which can change
+		// while the file is written
+		std::vector<std::byte> record;
+		const bool otherIsJournaled = other.SceneId == scene.GetInstanceId() && other.SaveId != 0;
+		if (changesTracked && (state.SaveId != 0 || otherIsJournaled)) {
+			std::vector<std::byte> changes;
+			scene.SerializeChangesToBinary(changes);
+			SceneJournalWriter::WriteRecord(changes, record);
+		}
+		scene.ClearChanges();
+		if (otherIsJournaled) {
+			// changes are cleared, so the other file gets them with its next save
+			other.PendingRecords.insert(other.PendingRecords.end(), record.begin(), record.end());
+		}
 
-		file.close();
-		if (file.fail()) {
-			_log->error("Failed to write scene data to file: {}", sceneFilePath.string());
-			return false;
+		const size_t journalSize = state.JournalSize + state.PendingRecords.size() + record.size();
+		const bool compact = !changesTracked || state.SaveId == 0
+		                     || state.RecordCount >= Config::SCENE_JOURNAL_MAX_RECORDS
+		                     || journalSize > state.FileSize * Config::SCENE_JOURNAL_COMPACTION_RATIO;
+
+		const uint64_t saveId = compact ? NewSaveId() : state.SaveId;
+		// a failed write breaks the chain of records, so the next save writes the whole scene
+		auto onFailed = [&state, saveId] {
+			if (state.SaveId == saveId) {
+				state.SaveId = 0;
+			}
+		};
+		auto onWritten = [filePath, onFailed, onSaved = std::move(onSaved)](bool success) {
+			if (success) {
+				_log->info("Scene saved successfully to: {}", filePath.string());
+			} else {
+				onFailed();
+				_log->error("Failed to write scene data to file: {}", filePath.string());
+			}
+			if (onSaved) onSaved(success);
+		};
+
+		if (!compact) {
+			_log->debug("Saving changes of scene to journal of file: {}", filePath.string());
+
+			std::vector<std::byte> records = std::move(state.PendingRecords);
+			state.PendingRecords.clear();
+			records.insert(records.end(), record.begin(), record.end());
+			state.JournalSize = journalSize;
+			state.RecordCount++;
+
+			auto encode = [records = std::move(records)](std::vector<std::byte>& content) mutable {
+				content = std::move(records);
+				return true;
+			};
+			_saveWriter.Append(GetJournalPath(filePath), std::move(encode), std::move(onWritten));
+			return true;
 		}
-		_log->info("Scene saved successfully to: {}", sceneFilePath.string());
+
+		_log->debug("Saving scene to file: {}", filePath.string());
+
+		// only fixed-size records are written here, MessagePack encoding of the rest runs on the writer thread
+		auto snapshot = std::make_shared<SceneFileSnapshot>();
+		scene.SerializeToBinary(*snapshot, saveId);
+		std::vector<std::byte> journal;
+		SceneJournalWriter::WriteHeader(saveId, journal);
+
+		// size of the encoded file is known once it's written, until then the binary part stands for it
+		auto fileSize = std::make_shared<size_t>(snapshot->GetBinarySize());
+		state.SaveId = saveId;
+		state.FileSize = *fileSize;
+		state.JournalSize = journal.size();
+		state.RecordCount = 0;
+		state.PendingRecords.clear();
+
+		// journal of the previous save is replaced only once the scene file is, so its changes aren't lost
+		// if the scene file fails to be written, and it's never applied on top of the new scene file
+		auto encodeScene = [snapshot, fileSize](std::vector<std::byte>& content) {
+			snapshot->Encode(content);
+			*fileSize = content.size();
+			return true;
+		};
+		auto encodeJournal = [journal = std::move(journal)](std::vector<std::byte>& content) mutable {
+			content = std::move(journal);
+			return true;
+		};
+		std::vector<Threading::BackgroundWriter::File> files;
+		files.push_back({filePath, std::move(encodeScene)});
+		files.push_back({GetJournalPath(filePath), std::move(encodeJournal)});
+		auto onSceneWritten = [&state, saveId, fileSize, onWritten = std::move(onWritten)](bool success) {
+			if (success && state.SaveId == saveId) {
+				state.FileSize = *fileSize;
+			}
+			onWritten(success);
+		};
+		_saveWriter.WriteAll(std::move(files), std::move(onSceneWritten));
+
+		return true;
+	}
+
+	bool Game::ExportCurrentSceneToJSON(const std::filesystem::path& filePath, SaveCallback onSaved) {
+		auto sceneJson = Scenes.GetCurrentScene()->SerializeToJSON();
+
+		_saveWriter.Write(filePath, EncodePrettyJSON(std::move(sceneJson)),
+		                  [filePath, onSaved = std::move(onSaved)](bool success) {
+			if (success) {
+				_log->info("Scene exported successfully to: {}", filePath.string());
+			} else {
+				_log->error("Failed to write scene data to file: {}", filePath.string());
+			}
+			if (onSaved) onSaved(success);
+		});
 
 		return true;
 	}
 
+	void Game::WaitForSaves() {
+		_saveWriter.Flush();
+	}
+
 	void Game::CloseProject() {
+		WaitForSaves();
+		_sceneSave = SceneSaveState();
+		_autosave = SceneSaveState();
 		Scenes.DestroyAll();
 		Input.RemoveAllActions();
 		Assets::UnloadAll();
@@ -198,24 +367,66 @@ namespace LowEngine {
 
 	void Game::LoadScene(const std::string& sceneName)
 	{
+		// the file might be still being saved
+		WaitForSaves();
 		std::filesystem::path sceneFilePath = ProjectDirectory / Config::SCENES_FOLDER_NAME / (sceneName + Config::SCENE_FILE_EXTENSION);
 		_log->info("Loading scene from file: {}", sceneFilePath.string());
-		std::ifstream file(sceneFilePath);
-		if (!file.is_open()) {
+		Utils::MappedFile file;
+		if (!file.Open(sceneFilePath)) {
 			_log->error("Failed to open scene file: {}", sceneFilePath.string());
 			return;
 		}
-		nlohmann::ordered_json sceneJson;
-		file >> sceneJson;
 		auto scene = Scenes.CreateEmptyScene(sceneName);
 		if (!scene) {
 			_log->error("Failed to create empty scene: {}", sceneName);
 			return;
 		}
-		if (!scene->DeserializeFromJSON(sceneJson)) {
-			_log->error("Failed to load scene data from JSON: {}", sceneName);
-			return;
+		SceneSaveState loaded;
+		loaded.SceneId = scene->GetInstanceId();
+		loaded.Path = sceneFilePath;
+		// scenes saved before the binary format, or exported for interchange, are JSON
+		std::span<const std::byte> sceneData = file.GetData();
+		if (SceneFileReader::IsSceneFile(sceneData)) {
+			if (!scene->DeserializeFromBinary(sceneData)) {
+				_log->error("Failed to load scene data from binary file: {}", sceneName);
+				return;
+			}
+
+			const uint64_t saveId = SceneJournalReader::ReadSaveId(sceneData);
+			std::filesystem::path journalPath = GetJournalPath(sceneFilePath);
+			std::error_code error;
+			Utils::MappedFile journalFile;
+			SceneJournalReader journal;
+			if (saveId != 0 && std::filesystem::exists(journalPath, error) && journalFile.Open(journalPath)
+			    && journal.Open(journalFile.GetData())) {
+				if (journal.GetSaveId() == saveId) {
+					for (std::span<const std::byte> record : journal.GetRecords()) {
+						if (!scene->DeserializeChangesFromBinary(record)) {
+							_log->error("Failed to apply scene changes from journal: {}", journalPath.string());
+							return;
+						}
+					}
+					// a torn journal is replaced by the next save
+					loaded.SaveId = journal.IsTruncated() ? 0 : saveId;
+					loaded.FileSize = sceneData.size();
+					loaded.JournalSize = journalFile.GetData().size();
+					loaded.RecordCount = journal.GetRecords().size();
+				} else {
+					_log->warn("Journal {} doesn't belong to the scene file and was ignored", journalPath.string());
+				}
+			}
+		} else {
+			std::string_view sceneJson(reinterpret_cast<const char*>(sceneData.data()), sceneData.size());
+			if (!scene->DeserializeFromJSONStream(sceneJson)) {
+				_log->error("Failed to load scene data from JSON: {}", sceneName);
+				return;
+			}
 		}
+		// loaded state is what the file holds
+		scene->ClearChanges();
+		_sceneSave = std::move(loaded);
+		_autosave = SceneSaveState();
+
 		Scenes.SelectScene(scene);
 		_log->info("Scene loaded successfully: {}", sceneName);
 	}
@@ -231,6 +442,17 @@ namespace LowEngine {
 
 		Scenes.GetCurrentScene()->Update(deltaTime);
 		Music.Update(deltaTime);
+
+		_saveWriter.Poll();
+		// play mode copies of scenes are never saved
+		if (AutosaveInterval > 0.0f && !ProjectDirectory.empty() && !Scenes.GetCurrentScene()->IsTemporary) {
+			_autosaveTimer += deltaTime;
+			// a slow disk delays autosave instead of queueing more of them
+			if (_autosaveTimer >= AutosaveInterval && !_saveWriter.IsWriting()) {
+				_autosaveTimer = 0.0f;
+				AutosaveCurrentScene();
+			}
+		}
 	}
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <filesystem>
+#include <functional>
 
 #include "EngineConfig.h"
 #include "log/Log.h"
@@ -10,6 +11,7 @@
 #include "scene/SceneManager.h"
 #include "input/InputManager.h"
 #include "music/MusicManager.h"
+#include "threading/BackgroundWriter.h"
 
 namespace LowEngine {
     /**
@@ -86,6 +88,20 @@ namespace LowEngine {
          */
         Music::MusicManager Music;
 
+        /**
+         * @brief Interval of autosaving the current scene, in seconds. 0 disables autosave.
+         *
+         * Autosave writes a copy next to the scene file, named with Config::AUTOSAVE_FILE_SUFFIX, so it never
+         * overwrites a scene the user saved. Like saves, autosaves append only changes to the copy's journal.
+         * It's skipped while another save is still being written.
+         */
+        float AutosaveInterval = 0.0f;
+
+        /**
+         * @brief Function called on the main thread once a save finished.
+         */
+        using SaveCallback = std::function<void(bool success)>;
+
         /**
          * @brief Default constructor for the Game class.
          * 
@@ -116,6 +132,7 @@ namespace LowEngine {
          * Ensures proper cleanup by stopping the logging system.
          */
         ~Game() {
+            WaitForSaves();
             StopLog();
         }
 
@@ -162,13 +179,15 @@ namespace LowEngine {
         /**
          * @brief Saves the current project to a file.
          *
-         * This function serializes the current project properties and assets to a JSON file.
+         * This function serializes the current project properties and assets to a JSON object. Formatting and
+         * writing it to the file happens in the background, see SaveCurrentScene.
          * The path should point to a valid location where the project can be saved.
          *
          * @param filePath The path to save the project file.
-         * @return true if the project was saved successfully, false otherwise.
+         * @param onSaved Function called once the file is written. Can be empty.
+         * @return true if the save was started, false otherwise.
 		 */
-		bool SaveProject(const std::string& filePath);
+		bool SaveProject(const std::string& filePath, SaveCallback onSaved = nullptr);
 
         /**
          * @brief Loads a project from a file.
@@ -181,7 +200,54 @@ namespace LowEngine {
 		 */
         bool LoadProject(const std::string& filePath);
 
-        bool SaveCurrentScene();
+        /**
+         * @brief Saves the current scene to the project's scenes folder, in the binary scene format.
+         *
+         * Once the scene file is written, later saves append only the changes since the previous save to its
+         * journal (see SceneJournalFormat), so their cost follows the size of the edits. The whole scene is
+         * written again when the journal grows past Config::SCENE_JOURNAL_COMPACTION_RATIO of the scene file
+         * or Config::SCENE_JOURNAL_MAX_RECORDS records, or after a failed write. It's also written whole while the
+         * scene holds Components whose edits can't be seen, see Scene::CanSerializeChanges.
+         * The scene, or its changes, are serialized on the calling thread, which is the snapshot: the binary
+         * format mostly copies raw Component state, so it's cheap. Writing happens on a background thread, so
+         * the scene can change meanwhile. The scene file is replaced atomically and torn journal records are
+         * dropped when loading, so an interrupted save keeps the previous state.
+         * Errors of writing are logged, and onSaved is called, during a later frame.
+         *
+         * @param onSaved Function called once the file is written. Can be empty.
+         * @return true if the save was started, false otherwise.
+         */
+        bool SaveCurrentScene(SaveCallback onSaved = nullptr);
+
+        /**
+         * @brief Saves a copy of the current scene next to its file, see AutosaveInterval.
+         * @return true if the save was started, false otherwise.
+         */
+        bool AutosaveCurrentScene();
+
+        /**
+         * @brief Exports the current scene as JSON, for interchange with other tools.
+         *
+         * JSON scenes can be loaded like binary ones, see LoadScene. The JSON is built on the calling thread and
+         * formatted and written in the background, like in SaveCurrentScene.
+         * @param filePath Path of the JSON file.
+         * @param onSaved Function called once the file is written. Can be empty.
+         * @return true if the export was started, false otherwise.
+         */
+        bool ExportCurrentSceneToJSON(const std::filesystem::path& filePath, SaveCallback onSaved = nullptr);
+
+        /**
+         * @brief Check if any save is still being written.
+         * @return true if a save is in progress.
+         */
+        [[nodiscard]] bool IsSaving() const {
+            return _saveWriter.IsWriting();
+        }
+
+        /**
+         * @brief Blocks until all started saves are written, and calls their callbacks.
+         */
+        void WaitForSaves();
 
         /**
          * @brief Closes the current project.
@@ -195,8 +261,9 @@ namespace LowEngine {
     	/**
          * @brief Loads a scene by its name.
          *
-         * This function loads a scene with the specified name.
-         * If the scene does not exist, it logs an error message.
+         * This function loads a scene with the specified name, memory-mapping its file.
+         * Both binary and JSON scene files are accepted. Changes in the journal of a binary file are applied
+         * on top of it, see SaveCurrentScene. If the scene does not exist, it logs an error message.
          *
 		 * @param sceneName The name of the scene to load.
 		 */
@@ -220,6 +287,56 @@ namespace LowEngine {
 		 */
         float _fixedUpdateAccumulator = 0.0f;
 
+        /**
+         * @brief Time since the last autosave.
+         */
+        float _autosaveTimer = 0.0f;
+
+        /**
+         * @brief Writes saved files in the background.
+         */
+        Threading::BackgroundWriter _saveWriter;
+
+        /**
+         * @brief State of a scene file and its journal, see SaveCurrentScene.
+         */
+        struct SceneSaveState {
+            /**
+             * @brief Instance id of the scene saved to the file, see Scene::GetInstanceId. Changes are tracked by
+             * the scene, so other scenes, even if created under the same name, are saved whole.
+             */
+            uint64_t SceneId = 0;
+            std::filesystem::path Path;
+            /** @brief Id of the save of the file. 0 if the next save has to write the whole scene. */
+            uint64_t SaveId = 0;
+            size_t FileSize = 0;
+            size_t JournalSize = 0;
+            size_t RecordCount = 0;
+            /** @brief Journal records of changes saved to the other file since this one was last written. */
+            std::vector<std::byte> PendingRecords;
+        };
+
+        /**
+         * @brief State of the file the current scene is saved to.
+         */
+        SceneSaveState _sceneSave;
+
+        /**
+         * @brief State of the file the current scene is autosaved to.
+         */
+        SceneSaveState _autosave;
+
+        /**
+         * @brief Serializes the scene, or its changes, and starts writing them to a file, see SaveCurrentScene.
+         * @param scene Scene to save.
+         * @param filePath Path of the scene file.
+         * @param state State of the file.
+         * @param other State of the other file the scene is saved to. Changes saved now are kept for it.
+         * @param onSaved Function called once the file is written. Can be empty.
+         */
+        bool SaveSceneToFile(Scene& scene, const std::filesystem::path& filePath, SceneSaveState& state,
+                             SceneSaveState& other, SaveCallback onSaved);
+
         /**
          * @brief Updates the game state.
          *
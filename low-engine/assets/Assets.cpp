@@ -219,7 +219,8 @@ namespace LowEngine {
     }
 
     Animation::SpriteSheet& Assets::GetSpriteSheet(size_t textureId) {
-        return *GetInstance()->_spriteSheets[textureId];
+        // at() doesn't modify the map, so it's safe to call from parallel Component updates
+        return *GetInstance()->_spriteSheets.at(textureId);
     }
 
     Animation::SpriteSheet& Assets::GetSpriteSheet(const std::string& textureAlias) {
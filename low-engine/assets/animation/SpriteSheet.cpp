@@ -77,6 +77,6 @@ namespace LowEngine::Animation {
     }
 
     Animation::AnimationClip& SpriteSheet::GetAnimationClip(const std::string& name) {
-        return *_animations[name];
+        return *_animations.at(name);
     }
 }
@@ -22,6 +22,7 @@ namespace LowEngine::ECS {
 		TextureId = textureId;
 		SetTexture(Assets::GetTexture(textureId));
 		UpdateFrameSize();
+		MarkChanged();
 	}
 
 	void AnimatedSpriteComponent::Play(const std::string& animationName, bool loop) {
@@ -41,6 +42,7 @@ namespace LowEngine::ECS {
 		CurrentFrame = 0;
 		FrameTime = 0.0f;
 		Loop = loop;
+		MarkChanged();
 
 		Sprite.setTextureRect(Clip.Frames[CurrentFrame]);
 	}
@@ -49,21 +51,29 @@ namespace LowEngine::ECS {
 		CurrentClipName.clear();
 		CurrentFrame = 0;
 		FrameTime = 0.0f;
+		MarkChanged();
 	}
 
 	void AnimatedSpriteComponent::Update(float deltaTime) {
 		auto transformComponent = _memory->GetComponent<TransformComponent>(EntityId);
-		Sprite.setPosition(transformComponent->Position);
-		Sprite.setRotation(transformComponent->Rotation);
-		Sprite.setScale(transformComponent->Scale);
+		if (transformComponent->GetVersion() != _transformVersion) {
+			Sprite.setPosition(transformComponent->GetPosition());
+			Sprite.setRotation(transformComponent->GetRotation());
+			Sprite.setScale(transformComponent->GetScale());
+			_transformVersion = transformComponent->GetVersion();
+		}
 		Sprite.DrawOrder = DrawOrder;
 
 		if (CurrentClipName.empty()) return;
 
+		// runs on worker threads, where nothing would catch a throwing lookup
+		if (!Assets::HasSpriteSheet(TextureId)) return;
 		auto& Sheet = Assets::GetSpriteSheet(TextureId);
+		if (!Sheet.HasAnimationClip(CurrentClipName)) return;
 		auto& Clip = Sheet.GetAnimationClip(CurrentClipName);
 
 		FrameTime += deltaTime;
+		MarkChanged();
 		if (FrameTime >= Clip.FrameDuration) {
 			FrameTime = 0.0f;
 			CurrentFrame++;
@@ -16,6 +16,17 @@ namespace LowEngine::ECS {
      */
     class AnimatedSpriteComponent : public IComponent<AnimatedSpriteComponent, TransformComponent> {
     public:
+        /**
+         * @brief Update only touches this Component and reads Transform and Assets, so Components can be updated
+         * in parallel.
+         */
+        static constexpr bool DependenciesReadOnly = true;
+        static constexpr bool WorkerThreadSafe = true;
+        static constexpr bool ParallelSafeUpdate = true;
+
+        /** @brief Setters and Update of a playing animation mark the Entity changed, see IComponentBase::MarkChanged. */
+        static constexpr bool TracksChanges = true;
+
         /**
          * @brief Id of the texture used by the Sprite.
          */
@@ -30,7 +41,7 @@ namespace LowEngine::ECS {
          * @brief The draw order of the sprite.
          *
          * Sprites with lower draw orders will be drawn first, and thus appear behind sprites with higher draw orders.
-         * The default draw order is 0.
+         * The default draw order is 0. Call MarkChanged after changing it.
 		 */
         int DrawOrder = 0;
 
@@ -65,7 +76,8 @@ namespace LowEngine::ECS {
             : IComponent(memory, other),
               TextureId(other->TextureId), Sprite(other->Sprite), DrawOrder(other->DrawOrder),
               CurrentClipName(other->CurrentClipName),
-              CurrentFrame(other->CurrentFrame), FrameTime(other->FrameTime), Loop(other->Loop) {
+              CurrentFrame(other->CurrentFrame), FrameTime(other->FrameTime), Loop(other->Loop),
+              _transformVersion(other->_transformVersion) {
         }
 
         /**
@@ -115,6 +127,11 @@ namespace LowEngine::ECS {
         bool DeserializeFromJSON(const nlohmann::ordered_json& jsonData) override;
 
     protected:
+        /**
+         * @brief Version of the Transform that Sprite was last synced with, see TransformComponent::GetVersion.
+         */
+        uint64_t _transformVersion = 0;
+
         void SetTexture(const sf::Texture& texture);
 
         /**
@@ -6,8 +6,8 @@ namespace LowEngine::ECS {
 	void CameraComponent::Update(float deltaTime) {
 		auto transformComponent = _memory->GetComponent<TransformComponent>(EntityId);
 		if (transformComponent) {
-			_view.setCenter(transformComponent->Position);
-			_view.setRotation(transformComponent->Rotation);
+			_view.setCenter(transformComponent->GetPosition());
+			_view.setRotation(transformComponent->GetRotation());
 		}
 	}
 
@@ -24,6 +24,7 @@ namespace LowEngine::ECS {
 		}
 		if (jsonData.contains("zoom_factor")) {
 			ZoomFactor = jsonData["zoom_factor"].get<float>();
+			MarkChanged();
 		} else {
 			_log->error("CameraComponent deserialization failed: missing 'zoom_factor' field.");
 			return false;
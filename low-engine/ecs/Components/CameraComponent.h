@@ -11,12 +11,23 @@ namespace LowEngine::ECS {
      */
     class CameraComponent : public IComponent<CameraComponent, TransformComponent> {
     public:
+        /**
+         * @brief Update only copies Transform into own data, so it can run on a worker thread.
+         */
+        static constexpr bool DependenciesReadOnly = true;
+        static constexpr bool WorkerThreadSafe = true;
+
+        /** @brief Setters mark the Entity changed, see IComponentBase::MarkChanged. */
+        static constexpr bool TracksChanges = true;
+
         /**
          * @brief A factor by which the viewport will be zoomed-in or -out.
          *
          * - <0.0 mirrors viewport;
          * - 0.0 - 1.0 zoom in;
          * - >1.0 zoom out;
+         *
+         * Call MarkChanged after changing it.
          */
         float ZoomFactor = 1.0f;
 
@@ -11,8 +11,18 @@ namespace LowEngine::ECS {
 		}
 	}
 
-	void ColliderComponent::Update(float deltaTime) {
-		
+	void ColliderComponent::Park() {
+		if (B2_IS_NON_NULL(_bodyId) && b2Body_IsValid(_bodyId)) {
+			b2Body_Disable(_bodyId);
+		}
+	}
+
+	void ColliderComponent::Reset() {
+		if (B2_IS_NON_NULL(_bodyId) && b2Body_IsValid(_bodyId)) {
+			b2Body_SetLinearVelocity(_bodyId, b2Vec2_zero);
+			b2Body_SetAngularVelocity(_bodyId, 0.0f);
+			b2Body_Enable(_bodyId);
+		}
 	}
 
 	void ColliderComponent::FixedUpdate(float fixedDeltaTime)
@@ -24,8 +34,8 @@ namespace LowEngine::ECS {
 			b2Rot currentRot = b2Body_GetRotation(_bodyId);
 			float currentAng = b2Rot_GetAngle(currentRot);
 			
-			b2Vec2 targetPos = { transform->Position.x, transform->Position.y };
-			b2Rot targetRot = b2MakeRot(transform->Rotation.asRadians());
+			b2Vec2 targetPos = { transform->GetPosition().x, transform->GetPosition().y };
+			b2Rot targetRot = b2MakeRot(transform->GetRotation().asRadians());
 			float targetAng = b2Rot_GetAngle(targetRot);
 			
 			float dx = targetPos.x - currentPos.x;
@@ -52,7 +62,7 @@ namespace LowEngine::ECS {
 			}
 		}
 
-		if (DrawCollisionOverlay && B2_IS_NON_NULL(_bodyId)) {
+		if (DrawCollisionOverlay && B2_IS_NON_NULL(_bodyId) && EnsureOverlayTexture()) {
 			auto position = b2Body_GetPosition(_bodyId);
 			auto rotation = b2Body_GetRotation(_bodyId);
 			auto angleRad = b2Rot_GetAngle(rotation);
@@ -120,6 +130,7 @@ namespace LowEngine::ECS {
 
 		if (jsonData.contains("DrawCollisionOverlay")) {
 			DrawCollisionOverlay = jsonData["DrawCollisionOverlay"].get<bool>();
+			MarkChanged();
 		}
 		else {
 			_log->error("ColliderComponent deserialization failed: 'DrawCollisionOverlay' field missing.");
@@ -129,6 +140,19 @@ namespace LowEngine::ECS {
 		return true;
 	}
 
+	bool ColliderComponent::EnsureOverlayTexture() {
+		if (_renderTexture.getSize().x > 0) {
+			return true;
+		}
+
+		if (!_renderTexture.resize({256, 256})) {
+			_log->error("Failed to resize render texture for collision overlay.");
+			DrawCollisionOverlay = false;
+			return false;
+		}
+		return true;
+	}
+
 	bool ColliderComponent::HasBody() {
 		return B2_IS_NON_NULL(_bodyId);
 	}
@@ -153,7 +177,7 @@ namespace LowEngine::ECS {
 		Type = ColliderType::Kinematic;
 
 		auto transform = _memory->GetComponent<TransformComponent>(EntityId);
-		bodyDef.position = b2Vec2{transform->Position.x, transform->Position.y};
+		bodyDef.position = b2Vec2{transform->GetPosition().x, transform->GetPosition().y};
 
 		_bodyId = b2CreateBody(_memory->Box2dWorldId, &bodyDef);
 
@@ -24,6 +24,9 @@ namespace LowEngine::ECS {
 	 */
 	class ColliderComponent : public IComponent<ColliderComponent, TransformComponent> {
 	public:
+		/** @brief Saved state is only the overlay flag, changes mark the Entity, see MarkChanged. */
+		static constexpr bool TracksChanges = true;
+
 		/**
 		 * @brief Type of this collider.
 		 *
@@ -34,24 +37,18 @@ namespace LowEngine::ECS {
 		ColliderType Type = ColliderType::Kinematic;
 
 		/**
-		 * @brief Should collision shapes be drawn as overlay in the scene?
+		 * @brief Should collision shapes be drawn as overlay in the scene? Call MarkChanged after changing it.
 		 */
 		bool DrawCollisionOverlay = false;
 
 		explicit ColliderComponent(Memory::Memory* memory)
 			: IComponent(memory), _sprite(Assets::GetDefaultTexture()) {
 			_sprite.DrawOrder = Config::DRAW_OVERLAY_LAYER_ID;
-			if (!_renderTexture.resize({256, 256})) {
-				_log->error("Failed to resize render texture for collision overlay.");
-			}
 		}
 
 		ColliderComponent(Memory::Memory* memory, const ColliderComponent* other)
 			: IComponent(memory, other), _sprite(Assets::GetDefaultTexture()) {
 			_sprite.DrawOrder = Config::DRAW_OVERLAY_LAYER_ID;
-			if (!_renderTexture.resize({ 256, 256 })) {
-				_log->error("Failed to resize render texture for collision overlay.");
-			}
 
 			 Type = other->Type;
 			 DrawCollisionOverlay = other->DrawCollisionOverlay;
@@ -66,7 +63,15 @@ namespace LowEngine::ECS {
 		void Initialize() override {
 		}
 
-		void Update(float deltaTime) override;
+		/**
+		 * @brief Disable physics body, so parked collider doesn't collide.
+		 */
+		void Park();
+
+		/**
+		 * @brief Enable physics body again, with no velocity left from the previous use.
+		 */
+		void Reset();
 
 		void FixedUpdate(float fixedDeltaTime) override;
 
@@ -136,9 +141,17 @@ namespace LowEngine::ECS {
 
 		/**
 		 * @brief texture used to generate an overlay image.
+		 *
+		 * Created on first use, so colliders that never draw the overlay don't hold a texture.
 		 */
 		sf::RenderTexture _renderTexture;
 
+		/**
+		 * @brief Make sure overlay texture is created.
+		 * @return True if texture is ready to draw to.
+		 */
+		bool EnsureOverlayTexture();
+
 		// Tunable thresholds
 		const float _snapLinear = 0.015f;
 		const float _snapLinear2 = _snapLinear * _snapLinear;
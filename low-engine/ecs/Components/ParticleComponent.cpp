@@ -17,7 +17,7 @@ namespace LowEngine::ECS {
         if (_positionOverride.has_value())
             return *_positionOverride + PositionOffset;
         const auto* transform = _memory->GetComponent<TransformComponent>(EntityId);
-        return transform->Position + PositionOffset;
+        return transform->GetPosition() + PositionOffset;
     }
 
     void ParticleComponent::Update(float deltaTime) {
@@ -181,6 +181,7 @@ namespace LowEngine::ECS {
         }
 
         DrawOrder = jsonData.value("DrawOrder", 0);
+        MarkChanged();
         return true;
     }
 
@@ -246,8 +247,25 @@ namespace LowEngine::ECS {
         _particles.clear();
     }
 
+    size_t ParticleComponent::GetHeapSize() const {
+        return _particles.capacity() * sizeof(Particles::Particle) + _vertices.getVertexCount() * sizeof(sf::Vertex);
+    }
+
+    void ParticleComponent::ShrinkToFit() {
+        // playing system would grow back to MaxParticles right away
+        if (_playing) {
+            return;
+        }
+
+        _particles.shrink_to_fit();
+        if (_particles.empty()) {
+            _vertices = sf::VertexArray(sf::PrimitiveType::Triangles);
+        }
+    }
+
     void ParticleComponent::SpawnParticle(const Particles::Emitter& emitter, sf::Vector2f origin) {
-        static std::mt19937 rng(std::random_device{}());
+        // one generator per thread, since particles are updated in parallel
+        thread_local std::mt19937 rng(std::random_device{}());
 
         Particles::Particle particle;
 
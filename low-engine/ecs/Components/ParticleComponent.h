@@ -18,17 +18,28 @@ namespace LowEngine::ECS {
      */
     class ParticleComponent : public IComponent<ParticleComponent, TransformComponent> {
     public:
+        /**
+         * @brief Update only touches this Component and reads Transform and Assets, so Components can be updated
+         * in parallel.
+         */
+        static constexpr bool DependenciesReadOnly = true;
+        static constexpr bool WorkerThreadSafe = true;
+        static constexpr bool ParallelSafeUpdate = true;
+
+        /** @brief Saved state is only the emitter and draw order, changes mark the Entity, see MarkChanged. */
+        static constexpr bool TracksChanges = true;
+
         /**
          * @brief ID of the Emitter asset that defines this system's behaviour.
          *
-         * Must be set before calling Play(). Defaults to Config::INVALID_ID.
+         * Must be set before calling Play(). Defaults to Config::INVALID_ID. Call MarkChanged after changing it.
          */
         std::size_t EmitterId = Config::INVALID_ID;
 
         /**
          * @brief Render order relative to other direct-draw components.
          *
-         * Lower values are drawn first (appear behind).
+         * Lower values are drawn first (appear behind). Call MarkChanged after changing it.
          */
         int DrawOrder = 0;
 
@@ -111,6 +122,21 @@ namespace LowEngine::ECS {
          */
         [[nodiscard]] bool IsPlaying() const { return _playing; }
 
+        /**
+         * @brief Returns memory held by live particles and their vertices, including reserved space.
+         */
+        [[nodiscard]] size_t GetHeapSize() const;
+
+        /**
+         * @brief Releases space reserved for particles. A stopped system with no live particles releases all of it.
+         */
+        void ShrinkToFit();
+
+        /**
+         * @brief Stops emission and removes live particles of the previous use. Reserved space is kept.
+         */
+        void Reset() { Clear(); }
+
     protected:
         /**
          * @brief Whether the system is currently emitting particles.
@@ -5,6 +5,7 @@ namespace LowEngine::ECS {
 		SoundId = Assets::GetSoundId(soundAlias);
 		auto& newSound = Assets::GetSound(soundAlias);
 		Sound.setBuffer(newSound);
+		MarkChanged();
 	}
 
 	void SoundComponent::Play() {
@@ -26,6 +27,7 @@ namespace LowEngine::ECS {
 			SoundId = jsonData["sound_id"].get<size_t>();
 			auto& newSound = Assets::GetSound(SoundId);
 			Sound.setBuffer(newSound);
+			MarkChanged();
 		} else {
 			_log->error("SoundComponent deserialization failed: missing 'sound_id' field.");
 			return false;
@@ -10,6 +10,9 @@ namespace LowEngine::ECS {
      */
     class SoundComponent : public IComponent<SoundComponent> {
     public:
+        /** @brief Setters mark the Entity changed, see IComponentBase::MarkChanged. */
+        static constexpr bool TracksChanges = true;
+
         explicit SoundComponent(Memory::Memory* memory)
             : IComponent(memory), Sound(Assets::GetDefaultSound()) {
         }
@@ -20,6 +23,9 @@ namespace LowEngine::ECS {
 
         ~SoundComponent() override = default;
 
+        /**
+         * @brief Id of the sound to play. Set with SetSound.
+         */
         size_t SoundId = 0;
 
         /**
@@ -41,9 +47,6 @@ namespace LowEngine::ECS {
         void Initialize() override {
         }
 
-        void Update(float deltaTime) override {
-        }
-
         nlohmann::ordered_json SerializeToJSON() override;
 		bool DeserializeFromJSON(const nlohmann::ordered_json& jsonData) override;
 
@@ -57,6 +57,7 @@ namespace LowEngine::ECS
 	{
 		auto& sound = Assets::GetSound(soundId);
 		_soundCues[soundId] = std::make_unique<sf::Sound>(sound);
+		MarkChanged();
 	}
 
 	void SoundCueComponent::AddSound(const std::string& soundAlias)
@@ -70,6 +71,7 @@ namespace LowEngine::ECS
 		auto it = _soundCues.find(soundId);
 		if (it != _soundCues.end()) {
 			_soundCues.erase(it);
+			MarkChanged();
 		}
 		else {
 			_log->error("SoundCueComponent: Sound ID {} not found in sound cues.", soundId);
@@ -9,6 +9,9 @@ namespace LowEngine::ECS
 	class SoundCueComponent : public IComponent<SoundCueComponent>
 	{
 	public:
+		/** @brief Adding and removing sounds marks the Entity changed, see IComponentBase::MarkChanged. */
+		static constexpr bool TracksChanges = true;
+
 		explicit SoundCueComponent(Memory::Memory* memory)
 			: IComponent(memory) {
 		}
@@ -18,7 +21,6 @@ namespace LowEngine::ECS
 		~SoundCueComponent() override = default;
 
 		void Initialize() override{}
-		void Update(float deltaTime) override {}
 
 		nlohmann::ordered_json SerializeToJSON() override;
 		bool DeserializeFromJSON(const nlohmann::ordered_json& jsonData) override;
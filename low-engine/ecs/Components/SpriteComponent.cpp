@@ -13,9 +13,12 @@ namespace LowEngine::ECS {
 
 	void SpriteComponent::Update(float deltaTime) {
 		auto transformComponent = _memory->GetComponent<TransformComponent>(EntityId);
-		Sprite.setPosition(transformComponent->Position);
-		Sprite.setRotation(transformComponent->Rotation);
-		Sprite.setScale(transformComponent->Scale);
+		if (transformComponent->GetVersion() != _transformVersion) {
+			Sprite.setPosition(transformComponent->GetPosition());
+			Sprite.setRotation(transformComponent->GetRotation());
+			Sprite.setScale(transformComponent->GetScale());
+			_transformVersion = transformComponent->GetVersion();
+		}
 		Sprite.DrawOrder = DrawOrder;
 	}
 
@@ -57,5 +60,6 @@ namespace LowEngine::ECS {
 	void SpriteComponent::SetTexture(size_t textureId) {
 		TextureId = textureId;
 		SetTexture(Assets::GetTexture(textureId));
+		MarkChanged();
 	}
 }
@@ -16,6 +16,16 @@ namespace LowEngine::ECS {
      */
     class SpriteComponent : public IComponent<SpriteComponent, TransformComponent> {
     public:
+        /**
+         * @brief Update only copies Transform into own data, so Components can be updated in parallel.
+         */
+        static constexpr bool DependenciesReadOnly = true;
+        static constexpr bool WorkerThreadSafe = true;
+        static constexpr bool ParallelSafeUpdate = true;
+
+        /** @brief Setters mark the Entity changed, see IComponentBase::MarkChanged. */
+        static constexpr bool TracksChanges = true;
+
         /**
          * @brief Id of the texture used by the Sprite.
          */
@@ -30,7 +40,7 @@ namespace LowEngine::ECS {
          * @brief The draw order of the sprite.
          *
          * Sprites with lower draw orders will be drawn first, and thus appear behind sprites with higher draw orders.
-         * The default draw order is 0.
+         * The default draw order is 0. Call MarkChanged after changing it.
          */
         int DrawOrder = 0;
 
@@ -39,7 +49,8 @@ namespace LowEngine::ECS {
         }
 
         SpriteComponent(Memory::Memory* memory, SpriteComponent const* other)
-            : IComponent(memory, other), TextureId(other->TextureId), Sprite(other->Sprite), DrawOrder(other->DrawOrder) {
+            : IComponent(memory, other), TextureId(other->TextureId), Sprite(other->Sprite), DrawOrder(other->DrawOrder),
+              _transformVersion(other->_transformVersion) {
         }
 
         virtual ~SpriteComponent() = default;
@@ -69,6 +80,11 @@ namespace LowEngine::ECS {
         virtual void SetTexture(size_t textureId);
 
     protected:
+        /**
+         * @brief Version of the Transform that Sprite was last synced with, see TransformComponent::GetVersion.
+         */
+        uint64_t _transformVersion = 0;
+
         /**
          * @brief Changes the texture the Sprite is using.
          * @param texture Reference to texture.
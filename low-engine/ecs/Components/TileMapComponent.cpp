@@ -8,9 +8,12 @@ namespace LowEngine::ECS {
 		map.Update(deltaTime);
 
 		auto transformComponent = _memory->GetComponent<TransformComponent>(EntityId);
-		_sprite.setPosition(transformComponent->Position);
-		_sprite.setRotation(transformComponent->Rotation);
-		_sprite.setScale(transformComponent->Scale);
+		if (transformComponent->GetVersion() != _transformVersion) {
+			_sprite.setPosition(transformComponent->GetPosition());
+			_sprite.setRotation(transformComponent->GetRotation());
+			_sprite.setScale(transformComponent->GetScale());
+			_transformVersion = transformComponent->GetVersion();
+		}
 		_sprite.DrawOrder = Layer;
 	}
 
@@ -52,6 +55,7 @@ namespace LowEngine::ECS {
 		}
 		if (jsonData.contains("DrawOrder")) {
 			Layer = jsonData["DrawOrder"].get<int>();
+			MarkChanged();
 		} else {
 			_log->error("TileMapComponent deserialization failed: missing 'DrawOrder' field.");
 			return false;
@@ -65,6 +69,7 @@ namespace LowEngine::ECS {
 
 		_mapId = mapId;
 		Resize(map);
+		MarkChanged();
 	}
 
 	std::vector<sf::Vector2f> TileMapComponent::FindPath(sf::Vector2f start, sf::Vector2f end,
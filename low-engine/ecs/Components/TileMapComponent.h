@@ -12,11 +12,14 @@ namespace LowEngine::ECS {
      */
     class TileMapComponent : public IComponent<TileMapComponent, TransformComponent> {
     public:
+        /** @brief Setters mark the Entity changed, see IComponentBase::MarkChanged. */
+        static constexpr bool TracksChanges = true;
+
         /**
          * @brief Layer number.
          *
          * Sprite of this component will be drawn on this layer.
-         * This applies only if Scene's sorting mode is set to DrawOrder.
+         * This applies only if Scene's sorting mode is set to DrawOrder. Call MarkChanged after changing it.
          */
         int Layer = 0;
 
@@ -25,7 +28,8 @@ namespace LowEngine::ECS {
         }
 
         TileMapComponent(Memory::Memory* memory, TileMapComponent const* other)
-            : IComponent(memory, other), _sprite(other->_sprite), _mapId(other->_mapId), Layer(other->Layer) {
+            : IComponent(memory, other), _sprite(other->_sprite), _mapId(other->_mapId), Layer(other->Layer),
+              _transformVersion(other->_transformVersion) {
 
             auto& map = Assets::GetTileMap(_mapId);
             Resize(map);
@@ -64,6 +68,11 @@ namespace LowEngine::ECS {
          */
         sf::RenderTexture _texture;
 
+        /**
+         * @brief Version of the Transform that _sprite was last synced with, see TransformComponent::GetVersion.
+         */
+        uint64_t _transformVersion = 0;
+
         /**
          * @brief Resize internal _texture and _sprite to match provided map asset.
          * @param map Reference to map asset to mach size to
@@ -1,11 +1,72 @@
 #include "TransformComponent.h"
 
+#include <atomic>
+#include <cstring>
+
+#include "memory/Memory.h"
+
 namespace LowEngine::ECS {
+	namespace {
+		/** @brief Last version handed out to any transform. */
+		std::atomic<uint64_t> LastVersion{0};
+	}
+
+	void TransformComponent::Initialize() {
+		if (_memory == nullptr) {
+			return;
+		}
+		_changedTick = _memory->GetTick();
+		_memory->RecordComponentChange<TransformComponent>(EntityId, _changedTick);
+	}
+
+	void TransformComponent::MarkChanged() {
+		BumpVersion();
+		if (_memory != nullptr) {
+			// later changes during the same tick are covered by the first record
+			uint64_t tick = _memory->GetTick();
+			if (tick != _changedTick) {
+				_changedTick = tick;
+				_memory->RecordComponentChange<TransformComponent>(EntityId, tick);
+			}
+		}
+		IComponentBase::MarkChanged();
+	}
+
+	void TransformComponent::BumpVersion() {
+		_version = LastVersion.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
+	void TransformComponent::WriteSnapshot(std::byte* out) const {
+		const float values[5] = {
+			_storage->PositionX[_index], _storage->PositionY[_index], _storage->Rotation[_index],
+			_storage->ScaleX[_index], _storage->ScaleY[_index]
+		};
+		std::memcpy(out, values, SnapshotSize);
+	}
+
+	void TransformComponent::ReadSnapshot(const std::byte* in) {
+		float values[5];
+		std::memcpy(values, in, SnapshotSize);
+		SetPosition({values[0], values[1]});
+		SetRotation(sf::radians(values[2]));
+		SetScale({values[3], values[4]});
+	}
+
+	void TransformComponent::ReadBinary(const std::byte* in) {
+		float values[5];
+		std::memcpy(values, in, BinarySize);
+		_storage->PositionX[_index] = values[0];
+		_storage->PositionY[_index] = values[1];
+		_storage->Rotation[_index] = values[2];
+		_storage->ScaleX[_index] = values[3];
+		_storage->ScaleY[_index] = values[4];
+	}
+
 	nlohmann::ordered_json TransformComponent::SerializeToJSON() {
 		nlohmann::ordered_json json = IComponent::SerializeToJSON();
-		json["Position"] = {{"x", Position.x}, {"y", Position.y}};
-		json["Rotation"] = Rotation.asDegrees();
-		json["Scale"] = {{"x", Scale.x}, {"y", Scale.y}};
+		json["Position"] = {{"x", _storage->PositionX[_index]}, {"y", _storage->PositionY[_index]}};
+		json["Rotation"] = GetRotation().asDegrees();
+		json["Scale"] = {{"x", _storage->ScaleX[_index]}, {"y", _storage->ScaleY[_index]}};
 		return json;
 	}
 
@@ -15,16 +76,19 @@ namespace LowEngine::ECS {
 			return false;
 		}
 
+		sf::Vector2f position;
+		sf::Angle rotation;
+		sf::Vector2f scale;
 		if (jsonData.contains("Position")) {
 			auto posJson = jsonData["Position"];
 			if (posJson.contains("x")) {
-				Position.x = posJson["x"].get<float>();
+				position.x = posJson["x"].get<float>();
 			} else {
 				_log->error("TransformComponent deserialization failed: 'Position.x' field is missing.");
 				return false;
 			}
 			if (posJson.contains("y")) {
-				Position.y = posJson["y"].get<float>();
+				position.y = posJson["y"].get<float>();
 			} else {
 				_log->error("TransformComponent deserialization failed: 'Position.y' field is missing.");
 				return false;
@@ -34,7 +98,7 @@ namespace LowEngine::ECS {
 			return false;
 		}
 		if (jsonData.contains("Rotation")) {
-			Rotation = sf::degrees(jsonData["Rotation"].get<float>());
+			rotation = sf::degrees(jsonData["Rotation"].get<float>());
 		} else {
 			_log->error("TransformComponent deserialization failed: 'Rotation' field is missing.");
 			return false;
@@ -42,13 +106,13 @@ namespace LowEngine::ECS {
 		if (jsonData.contains("Scale")) {
 			auto scaleJson = jsonData["Scale"];
 			if (scaleJson.contains("x")) {
-				Scale.x = scaleJson["x"].get<float>();
+				scale.x = scaleJson["x"].get<float>();
 			} else {
 				_log->error("TransformComponent deserialization failed: 'Scale.x' field is missing.");
 				return false;
 			}
 			if (scaleJson.contains("y")) {
-				Scale.y = scaleJson["y"].get<float>();
+				scale.y = scaleJson["y"].get<float>();
 			} else {
 				_log->error("TransformComponent deserialization failed: 'Scale.y' field is missing.");
 				return false;
@@ -58,6 +122,12 @@ namespace LowEngine::ECS {
 			return false;
 		}
 
+		_storage->PositionX[_index] = position.x;
+		_storage->PositionY[_index] = position.y;
+		_storage->Rotation[_index] = rotation.asRadians();
+		_storage->ScaleX[_index] = scale.x;
+		_storage->ScaleY[_index] = scale.y;
+		MarkChanged();
 		return true;
 	}
 }
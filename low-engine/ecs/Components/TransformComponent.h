@@ -1,49 +1,285 @@
 #pragma once
 
 #include "ecs/IComponent.h"
+#include "memory/SoAArray.h"
 #include <SFML/Graphics.hpp>
 
 namespace LowEngine::ECS {
+    /**
+     * @brief Position, rotation and scale of all TransformComponents of a pool, in separate arrays.
+     *
+     * Entries follow the iteration order of the pool, active components first, see
+     * Memory::ComponentPool::GetSoAStorage. Batch work can run over the arrays directly; changes made that way
+     * are not tracked until TransformComponent::MarkChanged is called.
+     */
+    struct TransformStorage {
+        Memory::SoAArray<float> PositionX;
+        Memory::SoAArray<float> PositionY;
+        /** @brief Rotation in radians. */
+        Memory::SoAArray<float> Rotation;
+        Memory::SoAArray<float> ScaleX;
+        Memory::SoAArray<float> ScaleY;
+
+        explicit TransformStorage(std::pmr::memory_resource* resource)
+            : PositionX(resource), PositionY(resource), Rotation(resource), ScaleX(resource), ScaleY(resource) {
+        }
+
+        TransformStorage(const TransformStorage& other, std::pmr::memory_resource* resource)
+            : PositionX(other.PositionX, resource), PositionY(other.PositionY, resource),
+              Rotation(other.Rotation, resource), ScaleX(other.ScaleX, resource), ScaleY(other.ScaleY, resource) {
+        }
+
+        void PushBack() {
+            PositionX.PushBack(0.0f);
+            PositionY.PushBack(0.0f);
+            Rotation.PushBack(0.0f);
+            ScaleX.PushBack(1.0f);
+            ScaleY.PushBack(1.0f);
+        }
+
+        void PopBack() {
+            PositionX.PopBack();
+            PositionY.PopBack();
+            Rotation.PopBack();
+            ScaleX.PopBack();
+            ScaleY.PopBack();
+        }
+
+        void Swap(size_t first, size_t second) {
+            PositionX.Swap(first, second);
+            PositionY.Swap(first, second);
+            Rotation.Swap(first, second);
+            ScaleX.Swap(first, second);
+            ScaleY.Swap(first, second);
+        }
+
+        void Reserve(size_t capacity) {
+            PositionX.Reserve(capacity);
+            PositionY.Reserve(capacity);
+            Rotation.Reserve(capacity);
+            ScaleX.Reserve(capacity);
+            ScaleY.Reserve(capacity);
+        }
+
+        void ShrinkToFit() {
+            PositionX.ShrinkToFit();
+            PositionY.ShrinkToFit();
+            Rotation.ShrinkToFit();
+            ScaleX.ShrinkToFit();
+            ScaleY.ShrinkToFit();
+        }
+
+        [[nodiscard]] size_t GetReservedBytes() const {
+            return (PositionX.GetCapacity() + PositionY.GetCapacity() + Rotation.GetCapacity()
+                    + ScaleX.GetCapacity() + ScaleY.GetCapacity()) * sizeof(float);
+        }
+    };
+
     /**
      * Represents a component that manages the transformation data, including position, rotation, and scale.
+     *
+     * Position, rotation and scale are hot data, read by most other systems. They live in the pool's
+     * TransformStorage, while the component object keeps the rest and acts as a proxy: accessors read and write
+     * its entry in the storage.
+     *
+     * Changes are tracked: every setter bumps the version of the component and records the tick of the change,
+     * so dependent components resync only when their transform changed (see GetVersion), and Memory can report
+     * Entities whose transform changed since a given tick (see Memory::GetEntitiesChangedSince).
      */
     class TransformComponent : public IComponent<TransformComponent> {
     public:
+        /** @brief Position, rotation in radians and scale, as floats. */
+        static constexpr size_t SnapshotSize = 5 * sizeof(float);
+
+        /** @brief Same state as snapshots: position, rotation in radians and scale, as floats. */
+        static constexpr size_t BinarySize = SnapshotSize;
+
+        /** @brief Every setter records the tick of its change, see GetChangedTick, and marks the Entity changed. */
+        static constexpr bool TracksChanges = true;
+
+        using SoAStorage = TransformStorage;
+
+        explicit TransformComponent(Memory::Memory* memory)
+            : IComponent(memory) {
+            BumpVersion();
+        }
+
+        /**
+         * @brief Copy of a component. Position, rotation and scale are copied by the pool, along with the storage.
+         */
+        TransformComponent(Memory::Memory* memory, TransformComponent const* other)
+            : IComponent(memory, other), _version(other->_version), _changedTick(other->_changedTick) {
+        }
+
+        ~TransformComponent() override = default;
+
+        /**
+         * @brief Record creation of the component as its change, see GetChangedTick.
+         */
+        void Initialize() override;
+
+        /**
+         * @brief Move back to the origin, with no rotation and unit scale, like a new component.
+         */
+        void Reset() {
+            SetPosition({0.0f, 0.0f});
+            SetRotation(sf::radians(0.0f));
+            SetScale({1.0f, 1.0f});
+        }
+
         /**
-         * @brief Position in the world, in Units.
+         * @brief Point the component to its entry in the pool's storage. Called by Component Pool.
+         * @param storage Storage of the pool.
+         * @param index Position of the entry.
+         */
+        void BindSoAStorage(TransformStorage* storage, size_t index) {
+            _storage = storage;
+            _index = index;
+        }
+
+        /**
+         * @brief Retrieve position in the world, in Units.
          *
          * Units are equal to SFML's positioning units.
+         * @return Current position.
          */
-        sf::Vector2f Position = sf::Vector2f(0.0f, 0.0f);
+        [[nodiscard]] sf::Vector2f GetPosition() const {
+            return {_storage->PositionX[_index], _storage->PositionY[_index]};
+        }
 
         /**
-         * @brief Current rotation.
+         * @brief Set position in the world, in Units.
+         * @param position New position.
          */
-        sf::Angle Rotation = sf::degrees(0.0f);
+        void SetPosition(const sf::Vector2f& position) {
+            if (GetPosition() == position) return;
+            _storage->PositionX[_index] = position.x;
+            _storage->PositionY[_index] = position.y;
+            MarkChanged();
+        }
 
         /**
-         * @brief Current scale.
+         * @brief Move by provided offset, in Units.
+         * @param offset Offset to add to the current position.
          */
-        sf::Vector2f Scale = sf::Vector2f(1.0f, 1.0f);
+        void Move(const sf::Vector2f& offset) {
+            SetPosition(GetPosition() + offset);
+        }
 
-        explicit TransformComponent(Memory::Memory* memory)
-            : IComponent(memory) {
+        /**
+         * @brief Retrieve current rotation.
+         * @return Current rotation.
+         */
+        [[nodiscard]] sf::Angle GetRotation() const {
+            return sf::radians(_storage->Rotation[_index]);
         }
 
-        TransformComponent(Memory::Memory* memory, TransformComponent const* other)
-            : IComponent(memory, other), Position(other->Position), Rotation(other->Rotation), Scale(other->Scale) {
+        /**
+         * @brief Set current rotation.
+         * @param rotation New rotation.
+         */
+        void SetRotation(sf::Angle rotation) {
+            if (_storage->Rotation[_index] == rotation.asRadians()) return;
+            _storage->Rotation[_index] = rotation.asRadians();
+            MarkChanged();
         }
 
-        ~TransformComponent() override = default;
+        /**
+         * @brief Retrieve current scale.
+         * @return Current scale.
+         */
+        [[nodiscard]] sf::Vector2f GetScale() const {
+            return {_storage->ScaleX[_index], _storage->ScaleY[_index]};
+        }
 
-        void Initialize() override {
+        /**
+         * @brief Set current scale.
+         * @param scale New scale.
+         */
+        void SetScale(const sf::Vector2f& scale) {
+            if (GetScale() == scale) return;
+            _storage->ScaleX[_index] = scale.x;
+            _storage->ScaleY[_index] = scale.y;
+            MarkChanged();
+        }
+
+        /**
+         * @brief Retrieve version of the transform. Version changes every time position, rotation or scale changes.
+         *
+         * Dependent components store the version they synced with and compare it to skip unchanged transforms.
+         * Versions come from a counter shared by all transforms, so a new component never gets 0 or a version
+         * of a transform that existed before it.
+         * @return Current version.
+         */
+        [[nodiscard]] uint64_t GetVersion() const {
+            return _version;
         }
 
-        void Update(float deltaTime) override {
+        /**
+         * @brief Retrieve tick of the last change, see Memory::GetTick.
+         *
+         * First change during a tick is recorded in the pool, see Memory::GetEntitiesChangedSince.
+         * @return Tick of the last change.
+         */
+        [[nodiscard]] uint64_t GetChangedTick() const {
+            return _changedTick;
         }
 
+        /**
+         * @brief Bump the version, record current tick of the Memory manager and mark owning Entity as changed.
+         *
+         * Called by every setter. Call it after writing to the pool's storage directly.
+         */
+        void MarkChanged();
+
+        /**
+         * @brief Write position, rotation and scale.
+         * @param[out] out Pointer to SnapshotSize bytes.
+         */
+        void WriteSnapshot(std::byte* out) const;
+
+        /**
+         * @brief Restore position, rotation and scale. Changed values are tracked like with setters.
+         * @param in Pointer to SnapshotSize bytes.
+         */
+        void ReadSnapshot(const std::byte* in);
+
+        /**
+         * @brief Write position, rotation and scale for binary scene files.
+         * @param[out] out Pointer to BinarySize bytes.
+         */
+        void WriteBinary(std::byte* out) const {
+            WriteSnapshot(out);
+        }
+
+        /**
+         * @brief Load position, rotation and scale straight into the storage, without tracking changes.
+         * @param in Pointer to BinarySize bytes.
+         */
+        void ReadBinary(const std::byte* in);
+
         nlohmann::ordered_json SerializeToJSON() override;
 
         bool DeserializeFromJSON(const nlohmann::ordered_json& jsonData) override;
+
+    protected:
+        /** @brief Storage holding position, rotation and scale. Not owned. */
+        TransformStorage* _storage = nullptr;
+
+        /** @brief Position of this component's entry in _storage. */
+        size_t _index = 0;
+
+        /** @brief Version of the transform, taken from a counter shared by all transforms on every change. */
+        uint64_t _version = 0;
+
+        /** @brief Tick of the last change. */
+        uint64_t _changedTick = 0;
+
+        /**
+         * @brief Take the next version from the shared counter.
+         *
+         * Transform added again to the same Entity never repeats a version its dependents already synced with.
+         */
+        void BumpVersion();
     };
 }
@@ -11,36 +11,48 @@ namespace LowEngine::ECS {
     Entity::Entity(Memory::Memory* memory, const Entity& other) {
         _memory = memory;
 
-        Name = other.Name;
-        Active = other.Active;
+        // name is kept by the Memory manager, which copies it together with the slot
+        _active = other._active;
     }
 
-    void Entity::Activate(const std::string& name) {
-        Name = name;
-        Active = true;
+    void Entity::Activate() {
+        SetActive(true);
+    }
+
+    void Entity::SetActive(bool active) {
+        if (_active == active) return;
+        _active = active;
+        _memory->MarkEntityChanged(Id);
+    }
+
+    std::string_view Entity::GetName() const {
+        return _memory->GetEntityName(Id);
+    }
+
+    void Entity::SetName(std::string_view name) {
+        _memory->RenameEntity(Id, name);
     }
 
     bool Entity::HasComponent(const std::type_index& typeIndex) {
-        void* componentPtr = _memory->GetComponent(Id, typeIndex);
-        return componentPtr != nullptr;
+        return _memory->HasComponent(Id, typeIndex);
     }
 
 	nlohmann::ordered_json Entity::SerializeToJSON() {
 		nlohmann::ordered_json entityJson;
 
 		entityJson["id"] = Id;
-		entityJson["name"] = Name;
-		entityJson["active"] = Active;
+		entityJson["name"] = std::string(GetName());
+		entityJson["active"] = _active;
 		
         return entityJson;
 	}
 
     void Entity::DeserializeFromJSON(const nlohmann::ordered_json& jsonData) {
         if (jsonData.contains("name")) {
-            Name = jsonData["name"].get<std::string>();
+            SetName(jsonData["name"].get_ref<const std::string&>());
         }
         if (jsonData.contains("active")) {
-            Active = jsonData["active"].get<bool>();
+            SetActive(jsonData["active"].get<bool>());
 		}
     }
 
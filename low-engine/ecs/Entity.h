@@ -36,10 +36,29 @@ namespace LowEngine::ECS {
         Entity(Memory::Memory* memory, const Entity& other);
 
         /**
-         * @brief Activate this instance and assigning it a name.
-         * @param name Name that should be assigned to Entity.
+         * @brief Activate this instance.
          */
-        void Activate(const std::string& name);
+        void Activate();
+
+        /**
+         * @brief Activate or deactivate this Entity, marking it changed in the Memory manager.
+         * @param active Should Entity be Active?
+         */
+        void SetActive(bool active) override;
+
+        /**
+         * @brief Retrieve name of this Entity.
+         *
+         * Names are interned by the Memory manager, Entity itself only holds its Id.
+         * @return View of the name. Valid until Entity is renamed or destroyed.
+         */
+        [[nodiscard]] std::string_view GetName() const override;
+
+        /**
+         * @brief Rename this Entity, keeping name lookups of the Memory manager up to date.
+         * @param name New name of the Entity.
+         */
+        void SetName(std::string_view name) override;
 
         /**
          * @brief Add new component to this entity.
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LowEngine::ECS {
+    static_assert(sizeof(size_t) == 8, "Entity Id requires 64-bit size_t");
+
+    /**
+     * @brief Mask selecting slot index part of the Entity Id.
+     */
+    inline constexpr size_t ENTITY_INDEX_MASK = 0xFFFFFFFFull;
+
+    /**
+     * @brief Number of bits the generation is shifted by inside Entity Id.
+     */
+    inline constexpr unsigned ENTITY_GENERATION_SHIFT = 32;
+
+    /**
+     * @brief Build Entity Id from slot index and generation.
+     *
+     * Entity Id is a handle: lower 32 bits are the index of the slot in Memory's Entity storage,
+     * upper 32 bits are the generation of that slot. Generation increases every time a slot is freed,
+     * so handles to destroyed Entities can be detected even after their slot was reused.
+     *
+     * Slots used for the first time have generation 0, so in a fresh Memory Entity Id equals its index.
+     * @param index Slot index.
+     * @param generation Generation of the slot.
+     * @return Entity Id.
+     */
+    constexpr size_t MakeEntityId(uint32_t index, uint32_t generation) {
+        return (static_cast<size_t>(generation) << ENTITY_GENERATION_SHIFT) | index;
+    }
+
+    /**
+     * @brief Retrieve slot index from Entity Id.
+     * @param entityId Entity Id.
+     * @return Slot index.
+     */
+    constexpr uint32_t GetEntityIndex(size_t entityId) {
+        return static_cast<uint32_t>(entityId & ENTITY_INDEX_MASK);
+    }
+
+    /**
+     * @brief Retrieve generation from Entity Id.
+     * @param entityId Entity Id.
+     * @return Generation of the slot at the time the Id was issued.
+     */
+    constexpr uint32_t GetEntityGeneration(size_t entityId) {
+        return static_cast<uint32_t>(entityId >> ENTITY_GENERATION_SHIFT);
+    }
+}
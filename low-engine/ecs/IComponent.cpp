@@ -0,0 +1,11 @@
+#include "IComponent.h"
+
+#include "memory/Memory.h"
+
+namespace LowEngine::ECS {
+    void IComponentBase::MarkChanged() {
+        if (_memory != nullptr) {
+            _memory->MarkEntityChanged(EntityId);
+        }
+    }
+}
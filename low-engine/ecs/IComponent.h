@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
@@ -11,9 +13,13 @@
 #include "graphics/Sprite.h"
 #include "graphics/Drawables.h"
 #include "utils/TypeName.h"
+#include "memory/ComponentTypeId.h"
 
 namespace LowEngine::Memory {
     class Memory;
+
+    template <typename T>
+    class ComponentPool;
 }
 
 namespace LowEngine::ECS {
@@ -24,21 +30,33 @@ namespace LowEngine::ECS {
          */
         size_t EntityId = 0;
 
-        /**
-         * @brief Is this component Active?
-         *
-         * Component that is not Active skips their Update and Draw calls.
-         */
-        bool Active = false;
-
         explicit IComponentBase(Memory::Memory* memory) : _memory(memory) {
         };
 
         IComponentBase(Memory::Memory* memory, IComponentBase const* other) : _memory(memory) {
             EntityId = other->EntityId;
-            Active = other->Active;
+            _active = other->_active;
         };
 
+        /**
+         * @brief Is this component Active?
+         *
+         * Component that is not Active skips their Update and Draw calls.
+         * Use Memory::SetComponentActive to change it.
+         * @return True if component is Active.
+         */
+        [[nodiscard]] bool IsActive() const {
+            return _active;
+        }
+
+        /**
+         * @brief Mark owning Entity as changed, so it's saved with the next scene changes.
+         *
+         * Called by Components that track their changes, see IComponent::TracksChanges. Safe to call from Update
+         * running on a worker thread.
+         */
+        void MarkChanged();
+
         /**
          * @brief Creates a copy of the Component in the provided Memory manager.
          *
@@ -98,6 +116,29 @@ namespace LowEngine::ECS {
          * @brief Pointer to Memory manager that is responsible for this instance of Component. Will also contain Entity.
          */
         Memory::Memory* _memory;
+
+        /**
+         * @brief Is this component Active? Kept in sync with component's position in the pool by ComponentPool.
+         */
+        bool _active = false;
+
+        template <typename T>
+        friend class Memory::ComponentPool;
+    };
+
+    /**
+     * @brief Compile-time list of Component types, used to declare what a Component accesses during update.
+     * @tparam Components Component types.
+     */
+    template<typename... Components>
+    struct ComponentList {
+        /**
+         * @brief Retrieve type ids of all Components in the list.
+         * @return Vector of type ids.
+         */
+        static std::vector<Memory::ComponentTypeId> GetTypeIds() {
+            return {Memory::GetComponentTypeId<Components>()...};
+        }
     };
 
     /**
@@ -126,19 +167,197 @@ namespace LowEngine::ECS {
          */
         IComponent(Memory::Memory* memory, IComponent const* other) : IComponentBase(memory, other) {};
 
+        /**
+         * @brief Components of other types that Update and FixedUpdate read.
+         *
+         * Dependencies are always accessed, so this only needs to list additional types.
+         * Redeclare in Derived to extend, e.g. `using ReadsComponents = ComponentList<CameraComponent>;`
+         */
+        using ReadsComponents = ComponentList<>;
+
+        /**
+         * @brief Do Update and FixedUpdate only read the Components this type depends on?
+         *
+         * Off by default, so dependencies are treated as modified and the Component is never updated at the same time
+         * as other Components using them. Redeclare in Derived as true if dependencies are only read.
+         */
+        static constexpr bool DependenciesReadOnly = false;
+
+        /**
+         * @brief Components of other types that Update and FixedUpdate modify.
+         *
+         * Component always modifies its own type. Redeclare in Derived to extend.
+         */
+        using WritesComponents = ComponentList<>;
+
+        /**
+         * @brief Does every change of the Component's saved state call MarkChanged?
+         *
+         * Off by default, since the engine can't see edits of fields. Scenes holding Components of such types can't
+         * tell which of them changed, so they are always saved whole rather than to a scene journal. Redeclare in
+         * Derived as true if setters, Update and FixedUpdate call MarkChanged whenever they change saved state.
+         * Public fields of such Components are still writable, code that writes them calls MarkChanged as well.
+         */
+        static constexpr bool TracksChanges = false;
+
+        /**
+         * @brief Can Update and FixedUpdate of this Component type run on a worker thread?
+         *
+         * Off by default, since most Components talk to SFML, Box2D or Assets, which must stay on the main thread.
+         * Redeclare in Derived as true if Update and FixedUpdate only touch the Component itself and the Components
+         * declared as read or written.
+         */
+        static constexpr bool WorkerThreadSafe = false;
+
+        /**
+         * @brief Can Components of this type be updated concurrently with each other?
+         *
+         * When true, Component Pool splits Update and FixedUpdate into batches that run on several worker threads.
+         * Requires WorkerThreadSafe. Redeclare in Derived as true if Update and FixedUpdate don't touch any other
+         * Component of the same type and don't use shared mutable state.
+         */
+        static constexpr bool ParallelSafeUpdate = false;
+
+        /**
+         * @brief Structure-of-arrays storage of hot data, kept by Component Pool. void means the type doesn't use it.
+         *
+         * Redeclare in Derived to keep frequently read data in separate arrays owned by the pool, parallel to its
+         * iteration order, so batch work runs over contiguous values. The type must provide:
+         * - constructor taking std::pmr::memory_resource*, and copy constructor taking one as second argument,
+         * - PushBack() appending default values, PopBack(), Swap(size_t, size_t),
+         * - Reserve(size_t), ShrinkToFit() and GetReservedBytes().
+         *
+         * Derived must also provide BindSoAStorage(SoAStorage*, size_t index), called by the pool whenever the
+         * position of the Component changes. Data isn't bound yet while the constructor runs.
+         */
+        using SoAStorage = void;
+
+        /**
+         * @brief Size in bytes of the state written by WriteSnapshot. 0 means the type doesn't support snapshots.
+         *
+         * Snapshots store simulation state in a compact binary form, see Memory::WriteSnapshot. To support them,
+         * redeclare in Derived together with WriteSnapshot and ReadSnapshot.
+         */
+        static constexpr size_t SnapshotSize = 0;
+
+        /**
+         * @brief Write simulation state of the Component.
+         * @param[out] out Pointer to SnapshotSize bytes to write the state to. Not aligned.
+         */
+        void WriteSnapshot(std::byte* out) const {
+        }
+
+        /**
+         * @brief Restore simulation state written by WriteSnapshot.
+         * @param in Pointer to SnapshotSize bytes of the state. Not aligned.
+         */
+        void ReadSnapshot(const std::byte* in) {
+        }
+
+        /**
+         * @brief Size in bytes of the state written by WriteBinary. 0 means the type is saved through JSON.
+         *
+         * Binary scene files store pools of such types as fixed-size records, decoded straight into new
+         * Components. Redeclare in Derived together with WriteBinary and ReadBinary. Unlike snapshots, the
+         * layout is persistent: change it only together with SceneFileFormat::VERSION.
+         */
+        static constexpr size_t BinarySize = 0;
+
+        /**
+         * @brief Write saved state of the Component.
+         * @param[out] out Pointer to BinarySize bytes to write the state to. Not aligned.
+         */
+        void WriteBinary(std::byte* out) const {
+        }
+
+        /**
+         * @brief Restore state written by WriteBinary. Called on a new Component, before Initialize().
+         * @param in Pointer to BinarySize bytes of the state. Not aligned.
+         */
+        void ReadBinary(const std::byte* in) {
+        }
+
+        /**
+         * @brief Retrieve heap memory owned by the Component, in bytes, for memory statistics of its pool.
+         *
+         * Components owning containers or buffers redeclare it in Derived.
+         * @return Number of bytes. Default is 0.
+         */
+        [[nodiscard]] size_t GetHeapSize() const {
+            return 0;
+        }
+
+        /**
+         * @brief Release spare heap memory, called by Memory::ShrinkToFit. Redeclare in Derived to support it.
+         */
+        void ShrinkToFit() {
+        }
+
+        /**
+         * @brief Called when the owning Entity is parked in its prefab's pool, see Memory::DespawnEntity.
+         *
+         * Component is deactivated right after. Redeclare in Derived to stop anything that acts outside of Update,
+         * like physics bodies.
+         */
+        void Park() {
+        }
+
+        /**
+         * @brief Return the Component to the state of a newly created one, called when a parked Entity is reused.
+         *
+         * See Memory::SpawnEntity. Component is activated right after. Redeclare in Derived to clear the state
+         * of the previous use, keeping allocated resources for the next one. Default keeps the state as it is.
+         */
+        void Reset() {
+        }
+
+        /**
+         * @brief Does Derived override Update?
+         *
+         * Pools of types that don't are left out of the update schedule, so no call is made per Component.
+         * @return True if Update is overridden.
+         */
+        static constexpr bool OverridesUpdate() {
+            return !std::is_same_v<decltype(&Derived::Update), decltype(&IComponentBase::Update)>;
+        }
+
+        /**
+         * @brief Does Derived override FixedUpdate?
+         * @return True if FixedUpdate is overridden.
+         */
+        static constexpr bool OverridesFixedUpdate() {
+            return !std::is_same_v<decltype(&Derived::FixedUpdate), decltype(&IComponentBase::FixedUpdate)>;
+        }
+
+        /**
+         * @brief Does Derived override Draw?
+         * @return True if Draw is overridden.
+         */
+        static constexpr bool OverridesDraw() {
+            return !std::is_same_v<decltype(&Derived::Draw), decltype(&IComponentBase::Draw)>;
+        }
+
+        /**
+         * @brief Does Derived override DrawDirect?
+         * @return True if DrawDirect is overridden.
+         */
+        static constexpr bool OverridesDrawDirect() {
+            return !std::is_same_v<decltype(&Derived::DrawDirect), decltype(&IComponentBase::DrawDirect)>;
+        }
+
         /**
          * @brief Get a list of Component types that this Component depends on.
          * 
-         * This method returns a vector of type indices representing all Component types
+         * This method returns a vector of type ids representing all Component types
          * that were specified as dependencies in the template parameters.
          * The dependencies are used during Entity configuration to ensure all required
          * Components are present before this Component can be added to an Entity.
          * 
-         * @return Reference to a static vector containing type indices of all dependencies.
+         * @return Reference to a static vector containing type ids of all dependencies.
          */
-        static const std::vector<std::type_index>& GetDependencies() {
-            static std::vector<std::type_index> dependencies = {
-                std::type_index(typeid(Dependencies))...
+        static const std::vector<Memory::ComponentTypeId>& GetDependencies() {
+            static std::vector<Memory::ComponentTypeId> dependencies = {
+                Memory::GetComponentTypeId<Dependencies>()...
             };
             return dependencies;
         };
@@ -158,9 +377,9 @@ namespace LowEngine::ECS {
          */
         virtual nlohmann::ordered_json SerializeToJSON() {
             nlohmann::ordered_json compJson;
-			compJson["Type"] = LowEngine::Utils::GetCleanTypeName<Derived>();
+			compJson["Type"] = Memory::ComponentTypeName<Derived>;
             compJson["EntityId"] = EntityId;
-            compJson["Active"] = Active;
+            compJson["Active"] = _active;
             return compJson;
         };
 
@@ -170,15 +389,8 @@ namespace LowEngine::ECS {
          */
         virtual bool DeserializeFromJSON(const nlohmann::ordered_json& jsonData) {
             // EntityId should not be changed during deserialization
-            if (jsonData.contains("Active")) {
-                Active = jsonData["Active"].get<bool>();
-            }
-            else
-            {
-				return false;
-            }
-
-            return true;
+            // Active is applied by Memory, as it decides component's position in the pool
+            return jsonData.contains("Active");
         };
     };
 }
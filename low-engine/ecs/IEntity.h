@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string_view>
+
 #include "nlohmann/json.hpp"
 
 namespace LowEngine::Memory {
@@ -25,8 +27,17 @@ namespace LowEngine::ECS {
 
         /**
          * @brief Check if Entity is Active. Entity that is not active will be skipped during Update and Draw calls.
+         * @return True if Entity is Active.
          */
-        bool Active = false;
+        [[nodiscard]] bool IsActive() const {
+            return _active;
+        }
+
+        /**
+         * @brief Activate or deactivate this Entity.
+         * @param active Should Entity be Active?
+         */
+        virtual void SetActive(bool active) = 0;
 
         /**
          * @brief Id that was assigned to this Entity during creation.
@@ -34,9 +45,16 @@ namespace LowEngine::ECS {
         size_t Id = 0;
 
         /**
-         * @brief Name of this Entity.
+         * @brief Retrieve name of this Entity.
+         * @return View of the name. Valid until Entity is renamed or destroyed.
+         */
+        [[nodiscard]] virtual std::string_view GetName() const = 0;
+
+        /**
+         * @brief Rename this Entity.
+         * @param name New name of the Entity.
          */
-        std::string Name;
+        virtual void SetName(std::string_view name) = 0;
 
         /**
          * @brief Check if this Entity has a Component of given type.
@@ -58,5 +76,10 @@ namespace LowEngine::ECS {
 		virtual void DeserializeFromJSON(const nlohmann::ordered_json& jsonData) = 0;
     protected:
         IEntity() = default;
+
+        /**
+         * @brief Is this Entity Active? Changed through SetActive, so the change can be tracked.
+         */
+        bool _active = false;
     };
 }
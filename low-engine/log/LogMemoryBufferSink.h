@@ -1,30 +1,27 @@
 #pragma once
-#include <spdlog/sinks/sink.h>
-#include "spdlog/pattern_formatter.h"
+#include <mutex>
+#include <spdlog/sinks/base_sink.h>
 
 namespace LowEngine {
-    class LogMemoryBufferSink : public spdlog::sinks::sink {
+    /**
+     * @brief Sink appending formatted log messages to a memory buffer, e.g. for the editor's log panel.
+     *
+     * Components updated on worker threads can log, so appends are guarded by the sink's mutex.
+     */
+    class LogMemoryBufferSink : public spdlog::sinks::base_sink<std::mutex> {
     public:
         LogMemoryBufferSink(fmt::memory_buffer& buffer) : buffer_(buffer) {}
 
-        void log(const spdlog::details::log_msg& msg) override {
+    protected:
+        void sink_it_(const spdlog::details::log_msg& msg) override {
             spdlog::memory_buf_t formatted;
             formatter_->format(msg, formatted);
             buffer_.append(formatted.data(), formatted.data() + formatted.size());
         }
 
-        void flush() override {}
-
-        void set_pattern(const std::string& pattern) override {
-            formatter_ = std::unique_ptr<spdlog::formatter>(new spdlog::pattern_formatter(pattern));
-        }
-
-        void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override {
-            formatter_ = std::move(sink_formatter);
-        }
+        void flush_() override {}
 
     private:
         fmt::memory_buffer& buffer_;
-        std::unique_ptr<spdlog::formatter> formatter_;
     };
 }
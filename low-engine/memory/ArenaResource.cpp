@@ -0,0 +1,34 @@
+#include "ArenaResource.h"
+
+#include <algorithm>
+
+namespace LowEngine::Memory {
+	ArenaResource::ArenaResource() : _system(_stats), _pools(&_system) {
+	}
+
+	void* ArenaResource::do_allocate(size_t bytes, size_t alignment) {
+		void* pointer = _pools.allocate(bytes, alignment);
+		_stats.BytesInUse += bytes;
+		_stats.PeakBytesInUse = std::max(_stats.PeakBytesInUse, _stats.BytesInUse);
+		_stats.LiveAllocations++;
+		_stats.TotalAllocations++;
+		return pointer;
+	}
+
+	void ArenaResource::do_deallocate(void* pointer, size_t bytes, size_t alignment) {
+		_pools.deallocate(pointer, bytes, alignment);
+		_stats.BytesInUse -= bytes;
+		_stats.LiveAllocations--;
+	}
+
+	void* ArenaResource::SystemResource::do_allocate(size_t bytes, size_t alignment) {
+		void* pointer = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		_stats.BytesReserved += bytes;
+		return pointer;
+	}
+
+	void ArenaResource::SystemResource::do_deallocate(void* pointer, size_t bytes, size_t alignment) {
+		std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+		_stats.BytesReserved -= bytes;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace LowEngine::Memory {
+	/**
+	 * @brief Allocation statistics of an ArenaResource.
+	 */
+	struct ArenaStats {
+		/** @brief Bytes handed out and not yet returned. */
+		size_t BytesInUse = 0;
+
+		/** @brief Highest value BytesInUse ever reached. */
+		size_t PeakBytesInUse = 0;
+
+		/** @brief Bytes requested from the system, including pool overhead and blocks kept for reuse. */
+		size_t BytesReserved = 0;
+
+		/** @brief Number of allocations not yet returned. */
+		size_t LiveAllocations = 0;
+
+		/** @brief Number of allocations made since the arena was created. */
+		size_t TotalAllocations = 0;
+	};
+
+	/**
+	 * @brief Memory resource owned by a single Memory manager, backing its Entity and Component storage.
+	 *
+	 * Small allocations are served from pools of fixed-size blocks, large ones (like chunks of Component Pools)
+	 * are passed to the system and tracked. Returned small blocks are kept for reuse by the same arena.
+	 * Everything the arena requested from the system is freed at once when the arena is destroyed.
+	 *
+	 * Not thread-safe: Memory allocates only during structural changes, which happen on the main thread.
+	 */
+	class ArenaResource : public std::pmr::memory_resource {
+	public:
+		ArenaResource();
+
+		ArenaResource(const ArenaResource&) = delete;
+		ArenaResource& operator=(const ArenaResource&) = delete;
+
+		/**
+		 * @brief Retrieve allocation statistics.
+		 * @return Current statistics.
+		 */
+		[[nodiscard]] const ArenaStats& GetStats() const {
+			return _stats;
+		}
+
+	protected:
+		/**
+		 * @brief Upstream of the pools, counting memory requested from the system.
+		 */
+		class SystemResource : public std::pmr::memory_resource {
+		public:
+			explicit SystemResource(ArenaStats& stats) : _stats(stats) {
+			}
+
+		protected:
+			ArenaStats& _stats;
+
+			void* do_allocate(size_t bytes, size_t alignment) override;
+
+			void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+
+			[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+				return this == &other;
+			}
+		};
+
+		ArenaStats _stats;
+		SystemResource _system;
+		std::pmr::unsynchronized_pool_resource _pools;
+
+		void* do_allocate(size_t bytes, size_t alignment) override;
+
+		void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+
+		[[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+}
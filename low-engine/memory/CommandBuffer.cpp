@@ -0,0 +1,87 @@
+#include "CommandBuffer.h"
+
+#include "memory/Memory.h"
+
+namespace LowEngine::Memory {
+	void CommandBuffer::CreateEntity(const std::string& name,
+	                                 std::function<void(Memory& memory, ECS::Entity& entity)> initialize) {
+		Command& command = _commands.emplace_back(CommandType::CreateEntity, Config::INVALID_ID,
+		                                          INVALID_COMPONENT_TYPE_ID);
+		command.Action = [name, initialize = std::move(initialize)](Memory& memory) {
+			ECS::Entity* entity = memory.CreateEntity<ECS::Entity>(name);
+			if (entity != nullptr && initialize) {
+				initialize(memory, *entity);
+			}
+		};
+	}
+
+	void CommandBuffer::DestroyEntity(size_t entityId) {
+		_commands.emplace_back(CommandType::DestroyEntity, entityId, INVALID_COMPONENT_TYPE_ID);
+	}
+
+	void CommandBuffer::SpawnEntity(const std::string& prefab, const std::string& name,
+	                                std::function<void(Memory& memory, ECS::Entity& entity)> build) {
+		Command& command = _commands.emplace_back(CommandType::SpawnEntity, Config::INVALID_ID,
+		                                          INVALID_COMPONENT_TYPE_ID);
+		command.Action = [prefab, name, build = std::move(build)](Memory& memory) {
+			memory.SpawnEntity<ECS::Entity>(prefab, name, [&build](Memory& target, ECS::Entity& entity) {
+				if (build) {
+					build(target, entity);
+				}
+			});
+		};
+	}
+
+	void CommandBuffer::Playback(Memory& memory) {
+		// reserve storage for everything that will be created
+		size_t entityCount = 0;
+		std::vector<size_t> componentCounts;
+		for (const auto& command: _commands) {
+			if (command.Type == CommandType::CreateEntity || command.Type == CommandType::SpawnEntity) {
+				entityCount++;
+			} else if (command.Type == CommandType::AddComponent) {
+				if (command.TypeId >= componentCounts.size()) {
+					componentCounts.resize(command.TypeId + 1, 0);
+				}
+				componentCounts[command.TypeId]++;
+			}
+		}
+
+		memory.ReserveEntities(entityCount);
+		for (ComponentTypeId typeId = 0; typeId < componentCounts.size(); ++typeId) {
+			if (componentCounts[typeId] > 0) {
+				memory.ReserveComponents(typeId, componentCounts[typeId]);
+			}
+		}
+
+		// commands can record new commands, so vector may grow during the loop
+		for (size_t index = 0; index < _commands.size(); ++index) {
+			Command command = std::move(_commands[index]);
+			switch (command.Type) {
+				case CommandType::CreateEntity:
+				case CommandType::SpawnEntity:
+				case CommandType::AddComponent:
+					command.Action(memory);
+					break;
+				case CommandType::DestroyEntity:
+					if (memory.IsEntityValid(command.EntityId)) {
+						memory.DestroyEntity(memory.GetEntity<ECS::Entity>(command.EntityId));
+					}
+					break;
+				case CommandType::DespawnEntity:
+					if (memory.IsEntityValid(command.EntityId)) {
+						memory.DespawnEntity(command.EntityId);
+					}
+					break;
+				case CommandType::DestroyComponent:
+					memory.DestroyComponent(command.EntityId, command.TypeId);
+					break;
+				case CommandType::SetComponentActive:
+					memory.SetComponentActive(command.EntityId, command.TypeId, command.Active);
+					break;
+			}
+		}
+
+		_commands.clear();
+	}
+}
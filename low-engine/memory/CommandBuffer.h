@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "memory/ComponentTypeId.h"
+
+namespace LowEngine::ECS {
+	class Entity;
+}
+
+namespace LowEngine::Memory {
+	class Memory;
+
+	/**
+	 * @brief Records structural changes of the ECS to apply them later, in one batch.
+	 *
+	 * Creating and destroying Entities and Components while Component Pools are being updated is not safe.
+	 * Changes requested from Update and FixedUpdate are recorded here instead, and played back by Memory
+	 * after all pools finished updating. Commands from one buffer are played back in order they were recorded.
+	 *
+	 * Memory keeps one buffer per thread, see Memory::GetCommandBuffer. Buffers keep their capacity between frames.
+	 */
+	class CommandBuffer {
+	public:
+		/**
+		 * @brief Record creation of a new Entity.
+		 * @param name Name of the new Entity.
+		 * @param initialize Function called right after Entity is created, e.g. to attach Components. Can be empty.
+		 */
+		void CreateEntity(const std::string& name,
+		                  std::function<void(Memory& memory, ECS::Entity& entity)> initialize = nullptr);
+
+		/**
+		 * @brief Record destruction of an Entity and all its Components.
+		 *
+		 * Destroying the same Entity several times is allowed. Only the first command has an effect.
+		 * @param entityId Id of the Entity.
+		 */
+		void DestroyEntity(size_t entityId);
+
+		/**
+		 * @brief Record spawning of an Entity of a prefab, see Memory::SpawnEntity.
+		 * @param prefab Name of the prefab.
+		 * @param name Name of the Entity.
+		 * @param build Function attaching Components to a new Entity. Not called for reused Entities.
+		 */
+		void SpawnEntity(const std::string& prefab, const std::string& name,
+		                 std::function<void(Memory& memory, ECS::Entity& entity)> build);
+
+		/**
+		 * @brief Record despawning of an Entity, see Memory::DespawnEntity.
+		 *
+		 * Despawning the same Entity several times is allowed. Only the first command has an effect.
+		 * @param entityId Id of the Entity.
+		 */
+		void DespawnEntity(size_t entityId) {
+			_commands.emplace_back(CommandType::DespawnEntity, entityId, INVALID_COMPONENT_TYPE_ID);
+		}
+
+		/**
+		 * @brief Record creation of a Component.
+		 * @tparam T Type of the Component.
+		 * @tparam Args Types of arguments forwarded to Component's c-tor.
+		 * @param entityId Id of the Entity that will own the Component.
+		 * @param args Arguments forwarded to Component's c-tor. Stored by value until playback.
+		 */
+		template <typename T, typename... Args>
+		void AddComponent(size_t entityId, Args&&... args) {
+			Command& command = _commands.emplace_back(CommandType::AddComponent, entityId, GetComponentTypeId<T>());
+			// generic lambda, so Memory doesn't have to be complete here
+			command.Action = [entityId, ...args = std::forward<Args>(args)](auto& memory) mutable {
+				memory.template CreateComponent<T>(entityId, std::move(args)...);
+			};
+		}
+
+		/**
+		 * @brief Record destruction of a Component.
+		 * @tparam T Type of the Component.
+		 * @param entityId Id of the Entity that owns the Component.
+		 */
+		template <typename T>
+		void DestroyComponent(size_t entityId) {
+			DestroyComponent(entityId, GetComponentTypeId<T>());
+		}
+
+		/**
+		 * @brief Record destruction of a Component.
+		 * @param entityId Id of the Entity that owns the Component.
+		 * @param typeId Id of the Component type.
+		 */
+		void DestroyComponent(size_t entityId, ComponentTypeId typeId) {
+			_commands.emplace_back(CommandType::DestroyComponent, entityId, typeId);
+		}
+
+		/**
+		 * @brief Record activation or deactivation of a Component.
+		 * @param entityId Id of the Entity that owns the Component.
+		 * @param typeId Id of the Component type.
+		 * @param active New state of the Component.
+		 */
+		void SetComponentActive(size_t entityId, ComponentTypeId typeId, bool active) {
+			_commands.emplace_back(CommandType::SetComponentActive, entityId, typeId).Active = active;
+		}
+
+		/**
+		 * @brief Apply all recorded commands to Memory manager and clear the buffer.
+		 *
+		 * Storage for created Entities and Components is reserved up front. Commands recorded during playback
+		 * are played back in the same call.
+		 * @param memory Memory manager to apply commands to.
+		 */
+		void Playback(Memory& memory);
+
+		/**
+		 * @brief Remove all recorded commands without applying them.
+		 */
+		void Clear() {
+			_commands.clear();
+		}
+
+		/**
+		 * @brief Retrieve number of recorded commands.
+		 * @return Number of commands.
+		 */
+		[[nodiscard]] size_t GetSize() const {
+			return _commands.size();
+		}
+
+		/**
+		 * @brief Check if there are no recorded commands.
+		 * @return True if buffer is empty.
+		 */
+		[[nodiscard]] bool IsEmpty() const {
+			return _commands.empty();
+		}
+
+	protected:
+		enum class CommandType : uint8_t {
+			CreateEntity,
+			DestroyEntity,
+			SpawnEntity,
+			DespawnEntity,
+			AddComponent,
+			DestroyComponent,
+			SetComponentActive
+		};
+
+		/**
+		 * @brief Single recorded change.
+		 */
+		struct Command {
+			CommandType Type;
+			size_t EntityId;
+			ComponentTypeId TypeId;
+			/** @brief New state for SetComponentActive commands. */
+			bool Active = false;
+			/** @brief Work to do for commands that create something. */
+			std::function<void(Memory&)> Action;
+
+			Command(CommandType type, size_t entityId, ComponentTypeId typeId)
+				: Type(type), EntityId(entityId), TypeId(typeId) {}
+		};
+
+		std::vector<Command> _commands;
+	};
+}
@@ -1,14 +1,29 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <unordered_map>
 
 #include "nlohmann/json.hpp"
 
 #include "EngineConfig.h"
 #include "../log/Log.h"
+#include "memory/ComponentTypeId.h"
+#include "memory/SparseIndex.h"
+#include "ecs/EntityId.h"
 #include "graphics/Sprite.h"
 #include "graphics/Drawables.h"
+#include "threading/WorkerPool.h"
+#include "utils/BinaryStream.h"
 
 namespace LowEngine::Memory {
 	class Memory;
@@ -23,6 +38,80 @@ namespace LowEngine::Memory {
 		alignas(T) std::byte data[sizeof(T)];
 	};
 
+	/**
+	 * @brief Placeholder for structure-of-arrays storage of Component types that don't use it.
+	 */
+	struct NoSoAStorage {
+		explicit NoSoAStorage(std::pmr::memory_resource*) {
+		}
+
+		NoSoAStorage(const NoSoAStorage&, std::pmr::memory_resource*) {
+		}
+	};
+
+	/**
+	 * @brief Does Component type keep hot data in structure-of-arrays storage? See IComponent::SoAStorage.
+	 */
+	template <typename T>
+	constexpr bool HasSoAStorage = !std::is_void_v<typename T::SoAStorage>;
+
+	/**
+	 * @brief Structure-of-arrays storage kept by pool of Component type, NoSoAStorage if the type doesn't use it.
+	 */
+	template <typename T>
+	using SoAStorageOf = std::conditional_t<HasSoAStorage<T>, typename T::SoAStorage, NoSoAStorage>;
+
+	/**
+	 * @brief Does Component type record the tick of its last change? See ComponentPool::RecordChange.
+	 */
+	template <typename T>
+	constexpr bool HasChangedTick = requires(const T& component) { component.GetChangedTick(); };
+
+	/**
+	 * @brief Change of a Component during a tick, see ComponentPool::RecordChange.
+	 */
+	struct ChangeRecord {
+		/** @brief Tick of the change. */
+		uint64_t Tick = 0;
+		/** @brief Id of the Entity owning the Component. */
+		size_t EntityId = 0;
+	};
+
+	/**
+	 * @brief Memory usage of a single Component Pool.
+	 */
+	struct PoolStats {
+		/** @brief Id of the Component type. Filled in by Memory, pools leave it invalid. */
+		ComponentTypeId TypeId = INVALID_COMPONENT_TYPE_ID;
+
+		/** @brief Number of live Components. */
+		size_t Count = 0;
+
+		/** @brief Number of active Components. */
+		size_t ActiveCount = 0;
+
+		/** @brief Highest number of live Components at once. */
+		size_t PeakCount = 0;
+
+		/** @brief Number of Components that fit in allocated chunks. */
+		size_t Capacity = 0;
+
+		/** @brief Number of allocated chunks. */
+		size_t ChunkCount = 0;
+
+		/** @brief Number of chunks allocated since the pool was created. */
+		size_t GrowthEvents = 0;
+
+		/** @brief Bytes allocated by the pool: chunks, dense collections and index pages. */
+		size_t BytesReserved = 0;
+
+		/** @brief Part of BytesReserved holding live Components and their entries in dense collections. */
+		size_t BytesUsed = 0;
+
+		/** @brief Heap memory owned by live Components, as reported by their GetHeapSize. */
+		size_t ComponentHeapBytes = 0;
+	};
+
 	/**
 	 * @brief Interface abstracting Component Pool
 	 */
@@ -33,9 +122,10 @@ namespace LowEngine::Memory {
 		/**
 		 * @brief Deep clone for Component Pool
 		 * @param newMemory Pointer to Memory manager which will hold new copy of the Component Pool
+		 * @param resource Memory resource the copy allocates its storage from.
 		 * @return Pointer to new copy of Component Pool
 		 */
-		virtual std::unique_ptr<IComponentPool> Clone(Memory* newMemory) const = 0;
+		virtual std::unique_ptr<IComponentPool> Clone(Memory* newMemory, std::pmr::memory_resource* resource) const = 0;
 
 		/**
 		 * @brief Retrieve Component for particular Entity Id.
@@ -73,58 +163,220 @@ namespace LowEngine::Memory {
 		 */
 		virtual void DestroyComponent(size_t entityId) = 0;
 
+		/**
+		 * @brief Make sure that provided number of components can be created without allocating memory.
+		 * @param additional Number of components that will be created.
+		 */
+		virtual void Reserve(size_t additional) = 0;
+
+		/**
+		 * @brief Activate or deactivate Component owned by Entity with provided Id.
+		 *
+		 * Moves the component across the boundary between active and inactive components.
+		 * Must not be called while the pool is being iterated.
+		 * @param entityId Id of the Entity that owns the Component.
+		 * @param active New state of the Component.
+		 * @return True if Entity owns a Component in this pool.
+		 */
+		virtual bool SetActive(size_t entityId, bool active) = 0;
+
+		/**
+		 * @brief Call Park hook of Component owned by Entity with provided Id and deactivate it.
+		 * @param entityId Id of the Entity that owns the Component.
+		 * @return True if Entity owns a Component in this pool.
+		 */
+		virtual bool Park(size_t entityId) = 0;
+
+		/**
+		 * @brief Call Reset hook of Component owned by Entity with provided Id and activate it.
+		 * @param entityId Id of the Entity that owns the Component.
+		 * @return True if Entity owns a Component in this pool.
+		 */
+		virtual bool Reuse(size_t entityId) = 0;
+
 		virtual nlohmann::ordered_json SerializeToJSON() = 0;
+
+		/**
+		 * @brief Append Components to a binary scene file block.
+		 *
+		 * Written are the record count, size of Component's binary state (see IComponent::BinarySize) and records:
+		 * Id of the owning Entity and active flag, followed by the binary state, or by MessagePack encoded JSON
+		 * of the Component for types without binary state (see Utils::BinaryWriter::WriteMessagePack).
+		 * @param out Writer of the block.
+		 * @param skip Optional filter. Components of Entities for which it returns true are left out.
+		 * @return Number of written records.
+		 */
+		virtual size_t WriteBinary(Utils::BinaryWriter& out, const std::function<bool(size_t)>& skip) = 0;
+
+		/**
+		 * @brief Append Components of provided Entities to a binary scene file block, in the layout of WriteBinary.
+		 *
+		 * Only the listed Components are visited, so the cost doesn't depend on the size of the pool.
+		 * @param out Writer of the block.
+		 * @param entityIds Ids of the Entities. Entities that don't own a Component in this pool are left out.
+		 * @return Number of written records.
+		 */
+		virtual size_t WriteBinary(Utils::BinaryWriter& out, std::span<const size_t> entityIds) = 0;
+
+		/**
+		 * @brief Retrieve size of a single Component's record in a snapshot.
+		 *
+		 * Record is the Id of the owning Entity followed by Component's state.
+		 * @return Size in bytes. 0 if Component type doesn't support snapshots.
+		 */
+		[[nodiscard]] virtual size_t GetSnapshotRecordSize() const = 0;
+
+		/**
+		 * @brief Append snapshot records of all Components, in iteration order.
+		 * @param[out] out Buffer to append records to.
+		 * @return Number of appended records.
+		 */
+		virtual size_t WriteSnapshot(std::vector<std::byte>& out) const = 0;
+
+		/**
+		 * @brief Check if snapshot records cover exactly the Entities owning a Component in this pool.
+		 * @param records Pointer to records written by WriteSnapshot.
+		 * @param count Number of records.
+		 * @return True if every Component has a record and every record has a Component.
+		 */
+		[[nodiscard]] virtual bool MatchesSnapshot(const std::byte* records, size_t count) const = 0;
+
+		/**
+		 * @brief Restore Components from snapshot records.
+		 *
+		 * Records of Entities that no longer own a Component in this pool are skipped, see MatchesSnapshot.
+		 * @param records Pointer to records written by WriteSnapshot.
+		 * @param count Number of records.
+		 */
+		virtual void ReadSnapshot(const std::byte* records, size_t count) = 0;
+
+		/**
+		 * @brief Retrieve number of components in this pool.
+		 * @return Number of components.
+		 */
+		[[nodiscard]] virtual size_t GetSize() const = 0;
+
+		/**
+		 * @brief Retrieve memory usage of this pool.
+		 * @return Statistics of the pool.
+		 */
+		[[nodiscard]] virtual PoolStats GetStats() const = 0;
+
+		/**
+		 * @brief Release memory that isn't needed by live Components.
+		 *
+		 * Frees chunks without live Components, trims dense collections and the sparse index, and lets Components
+		 * release their own spare heap memory. Live Components are never moved.
+		 */
+		virtual void ShrinkToFit() = 0;
+
+		/**
+		 * @brief Drop change records superseded by later changes and make room for every Component to record one more.
+		 *
+		 * Called before every update, so Components changing on worker threads don't allocate. Pools of Component
+		 * types without change ticks do nothing.
+		 */
+		virtual void PrepareChangeLog() = 0;
+
+		/**
+		 * @brief Set worker pool used by pools of ParallelSafeUpdate Components to split their update.
+		 * @param workerPool Pointer to worker pool. Can be nullptr.
+		 */
+		void SetWorkerPool(Threading::WorkerPool* workerPool) {
+			_workerPool = workerPool;
+		}
+
+	protected:
+		/** @brief Worker pool used for parallel updates. Not owned. */
+		Threading::WorkerPool* _workerPool = nullptr;
 	};
 
 
 	/**
 	 * @brief Class representing a pool of components for managing entity-component storage.
 	 *
-	 * Component Pool stores components of particular type in sequential order in memory.
-	 * It starts with a capacity of Config::DEFAULT_COMPONENT_POOL_SIZE, but will expand exponentially when limit is reached.
+	 * Component Pool stores components of particular type in fixed-size chunks of Config::COMPONENT_POOL_CHUNK_SIZE
+	 * components. Live components are never moved: growing the pool allocates a new chunk and destroyed components
+	 * leave a free slot that is reused by the next created component. Pointers to components stay valid
+	 * until the component is destroyed.
+	 *
+	 * Pointers to live components are kept in a dense collection, which is used for iteration. The collection is
+	 * partitioned: active components come first, so Update and Draw iterate only over the active range and never
+	 * check the state of a component. Changing the state goes through SetActive, which swaps the component
+	 * across the partition boundary.
+	 *
+	 * Chunks and all internal collections are allocated from the memory resource provided on construction, which
+	 * Memory points to its per-scene arena.
+	 *
+	 * Component types declaring SoAStorage keep their hot data in it, parallel to the dense collection. Every move
+	 * in the dense collection is mirrored there, so batch work can run over the arrays of GetSoAStorage, with
+	 * active components first.
 	 */
 	template <typename T>
 	class ComponentPool : public IComponentPool {
 	public:
-		explicit ComponentPool(size_t capacity = Config::DEFAULT_COMPONENT_POOL_SIZE) {
-			Storage.reserve(capacity);
+		explicit ComponentPool(size_t chunkSize = Config::COMPONENT_POOL_CHUNK_SIZE,
+		                       std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			: ChunkSize(chunkSize > 0 ? chunkSize : 1), Chunks(resource), FreeSlots(resource), Components(resource),
+			  Entities(resource), Index(resource), SoA(resource), ChangeLog(resource) {
 		}
 
-		ComponentPool(const ComponentPool& other, Memory* newMem)
-			: ComponentPool(other.Storage.capacity()) {
-			for (const auto& [entityId, oldIndex] : other.IndexMap) {
-				Storage.emplace_back();
-
-				void* slot = &Storage.back();
-				auto* oldComp = reinterpret_cast<const T*>(&other.Storage[oldIndex]);
-				oldComp->CloneInto(newMem, slot);
+		ComponentPool(const ComponentPool& other, Memory* newMem, std::pmr::memory_resource* resource)
+			: ChunkSize(other.ChunkSize), Chunks(resource), FreeSlots(resource), Components(resource),
+			  Entities(resource), Index(resource), SoA(other.SoA, resource), ChangeLog(other.ChangeLog, resource) {
+			// clones are placed one after another into fresh chunks, dropping free storage of the other pool
+			const size_t count = other.Components.size();
+			const size_t chunkCount = (count + ChunkSize - 1) / ChunkSize;
+			Chunks.reserve(chunkCount);
+			for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+				AllocateChunk();
+			}
+			LastChunkUsed = count - (chunkCount > 0 ? (chunkCount - 1) * ChunkSize : 0);
 
-				size_t newIndex = Storage.size() - 1;
-				IndexMap[entityId] = newIndex;
-				ReverseMap[newIndex] = entityId;
+			Components.reserve(count);
+			for (size_t index = 0; index < count; ++index) {
+				void* slot = &Chunks[index / ChunkSize][index % ChunkSize];
+				other.Components[index]->CloneInto(newMem, slot);
+				if constexpr (HasSoAStorage<T>) {
+					reinterpret_cast<T*>(slot)->BindSoAStorage(&SoA, index);
+				}
+				Components.push_back(reinterpret_cast<T*>(slot));
 			}
+
+			// positions in Components are kept, so Entity Ids and the index are copied as they are
+			Entities.assign(other.Entities.begin(), other.Entities.end());
+			Index = SparseIndex(other.Index, resource);
+			ActiveCount = other.ActiveCount;
 		}
 
 		~ComponentPool() override {
-			for (auto& component : Storage) {
-				reinterpret_cast<T*>(&component)->~T();
+			for (T* component : Components) {
+				component->~T();
+			}
+			for (AlignedStorage<T>* chunk : Chunks) {
+				Chunks.get_allocator().resource()->deallocate(chunk, sizeof(AlignedStorage<T>) * ChunkSize,
+				                                              CHUNK_ALIGNMENT);
 			}
 		};
 
 		/**
 		 * @brief Deep-copy this Component Pool. Store new copy in the provided Memory manager.
 		 * @param newMemory Pointer to Memory manager that will store new copy.
+		 * @param resource Memory resource the copy allocates its storage from.
 		 * @return Pointer to new copy.
 		 */
-		std::unique_ptr<IComponentPool> Clone(Memory* newMemory) const override {
+		std::unique_ptr<IComponentPool> Clone(Memory* newMemory, std::pmr::memory_resource* resource) const override {
 			return std::make_unique<ComponentPool<T>>(
 				*static_cast<const ComponentPool<T>*>(this),
-				newMemory
+				newMemory,
+				resource
 			);
 		}
 
 		/**
 		 * @brief Create new Component and attach it to Entity with provided Id.
+		 *
+		 * New Component is Active.
 		 * @tparam Args List of arguments to pass to Component's constructor.
 		 * @param memory Pointer to Memory manager that owns this Component Pool.
 		 * @param entityId Id of the Entity that will own new Component
@@ -133,29 +385,31 @@ namespace LowEngine::Memory {
 		 */
 		template <typename... Args>
 		T* CreateComponent(Memory* memory, size_t entityId, Args&&... args) {
-			if (IndexMap.contains(entityId)) {
+			if (Index.Contains(ECS::GetEntityIndex(entityId))) {
 				_log->error("Component pool: Component {} already exists for entity id {}.", typeid(T).name(),
 				            entityId);
 				return nullptr;
 			}
 
-			// get index to create component
-			size_t index = Storage.size();
-			if (index >= Storage.capacity()) {
-				Storage.reserve(Storage.capacity() * 2);
-				_log->debug("Component pool: Reallocating memory for component type {}. Current size: {}",
-				            typeid(T).name(), Storage.capacity());
-				// note: this memcopy data to new location, which will cause problems if components are not trivially copyable
-				// make sure that component don't have any pointers or references to other objects
+			void* slot = AcquireSlot();
+			if constexpr (HasSoAStorage<T>) {
+				SoA.PushBack();
 			}
-
-			// placement-new to initialize memory
-			Storage.emplace_back();
 			try {
-				T* component = new(&Storage.back()) T(memory, std::forward<Args>(args)...);
+				// placement-new to initialize memory
+				T* component = new(slot) T(memory, std::forward<Args>(args)...);
+				component->_active = true;
+				if constexpr (HasSoAStorage<T>) {
+					component->BindSoAStorage(&SoA, Components.size());
+				}
 				// map entityId to component index
-				IndexMap[entityId] = index;
-				ReverseMap[index] = entityId;
+				Index.Set(ECS::GetEntityIndex(entityId), Components.size());
+				Components.push_back(component);
+				Entities.push_back(entityId);
+				PeakCount = std::max(PeakCount, Components.size());
+				// extend active range over new component
+				SwapPositions(Components.size() - 1, ActiveCount);
+				ActiveCount++;
 				return component;
 			} catch (...) {
 				// since placement new don't allocate, it can't fail.
@@ -163,7 +417,10 @@ namespace LowEngine::Memory {
 
 				_log->error("ERROR!: Creating component of type '{0}' critically failed.", typeid(T).name());
 
-				Storage.pop_back(); // in case of error remove pre-allocated element on the vector
+				FreeSlots.push_back(slot); // in case of error return the slot for reuse
+				if constexpr (HasSoAStorage<T>) {
+					SoA.PopBack();
+				}
 				return nullptr;
 			}
 		}
@@ -173,28 +430,111 @@ namespace LowEngine::Memory {
 		 * @param entityId Id of the Entity that will have its Component destroyed.
 		 */
 		void DestroyComponent(size_t entityId) override {
-			auto it = IndexMap.find(entityId);
-			if (it == IndexMap.end()) {
+			size_t removedIndex = FindIndex(entityId);
+			if (removedIndex == SparseIndex::NOT_FOUND) {
 				return; // component not found
 			}
 
-			size_t removedIndex = it->second;
-			reinterpret_cast<T*>(&Storage[removedIndex])->~T();
+			T* component = Components[removedIndex];
+
+			// move removed component out of active range first, so the partition stays intact
+			if (removedIndex < ActiveCount) {
+				ActiveCount--;
+				SwapPositions(removedIndex, ActiveCount);
+				removedIndex = ActiveCount;
+			}
+
+			// swap pointer to removed component with the last one; component objects stay where they are
+			SwapPositions(removedIndex, Components.size() - 1);
+
+			component->~T();
+			FreeSlots.push_back(component);
+
+			Components.pop_back();
+			Entities.pop_back();
+			if constexpr (HasSoAStorage<T>) {
+				SoA.PopBack();
+			}
+			Index.Erase(ECS::GetEntityIndex(entityId));
+		}
+
+		/**
+		 * @brief Activate or deactivate Component owned by Entity with provided Id.
+		 *
+		 * Moves the component across the boundary between active and inactive components.
+		 * Must not be called while the pool is being iterated.
+		 * @param entityId Id of the Entity that owns the Component.
+		 * @param active New state of the Component.
+		 * @return True if Entity owns a Component in this pool.
+		 */
+		bool SetActive(size_t entityId, bool active) override {
+			size_t index = FindIndex(entityId);
+			if (index == SparseIndex::NOT_FOUND) {
+				return false;
+			}
+
+			T* component = Components[index];
+			if (component->_active == active) {
+				return true;
+			}
+
+			component->_active = active;
+			if (active) {
+				SwapPositions(index, ActiveCount);
+				ActiveCount++;
+			} else {
+				ActiveCount--;
+				SwapPositions(index, ActiveCount);
+			}
+			return true;
+		}
 
-			size_t lastIndex = Storage.size() - 1;
+		bool Park(size_t entityId) override {
+			T* component = TryGetComponent(entityId);
+			if (component == nullptr) {
+				return false;
+			}
 
-			// swap component to remove (index) with the last one
-			if (removedIndex != lastIndex) {
-				std::swap(Storage[removedIndex], Storage[lastIndex]);
+			component->Park();
+			return SetActive(entityId, false);
+		}
 
-				size_t swappedEntityId = ReverseMap[lastIndex];
-				IndexMap[swappedEntityId] = removedIndex;
-				ReverseMap[removedIndex] = swappedEntityId;
+		bool Reuse(size_t entityId) override {
+			T* component = TryGetComponent(entityId);
+			if (component == nullptr) {
+				return false;
 			}
 
-			Storage.pop_back();
-			IndexMap.erase(it);
-			ReverseMap.erase(lastIndex);
+			component->Reset();
+			return SetActive(entityId, true);
+		}
+
+		/**
+		 * @brief Make sure that provided number of components can be created without allocating memory.
+		 *
+		 * Missing storage is allocated as whole spare chunks, handed out in order once the current chunk is full.
+		 * Free slots and the unused rest of the current chunk count as reserved.
+		 * @param additional Number of components that will be created.
+		 */
+		void Reserve(size_t additional) override {
+			Components.reserve(Components.size() + additional);
+			Entities.reserve(Entities.size() + additional);
+			if constexpr (HasSoAStorage<T>) {
+				SoA.Reserve(Components.size() + additional);
+			}
+
+			size_t available = FreeSlots.size() + GetUnusedSlotCount();
+			if (available >= additional) {
+				return;
+			}
+
+			// new chunks are handed out in order by AcquireSlot, nothing is written into them up front
+			size_t newChunks = (additional - available + ChunkSize - 1) / ChunkSize;
+			Chunks.reserve(Chunks.size() + newChunks);
+			for (size_t chunk = 0; chunk < newChunks; ++chunk) {
+				AllocateChunk();
+				SpareChunks++;
+			}
 		}
 
 		/**
@@ -203,11 +543,198 @@ namespace LowEngine::Memory {
 		 * @return Pointer to component. Returns nullptr when Component not found
 		 */
 		void* GetComponentPtr(size_t entityId) override {
-			auto it = IndexMap.find(entityId);
-			if (it == IndexMap.end()) {
+			return TryGetComponent(entityId);
+		}
+
+		/**
+		 * @brief Retrieve typed pointer to a component belonging to Entity with provided Id.
+		 *
+		 * Non-virtual counterpart of GetComponentPtr, meant for hot loops.
+		 * @param entityId Id of the Entity the component belong to.
+		 * @return Pointer to component. Returns nullptr when Component not found
+		 */
+		T* TryGetComponent(size_t entityId) {
+			size_t index = FindIndex(entityId);
+			if (index == SparseIndex::NOT_FOUND) {
 				return nullptr;
 			}
-			return &Storage[it->second];
+			return Components[index];
+		}
+
+		[[nodiscard]] size_t GetSize() const override {
+			return Components.size();
+		}
+
+		/**
+		 * @brief Retrieve number of active components in this pool.
+		 *
+		 * Active components occupy first GetActiveCount() positions of the iteration order.
+		 * @return Number of active components.
+		 */
+		[[nodiscard]] size_t GetActiveCount() const {
+			return ActiveCount;
+		}
+
+		/**
+		 * @brief Retrieve number of components this pool can hold without allocating a new chunk.
+		 * @return Number of components.
+		 */
+		[[nodiscard]] size_t GetCapacity() const {
+			return Chunks.size() * ChunkSize;
+		}
+
+		/**
+		 * @brief Retrieve Ids of all Entities owning a component in this pool, in iteration order.
+		 * @return Reference to dense collection of Entity Ids.
+		 */
+		[[nodiscard]] const std::pmr::vector<size_t>& GetEntityIds() const {
+			return Entities;
+		}
+
+		/**
+		 * @brief Retrieve structure-of-arrays storage of this pool, see IComponent::SoAStorage.
+		 *
+		 * Entries follow the order of GetEntityIds, with the first GetActiveCount() entries belonging to
+		 * active components.
+		 * @return Reference to the storage.
+		 */
+		[[nodiscard]] SoAStorageOf<T>& GetSoAStorage() requires HasSoAStorage<T> {
+			return SoA;
+		}
+
+		[[nodiscard]] PoolStats GetStats() const override {
+			PoolStats stats;
+			stats.Count = Components.size();
+			stats.ActiveCount = ActiveCount;
+			stats.PeakCount = PeakCount;
+			stats.Capacity = GetCapacity();
+			stats.ChunkCount = Chunks.size();
+			stats.GrowthEvents = GrowthEvents;
+			stats.BytesReserved = Chunks.size() * ChunkSize * sizeof(AlignedStorage<T>)
+			                      + Chunks.capacity() * sizeof(AlignedStorage<T>*)
+			                      + FreeSlots.capacity() * sizeof(void*)
+			                      + Components.capacity() * sizeof(T*)
+			                      + Entities.capacity() * sizeof(size_t)
+			                      + Index.GetReservedBytes()
+			                      + ChangeLog.capacity() * sizeof(ChangeRecord);
+			if constexpr (HasSoAStorage<T>) {
+				stats.BytesReserved += SoA.GetReservedBytes();
+			}
+			stats.BytesUsed = Components.size() * (sizeof(AlignedStorage<T>) + sizeof(T*) + sizeof(size_t));
+			for (const T* component : Components) {
+				stats.ComponentHeapBytes += component->GetHeapSize();
+			}
+			return stats;
+		}
+
+		void ShrinkToFit() override {
+			for (T* component : Components) {
+				component->ShrinkToFit();
+			}
+
+			// reserved chunks never handed out hold nothing
+			for (; SpareChunks > 0; SpareChunks--) {
+				Chunks.get_allocator().resource()->deallocate(Chunks.back(), sizeof(AlignedStorage<T>) * ChunkSize,
+				                                              CHUNK_ALIGNMENT);
+				Chunks.pop_back();
+			}
+
+			// storage never handed out counts as free
+			if (!Chunks.empty()) {
+				for (size_t index = ChunkSize; index > LastChunkUsed; --index) {
+					FreeSlots.push_back(&Chunks.back()[index - 1]);
+				}
+				LastChunkUsed = ChunkSize;
+			}
+
+			// chunk holds no live component when all of its storage objects are free
+			std::sort(Chunks.begin(), Chunks.end());
+			std::pmr::vector<size_t> freeCounts(Chunks.size(), 0, Chunks.get_allocator());
+			for (void* slot : FreeSlots) {
+				freeCounts[FindChunk(slot)]++;
+			}
+
+			std::erase_if(FreeSlots, [this, &freeCounts](void* slot) {
+				return freeCounts[FindChunk(slot)] == ChunkSize;
+			});
+			// free slots are taken from the back, so the lowest addresses are reused first
+			std::sort(FreeSlots.begin(), FreeSlots.end(), std::greater<>());
+
+			std::pmr::vector<AlignedStorage<T>*> keptChunks(Chunks.get_allocator());
+			for (size_t index = 0; index < Chunks.size(); ++index) {
+				if (freeCounts[index] == ChunkSize) {
+					Chunks.get_allocator().resource()->deallocate(Chunks[index], sizeof(AlignedStorage<T>) * ChunkSize,
+					                                              CHUNK_ALIGNMENT);
+				} else {
+					keptChunks.push_back(Chunks[index]);
+				}
+			}
+
+			Chunks = std::move(keptChunks);
+			Chunks.shrink_to_fit();
+			FreeSlots.shrink_to_fit();
+			Components.shrink_to_fit();
+			Entities.shrink_to_fit();
+			Index.ShrinkToFit();
+			if constexpr (HasChangedTick<T>) {
+				std::erase_if(ChangeLog, [this](const ChangeRecord& record) { return !IsCurrentChange(record); });
+			}
+			ChangeLog.shrink_to_fit();
+			// parallel update rebuilds its scratch every frame
+			UpdateOrder = std::pmr::vector<T*>(UpdateOrder.get_allocator());
+			UpdateChunks = std::pmr::vector<AlignedStorage<T>*>(UpdateChunks.get_allocator());
+			UpdateChunkEnds = std::pmr::vector<size_t>(UpdateChunkEnds.get_allocator());
+			UpdateBatchEnds = std::pmr::vector<size_t>(UpdateBatchEnds.get_allocator());
+			if constexpr (HasSoAStorage<T>) {
+				SoA.ShrinkToFit();
+			}
+		}
+
+		void PrepareChangeLog() override {
+			if constexpr (HasChangedTick<T>) {
+				if (ChangeLog.capacity() - ChangeLog.size() >= Components.size()) {
+					return;
+				}
+
+				// every live component has a single current record, the rest is stale
+				std::erase_if(ChangeLog, [this](const ChangeRecord& record) { return !IsCurrentChange(record); });
+				// room for two rounds of changes, so dropping stale records is paid for by the records themselves
+				ChangeLog.reserve(ChangeLog.size() + 2 * Components.size());
+			}
+		}
+
+		/**
+		 * @brief Record that component owned by Entity changed during provided tick, see GetEntitiesChangedSince.
+		 *
+		 * Component records only its first change during a tick. Ticks never decrease, so records stay ordered
+		 * by tick. Not thread-safe, Memory serializes the calls.
+		 * @param entityId Id of the Entity that owns the component.
+		 * @param tick Tick of the change.
+		 */
+		void RecordChange(size_t entityId, uint64_t tick) requires HasChangedTick<T> {
+			ChangeLog.push_back({tick, entityId});
+		}
+
+		/**
+		 * @brief Retrieve Ids of Entities whose component changed during provided tick or later.
+		 *
+		 * Only records of the requested ticks are visited, so the cost doesn't depend on the size of the pool.
+		 * @param tick First tick to include.
+		 * @return Ids of Entities, sorted.
+		 */
+		std::vector<size_t> GetEntitiesChangedSince(uint64_t tick) const requires HasChangedTick<T> {
+			std::vector<size_t> entityIds;
+			auto first = std::ranges::lower_bound(ChangeLog, tick, {}, &ChangeRecord::Tick);
+			for (auto record = first; record != ChangeLog.end(); ++record) {
+				if (IsCurrentChange(*record)) {
+					entityIds.push_back(record->EntityId);
+				}
+			}
+
+			// component destroyed and created again during one tick has two current records
+			std::ranges::sort(entityIds);
+			entityIds.erase(std::ranges::unique(entityIds).begin(), entityIds.end());
+			return entityIds;
 		}
 
 		/**
@@ -217,36 +744,41 @@ namespace LowEngine::Memory {
 		 */
 		template <typename Callback>
 		void ForEachComponent(Callback&& callback) {
-			for (auto& storage : Storage) {
-				T* component = reinterpret_cast<T*>(&storage);
+			for (T* component : Components) {
 				callback(*component);
 			}
 		}
 
 		/**
 		 * @brief Call update function for all active components.
+		 *
+		 * Does nothing if T doesn't override Update.
 		 * @param deltaTime Time passed since last update, in seconds.
 		 */
 		void Update(float deltaTime) override {
-			for (auto& storage : Storage) {
-				auto component = reinterpret_cast<T*>(&storage);
-				if (component->Active) {
-					component->Update(deltaTime);
-				}
+			if constexpr (!T::OverridesUpdate()) {
+				return;
 			}
+
+			ForEachActiveInUpdate([deltaTime](T* component) {
+				component->Update(deltaTime);
+			});
 		}
 
 		/**
 		 * @brief Call fixed update function for all active components.
+		 *
+		 * Does nothing if T doesn't override FixedUpdate.
 		 * @param fixedDeltaTime Fixed time step for physics and other fixed-rate updates, in seconds.
 		 */
 		void FixedUpdate(float fixedDeltaTime) override {
-			for (auto& storage : Storage) {
-				auto component = reinterpret_cast<T*>(&storage);
-				if (component->Active) {
-					component->FixedUpdate(fixedDeltaTime);
-				}
+			if constexpr (!T::OverridesFixedUpdate()) {
+				return;
 			}
+
+			ForEachActiveInUpdate([fixedDeltaTime](T* component) {
+				component->FixedUpdate(fixedDeltaTime);
+			});
 		}
 
 		/**
@@ -255,53 +787,445 @@ namespace LowEngine::Memory {
 		 * @param[out] drawables Reference to collection that will be filled with drawables to render.
 		 */
 		void CollectDrawables(std::vector<SceneDrawable>& drawables) override {
-			for (auto& storage : Storage) {
-				T* component = reinterpret_cast<T*>(&storage);
-				if (component->Active) {
-					component->Draw(drawables);
-				}
+			if constexpr (!T::OverridesDraw()) {
+				return;
+			}
+
+			for (size_t index = 0; index < ActiveCount; ++index) {
+				Components[index]->Draw(drawables);
 			}
 		}
 
 		void DrawDirect(sf::RenderTarget& target) override {
-			for (auto & storage : Storage) {
-				T* component = reinterpret_cast<T*>(&storage);
-				if (component->Active) {
-					component->DrawDirect(target);
-				}
+			if constexpr (!T::OverridesDrawDirect()) {
+				return;
+			}
+
+			for (size_t index = 0; index < ActiveCount; ++index) {
+				Components[index]->DrawDirect(target);
 			}
 		}
 
 		nlohmann::ordered_json SerializeToJSON() override {
 			nlohmann::ordered_json componentJson = nlohmann::ordered_json::array();
 
-			for (auto& storage : Storage) {
-				T* component = reinterpret_cast<T*>(&storage);
+			for (T* component : Components) {
 				componentJson.push_back(component->SerializeToJSON());
 			}
 
 			return componentJson;
 		}
 
+		size_t WriteBinary(Utils::BinaryWriter& out, const std::function<bool(size_t)>& skip) override {
+			const size_t countOffset = BeginBinary(out);
+
+			uint64_t count = 0;
+			for (size_t index = 0; index < Components.size(); ++index) {
+				if (skip && skip(Entities[index])) continue;
+
+				WriteBinaryRecord(out, index);
+				count++;
+			}
+
+			out.WriteAt(countOffset, count);
+			return count;
+		}
+
+		size_t WriteBinary(Utils::BinaryWriter& out, std::span<const size_t> entityIds) override {
+			const size_t countOffset = BeginBinary(out);
+
+			uint64_t count = 0;
+			for (size_t entityId : entityIds) {
+				size_t index = FindIndex(entityId);
+				if (index == SparseIndex::NOT_FOUND) continue;
+
+				WriteBinaryRecord(out, index);
+				count++;
+			}
+
+			out.WriteAt(countOffset, count);
+			return count;
+		}
+
+		[[nodiscard]] size_t GetSnapshotRecordSize() const override {
+			return T::SnapshotSize == 0 ? 0 : sizeof(size_t) + T::SnapshotSize;
+		}
+
+		size_t WriteSnapshot(std::vector<std::byte>& out) const override {
+			if constexpr (T::SnapshotSize == 0) {
+				return 0;
+			}
+
+			const size_t recordSize = GetSnapshotRecordSize();
+			size_t offset = out.size();
+			out.resize(offset + Components.size() * recordSize);
+			for (size_t index = 0; index < Components.size(); ++index, offset += recordSize) {
+				std::memcpy(out.data() + offset, &Entities[index], sizeof(size_t));
+				Components[index]->WriteSnapshot(out.data() + offset + sizeof(size_t));
+			}
+			return Components.size();
+		}
+
+		[[nodiscard]] bool MatchesSnapshot(const std::byte* records, size_t count) const override {
+			if (count != Components.size()) {
+				return false;
+			}
+
+			// pool holds a single Component per Entity, so equal counts and no unknown Entity mean equal sets
+			const size_t recordSize = GetSnapshotRecordSize();
+			for (size_t record = 0; record < count; ++record, records += recordSize) {
+				size_t entityId;
+				std::memcpy(&entityId, records, sizeof(size_t));
+				if (FindIndex(entityId) == SparseIndex::NOT_FOUND) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void ReadSnapshot(const std::byte* records, size_t count) override {
+			if constexpr (T::SnapshotSize == 0) {
+				return;
+			}
+
+			const size_t recordSize = GetSnapshotRecordSize();
+			for (size_t record = 0; record < count; ++record, records += recordSize) {
+				size_t entityId;
+				std::memcpy(&entityId, records, sizeof(size_t));
+
+				size_t index = FindIndex(entityId);
+				if (index != SparseIndex::NOT_FOUND) {
+					Components[index]->ReadSnapshot(records + sizeof(size_t));
+				}
+			}
+		}
+
 	protected:
 		/**
-		 * @brief Collection of storage objects. Each object is a single component.
+		 * @brief Alignment of chunk allocations. Chunks start on a cache line, so batches of parallel update,
+		 * which always cover whole chunks, don't share cache lines.
+		 */
+		static constexpr size_t CHUNK_ALIGNMENT = std::max(Config::CACHE_LINE_SIZE, alignof(AlignedStorage<T>));
+
+		/**
+		 * @brief Number of components stored in a single chunk.
+		 */
+		size_t ChunkSize;
+
+		/**
+		 * @brief Collection of chunks. Each chunk holds ChunkSize storage objects, each object is a single component.
+		 *
+		 * Chunks are never reallocated, so components keep their address for their whole lifetime.
+		 */
+		std::pmr::vector<AlignedStorage<T>*> Chunks;
+
+		/**
+		 * @brief Number of storage objects in the current chunk that were handed out at least once.
+		 *
+		 * Current chunk is the last one in Chunks that isn't spare.
+		 */
+		size_t LastChunkUsed = 0;
+
+		/**
+		 * @brief Number of chunks at the end of Chunks allocated by Reserve and not handed out yet.
+		 */
+		size_t SpareChunks = 0;
+
+		/**
+		 * @brief Highest number of live components at once.
+		 */
+		size_t PeakCount = 0;
+
+		/**
+		 * @brief Number of chunks allocated since the pool was created.
+		 */
+		size_t GrowthEvents = 0;
+
+		/**
+		 * @brief Storage objects of destroyed components, available for reuse.
+		 */
+		std::pmr::vector<void*> FreeSlots;
+
+		/**
+		 * @brief Dense collection of pointers to live components.
+		 *
+		 * Active components occupy [0, ActiveCount), inactive ones the rest.
+		 */
+		std::pmr::vector<T*> Components;
+
+		/**
+		 * @brief Number of active components, all stored at the front of Components.
+		 */
+		size_t ActiveCount = 0;
+
+		/**
+		 * @brief Dense collection of Entity Ids, parallel to Components.
+		 *
+		 * Entities[i] is the Id of the Entity that owns component pointed to by Components[i].
+		 */
+		std::pmr::vector<size_t> Entities;
+
+		/**
+		 * @brief Sparse index of Entity's slot index to position in Components.
+		 */
+		SparseIndex Index;
+
+		/**
+		 * @brief Structure-of-arrays storage of hot component data, parallel to Components.
+		 */
+		[[no_unique_address]] SoAStorageOf<T> SoA;
+
+		/**
+		 * @brief Changes of components ordered by tick, see RecordChange. Empty for types without change ticks.
+		 *
+		 * Records of destroyed components and records superseded by a later change are stale. They are skipped
+		 * and dropped by PrepareChangeLog once the log has no room for a change of every component.
+		 */
+		std::pmr::vector<ChangeRecord> ChangeLog;
+
+		/**
+		 * @brief Active components grouped by the chunk they are stored in, rebuilt by every parallel update.
+		 *
+		 * Like the rest of the parallel update scratch, it's allocated from the default resource, not the pool's
+		 * one: pools update on worker threads, and the pool's resource may be an arena that is not thread-safe.
+		 */
+		std::pmr::vector<T*> UpdateOrder{std::pmr::get_default_resource()};
+
+		/**
+		 * @brief Chunks sorted by address, rebuilt by every parallel update.
+		 */
+		std::pmr::vector<AlignedStorage<T>*> UpdateChunks{std::pmr::get_default_resource()};
+
+		/**
+		 * @brief End of each chunk's group in UpdateOrder, indexed like UpdateChunks.
+		 */
+		std::pmr::vector<size_t> UpdateChunkEnds{std::pmr::get_default_resource()};
+
+		/**
+		 * @brief End of each parallel update batch in UpdateOrder. Batches end on chunk group boundaries.
+		 */
+		std::pmr::vector<size_t> UpdateBatchEnds{std::pmr::get_default_resource()};
+
+		/**
+		 * @brief Find position in Components of the component owned by Entity.
+		 *
+		 * Index is keyed by Entity's slot index only, so the full Id stored in Entities is compared
+		 * to reject handles of destroyed Entities whose slot was reused.
+		 * @param entityId Id of the Entity.
+		 * @return Position in Components. Returns SparseIndex::NOT_FOUND if Entity doesn't own a component.
+		 */
+		size_t FindIndex(size_t entityId) const {
+			size_t index = Index.Get(ECS::GetEntityIndex(entityId));
+			if (index == SparseIndex::NOT_FOUND || Entities[index] != entityId) {
+				return SparseIndex::NOT_FOUND;
+			}
+			return index;
+		}
+
+		/**
+		 * @brief Is the record the last change of a live component?
+		 * @param record Change record.
+		 * @return False if the component was destroyed or changed during a later tick.
+		 */
+		bool IsCurrentChange(const ChangeRecord& record) const requires HasChangedTick<T> {
+			size_t index = FindIndex(record.EntityId);
+			return index != SparseIndex::NOT_FOUND && Components[index]->GetChangedTick() == record.Tick;
+		}
+
+		/**
+		 * @brief Write header of a binary block, see WriteBinary.
+		 * @param out Writer of the block.
+		 * @return Offset of the record count, to be filled in once records are written.
+		 */
+		size_t BeginBinary(Utils::BinaryWriter& out) const {
+			const size_t countOffset = out.GetSize();
+			out.Write(static_cast<uint64_t>(0));
+			out.Write(static_cast<uint32_t>(T::BinarySize));
+			return countOffset;
+		}
+
+		/**
+		 * @brief Write record of a single Component, see WriteBinary.
+		 * @param out Writer of the block.
+		 * @param index Position in Components.
+		 */
+		void WriteBinaryRecord(Utils::BinaryWriter& out, size_t index) {
+			out.Write(static_cast<uint64_t>(Entities[index]));
+			out.Write(static_cast<uint8_t>(index < ActiveCount));
+			if constexpr (T::BinarySize > 0) {
+				Components[index]->WriteBinary(out.Extend(T::BinarySize));
+			} else {
+				out.WriteMessagePack(Components[index]->SerializeToJSON());
+			}
+		}
+
+		/**
+		 * @brief Swap two positions of the dense collections and update the index of both Entities.
+		 * @param first Position in Components.
+		 * @param second Position in Components.
+		 */
+		void SwapPositions(size_t first, size_t second) {
+			if (first == second) {
+				return;
+			}
+
+			std::swap(Components[first], Components[second]);
+			std::swap(Entities[first], Entities[second]);
+			Index.Set(ECS::GetEntityIndex(Entities[first]), first);
+			Index.Set(ECS::GetEntityIndex(Entities[second]), second);
+			if constexpr (HasSoAStorage<T>) {
+				SoA.Swap(first, second);
+				Components[first]->BindSoAStorage(&SoA, first);
+				Components[second]->BindSoAStorage(&SoA, second);
+			}
+		}
+
+		/**
+		 * @brief Get uninitialized storage for a new component.
+		 *
+		 * Reuses storage of a destroyed component if available, otherwise takes the next unused storage object
+		 * from the current chunk. When it's full, the next spare chunk becomes current, or a new chunk is allocated.
+		 * @return Pointer to raw memory suitable for placement-new of T.
+		 */
+		void* AcquireSlot() {
+			if (!FreeSlots.empty()) {
+				void* slot = FreeSlots.back();
+				FreeSlots.pop_back();
+				return slot;
+			}
+
+			if (Chunks.size() == SpareChunks || LastChunkUsed == ChunkSize) {
+				if (SpareChunks > 0) {
+					SpareChunks--;
+				} else {
+					AllocateChunk();
+					_log->debug("Component pool: Allocating chunk for component type {}. Current capacity: {}",
+					            typeid(T).name(), GetCapacity());
+				}
+				LastChunkUsed = 0;
+			}
+
+			return &Chunks[Chunks.size() - 1 - SpareChunks][LastChunkUsed++];
+		}
+
+		/**
+		 * @brief Retrieve number of storage objects AcquireSlot hands out before allocating, free slots excluded.
+		 * @return Unused storage objects in the current chunk and in spare chunks.
+		 */
+		[[nodiscard]] size_t GetUnusedSlotCount() const {
+			size_t currentChunkFree = Chunks.size() == SpareChunks ? 0 : ChunkSize - LastChunkUsed;
+			return currentChunkFree + SpareChunks * ChunkSize;
+		}
+
+		/**
+		 * @brief Allocate new chunk with CHUNK_ALIGNMENT from the pool's memory resource and append it to Chunks.
+		 * @return Pointer to the new chunk.
+		 */
+		AlignedStorage<T>* AllocateChunk() {
+			void* chunk = Chunks.get_allocator().resource()->allocate(sizeof(AlignedStorage<T>) * ChunkSize,
+			                                                         CHUNK_ALIGNMENT);
+			GrowthEvents++;
+			return Chunks.emplace_back(static_cast<AlignedStorage<T>*>(chunk));
+		}
+
+		/**
+		 * @brief Find position in sorted Chunks of the chunk holding provided storage object.
+		 * @param slot Pointer to storage object. Must belong to one of the chunks.
+		 * @return Position in Chunks.
 		 */
-		std::vector<AlignedStorage<T>> Storage;
+		size_t FindChunk(const void* slot) const {
+			auto* storage = static_cast<const AlignedStorage<T>*>(slot);
+			auto next = std::upper_bound(Chunks.begin(), Chunks.end(), storage, std::less<>());
+			return static_cast<size_t>(next - Chunks.begin()) - 1;
+		}
 
 		/**
-		 * @brief Map of Entity Id to Component Id.
+		 * @brief Group active components by chunk into UpdateOrder and split the groups into batches.
 		 *
-		 * Key: Entity Id
-		 * Value: Component Id
+		 * Components order doesn't follow storage order, so neighbouring components in Components may sit in
+		 * different chunks and neighbouring storage objects may belong to different batches. Grouping by chunk
+		 * with a counting sort keeps every chunk inside a single batch.
+		 * @param count Number of active components.
+		 * @param batchSize Minimal number of components in a batch. Last batch may be smaller.
 		 */
-		std::unordered_map<size_t, size_t> IndexMap;
+		void BuildUpdateBatches(size_t count, size_t batchSize) {
+			// Chunks are only kept sorted by Shrink
+			UpdateChunks.assign(Chunks.begin(), Chunks.end());
+			std::sort(UpdateChunks.begin(), UpdateChunks.end(), std::less<>());
+			auto findChunk = [this](const T* component) {
+				auto* storage = reinterpret_cast<const AlignedStorage<T>*>(component);
+				auto next = std::upper_bound(UpdateChunks.begin(), UpdateChunks.end(), storage, std::less<>());
+				return static_cast<size_t>(next - UpdateChunks.begin()) - 1;
+			};
+
+			UpdateChunkEnds.assign(UpdateChunks.size(), 0);
+			for (size_t index = 0; index < count; ++index) {
+				++UpdateChunkEnds[findChunk(Components[index])];
+			}
+
+			// turn counts into starts of groups, scattering moves each start to the end of its group
+			size_t start = 0;
+			for (size_t& chunkEnd : UpdateChunkEnds) {
+				start += std::exchange(chunkEnd, start);
+			}
+			UpdateOrder.resize(count);
+			for (size_t index = 0; index < count; ++index) {
+				UpdateOrder[UpdateChunkEnds[findChunk(Components[index])]++] = Components[index];
+			}
+
+			UpdateBatchEnds.clear();
+			size_t batchStart = 0;
+			for (size_t chunkEnd : UpdateChunkEnds) {
+				if (chunkEnd - batchStart >= batchSize) {
+					UpdateBatchEnds.push_back(chunkEnd);
+					batchStart = chunkEnd;
+				}
+			}
+			if (batchStart < count) {
+				UpdateBatchEnds.push_back(count);
+			}
+		}
+
 		/**
-		 * @brief Map of Component Id to Entity Id
+		 * @brief Call function for every active component, as part of Update or FixedUpdate.
 		 *
-		 * Key: Component Id
-		 * Value Entity Id
+		 * Only the active range of Components is visited.
+		 *
+		 * Components of types declaring ParallelSafeUpdate are split into batches of at least
+		 * Config::PARALLEL_UPDATE_BATCH_SIZE components that run on the worker pool. Function returns after all
+		 * batches are finished. A batch covers whole chunks, so two workers never write to the same cache line.
+		 *
+		 * Memory defers creation and destruction of Components until all pools finished updating,
+		 * so Components don't change while they are iterated.
+		 * @param callback Function to call. Signature: void(T*)
 		 */
-		std::unordered_map<size_t, size_t> ReverseMap;
+		template <typename Callback>
+		void ForEachActiveInUpdate(Callback&& callback) {
+			const size_t count = ActiveCount;
+
+			if constexpr (T::ParallelSafeUpdate) {
+				static_assert(T::WorkerThreadSafe, "ParallelSafeUpdate Components must also be WorkerThreadSafe");
+
+				if (_workerPool != nullptr && _workerPool->GetThreadCount() > 0
+				    && count > Config::PARALLEL_UPDATE_BATCH_SIZE) {
+					// aim for a few batches per thread, so uneven components balance out
+					const size_t threads = _workerPool->GetThreadCount() + 1;
+					const size_t batchSize = std::max(Config::PARALLEL_UPDATE_BATCH_SIZE, count / (threads * 4));
+					BuildUpdateBatches(count, batchSize);
+
+					_workerPool->ParallelFor(UpdateBatchEnds.size(), [this, &callback](size_t batch) {
+						const size_t begin = batch > 0 ? UpdateBatchEnds[batch - 1] : 0;
+						for (size_t index = begin; index < UpdateBatchEnds[batch]; ++index) {
+							callback(UpdateOrder[index]);
+						}
+					});
+					return;
+				}
+			}
+
+			for (size_t index = 0; index < count; ++index) {
+				callback(Components[index]);
+			}
+		}
 	};
 }
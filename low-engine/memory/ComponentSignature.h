@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "EngineConfig.h"
+#include "memory/ComponentTypeId.h"
+
+namespace LowEngine::Memory {
+	/**
+	 * @brief Set of Component type ids, stored as a fixed-size bitmask.
+	 *
+	 * Every Entity carries a signature of the Component types attached to it, so checking whether an Entity owns
+	 * a Component is a single bit test and visiting its Components doesn't probe pools it isn't in.
+	 * Only ids lower than Config::MAX_COMPONENT_TYPES can be stored.
+	 */
+	class ComponentSignature {
+	public:
+		/**
+		 * @brief Number of bits in a single word of the mask.
+		 */
+		static constexpr size_t WORD_BITS = 64;
+
+		/**
+		 * @brief Number of words needed to hold Config::MAX_COMPONENT_TYPES bits.
+		 */
+		static constexpr size_t WORD_COUNT = (Config::MAX_COMPONENT_TYPES + WORD_BITS - 1) / WORD_BITS;
+
+		/**
+		 * @brief Add type to the signature.
+		 * @param typeId Id of the Component type.
+		 */
+		void Set(ComponentTypeId typeId) {
+			_words[typeId / WORD_BITS] |= uint64_t(1) << (typeId % WORD_BITS);
+		}
+
+		/**
+		 * @brief Remove type from the signature.
+		 * @param typeId Id of the Component type.
+		 */
+		void Reset(ComponentTypeId typeId) {
+			_words[typeId / WORD_BITS] &= ~(uint64_t(1) << (typeId % WORD_BITS));
+		}
+
+		/**
+		 * @brief Check if type is in the signature.
+		 * @param typeId Id of the Component type.
+		 * @return True if type is in the signature. Ids outside of the supported range are never in it.
+		 */
+		[[nodiscard]] bool Test(ComponentTypeId typeId) const {
+			if (typeId >= Config::MAX_COMPONENT_TYPES) {
+				return false;
+			}
+			return (_words[typeId / WORD_BITS] >> (typeId % WORD_BITS)) & 1;
+		}
+
+		/**
+		 * @brief Check if all types of other signature are also in this one.
+		 * @param other Signature to check.
+		 * @return True if this signature is a superset of other.
+		 */
+		[[nodiscard]] bool Contains(const ComponentSignature& other) const {
+			for (size_t word = 0; word < WORD_COUNT; ++word) {
+				if ((_words[word] & other._words[word]) != other._words[word]) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Remove all types from the signature.
+		 */
+		void Clear() {
+			_words.fill(0);
+		}
+
+		/**
+		 * @brief Check if signature holds no types.
+		 * @return True if signature is empty.
+		 */
+		[[nodiscard]] bool IsEmpty() const {
+			for (uint64_t word : _words) {
+				if (word != 0) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * @brief Call function for every type in the signature, in order of type ids.
+		 * @tparam Callback Type of a callback. Signature: void(ComponentTypeId)
+		 * @param callback Reference to a function that will be called.
+		 */
+		template <typename Callback>
+		void ForEach(Callback&& callback) const {
+			for (size_t word = 0; word < WORD_COUNT; ++word) {
+				uint64_t bits = _words[word];
+				while (bits != 0) {
+					auto bit = static_cast<ComponentTypeId>(std::countr_zero(bits));
+					callback(static_cast<ComponentTypeId>(word * WORD_BITS) + bit);
+					bits &= bits - 1;
+				}
+			}
+		}
+
+		bool operator==(const ComponentSignature& other) const = default;
+
+	private:
+		std::array<uint64_t, WORD_COUNT> _words{};
+	};
+}
@@ -0,0 +1,63 @@
+#include "ComponentTypeId.h"
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace LowEngine::Memory {
+	namespace {
+		/**
+		 * @brief Transparent string hash, so registry can be searched with std::string_view without allocation.
+		 */
+		struct TypeNameHash {
+			using is_transparent = void;
+
+			size_t operator()(std::string_view name) const {
+				return std::hash<std::string_view>{}(name);
+			}
+		};
+
+		struct RegistryData {
+			std::mutex Mutex;
+			/** @brief Names indexed by type id. Deque, so string_views pointing at names stay valid. */
+			std::deque<std::string> Names;
+			std::unordered_map<std::string_view, ComponentTypeId, TypeNameHash, std::equal_to<>> Ids;
+		};
+
+		RegistryData& GetRegistryData() {
+			static RegistryData data;
+			return data;
+		}
+	}
+
+	ComponentTypeId ComponentTypeRegistry::GetOrRegister(std::string_view typeName) {
+		RegistryData& data = GetRegistryData();
+		std::lock_guard lock(data.Mutex);
+
+		auto it = data.Ids.find(typeName);
+		if (it != data.Ids.end()) {
+			return it->second;
+		}
+
+		auto typeId = static_cast<ComponentTypeId>(data.Names.size());
+		const std::string& name = data.Names.emplace_back(typeName);
+		data.Ids.emplace(name, typeId);
+		return typeId;
+	}
+
+	ComponentTypeId ComponentTypeRegistry::Find(std::string_view typeName) {
+		RegistryData& data = GetRegistryData();
+		std::lock_guard lock(data.Mutex);
+
+		auto it = data.Ids.find(typeName);
+		return it != data.Ids.end() ? it->second : INVALID_COMPONENT_TYPE_ID;
+	}
+
+	std::string_view ComponentTypeRegistry::GetName(ComponentTypeId typeId) {
+		RegistryData& data = GetRegistryData();
+		std::lock_guard lock(data.Mutex);
+
+		return typeId < data.Names.size() ? std::string_view(data.Names[typeId]) : std::string_view();
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#include "utils/TypeName.h"
+
+namespace LowEngine::Memory {
+	/**
+	 * @brief Dense, process-wide identifier of a Component type.
+	 *
+	 * Ids are assigned in order of first use, starting from 0, so they can be used to index arrays.
+	 * Ids are not stable between runs. Use ComponentTypeName for anything that is saved.
+	 */
+	using ComponentTypeId = uint32_t;
+
+	/**
+	 * @brief Value used for "no Component type".
+	 */
+	inline constexpr ComponentTypeId INVALID_COMPONENT_TYPE_ID = std::numeric_limits<ComponentTypeId>::max();
+
+	/**
+	 * @brief Clean name of the Component type, resolved at compile time.
+	 *
+	 * This is the name used for the "Type" field of serialized Components.
+	 * @tparam T Type of the Component.
+	 */
+	template <typename T>
+	inline constexpr std::string_view ComponentTypeName = Utils::TypeName<T>();
+
+	/**
+	 * @brief Registry assigning Component type ids to Component type names.
+	 *
+	 * Registry lives in the engine library, so every module (engine, editor, game) gets the same id for the same
+	 * Component type. Lookups by name are hashed.
+	 */
+	class ComponentTypeRegistry {
+	public:
+		/**
+		 * @brief Retrieve id of the type with provided name. New id is assigned if name was not seen before.
+		 * @param typeName Clean name of the Component type.
+		 * @return Id of the type.
+		 */
+		static ComponentTypeId GetOrRegister(std::string_view typeName);
+
+		/**
+		 * @brief Retrieve id of the type with provided name.
+		 * @param typeName Clean name of the Component type.
+		 * @return Id of the type. Returns INVALID_COMPONENT_TYPE_ID if name was never registered.
+		 */
+		static ComponentTypeId Find(std::string_view typeName);
+
+		/**
+		 * @brief Retrieve name of the type with provided id.
+		 * @param typeId Id of the type.
+		 * @return Clean name of the Component type. Returns empty string if id was never assigned.
+		 */
+		static std::string_view GetName(ComponentTypeId typeId);
+	};
+
+	/**
+	 * @brief Retrieve id of the Component type.
+	 *
+	 * Id is resolved through ComponentTypeRegistry once per type and cached.
+	 * @tparam T Type of the Component.
+	 * @return Id of the type.
+	 */
+	template <typename T>
+	ComponentTypeId GetComponentTypeId() {
+		static_assert(!ComponentTypeName<T>.empty(), "Unable to resolve Component type name on this compiler");
+		static const ComponentTypeId id = ComponentTypeRegistry::GetOrRegister(ComponentTypeName<T>);
+		return id;
+	}
+}
@@ -1,80 +1,501 @@
 #include "Memory.h"
 
+#include <cstring>
+
 namespace LowEngine::Memory {
     Memory::Memory() {
         // do nothing
     }
 
-    Memory::Memory(Memory const& other) : _typeInfos(other._typeInfos) {
-        _nextTypeId = other._nextTypeId;
+    Memory::Memory(Memory const& other) : _entitySlots(other._entitySlots, &_arena),
+                                          _entitySignatures(other._entitySignatures, &_arena),
+                                          _freeEntitySlots(other._freeEntitySlots, &_arena),
+                                          _names(other._names, &_arena),
+                                          _entitiesByName(other._entitiesByName, &_arena),
+                                          _parkedNameUses(other._parkedNameUses, &_arena),
+                                          _prefabNames(other._prefabNames, &_arena),
+                                          _parkedEntities(other._parkedEntities, &_arena),
+                                          _entityPoolCapacities(other._entityPoolCapacities, &_arena),
+                                          _parkedEntityCount(other._parkedEntityCount),
+                                          _typeInfos(other._typeInfos),
+                                          _typeIdsByIndex(other._typeIdsByIndex),
+                                          _workerPool(other._workerPool),
+                                          _tick(other._tick),
+                                          _changedEntities(other._changedEntities, &_arena),
+                                          _changesTick(other._changesTick) {
+        // clone entities, keeping their slots and Ids
+        for (auto const& entity: other._entities) {
+            _entities.emplace_back(this, entity);
+            _entities.back().Id = entity.Id;
+        }
+
+        // clone components
+        _components.resize(other._components.size());
+        for (size_t typeId = 0; typeId < other._components.size(); ++typeId) {
+            if (other._components[typeId] != nullptr) {
+                _components[typeId] = other._components[typeId]->Clone(this, &_arena);
+                _components[typeId]->SetWorkerPool(_workerPool);
+            }
+        }
+    }
+
+    ECS::Entity* Memory::ActivateEntitySlot(uint32_t index, std::string_view name) {
+        return ActivateEntitySlot(index, _names.Intern(name));
+    }
+
+    ECS::Entity* Memory::ActivateEntitySlot(uint32_t index, NameId nameId) {
+        EntitySlot& slot = _entitySlots[index];
+        slot.Alive = true;
 
-        // clone entities
-        for (auto const& entPtr: other._entities) {
-            if (entPtr == nullptr) continue;
+        // Id is set first, activation marks the Entity it belongs to
+        ECS::Entity& entity = _entities[index];
+        entity.Id = ECS::MakeEntityId(index, slot.Generation);
+        entity.Activate();
+        LinkEntityName(index, nameId);
+        MarkSlotChanged(index);
+        return &entity;
+    }
 
-            _entities.emplace_back(
-                std::unique_ptr<ECS::IEntity>(entPtr->Clone(this))
-            );
-            _entities.back()->Id = _entities.size() - 1;
+    bool Memory::RenameEntity(size_t entityId, std::string_view name) {
+        if (!IsEntityValid(entityId)) {
+            _log->error("Entity id {} is not valid", entityId);
+            return false;
         }
 
-        // clone components
-        for (auto const& [typeIdx, poolPtr]: other._components) {
-            _components[typeIdx] = poolPtr->Clone(this);
+        uint32_t index = ECS::GetEntityIndex(entityId);
+        if (_entitySlots[index].Parked) {
+            // parked Entity gets its name when it's spawned again
+            _log->error("Entity id {} is parked and can't be renamed", entityId);
+            return false;
         }
+        if (_names.GetName(_entitySlots[index].Name) == name) {
+            return true;
+        }
+
+        UnlinkEntityName(index);
+        LinkEntityName(index, name);
+        MarkSlotChanged(index);
+        return true;
     }
 
-    void Memory::UpdateAllComponents(float deltaTime) {
-        for (auto& component: _components) {
-            component.second->Update(deltaTime);
+    void Memory::DespawnEntity(size_t entityId) {
+        if (!IsEntityValid(entityId)) {
+            _log->error("Entity id {} is not valid", entityId);
+            return;
         }
+
+        if (_isUpdating) {
+            GetCommandBuffer().DespawnEntity(entityId);
+            return;
+        }
+
+        uint32_t index = ECS::GetEntityIndex(entityId);
+        EntitySlot& slot = _entitySlots[index];
+        if (slot.Parked) {
+            return;
+        }
+
+        if (slot.Prefab == INVALID_NAME_ID || _parkedEntities[slot.Prefab].size() >= _entityPoolCapacities[slot.Prefab]) {
+            DestroyEntity(&_entities[index]);
+            return;
+        }
+
+        _entitySignatures[index].ForEach([this, entityId](ComponentTypeId typeId) {
+            _components[typeId]->Park(entityId);
+        });
+
+        // name is kept for the next spawn, but parked Entity isn't found by it
+        RemoveFromNameList(index);
+        _parkedNameUses[slot.Name]++;
+        _entities[index].SetActive(false);
+        slot.Parked = true;
+        slot.PoolPosition = static_cast<uint32_t>(_parkedEntities[slot.Prefab].size());
+        _parkedEntities[slot.Prefab].push_back(index);
+        _parkedEntityCount++;
+        // parked Entities aren't saved
+        MarkSlotChanged(index);
     }
 
-    void Memory::FixedUpdateAllComponents(float fixedDeltaTime) {
-        for (auto& component: _components) {
-            component.second->FixedUpdate(fixedDeltaTime);
+    void Memory::SetEntityPoolCapacity(std::string_view prefab, size_t capacity) {
+        if (_isUpdating) {
+            _log->error("Entity pool capacity of prefab '{}' can't be changed during update.", prefab);
+            return;
+        }
+
+        NameId poolId = GetEntityPoolId(prefab);
+        _entityPoolCapacities[poolId] = capacity;
+
+        auto& parked = _parkedEntities[poolId];
+        while (parked.size() > capacity) {
+            DestroyEntity(&_entities[parked.back()]);
         }
+        // despawning never allocates
+        parked.reserve(capacity);
     }
 
-    nlohmann::ordered_json Memory::SerializeAllEntitiesToJSON() {
-        nlohmann::ordered_json entitiesJson = nlohmann::ordered_json::array();
-        for (const auto& entity: _entities) {
-            if (entity != nullptr) {
-                entitiesJson.push_back(entity->SerializeToJSON());
+    size_t Memory::GetParkedEntityCount(std::string_view prefab) const {
+        NameId poolId = _prefabNames.Find(prefab);
+        return poolId != INVALID_NAME_ID ? _parkedEntities[poolId].size() : 0;
+    }
+
+    NameId Memory::GetEntityPoolId(std::string_view prefab) {
+        NameId poolId = _prefabNames.Intern(prefab);
+        if (poolId >= _parkedEntities.size()) {
+            _parkedEntities.resize(poolId + 1);
+            _entityPoolCapacities.resize(poolId + 1, 0);
+        }
+        return poolId;
+    }
+
+    ECS::Entity* Memory::ReuseParkedEntity(std::string_view prefab, std::string_view name) {
+        NameId poolId = _prefabNames.Find(prefab);
+        if (poolId == INVALID_NAME_ID || _parkedEntities[poolId].empty()) {
+            return nullptr;
+        }
+
+        uint32_t index = _parkedEntities[poolId].back();
+        _parkedEntities[poolId].pop_back();
+        _parkedEntityCount--;
+        EntitySlot& slot = _entitySlots[index];
+        slot.Parked = false;
+
+        NameId keptName = slot.Name;
+        _parkedNameUses[keptName]--;
+        if (_names.GetName(keptName) == name) {
+            LinkEntityName(index, keptName);
+        } else {
+            ReleaseEntityName(keptName);
+            LinkEntityName(index, name);
+        }
+
+        ECS::Entity& entity = _entities[index];
+        entity.Activate();
+        MarkSlotChanged(index);
+
+        size_t entityId = entity.Id;
+        _entitySignatures[index].ForEach([this, entityId](ComponentTypeId typeId) {
+            _components[typeId]->Reuse(entityId);
+        });
+        return &entity;
+    }
+
+    void Memory::TakeParkedEntity(uint32_t index) {
+        EntitySlot& slot = _entitySlots[index];
+
+        // move the last parked Entity into the freed position
+        auto& parked = _parkedEntities[slot.Prefab];
+        uint32_t last = parked.back();
+        parked[slot.PoolPosition] = last;
+        _entitySlots[last].PoolPosition = slot.PoolPosition;
+        parked.pop_back();
+        slot.Parked = false;
+        slot.PoolPosition = 0;
+        _parkedEntityCount--;
+
+        _parkedNameUses[slot.Name]--;
+        ReleaseEntityName(slot.Name);
+        slot.Name = INVALID_NAME_ID;
+    }
+
+    void Memory::LinkEntityName(uint32_t index, std::string_view name) {
+        LinkEntityName(index, _names.Intern(name));
+    }
+
+    void Memory::LinkEntityName(uint32_t index, NameId nameId) {
+        GrowNameLookups(nameId);
+
+        auto& entities = _entitiesByName[nameId];
+        EntitySlot& slot = _entitySlots[index];
+        slot.Name = nameId;
+        slot.NamePosition = static_cast<uint32_t>(entities.size());
+        entities.push_back(_entities[index].Id);
+    }
+
+    void Memory::UnlinkEntityName(uint32_t index) {
+        EntitySlot& slot = _entitySlots[index];
+        RemoveFromNameList(index);
+        ReleaseEntityName(slot.Name);
+        slot.Name = INVALID_NAME_ID;
+    }
+
+    void Memory::RemoveFromNameList(uint32_t index) {
+        EntitySlot& slot = _entitySlots[index];
+        auto& entities = _entitiesByName[slot.Name];
+
+        // move the last Entity with this name into the freed position
+        size_t last = entities.back();
+        entities[slot.NamePosition] = last;
+        _entitySlots[ECS::GetEntityIndex(last)].NamePosition = slot.NamePosition;
+        entities.pop_back();
+        slot.NamePosition = 0;
+    }
+
+    void Memory::ReleaseEntityName(NameId nameId) {
+        auto& entities = _entitiesByName[nameId];
+        if (entities.empty() && _parkedNameUses[nameId] == 0) {
+            entities.shrink_to_fit();
+            _names.Erase(nameId);
+        }
+    }
+
+    void Memory::GrowNameLookups(NameId nameId) {
+        if (nameId >= _entitiesByName.size()) {
+            _entitiesByName.resize(nameId + 1);
+            _parkedNameUses.resize(nameId + 1, 0);
+        }
+    }
+
+    std::vector<size_t> Memory::CreateEntities(size_t count, const std::string& name) {
+        std::vector<size_t> entityIds;
+        if (_isUpdating) {
+            _log->error("{} entities can't be created during update. Use command buffer instead.", count);
+            return entityIds;
+        }
+
+        size_t reused = std::min(count, _freeEntitySlots.size());
+        size_t appended = count - reused;
+        if (_entitySlots.size() + appended > Config::MAX_ENTITY_COUNT) {
+            _log->error("Failed to create {} entities. Entity limit reached.", count);
+            return entityIds;
+        }
+
+        if (count == 0) {
+            return entityIds;
+        }
+
+        // all Entities share the name, intern it once and grow lookups once for the whole batch
+        NameId nameId = _names.Intern(name);
+        GrowNameLookups(nameId);
+        _entitiesByName[nameId].reserve(_entitiesByName[nameId].size() + count);
+        _changedEntities.reserve(_changedEntities.size() + count);
+
+        entityIds.reserve(count);
+        for (size_t i = 0; i < reused; ++i) {
+            uint32_t index = _freeEntitySlots.back();
+            _freeEntitySlots.pop_back();
+            entityIds.push_back(ActivateEntitySlot(index, nameId)->Id);
+        }
+
+        // appended slots are new, so they are filled in directly instead of going through ActivateEntitySlot
+        auto firstAppended = static_cast<uint32_t>(_entitySlots.size());
+        _entitySlots.reserve(_entitySlots.size() + appended);
+        _entitySignatures.resize(_entitySlots.size() + appended);
+        auto& named = _entitiesByName[nameId];
+        for (size_t i = 0; i < appended; ++i) {
+            uint32_t index = firstAppended + static_cast<uint32_t>(i);
+            EntitySlot& slot = _entitySlots.emplace_back();
+            slot.Alive = true;
+            slot.Name = nameId;
+            slot.NamePosition = static_cast<uint32_t>(named.size());
+            slot.Changed = true;
+
+            ECS::Entity& entity = _entities.emplace_back(this);
+            entity.Id = ECS::MakeEntityId(index, slot.Generation);
+            entity.Activate();
+
+            named.push_back(entity.Id);
+            _changedEntities.push_back(index);
+            entityIds.push_back(entity.Id);
+        }
+
+        _log->debug("{} entities created", count);
+        return entityIds;
+    }
+
+    ECS::Entity* Memory::CreateEntityWithId(size_t entityId, std::string_view name) {
+        uint32_t index = ECS::GetEntityIndex(entityId);
+        // checked before growing storage, so a corrupted Id doesn't allocate every slot up to its index
+        if (index >= Config::MAX_ENTITY_COUNT) {
+            _log->error("Entity id {} is not valid. Index {} exceeds the entity limit.", entityId, index);
+            return nullptr;
+        }
+
+        if (index < _entitySlots.size()) {
+            if (_entitySlots[index].Alive) {
+                _log->error("Cannot create entity with id {}. Slot is already taken.", entityId);
+                return nullptr;
+            }
+            std::erase(_freeEntitySlots, index);
+        } else {
+            // slots skipped over become free
+            for (auto i = static_cast<uint32_t>(_entitySlots.size()); i < index; ++i) {
+                _entitySlots.emplace_back();
+                _entitySignatures.emplace_back();
+                _entities.emplace_back(this);
+                _freeEntitySlots.push_back(i);
+            }
+            _entitySlots.emplace_back();
+            _entitySignatures.emplace_back();
+            _entities.emplace_back(this);
+        }
+
+        _entitySlots[index].Generation = ECS::GetEntityGeneration(entityId);
+        return ActivateEntitySlot(index, name);
+    }
+
+    const UpdateSchedule& Memory::GetUpdateSchedule() {
+        RebuildPhases();
+        return _updateSchedule;
+    }
+
+    const UpdateSchedule& Memory::GetFixedUpdateSchedule() {
+        RebuildPhases();
+        return _fixedUpdateSchedule;
+    }
+
+    void Memory::RebuildPhases() {
+        if (!_updateScheduleDirty) {
+            return;
+        }
+
+        // pools take part only in phases their Component type overrides
+        std::vector<UpdateSchedule::PoolAccess> updatePools;
+        std::vector<UpdateSchedule::PoolAccess> fixedUpdatePools;
+        _drawPools.clear();
+        _drawDirectPools.clear();
+        for (ComponentTypeId typeId = 0; typeId < _components.size(); ++typeId) {
+            if (_components[typeId] == nullptr) continue;
+
+            const TypeInfo& typeInfo = _typeInfos[typeId];
+            UpdateSchedule::PoolAccess access = {
+                typeId, typeInfo.TypeName, typeInfo.Dependencies, typeInfo.Reads, typeInfo.Writes,
+                typeInfo.DependenciesReadOnly, typeInfo.WorkerThreadSafe
+            };
+            if (typeInfo.HasUpdate) updatePools.push_back(access);
+            if (typeInfo.HasFixedUpdate) fixedUpdatePools.push_back(access);
+            if (typeInfo.HasDraw) _drawPools.push_back(typeId);
+            if (typeInfo.HasDrawDirect) _drawDirectPools.push_back(typeId);
+        }
+
+        _updateSchedule.Build(updatePools);
+        _fixedUpdateSchedule.Build(fixedUpdatePools);
+        _updateScheduleDirty = false;
+    }
+
+    void Memory::RunScheduled(const UpdateSchedule& schedule, const std::function<void(IComponentPool&)>& callback) {
+        // Components mark their Entities changed while updating, the lists can't allocate from the arena then
+        _changedEntities.reserve(_entitySlots.size());
+        for (auto& pool: _components) {
+            if (pool != nullptr) {
+                pool->PrepareChangeLog();
+            }
+        }
+        for (const auto& stage: schedule.GetStages()) {
+            if (_workerPool == nullptr) {
+                for (ComponentTypeId typeId: stage.MainThread) {
+                    callback(*_components[typeId]);
+                }
+                for (ComponentTypeId typeId: stage.Workers) {
+                    callback(*_components[typeId]);
+                }
+                continue;
+            }
+
+            auto batch = _workerPool->Submit(stage.Workers.size(), [this, &stage, &callback](size_t index) {
+                callback(*_components[stage.Workers[index]]);
+            });
+            for (ComponentTypeId typeId: stage.MainThread) {
+                callback(*_components[typeId]);
+            }
+            _workerPool->Wait(batch);
+        }
+    }
+
+    CommandBuffer& Memory::GetCommandBuffer() {
+        std::lock_guard lock(_commandBuffersMutex);
+
+        std::thread::id threadId = std::this_thread::get_id();
+        for (auto& [ownerId, buffer]: _commandBuffers) {
+            if (ownerId == threadId) {
+                return *buffer;
+            }
+        }
+
+        return *_commandBuffers.emplace_back(threadId, std::make_unique<CommandBuffer>()).second;
+    }
+
+    void Memory::PlaybackCommands() {
+        // playback may record new commands and add buffers, so iterate by index
+        for (size_t index = 0; index < _commandBuffers.size(); ++index) {
+            CommandBuffer* buffer;
+            {
+                std::lock_guard lock(_commandBuffersMutex);
+                buffer = _commandBuffers[index].second.get();
             }
+            buffer->Playback(*this);
         }
+    }
+
+    void Memory::UpdateAllComponents(float deltaTime) {
+        _tick++;
+        _isUpdating = true;
+        RunScheduled(GetUpdateSchedule(), [deltaTime](IComponentPool& pool) {
+            pool.Update(deltaTime);
+        });
+        _isUpdating = false;
+
+        PlaybackCommands();
+    }
+
+    void Memory::FixedUpdateAllComponents(float fixedDeltaTime) {
+        _isUpdating = true;
+        RunScheduled(GetFixedUpdateSchedule(), [fixedDeltaTime](IComponentPool& pool) {
+            pool.FixedUpdate(fixedDeltaTime);
+        });
+        _isUpdating = false;
+
+        PlaybackCommands();
+    }
+
+    nlohmann::ordered_json Memory::SerializeAllEntitiesToJSON() {
+        nlohmann::ordered_json entitiesJson = nlohmann::ordered_json::array();
+        ForEachEntity([&entitiesJson](ECS::Entity& entity) {
+            entitiesJson.push_back(entity.SerializeToJSON());
+        });
 
         return entitiesJson;
     }
 
-    nlohmann::ordered_json Memory::SerializeAllComponentsToJSON() {
+    std::vector<ComponentTypeId> Memory::GetSerializationOrder() const {
         // Serialize pools in dependency order (DFS topological sort) so that
         // deserialization can recreate components without missing dependencies.
-        std::vector<std::type_index> sorted;
-        std::unordered_map<std::type_index, bool> visited;
-
-        std::function<void(const std::type_index&)> visit = [&](const std::type_index& typeIdx) {
-            if (visited[typeIdx]) return;
-            visited[typeIdx] = true;
-
-            if (_typeInfos.contains(typeIdx)) {
-                for (const auto& dep: _typeInfos.at(typeIdx).Dependencies) {
-                    if (_components.contains(dep)) {
-                        visit(dep);
-                    }
+        std::vector<ComponentTypeId> sorted;
+        std::vector<bool> visited(_components.size(), false);
+
+        std::function<void(ComponentTypeId)> visit = [&](ComponentTypeId typeId) {
+            if (visited[typeId]) return;
+            visited[typeId] = true;
+
+            for (ComponentTypeId dep: _typeInfos[typeId].Dependencies) {
+                if (GetPool(dep) != nullptr) {
+                    visit(dep);
                 }
             }
 
-            sorted.push_back(typeIdx);
+            sorted.push_back(typeId);
         };
 
-        for (const auto& [type, pool]: _components) {
-            visit(type);
+        for (ComponentTypeId typeId = 0; typeId < _components.size(); ++typeId) {
+            if (_components[typeId] != nullptr) {
+                visit(typeId);
+            }
         }
 
+        return sorted;
+    }
+
+    nlohmann::ordered_json Memory::SerializeAllComponentsToJSON() {
         nlohmann::ordered_json componentsJson = nlohmann::ordered_json::array();
-        for (const auto& typeIdx: sorted) {
-            componentsJson.push_back(_components.at(typeIdx)->SerializeToJSON());
+        for (ComponentTypeId typeId: GetSerializationOrder()) {
+            nlohmann::ordered_json poolJson = _components[typeId]->SerializeToJSON();
+            if (_parkedEntityCount > 0) {
+                // parked Entities aren't saved, neither are their Components
+                std::erase_if(poolJson.get_ref<nlohmann::ordered_json::array_t&>(),
+                              [this](const nlohmann::ordered_json& componentJson) {
+                                  return IsEntityParked(componentJson["EntityId"].get<size_t>());
+                              });
+            }
+            componentsJson.push_back(std::move(poolJson));
         }
 
         return componentsJson;
@@ -82,19 +503,9 @@ namespace LowEngine::Memory {
 
     bool Memory::DeserializeAllComponentsFromJSON(const nlohmann::ordered_json& jsonData) {
         for (const auto& componentsJson: jsonData) {
-            for (int i = 0; i < componentsJson.size(); ++i) {
-                auto& componentJson = componentsJson[i];
-                size_t entityId = componentJson["EntityId"];
-                std::string typeName = componentJson["Type"];
-                for (auto& typeInfoPair: _typeInfos) {
-                    const TypeInfo& typeInfo = typeInfoPair.second;
-                    if (typeInfo.TypeName == typeName) {
-                        if (!typeInfo.DeserializeFromJSON(entityId, componentJson)) {
-                            _log->error("Failed to deserialize component of type '{}' for entity with id '{}'",
-                                        typeName, entityId);
-                            return false;
-                        }
-                    }
+            for (const auto& componentJson: componentsJson) {
+                if (!DeserializeComponentFromJSON(componentJson)) {
+                    return false;
                 }
             }
         }
@@ -102,23 +513,362 @@ namespace LowEngine::Memory {
         return true;
     }
 
+    bool Memory::DeserializeComponentFromJSON(const nlohmann::ordered_json& componentJson) {
+        size_t entityId = componentJson["EntityId"];
+        const auto& typeName = componentJson["Type"].get_ref<const std::string&>();
+
+        ComponentTypeId typeId = ComponentTypeRegistry::Find(typeName);
+        if (typeId >= _typeInfos.size() || !_typeInfos[typeId].IsRegistered()) {
+            _log->warn("Component type '{}' is not registered. Component for entity with id '{}' skipped.",
+                       typeName, entityId);
+            return true;
+        }
+
+        if (!_typeInfos[typeId].DeserializeFromJSON(*this, entityId, componentJson)) {
+            _log->error("Failed to deserialize component of type '{}' for entity with id '{}'",
+                        typeName, entityId);
+            return false;
+        }
+        return true;
+    }
+
+    void Memory::SerializeAllEntitiesToBinary(Utils::BinaryWriter& out) {
+        out.Write(static_cast<uint64_t>(GetEntityCount() - _parkedEntityCount));
+        ForEachEntity([&out](ECS::Entity& entity) {
+            out.Write(static_cast<uint64_t>(entity.Id));
+            out.Write(static_cast<uint8_t>(entity.IsActive()));
+            out.WriteString(entity.GetName());
+        });
+    }
+
+    bool Memory::DeserializeAllEntitiesFromBinary(Utils::BinaryReader& in) {
+        uint64_t count = 0;
+        if (!in.Read(count)) {
+            _log->error("Entities are truncated");
+            return false;
+        }
+        ReserveEntities(std::min<uint64_t>(count, in.GetRemaining()));
+
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t entityId = 0;
+            uint8_t active = 0;
+            std::string_view name;
+            if (!in.Read(entityId) || !in.Read(active) || !in.ReadString(name)) {
+                _log->error("Entities are truncated");
+                return false;
+            }
+
+            ECS::Entity* entity = CreateEntityWithId(entityId, name);
+            if (entity == nullptr) {
+                _log->error("Failed to create entity during deserialization");
+                return false;
+            }
+            entity->SetActive(active != 0);
+        }
+
+        return true;
+    }
+
+    void Memory::SerializeComponentsToBinary(ComponentTypeId typeId, Utils::BinaryWriter& out) {
+        out.WriteString(_typeInfos[typeId].TypeName);
+        if (_parkedEntityCount > 0) {
+            // parked Entities aren't saved, neither are their Components
+            _components[typeId]->WriteBinary(out, [this](size_t entityId) {
+                return IsEntityParked(entityId);
+            });
+        } else {
+            _components[typeId]->WriteBinary(out, nullptr);
+        }
+    }
+
+    bool Memory::DeserializeComponentsFromBinary(Utils::BinaryReader& in) {
+        std::string_view typeName;
+        if (!in.ReadString(typeName)) {
+            _log->error("Components are truncated");
+            return false;
+        }
+
+        ComponentTypeId typeId = ComponentTypeRegistry::Find(typeName);
+        if (typeId >= _typeInfos.size() || !_typeInfos[typeId].IsRegistered()) {
+            _log->warn("Component type '{}' is not registered. Its components were skipped.", typeName);
+            return true;
+        }
+
+        return _typeInfos[typeId].DeserializeFromBinary(*this, in);
+    }
+
+    void Memory::ClearChanges() {
+        for (uint32_t index: _changedEntities) {
+            _entitySlots[index].Changed = false;
+        }
+        _changedEntities.clear();
+        // changes made from now on get a newer tick than the saved ones
+        _changesTick = ++_tick;
+    }
+
+    bool Memory::CanSerializeChanges() const {
+        for (ComponentTypeId typeId = 0; typeId < _components.size(); ++typeId) {
+            if (_components[typeId] != nullptr && !_typeInfos[typeId].TracksChanges
+                && _components[typeId]->GetSize() > 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<size_t> Memory::GetChangedEntityIds() const {
+        std::vector<size_t> entityIds;
+        entityIds.reserve(_changedEntities.size());
+        for (uint32_t index: _changedEntities) {
+            const EntitySlot& slot = _entitySlots[index];
+            if (slot.Alive && !slot.Parked) {
+                entityIds.push_back(_entities[index].Id);
+            }
+        }
+        return entityIds;
+    }
+
+    void Memory::SerializeEntityChangesToBinary(Utils::BinaryWriter& out) {
+        std::vector<uint32_t> removedIndices;
+        for (uint32_t index: _changedEntities) {
+            const EntitySlot& slot = _entitySlots[index];
+            if (!slot.Alive || slot.Parked) {
+                removedIndices.push_back(index);
+            }
+        }
+        out.Write(static_cast<uint64_t>(removedIndices.size()));
+        for (uint32_t index: removedIndices) {
+            out.Write(index);
+        }
+
+        std::vector<size_t> entityIds = GetChangedEntityIds();
+        out.Write(static_cast<uint64_t>(entityIds.size()));
+        for (size_t entityId: entityIds) {
+            const ECS::Entity& entity = _entities[ECS::GetEntityIndex(entityId)];
+            out.Write(static_cast<uint64_t>(entity.Id));
+            out.Write(static_cast<uint8_t>(entity.IsActive()));
+            out.WriteString(GetEntityName(entityId));
+        }
+    }
+
+    bool Memory::DeserializeEntityChangesFromBinary(Utils::BinaryReader& in) {
+        uint64_t count = 0;
+        if (!in.Read(count)) {
+            _log->error("Entity changes are truncated");
+            return false;
+        }
+        for (uint64_t i = 0; i < count; ++i) {
+            uint32_t index = 0;
+            if (!in.Read(index)) {
+                _log->error("Entity changes are truncated");
+                return false;
+            }
+            // slots of Entities created and removed between two saves are empty already
+            if (index < _entitySlots.size() && _entitySlots[index].Alive) {
+                DestroyEntity(&_entities[index]);
+            }
+        }
+
+        if (!in.Read(count)) {
+            _log->error("Entity changes are truncated");
+            return false;
+        }
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t entityId = 0;
+            uint8_t active = 0;
+            std::string_view name;
+            if (!in.Read(entityId) || !in.Read(active) || !in.ReadString(name)) {
+                _log->error("Entity changes are truncated");
+                return false;
+            }
+
+            ECS::Entity* entity;
+            uint32_t index = ECS::GetEntityIndex(entityId);
+            if (IsEntityValid(entityId) && !IsEntityParked(entityId)) {
+                // Components are recreated by the blocks that follow
+                entity = &_entities[index];
+                ComponentSignature& signature = _entitySignatures[index];
+                signature.ForEach([this, entityId](ComponentTypeId typeId) {
+                    _components[typeId]->DestroyComponent(entityId);
+                });
+                signature.Clear();
+                RenameEntity(entityId, name);
+            } else {
+                if (index < _entitySlots.size() && _entitySlots[index].Alive) {
+                    // slot was reused by the saved Entity
+                    DestroyEntity(&_entities[index]);
+                }
+                entity = CreateEntityWithId(entityId, name);
+                if (entity == nullptr) {
+                    _log->error("Failed to create entity while applying changes");
+                    return false;
+                }
+            }
+            entity->SetActive(active != 0);
+        }
+
+        return true;
+    }
+
+    void Memory::SerializeComponentChangesToBinary(ComponentTypeId typeId, Utils::BinaryWriter& out) {
+        out.WriteString(_typeInfos[typeId].TypeName);
+        _components[typeId]->WriteBinary(out, GetChangedEntityIds());
+    }
+
+    bool Memory::WriteSnapshot(std::vector<std::byte>& out, std::span<const ComponentTypeId> typeIds) {
+        // layout: pool count, then for each pool: type id, record size, record count and records
+        out.clear();
+        auto append = [&out](const auto& value) {
+            size_t offset = out.size();
+            out.resize(offset + sizeof(value));
+            std::memcpy(out.data() + offset, &value, sizeof(value));
+        };
+
+        append(static_cast<uint32_t>(typeIds.size()));
+        for (ComponentTypeId typeId: typeIds) {
+            IComponentPool* pool = GetPool(typeId);
+            if (pool == nullptr) {
+                _log->error("Snapshot failed: Component type {} not found", ComponentTypeRegistry::GetName(typeId));
+                return false;
+            }
+
+            auto recordSize = static_cast<uint32_t>(pool->GetSnapshotRecordSize());
+            if (recordSize == 0) {
+                _log->error("Snapshot failed: Component type {} doesn't support snapshots",
+                            ComponentTypeRegistry::GetName(typeId));
+                return false;
+            }
+
+            append(static_cast<uint32_t>(typeId));
+            append(recordSize);
+            size_t countOffset = out.size();
+            append(uint64_t(0));
+
+            auto count = static_cast<uint64_t>(pool->WriteSnapshot(out));
+            std::memcpy(out.data() + countOffset, &count, sizeof(count));
+        }
+
+        return true;
+    }
+
+    bool Memory::ReadSnapshot(std::span<const std::byte> snapshot) {
+        size_t offset = 0;
+        auto read = [&snapshot, &offset](auto& value) {
+            if (offset + sizeof(value) > snapshot.size()) {
+                return false;
+            }
+            std::memcpy(&value, snapshot.data() + offset, sizeof(value));
+            offset += sizeof(value);
+            return true;
+        };
+
+        uint32_t poolCount = 0;
+        if (!read(poolCount)) {
+            _log->error("Snapshot restore failed: snapshot is empty");
+            return false;
+        }
+
+        // check every pool first, so a rejected snapshot leaves all Components as they are
+        struct PoolRecords {
+            IComponentPool* Pool;
+            const std::byte* Records;
+            size_t Count;
+        };
+        std::vector<PoolRecords> pools;
+        pools.reserve(poolCount);
+
+        for (uint32_t poolIndex = 0; poolIndex < poolCount; ++poolIndex) {
+            uint32_t typeId = 0;
+            uint32_t recordSize = 0;
+            uint64_t count = 0;
+            if (!read(typeId) || !read(recordSize) || !read(count) || count * recordSize > snapshot.size() - offset) {
+                _log->error("Snapshot restore failed: snapshot is truncated");
+                return false;
+            }
+
+            IComponentPool* pool = GetPool(typeId);
+            if (pool == nullptr || pool->GetSnapshotRecordSize() != recordSize) {
+                _log->error("Snapshot restore failed: snapshot doesn't match Component type {}",
+                            ComponentTypeRegistry::GetName(typeId));
+                return false;
+            }
+
+            if (!pool->MatchesSnapshot(snapshot.data() + offset, count)) {
+                _log->error("Snapshot restore failed: Components of type {} were created or destroyed since snapshot",
+                            ComponentTypeRegistry::GetName(typeId));
+                return false;
+            }
+
+            pools.push_back({pool, snapshot.data() + offset, count});
+            offset += count * recordSize;
+        }
+
+        for (const PoolRecords& pool: pools) {
+            pool.Pool->ReadSnapshot(pool.Records, pool.Count);
+        }
+
+        return true;
+    }
+
+    std::vector<PoolStats> Memory::GetPoolStats() const {
+        std::vector<PoolStats> stats;
+        for (size_t typeId = 0; typeId < _components.size(); ++typeId) {
+            if (_components[typeId] != nullptr) {
+                PoolStats& poolStats = stats.emplace_back(_components[typeId]->GetStats());
+                poolStats.TypeId = static_cast<ComponentTypeId>(typeId);
+            }
+        }
+        return stats;
+    }
+
+    void Memory::ShrinkToFit() {
+        if (_isUpdating) {
+            _log->error("Memory can't be shrunk during update.");
+            return;
+        }
+
+        for (auto& pool: _components) {
+            if (pool != nullptr) {
+                pool->ShrinkToFit();
+            }
+        }
+        _freeEntitySlots.shrink_to_fit();
+    }
+
     void Memory::CollectDrawables(std::vector<SceneDrawable>& drawables) {
-        for (auto& [type, pool]: _components) {
-            pool->CollectDrawables(drawables);
+        RebuildPhases();
+        for (ComponentTypeId typeId: _drawPools) {
+            _components[typeId]->CollectDrawables(drawables);
         }
     }
 
     void Memory::DrawDirect(sf::RenderTarget& target) {
-        for (auto& [type, pool]: _components) {
-            pool->DrawDirect(target);
+        RebuildPhases();
+        for (ComponentTypeId typeId: _drawDirectPools) {
+            _components[typeId]->DrawDirect(target);
         }
     }
 
     void Memory::Destroy() {
         _entities.clear();
-        for (auto& component: _components) {
-            component.second.reset();
+        _entitySlots.clear();
+        _entitySignatures.clear();
+        _freeEntitySlots.clear();
+        _names.Clear();
+        _entitiesByName.clear();
+        _parkedNameUses.clear();
+        for (auto& parked: _parkedEntities) {
+            parked.clear();
+        }
+        _parkedEntityCount = 0;
+        _changedEntities.clear();
+        for (auto& pool: _components) {
+            pool.reset();
         }
         _components.clear();
+        _updateScheduleDirty = true;
+
+        std::lock_guard lock(_commandBuffersMutex);
+        _commandBuffers.clear();
     }
 }
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory_resource>
+#include <span>
 #include <string>
 #include <typeindex>
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include <mutex>
+#include <thread>
 
 #ifdef _MSC_VER
 #include <cstdlib>
@@ -19,10 +27,20 @@
 #include "box2d/id.h"
 
 #include "../log/Log.h"
-#include "ecs/IEntity.h"
+#include "ecs/Entity.h"
+#include "memory/ArenaResource.h"
+#include "ecs/EntityId.h"
+#include "memory/CommandBuffer.h"
 #include "memory/ComponentPool.h"
+#include "memory/ComponentSignature.h"
+#include "memory/ComponentTypeId.h"
+#include "memory/NameTable.h"
+#include "memory/UpdateSchedule.h"
+#include "memory/View.h"
 #include "graphics/Sprite.h"
+#include "utils/BinaryStream.h"
 #include "utils/TypeName.h"
+#include "threading/WorkerPool.h"
 
 namespace LowEngine::Memory {
 	/**
@@ -31,6 +49,9 @@ namespace LowEngine::Memory {
 	 * The Memory class provides mechanisms to create, manage, and access entities and their components.
 	 * It supports component pools, type information tracking, and dependency checks
 	 * during component creation.
+	 *
+	 * Entity records and Component Pool storage are allocated from an arena owned by the Memory manager, so
+	 * destroying a scene hands its memory back in bulk, and allocation statistics are available per scene.
 	 */
 	class Memory {
 	public:
@@ -41,12 +62,29 @@ namespace LowEngine::Memory {
 		 */
 		struct TypeInfo {
 			std::string Name = "";
-			unsigned int Id = 0;
+			ComponentTypeId Id = INVALID_COMPONENT_TYPE_ID;
 			std::type_index TypeIndex = std::type_index(typeid(void));
-			std::string TypeName = "";
+			std::string_view TypeName = "";
 			size_t Size = 0;
-			std::vector<std::type_index> Dependencies;
-			std::function<bool(size_t, const nlohmann::ordered_json&)> DeserializeFromJSON = nullptr;
+			std::vector<ComponentTypeId> Dependencies;
+			std::vector<ComponentTypeId> Reads;
+			std::vector<ComponentTypeId> Writes;
+			bool DependenciesReadOnly = false;
+			bool WorkerThreadSafe = false;
+			bool TracksChanges = false;
+			bool HasUpdate = false;
+			bool HasFixedUpdate = false;
+			bool HasDraw = false;
+			bool HasDrawDirect = false;
+			bool (*DeserializeFromJSON)(Memory& memory, size_t entityId, const nlohmann::ordered_json& json) = nullptr;
+			bool (*DeserializeFromBinary)(Memory& memory, Utils::BinaryReader& in) = nullptr;
+
+			/**
+			 * @brief Was the type registered in this Memory manager?
+			 */
+			[[nodiscard]] bool IsRegistered() const {
+				return Id != INVALID_COMPONENT_TYPE_ID;
+			}
 		};
 
 		/**
@@ -71,25 +109,59 @@ namespace LowEngine::Memory {
 
 		/**
 		 * @brief Creates new Entity object.
-		 * @tparam T Type of Entity. Must extend IEntity
+		 *
+		 * Entity is placed in the first free slot. Slots of destroyed Entities are reused, with their generation
+		 * increased, so Ids issued before the slot was freed remain invalid.
+		 * Entities can't be created while Components are being updated. Use GetCommandBuffer().CreateEntity() instead.
+		 * @tparam T Type of Entity. Entities are stored by value, so this must be ECS::Entity
 		 * @param name Name of this new Entity
-		 * @return Pointer to new Entity. Returns nullptr in case of error.
+		 * @return Pointer to new Entity. Pointer stays valid until Entity is destroyed. Returns nullptr in case of error.
 		 */
 		template <typename T>
 		T* CreateEntity(const std::string& name) {
-			std::unique_ptr<T> entity{new(std::nothrow) T(this)};
-			if (entity == nullptr) {
-				_log->error("Failed to create entity of type {}", typeid(T).name());
+			static_assert(std::is_same_v<T, ECS::Entity>, "Memory stores Entity records by value. Only ECS::Entity is supported.");
+
+			if (_isUpdating) {
+				_log->error("Entity '{}' can't be created during update. Use command buffer instead.", name);
 				return nullptr;
 			}
-			entity->Activate(name);
-			_entities.push_back(std::move(entity));
-			_entities.back()->Id = _entities.size() - 1;
-			return static_cast<T*>(_entities.back().get());
+
+			uint32_t index;
+			if (!_freeEntitySlots.empty()) {
+				index = _freeEntitySlots.back();
+				_freeEntitySlots.pop_back();
+			} else {
+				if (_entitySlots.size() >= Config::MAX_ENTITY_COUNT) {
+					_log->error("Failed to create entity of type {}. Entity limit reached.", typeid(T).name());
+					return nullptr;
+				}
+				index = static_cast<uint32_t>(_entitySlots.size());
+				_entitySlots.emplace_back();
+				_entitySignatures.emplace_back();
+				_entities.emplace_back(this);
+			}
+
+			return ActivateEntitySlot(index, name);
 		}
 
+		/**
+		 * @brief Create many Entities at once.
+		 *
+		 * Free slots are reused first, remaining Entities are appended with a single resize of slot data.
+		 * Nothing is logged per Entity.
+		 * Entities can't be created while Components are being updated. Use GetCommandBuffer().CreateEntity() instead.
+		 * @param count Number of Entities to create.
+		 * @param name Name given to every new Entity.
+		 * @return Ids of new Entities. Empty in case of error.
+		 */
+		std::vector<size_t> CreateEntities(size_t count, const std::string& name = "Entity");
+
 		/**
 		 * @brief Destroy Entity and all its Components.
+		 *
+		 * Entity's slot is released for reuse and its generation is increased.
+		 * If called while Components are being updated, destruction is recorded in the command buffer
+		 * and happens after the update.
 		 * @tparam T Type of Entity. Must extend IEntity
 		 * @param entity Pointer to Entity that should be destroyed.
 		 */
@@ -101,21 +173,128 @@ namespace LowEngine::Memory {
 			}
 
 			size_t entityId = entity->Id;
-			if (entityId >= _entities.size()) {
-				_log->error("Entity id is out of range");
+			if (!IsEntityValid(entityId)) {
+				_log->error("Entity id {} is not valid", entityId);
 				return;
 			}
 
-			// Remove all components associated with the entity
-			for (const auto& typeInfo : _typeInfos) {
-				auto typeIndex = typeInfo.first;
-				if (_components.contains(typeIndex)) {
-					_components[typeIndex]->DestroyComponent(entityId);
-				}
+			if (_isUpdating) {
+				GetCommandBuffer().DestroyEntity(entityId);
+				return;
+			}
+
+			// Remove all components associated with the entity. Only pools that own it are touched.
+			uint32_t index = ECS::GetEntityIndex(entityId);
+			ComponentSignature& signature = _entitySignatures[index];
+			signature.ForEach([this, entityId](ComponentTypeId typeId) {
+				_components[typeId]->DestroyComponent(entityId);
+			});
+			signature.Clear();
+
+			// Release the slot
+			EntitySlot& slot = _entitySlots[index];
+			if (slot.Parked) {
+				TakeParkedEntity(index);
+			} else {
+				UnlinkEntityName(index);
+			}
+			MarkSlotChanged(index);
+			slot.Alive = false;
+			slot.Generation++;
+			slot.Prefab = INVALID_NAME_ID;
+
+			ECS::Entity& record = _entities[index];
+			record.SetActive(false);
+			record.Id = Config::INVALID_ID;
+
+			_freeEntitySlots.push_back(index);
+		}
+
+		/**
+		 * @brief Spawn Entity of a prefab, reusing an Entity parked in the prefab's pool if there is one.
+		 *
+		 * Reused Entity keeps its Components. Each of them is reset (see IComponent::Reset) and activated,
+		 * and the Entity gets the provided name, so once the pool is warm spawning doesn't allocate.
+		 * If no Entity is parked, a new one is created and build attaches its Components.
+		 * Entities can't be spawned while Components are being updated. Use GetCommandBuffer().SpawnEntity() instead.
+		 * @tparam T Type of Entity. Must be ECS::Entity
+		 * @tparam Build Type of function attaching Components. Signature: void(Memory&, ECS::Entity&)
+		 * @param prefab Name of the prefab, see SetEntityPoolCapacity.
+		 * @param name Name of the Entity.
+		 * @param build Function attaching Components to a new Entity. Not called for reused Entities.
+		 * @return Pointer to Entity. Returns nullptr in case of error.
+		 */
+		template <typename T, typename Build>
+		T* SpawnEntity(std::string_view prefab, const std::string& name, Build&& build) {
+			static_assert(std::is_same_v<T, ECS::Entity>, "Memory stores Entity records by value. Only ECS::Entity is supported.");
+
+			if (_isUpdating) {
+				_log->error("Entity '{}' can't be spawned during update. Use command buffer instead.", name);
+				return nullptr;
+			}
+
+			ECS::Entity* entity = ReuseParkedEntity(prefab, name);
+			if (entity != nullptr) {
+				return entity;
 			}
 
-			// Remove the entity itself
-			_entities[entityId].reset();
+			entity = CreateEntity<T>(name);
+			if (entity == nullptr) {
+				return nullptr;
+			}
+			_entitySlots[ECS::GetEntityIndex(entity->Id)].Prefab = GetEntityPoolId(prefab);
+			build(*this, *entity);
+			return entity;
+		}
+
+		/**
+		 * @brief Despawn Entity created by SpawnEntity, parking it for reuse if its prefab's pool has room.
+		 *
+		 * Parked Entity keeps its Components, deactivated after their Park hook. It keeps its Id and name for its next
+		 * spawn, but isn't found by name, is skipped by ForEachEntity and isn't serialized. Entities without a prefab,
+		 * or with a full pool, are destroyed. If called while Components are being updated, despawning is recorded in the command buffer.
+		 * @param entityId Id of the Entity.
+		 */
+		void DespawnEntity(size_t entityId);
+
+		/**
+		 * @brief Set number of despawned Entities of a prefab kept for reuse by SpawnEntity.
+		 *
+		 * Pool storage is reserved up front. Entities parked above the new capacity are destroyed.
+		 * Can't be called during update.
+		 * @param prefab Name of the prefab.
+		 * @param capacity Maximal number of parked Entities. Default for every prefab is 0.
+		 */
+		void SetEntityPoolCapacity(std::string_view prefab, size_t capacity);
+
+		/**
+		 * @brief Retrieve number of Entities of a prefab parked for reuse.
+		 * @param prefab Name of the prefab.
+		 * @return Number of parked Entities.
+		 */
+		[[nodiscard]] size_t GetParkedEntityCount(std::string_view prefab) const;
+
+		/**
+		 * @brief Check if Entity is parked in its prefab's pool.
+		 * @param entityId Id of the Entity.
+		 * @return True if Entity exists and is parked.
+		 */
+		[[nodiscard]] bool IsEntityParked(size_t entityId) const {
+			return IsEntityValid(entityId) && _entitySlots[ECS::GetEntityIndex(entityId)].Parked;
+		}
+
+		/**
+		 * @brief Check if Entity Id refers to an existing Entity.
+		 * @param entityId Id of the Entity.
+		 * @return True if Entity exists. False if Id is out of range or Entity was destroyed.
+		 */
+		bool IsEntityValid(size_t entityId) const {
+			uint32_t index = ECS::GetEntityIndex(entityId);
+			if (index >= _entitySlots.size()) {
+				return false;
+			}
+			const EntitySlot& slot = _entitySlots[index];
+			return slot.Alive && slot.Generation == ECS::GetEntityGeneration(entityId);
 		}
 
 		/**
@@ -126,68 +305,278 @@ namespace LowEngine::Memory {
 		 */
 		template <typename T>
 		T* GetEntity(size_t entityId) {
-			if (entityId >= _entities.size()) {
+			if (!IsEntityValid(entityId)) {
 				return nullptr;
 			}
 
-			return static_cast<T*>(_entities[entityId].get());
+			return static_cast<T*>(&_entities[ECS::GetEntityIndex(entityId)]);
 		}
 
 		/**
 		 * @brief Retrieves Entity by its name.
 		 *
-		 * If there's multiple Entities with the same name, the first one found will be retrieved.
+		 * Lookup is hashed, so it's cheap enough to be called every frame.
+		 * If there's multiple Entities with the same name, one of them is retrieved. Use FindEntities to get all.
 		 * @tparam T Type of Entity. Must extend IEntity
 		 * @param name Name od the Entity to retrieve.
 		 * @return Pointer to Entity. Returns nullptr if Entity with Name doesn't exist.
 		 */
 		template <typename T>
-		T* FindEntity(const std::string& name) {
-			for (const auto& entity : _entities) {
-				if (entity != nullptr && entity->Name == name) {
-					return static_cast<T*>(entity.get());
+		T* FindEntity(std::string_view name) {
+			NameId nameId = _names.Find(name);
+			// name stays interned while only parked Entities keep it, then the list is empty
+			if (nameId == INVALID_NAME_ID || _entitiesByName[nameId].empty()) {
+				return nullptr;
+			}
+
+			return static_cast<T*>(&_entities[ECS::GetEntityIndex(_entitiesByName[nameId].front())]);
+		}
+
+		/**
+		 * @brief Retrieve Ids of all Entities with provided name.
+		 * @param name Name of the Entities.
+		 * @return Ids of Entities, in no particular order. Span is invalidated when any Entity is created,
+		 * renamed or destroyed.
+		 */
+		std::span<const size_t> FindEntities(std::string_view name) const {
+			NameId nameId = _names.Find(name);
+			if (nameId == INVALID_NAME_ID) {
+				return {};
+			}
+			return _entitiesByName[nameId];
+		}
+
+		/**
+		 * @brief Retrieve name of the Entity.
+		 * @param entityId Id of the Entity.
+		 * @return View of the name, owned by the Memory manager. Valid until Entity is renamed or destroyed.
+		 * Empty if Entity doesn't exist.
+		 */
+		[[nodiscard]] std::string_view GetEntityName(size_t entityId) const {
+			if (!IsEntityValid(entityId)) {
+				return {};
+			}
+			return _names.GetName(_entitySlots[ECS::GetEntityIndex(entityId)].Name);
+		}
+
+		/**
+		 * @brief Rename the Entity, keeping name lookups up to date.
+		 *
+		 * Not thread-safe: must not be called from Components updated on worker threads.
+		 * @param entityId Id of the Entity.
+		 * @param name New name of the Entity.
+		 * @return True if Entity was renamed. False if it doesn't exist or is parked.
+		 */
+		bool RenameEntity(size_t entityId, std::string_view name);
+
+		/**
+		 * @brief Mark Entity as changed, so it's saved by the next SerializeEntityChangesToBinary.
+		 *
+		 * Creating and destroying Entities and Components, renaming, activating and deactivating Entities and
+		 * toggling Components mark them automatically. Components that track their changes mark their Entity
+		 * through IComponentBase::MarkChanged, edits of other Components can't be seen, see CanSerializeChanges.
+		 *
+		 * Can be called from worker threads during updates: Entities already marked are skipped without locking,
+		 * and the list of changed Entities is reserved before updates, so it never allocates there.
+		 * @param entityId Id of the Entity. Ids of Entities that don't exist are ignored.
+		 */
+		void MarkEntityChanged(size_t entityId) {
+			if (!IsEntityValid(entityId)) {
+				return;
+			}
+			uint32_t index = ECS::GetEntityIndex(entityId);
+			if (std::atomic_ref(_entitySlots[index].Changed).load(std::memory_order_relaxed)) {
+				return;
+			}
+			std::lock_guard lock(_changedEntitiesMutex);
+			if (!std::atomic_ref(_entitySlots[index].Changed).exchange(true, std::memory_order_relaxed)) {
+				_changedEntities.push_back(index);
+			}
+		}
+
+		/**
+		 * @brief Forget changes of Entities, e.g. once they are saved, and start a new tick.
+		 */
+		void ClearChanges();
+
+		/**
+		 * @brief Retrieve Ids of changed Entities that are saved, see SerializeEntityChangesToBinary.
+		 * @return Ids of existing, not parked Entities changed since ClearChanges.
+		 */
+		[[nodiscard]] std::vector<size_t> GetChangedEntityIds() const;
+
+		/**
+		 * @brief Check if every change since ClearChanges can be saved by SerializeEntityChangesToBinary.
+		 *
+		 * False if there's a Component of a type that doesn't track its changes (see IComponent::TracksChanges):
+		 * edits of its fields aren't seen, so the Memory has to be saved whole.
+		 * @return True if changes can be saved.
+		 */
+		[[nodiscard]] bool CanSerializeChanges() const;
+
+		/**
+		 * @brief Retrieve tick started by the last ClearChanges.
+		 *
+		 * Components that track their changes and changed during this tick or later weren't saved yet.
+		 * @return Tick of the last ClearChanges.
+		 */
+		[[nodiscard]] uint64_t GetChangesTick() const {
+			return _changesTick;
+		}
+
+		/**
+		 * @brief Retrieve number of distinct names of existing Entities, parked ones included.
+		 * @return Number of names.
+		 */
+		[[nodiscard]] size_t GetEntityNameCount() const {
+			return _names.GetCount();
+		}
+
+		/**
+		 * @brief Call function for all existing Entities, in order of their slots.
+		 *
+		 * Method created to be used in DevTools. Entities parked for reuse are skipped.
+		 * Be extra careful if using in Game Logic: callback must not create or destroy Entities.
+		 * @tparam Callback Type of a callback to be executed. Signature: void(ECS::Entity&)
+		 * @param callback Reference to a function that will be called.
+		 */
+		template <typename Callback>
+		void ForEachEntity(Callback&& callback) {
+			for (size_t i = 0; i < _entitySlots.size(); ++i) {
+				if (_entitySlots[i].Alive && !_entitySlots[i].Parked) {
+					callback(_entities[i]);
 				}
 			}
-			return nullptr;
 		}
 
 		/**
-		 * @brief Retrieve entire collection of Entities.
+		 * @brief Retrieve allocation statistics of the arena backing Entities and Component Pools.
+		 * @return Current statistics.
+		 */
+		[[nodiscard]] const ArenaStats& GetArenaStats() const {
+			return _arena.GetStats();
+		}
+
+		/**
+		 * @brief Retrieve memory usage of every Component Pool.
+		 * @return Statistics of existing pools, in order of type ids.
+		 */
+		[[nodiscard]] std::vector<PoolStats> GetPoolStats() const;
+
+		/**
+		 * @brief Release memory that isn't needed by existing Entities and Components.
 		 *
-		 * Method created to be used in DevTools.
-		 * Be extra careful if using in Game Logic.
-		 * @return Pointer to entire collection of Entities.
+		 * Meant for moments after a spike, like the end of a level that spawned many particles. Storage of pools
+		 * that shrank is handed back to the arena, see IComponentPool::ShrinkToFit. Can't be called during update.
+		 */
+		void ShrinkToFit();
+
+		/**
+		 * @brief Retrieve number of existing Entities.
+		 * @return Number of Entities.
 		 */
-		std::vector<std::unique_ptr<ECS::IEntity>>* GetAllEntities() {
-			return &_entities;
+		size_t GetEntityCount() const {
+			return _entitySlots.size() - _freeEntitySlots.size();
+		}
+
+		/**
+		 * @brief Retrieve signature of Component types attached to Entity.
+		 * @param entityId Id of the Entity.
+		 * @return Signature of the Entity. Empty signature if Entity doesn't exist.
+		 */
+		ComponentSignature GetEntitySignature(size_t entityId) const {
+			if (!IsEntityValid(entityId)) {
+				return {};
+			}
+			return _entitySignatures[ECS::GetEntityIndex(entityId)];
+		}
+
+		/**
+		 * @brief Check if Entity owns Component of given type.
+		 * @param entityId Id of the Entity.
+		 * @param typeId Id of the Component type.
+		 * @return True if Component is attached to Entity.
+		 */
+		bool HasComponent(size_t entityId, ComponentTypeId typeId) const {
+			return IsEntityValid(entityId) && _entitySignatures[ECS::GetEntityIndex(entityId)].Test(typeId);
+		}
+
+		/**
+		 * @brief Check if Entity owns Component of given type.
+		 * @param entityId Id of the Entity.
+		 * @param typeIndex Type of the Component.
+		 * @return True if Component is attached to Entity.
+		 */
+		bool HasComponent(size_t entityId, const std::type_index& typeIndex) const {
+			auto it = _typeIdsByIndex.find(typeIndex);
+			return it != _typeIdsByIndex.end() && HasComponent(entityId, it->second);
+		}
+
+		/**
+		 * @brief Check if Entity owns Component of given type.
+		 * @tparam T Type of the Component.
+		 * @param entityId Id of the Entity.
+		 * @return True if Component is attached to Entity.
+		 */
+		template <typename T>
+		bool HasComponent(size_t entityId) const {
+			return HasComponent(entityId, GetComponentTypeId<T>());
 		}
 
 		/**
 		 * @brief Register Component type in the system.
 		 * @tparam T Type of Component. Must extend IComponent
+		 * @return True if type is registered. False if type id doesn't fit in Entity signature.
 		 */
 		template <typename T>
-		void RegisterComponentType() {
+		bool RegisterComponentType() {
+			const ComponentTypeId typeId = GetComponentTypeId<T>();
+			if (typeId >= Config::MAX_COMPONENT_TYPES) {
+				_log->error("Component type {} can't be registered. Limit of {} Component types reached.",
+				            ComponentTypeName<T>, Config::MAX_COMPONENT_TYPES);
+				return false;
+			}
+			if (typeId >= _typeInfos.size()) {
+				_typeInfos.resize(typeId + 1);
+			}
+			if (typeId >= _components.size()) {
+				_components.resize(typeId + 1);
+			}
+
 			// register type
-			if (!_typeInfos.contains(std::type_index(typeid(T)))) {
-				TypeInfo& ti = _typeInfos[std::type_index(typeid(T))];
+			TypeInfo& ti = _typeInfos[typeId];
+			if (!ti.IsRegistered()) {
 				ti.Name = typeid(T).name();
-				ti.Id = _nextTypeId++;
+				ti.Id = typeId;
 				ti.TypeIndex = std::type_index(typeid(T));
-				ti.TypeName = Utils::GetCleanTypeName<T>();
+				ti.TypeName = ComponentTypeName<T>;
 				ti.Size = sizeof(T);
 				ti.Dependencies = T::GetDependencies();
-
-				ti.DeserializeFromJSON = [this](size_t entityId, const nlohmann::ordered_json& json) {
-					return DeserializeComponentFromJSON<T>(entityId, json);
+				ti.Reads = T::ReadsComponents::GetTypeIds();
+				ti.Writes = T::WritesComponents::GetTypeIds();
+				ti.DependenciesReadOnly = T::DependenciesReadOnly;
+				ti.WorkerThreadSafe = T::WorkerThreadSafe;
+				ti.TracksChanges = T::TracksChanges;
+				ti.HasUpdate = T::OverridesUpdate();
+				ti.HasFixedUpdate = T::OverridesFixedUpdate();
+				ti.HasDraw = T::OverridesDraw();
+				ti.HasDrawDirect = T::OverridesDrawDirect();
+				ti.DeserializeFromJSON = [](Memory& memory, size_t entityId, const nlohmann::ordered_json& json) {
+					return memory.DeserializeComponentFromJSON<T>(entityId, json);
 				};
-				// lambda can be replaced with std::bind, but I don't understand how it works :P
-				/*ti.DeserializeFromJSON = std::bind(&Memory::DeserializeComponentFromJSON<T>, this, std::placeholders::_1, std::placeholders::_2);*/
+				ti.DeserializeFromBinary = [](Memory& memory, Utils::BinaryReader& in) {
+					return memory.DeserializePoolFromBinary<T>(in);
+				};
+
+				_typeIdsByIndex[ti.TypeIndex] = typeId;
 			}
+			return true;
 		}
 
 		/**
 		 * @brief Create new component and assign it to Entity with provided Id.
+		 *
+		 * Components can't be created while Components are being updated. Use GetCommandBuffer().AddComponent() instead.
 		 * @tparam T Type of Component. Must extend IComponent
 		 * @tparam Args Template arguments that will be forwarded to Component's c-tor
 		 * @param entityId Id of the Entity that should have new Component attached.
@@ -196,26 +585,35 @@ namespace LowEngine::Memory {
 		 */
 		template <typename T, typename... Args>
 		T* CreateComponent(size_t entityId, Args&&... args) {
-			RegisterComponentType<T>();
+			if (_isUpdating) {
+				_log->error("Component {} can't be created during update. Use command buffer instead.",
+				            ComponentTypeName<T>);
+				return nullptr;
+			}
 
-			if (entityId >= _entities.size()) {
-				_log->error("Entity id is out of range");
+			if (!RegisterComponentType<T>()) {
+				return nullptr;
+			}
+
+			if (!IsEntityValid(entityId)) {
+				_log->error("Entity id {} is not valid", entityId);
 				return nullptr;
 			}
 
 			// checking dependencies
-			const auto& typeInfo = _typeInfos[std::type_index(typeid(T))];
-			for (const auto& dependency : typeInfo.Dependencies) {
-				if (!_components.contains(dependency)) {
+			const auto& typeInfo = _typeInfos[GetComponentTypeId<T>()];
+			const ComponentSignature& signature = _entitySignatures[ECS::GetEntityIndex(entityId)];
+			for (ComponentTypeId dependency : typeInfo.Dependencies) {
+				if (GetPool(dependency) == nullptr) {
 					_log->error("Component {} is a dependency for {}, but it is not registered",
-					            DemangledTypeName(dependency),
-					            DemangledTypeName(typeid(T)));
+					            ComponentTypeRegistry::GetName(dependency),
+					            ComponentTypeName<T>);
 					return nullptr;
 				}
-				if (_components[dependency]->GetComponentPtr(entityId) == nullptr) {
+				if (!signature.Test(dependency)) {
 					_log->error("Component {} is a dependency for {}, but it is not attached to Entity with id {}",
-					            DemangledTypeName(dependency),
-					            DemangledTypeName(typeid(T)), entityId);
+					            ComponentTypeRegistry::GetName(dependency),
+					            ComponentTypeName<T>, entityId);
 					return nullptr;
 				}
 			}
@@ -223,38 +621,114 @@ namespace LowEngine::Memory {
 			ComponentPool<T>& pool = GetOrCreatePool<T>();
 			T* component = pool.CreateComponent(this, entityId, std::forward<Args>(args)...);
 			if (component != nullptr) {
+				_entitySignatures[ECS::GetEntityIndex(entityId)].Set(GetComponentTypeId<T>());
+				MarkSlotChanged(ECS::GetEntityIndex(entityId));
 				component->EntityId = entityId;
-				component->Active = true;
 				component->Initialize();
 			}
 
-			_log->debug("Component {} created for Entity with id {}", DemangledTypeName(typeid(T)), entityId);
+			_log->debug("Component {} created for Entity with id {}", ComponentTypeName<T>, entityId);
 
 			return component;
 		}
 
+		/**
+		 * @brief Create Components of the same type for many Entities at once.
+		 *
+		 * Dependency pools are looked up once for the whole batch and pool storage is reserved up front.
+		 * Entities that are not valid, miss a dependency or already own the Component are skipped; they are
+		 * reported with a single warning instead of a log line per Entity.
+		 * Components can't be created while Components are being updated. Use GetCommandBuffer().AddComponent() instead.
+		 * @tparam T Type of Component. Must extend IComponent
+		 * @tparam Init Type of initialization callback. Signature: void(T&)
+		 * @param entityIds Ids of the Entities that should have new Component attached.
+		 * @param init Function called for every new Component, before its Initialize() method.
+		 * @return Number of created Components.
+		 */
+		template <typename T, typename Init>
+		size_t CreateComponents(std::span<const size_t> entityIds, Init&& init) {
+			if (_isUpdating) {
+				_log->error("Components {} can't be created during update. Use command buffer instead.",
+				            ComponentTypeName<T>);
+				return 0;
+			}
+
+			if (!RegisterComponentType<T>()) {
+				return 0;
+			}
+
+			// resolve dependencies once for the whole batch
+			const ComponentTypeId typeId = GetComponentTypeId<T>();
+			ComponentSignature dependencies;
+			for (ComponentTypeId dependency : _typeInfos[typeId].Dependencies) {
+				if (GetPool(dependency) == nullptr) {
+					_log->error("Component {} is a dependency for {}, but it is not registered",
+					            ComponentTypeRegistry::GetName(dependency),
+					            ComponentTypeName<T>);
+					return 0;
+				}
+				dependencies.Set(dependency);
+			}
+
+			ComponentPool<T>& pool = GetOrCreatePool<T>();
+			pool.Reserve(entityIds.size());
+
+			size_t created = 0;
+			for (size_t entityId : entityIds) {
+				if (!IsEntityValid(entityId)) continue;
+
+				ComponentSignature& signature = _entitySignatures[ECS::GetEntityIndex(entityId)];
+				if (!signature.Contains(dependencies)) continue;
+
+				T* component = pool.CreateComponent(this, entityId);
+				if (component == nullptr) continue;
+
+				signature.Set(typeId);
+				MarkSlotChanged(ECS::GetEntityIndex(entityId));
+				component->EntityId = entityId;
+				init(*component);
+				component->Initialize();
+				created++;
+			}
+
+			if (created < entityIds.size()) {
+				_log->warn("{} of {} Components {} were not created. Entities were invalid, missed a dependency "
+				           "or already owned the Component.", entityIds.size() - created, entityIds.size(),
+				           ComponentTypeName<T>);
+			}
+			_log->debug("{} Components {} created", created, ComponentTypeName<T>);
+
+			return created;
+		}
+
+		/**
+		 * @brief Create default Components of the same type for many Entities at once.
+		 * @tparam T Type of Component. Must extend IComponent
+		 * @param entityIds Ids of the Entities that should have new Component attached.
+		 * @return Number of created Components.
+		 */
 		template <typename T>
-		bool IsComponentSafeToDestroy(size_t entityId) {
-			// check if component is a dependency for any other component
-			for (const auto& _component : _components) {
-				const std::type_index& compType = _component.first;
-				const std::unique_ptr<IComponentPool>& pool = _component.second;
+		size_t CreateComponents(std::span<const size_t> entityIds) {
+			return CreateComponents<T>(entityIds, [](T&) {});
+		}
 
-				if (compType == std::type_index(typeid(T))) continue; // skip self-dependency
+		template <typename T>
+		bool IsComponentSafeToDestroy(size_t entityId) {
+			const ComponentTypeId typeId = GetComponentTypeId<T>();
 
-				auto componentPtr = pool->GetComponentPtr(entityId);
-				if (componentPtr == nullptr) continue; // no component of this type attached to Entity
+			// check if component is a dependency for any other component attached to Entity
+			bool safe = true;
+			GetEntitySignature(entityId).ForEach([this, typeId, &safe](ComponentTypeId compType) {
+				if (!safe || compType == typeId) return; // skip self-dependency
 
 				const auto& typeInfo = _typeInfos[compType];
-				if (std::find(typeInfo.Dependencies.begin(), typeInfo.Dependencies.end(), std::type_index(typeid(T))) !=
-					typeInfo.Dependencies.
-					         end()) {
-					_log->debug("Component {} is a dependency for {}", DemangledTypeName(typeid(T)),
-					            DemangledTypeName(compType));
-					return false;
+				if (std::find(typeInfo.Dependencies.begin(), typeInfo.Dependencies.end(), typeId) !=
+					typeInfo.Dependencies.end()) {
+					_log->debug("Component {} is a dependency for {}", ComponentTypeName<T>, typeInfo.TypeName);
+					safe = false;
 				}
-			}
-			return true;
+			});
+			return safe;
 		}
 
 		/**
@@ -263,15 +737,79 @@ namespace LowEngine::Memory {
 		 * @param entityId Id of the Entity that owns Component.
 		 *
 		 * This method will remove Component from Entity and destroy it.
+		 * If called while Components are being updated, destruction is recorded in the command buffer
+		 * and happens after the update.
 		 */
 		template <typename T>
 		void DestroyComponent(size_t entityId) {
-			auto typeIndex = std::type_index(typeid(T));
-			if (!_components.contains(typeIndex)) {
-				_log->warn("Component type {} not found", DemangledTypeName(typeid(T)));
+			DestroyComponent(entityId, GetComponentTypeId<T>());
+		}
+
+		/**
+		 * @brief Destroy Component of given type.
+		 * @param entityId Id of the Entity that owns Component.
+		 * @param typeId Id of the Component type.
+		 */
+		void DestroyComponent(size_t entityId, ComponentTypeId typeId) {
+			IComponentPool* pool = GetPool(typeId);
+			if (pool == nullptr) {
+				_log->warn("Component type {} not found", ComponentTypeRegistry::GetName(typeId));
+				return;
+			}
+
+			if (_isUpdating) {
+				GetCommandBuffer().DestroyComponent(entityId, typeId);
+				return;
+			}
+
+			if (!HasComponent(entityId, typeId)) {
 				return;
 			}
-			_components[typeIndex]->DestroyComponent(entityId);
+			pool->DestroyComponent(entityId);
+			_entitySignatures[ECS::GetEntityIndex(entityId)].Reset(typeId);
+			MarkSlotChanged(ECS::GetEntityIndex(entityId));
+		}
+
+		/**
+		 * @brief Activate or deactivate Component of given type.
+		 *
+		 * Component that is not Active skips its Update and Draw calls.
+		 * If called while Components are being updated, the change is recorded in the command buffer
+		 * and happens after the update.
+		 * @tparam T Type of the Component.
+		 * @param entityId Id of the Entity that owns Component.
+		 * @param active New state of the Component.
+		 */
+		template <typename T>
+		void SetComponentActive(size_t entityId, bool active) {
+			SetComponentActive(entityId, GetComponentTypeId<T>(), active);
+		}
+
+		/**
+		 * @brief Activate or deactivate Component of given type.
+		 * @param entityId Id of the Entity that owns Component.
+		 * @param typeId Id of the Component type.
+		 * @param active New state of the Component.
+		 */
+		void SetComponentActive(size_t entityId, ComponentTypeId typeId, bool active) {
+			IComponentPool* pool = GetPool(typeId);
+			if (pool == nullptr) {
+				_log->warn("Component type {} not found", ComponentTypeRegistry::GetName(typeId));
+				return;
+			}
+
+			if (_isUpdating) {
+				GetCommandBuffer().SetComponentActive(entityId, typeId, active);
+				return;
+			}
+
+			if (!HasComponent(entityId, typeId)) {
+				_log->warn("Component {} not found for Entity with id {}", ComponentTypeRegistry::GetName(typeId),
+				           entityId);
+				return;
+			}
+			pool->SetActive(entityId, active);
+			MarkSlotChanged(ECS::GetEntityIndex(entityId));
 		}
 
 		/**
@@ -281,14 +819,26 @@ namespace LowEngine::Memory {
 		 * @return Pointer to Component. Returns nullptr if Component was not found.
 		 */
 		void* GetComponent(size_t entityId, const std::type_index& typeIndex) {
-			if (_entities.size() <= entityId) {
-				_log->error("Entity id is out of range");
+			auto it = _typeIdsByIndex.find(typeIndex);
+			if (it == _typeIdsByIndex.end()) {
 				return nullptr;
 			}
-			if (!_components.contains(typeIndex)) {
+			return GetComponent(entityId, it->second);
+		}
+
+		/**
+		 * @brief Retrieve component of requested type.
+		 * @param entityId Id of the Entity that component is attached to.
+		 * @param typeId Id of the component type.
+		 * @return Pointer to Component. Returns nullptr if Component was not found.
+		 */
+		void* GetComponent(size_t entityId, ComponentTypeId typeId) {
+			// stale Entity Ids are rejected by the pool, which compares full Id including generation
+			IComponentPool* pool = GetPool(typeId);
+			if (pool == nullptr) {
 				return nullptr;
 			}
-			return _components[typeIndex]->GetComponentPtr(entityId);
+			return pool->GetComponentPtr(entityId);
 		}
 
 		/**
@@ -299,8 +849,11 @@ namespace LowEngine::Memory {
 		 */
 		template <typename T>
 		T* GetComponent(size_t entityId) {
-			auto typeIndex = std::type_index(typeid(T));
-			return static_cast<T*>(GetComponent(entityId, typeIndex));
+			ComponentPool<T>* pool = FindPool<T>();
+			if (pool == nullptr) {
+				return nullptr;
+			}
+			return pool->TryGetComponent(entityId);
 		}
 
 		/**
@@ -315,24 +868,208 @@ namespace LowEngine::Memory {
 			pool.ForEachComponent(std::forward<Callback>(callback));
 		}
 
+		/**
+		 * @brief Retrieve structure-of-arrays storage of a Component type, for batch work over its hot data.
+		 *
+		 * Entries follow pool's iteration order, active Components first. Storage must not be kept across
+		 * structural changes, which reorder and resize it.
+		 * @tparam T Type of Component. Must declare SoAStorage, e.g. TransformComponent.
+		 * @param[out] activeCount Number of leading entries that belong to active Components.
+		 * @return Pointer to storage. Returns nullptr if there are no Components of this type.
+		 */
+		template <typename T> requires HasSoAStorage<T>
+		SoAStorageOf<T>* GetSoAStorage(size_t& activeCount) {
+			ComponentPool<T>* pool = FindPool<T>();
+			if (pool == nullptr) {
+				activeCount = 0;
+				return nullptr;
+			}
+
+			activeCount = pool->GetActiveCount();
+			return &pool->GetSoAStorage();
+		}
+
+		/**
+		 * @brief Retrieve Ids of Entities whose Component of particular type changed during provided tick or later.
+		 *
+		 * Only Components that record their changes are supported, e.g. TransformComponent. Cost depends on
+		 * the number of changes since the tick, not on the number of Components.
+		 * @tparam T Type of Component. Must provide GetChangedTick() method and call RecordComponentChange.
+		 * @param tick First tick to include, see GetTick.
+		 * @return Ids of Entities, sorted.
+		 */
+		template <typename T> requires HasChangedTick<T>
+		std::vector<size_t> GetEntitiesChangedSince(uint64_t tick) {
+			ComponentPool<T>* pool = FindPool<T>();
+			if (pool == nullptr) {
+				return {};
+			}
+			return pool->GetEntitiesChangedSince(tick);
+		}
+
+		/**
+		 * @brief Record change of a Component during provided tick, see GetEntitiesChangedSince.
+		 *
+		 * Component calls it on its first change during a tick, once its Entity Id is set. Safe to call from
+		 * worker threads while Components are being updated.
+		 * @tparam T Type of Component. Must provide GetChangedTick() method returning the recorded tick.
+		 * @param entityId Id of the Entity owning the Component.
+		 * @param tick Tick of the change, see GetTick.
+		 */
+		template <typename T> requires HasChangedTick<T>
+		void RecordComponentChange(size_t entityId, uint64_t tick) {
+			ComponentPool<T>* pool = FindPool<T>();
+			if (pool == nullptr) {
+				return;
+			}
+			std::lock_guard lock(_changedEntitiesMutex);
+			pool->RecordChange(entityId, tick);
+		}
+
+		/**
+		 * @brief Create a View joining Components of provided types.
+		 *
+		 * View visits every Entity that owns all requested Components, yielding its Id and typed references
+		 * to the Components. Iteration is driven by the smallest pool. Entities are filtered on their signatures,
+		 * other Components are looked up directly through their pools' sparse indices.
+		 * @code
+		 * for (auto [entityId, transform, sprite] : memory.View<TransformComponent, SpriteComponent>()) { ... }
+		 * @endcode
+		 * @tparam Ts Types of the Components.
+		 * @return View over the Components. View is empty if any of the types has no pool yet.
+		 */
+		template <typename... Ts>
+		ComponentView<Ts...> View() {
+			return ComponentView<Ts...>(&_entitySignatures, FindPool<Ts>()...);
+		}
+
+		/**
+		 * @brief Set worker pool used to update Component Pools concurrently.
+		 *
+		 * Without a worker pool all Component Pools are updated on the calling thread, in schedule order.
+		 * Worker pool is also used by pools of ParallelSafeUpdate Components to split their own update.
+		 * @param workerPool Pointer to worker pool. Can be nullptr.
+		 */
+		void SetWorkerPool(Threading::WorkerPool* workerPool) {
+			_workerPool = workerPool;
+			for (auto& pool : _components) {
+				if (pool != nullptr) {
+					pool->SetWorkerPool(workerPool);
+				}
+			}
+		}
+
+		/**
+		 * @brief Retrieve current update schedule, rebuilding it if the set of pools changed.
+		 *
+		 * Only pools of Component types that override Update are scheduled.
+		 * @return Reference to update schedule.
+		 */
+		const UpdateSchedule& GetUpdateSchedule();
+
+		/**
+		 * @brief Retrieve current fixed update schedule, rebuilding it if the set of pools changed.
+		 *
+		 * Only pools of Component types that override FixedUpdate are scheduled.
+		 * @return Reference to fixed update schedule.
+		 */
+		const UpdateSchedule& GetFixedUpdateSchedule();
+
+		/**
+		 * @brief Retrieve command buffer of the calling thread.
+		 *
+		 * Commands recorded during UpdateAllComponents and FixedUpdateAllComponents are played back when all pools
+		 * finished updating. Commands recorded at other times are played back on next update, or by PlaybackCommands.
+		 * @return Reference to command buffer. Buffer stays valid until Memory is destroyed.
+		 */
+		CommandBuffer& GetCommandBuffer();
+
+		/**
+		 * @brief Apply commands recorded in all command buffers.
+		 *
+		 * Buffers are played back in order they were created in, each in order of recording.
+		 */
+		void PlaybackCommands();
+
+		/**
+		 * @brief Check if Components are being updated right now.
+		 * @return True during UpdateAllComponents and FixedUpdateAllComponents.
+		 */
+		[[nodiscard]] bool IsUpdating() const {
+			return _isUpdating;
+		}
+
+		/**
+		 * @brief Retrieve current tick. Tick advances at the start of every UpdateAllComponents call, and
+		 * in ClearChanges.
+		 *
+		 * Components that track their changes record the tick of their last change.
+		 * @return Current tick.
+		 */
+		[[nodiscard]] uint64_t GetTick() const {
+			return _tick;
+		}
+
+		/**
+		 * @brief Make sure that provided number of Entities can be created without reallocating slot data.
+		 *
+		 * Name lookups are reserved for the worst case of every new Entity having a name of its own.
+		 * @param additional Number of Entities that will be created.
+		 */
+		void ReserveEntities(size_t additional) {
+			size_t reused = std::min(additional, _freeEntitySlots.size());
+			size_t slotCount = _entitySlots.size() + additional - reused;
+			_entitySlots.reserve(slotCount);
+			_entitySignatures.reserve(slotCount);
+			_changedEntities.reserve(slotCount);
+			_names.Reserve(additional);
+			_entitiesByName.reserve(_entitiesByName.size() + additional);
+			_parkedNameUses.reserve(_parkedNameUses.size() + additional);
+		}
+
+		/**
+		 * @brief Make sure that provided number of Components can be created without allocating memory.
+		 * @param typeId Id of the Component type. Nothing happens if there's no pool for this type yet.
+		 * @param additional Number of Components that will be created.
+		 */
+		void ReserveComponents(ComponentTypeId typeId, size_t additional) {
+			IComponentPool* pool = GetPool(typeId);
+			if (pool != nullptr) {
+				pool->Reserve(additional);
+			}
+		}
+
 		/**
 		 * @brief Call Update function of all Components.
+		 *
+		 * Pools are updated stage by stage, following the update schedule. Pools of Component types declared as
+		 * WorkerThreadSafe run on the worker pool, others run on the calling thread.
+		 * Structural changes requested during update are played back at the end.
 		 * @param deltaTime Time passed since last call, in seconds.
 		 */
 		void UpdateAllComponents(float deltaTime);
-		
+
+		/**
+		 * @brief Call FixedUpdate function of all Components, following the fixed update schedule.
+		 * @param fixedDeltaTime Fixed time step, in seconds.
+		 */
 		void FixedUpdateAllComponents(float fixedDeltaTime);
 
 		nlohmann::ordered_json SerializeAllEntitiesToJSON();
 
+		/**
+		 * @brief Deserialize all Entities from JSON representation.
+		 *
+		 * Entities are recreated with the Ids stored in JSON, so Components and other references
+		 * to those Ids stay valid. Entities without stored Id are created in first free slot.
+		 * @tparam T Type of Entity. Must be ECS::Entity
+		 * @param jsonData JSON array representing all Entities.
+		 * @return True if deserialization was successful, false otherwise.
+		 */
 		template <typename T>
 		bool DeserializeAllEntitiesFromJSON(const nlohmann::ordered_json& jsonData) {
 			for (const auto& entityJson : jsonData) {
-				T* entity = CreateEntity<T>(entityJson.value("name", "Unnamed Entity"));
-				if (entity != nullptr) {
-					entity->DeserializeFromJSON(entityJson);
-				} else {
-					_log->error("Failed to create entity during deserialization");
+				if (!DeserializeEntityFromJSON<T>(entityJson)) {
 					return false;
 				}
 			}
@@ -340,6 +1077,29 @@ namespace LowEngine::Memory {
 			return true;
 		}
 
+		/**
+		 * @brief Deserialize a single Entity from JSON representation, e.g. while streaming a scene.
+		 *
+		 * Entity is recreated with the Id stored in JSON. Entity without stored Id is created in first free slot.
+		 * @tparam T Type of Entity. Must be ECS::Entity
+		 * @param entityJson JSON object representing the Entity.
+		 * @return True if deserialization was successful, false otherwise.
+		 */
+		template <typename T>
+		bool DeserializeEntityFromJSON(const nlohmann::ordered_json& entityJson) {
+			std::string name = entityJson.value("name", "Unnamed Entity");
+			T* entity = entityJson.contains("id")
+				            ? CreateEntityWithId(entityJson["id"].get<size_t>(), name)
+				            : CreateEntity<T>(name);
+			if (entity == nullptr) {
+				_log->error("Failed to create entity during deserialization");
+				return false;
+			}
+
+			entity->DeserializeFromJSON(entityJson);
+			return true;
+		}
+
 		/**
 		 * @brief Serialize all Components to JSON representation.
 		 * @return JSON object representing all Components.
@@ -353,15 +1113,122 @@ namespace LowEngine::Memory {
 		 */
 		bool DeserializeAllComponentsFromJSON(const nlohmann::ordered_json& jsonData);
 
+		/**
+		 * @brief Deserialize a single Component from JSON representation, e.g. while streaming a scene.
+		 *
+		 * Type of the Component is read from JSON. Components of types that aren't registered are skipped.
+		 * @param componentJson JSON object representing the Component. Its Entity must exist.
+		 * @return True if deserialization was successful or skipped, false otherwise.
+		 */
+		bool DeserializeComponentFromJSON(const nlohmann::ordered_json& componentJson);
+
+		/**
+		 * @brief Retrieve ids of Component types that have a pool, in the order they are serialized.
+		 *
+		 * Dependencies come before the types that depend on them, so Components can be recreated in this order.
+		 * @return Ids of Component types.
+		 */
+		std::vector<ComponentTypeId> GetSerializationOrder() const;
+
+		/**
+		 * @brief Serialize all Entities to a binary scene file block.
+		 *
+		 * Block holds the Entity count, followed by Id, active flag and name of every Entity. Parked Entities
+		 * aren't saved.
+		 * @param out Writer of the block.
+		 */
+		void SerializeAllEntitiesToBinary(Utils::BinaryWriter& out);
+
+		/**
+		 * @brief Recreate Entities from a block written by SerializeAllEntitiesToBinary, keeping their Ids.
+		 * @param in Reader of the block.
+		 * @return True if deserialization was successful, false otherwise.
+		 */
+		bool DeserializeAllEntitiesFromBinary(Utils::BinaryReader& in);
+
+		/**
+		 * @brief Serialize all Components of provided type to a binary scene file block.
+		 *
+		 * Block holds the type name, followed by the records written by IComponentPool::WriteBinary.
+		 * Components of parked Entities aren't saved.
+		 * @param typeId Id of the Component type. Type must have a pool.
+		 * @param out Writer of the block.
+		 */
+		void SerializeComponentsToBinary(ComponentTypeId typeId, Utils::BinaryWriter& out);
+
+		/**
+		 * @brief Recreate Components from a block written by SerializeComponentsToBinary.
+		 *
+		 * Components of types with binary state are created as one batch, decoded straight from the block.
+		 * Blocks of types that aren't registered are skipped.
+		 * @param in Reader of the block.
+		 * @return True if deserialization was successful, false otherwise.
+		 */
+		bool DeserializeComponentsFromBinary(Utils::BinaryReader& in);
+
+		/**
+		 * @brief Serialize Entities changed since ClearChanges to a binary scene file block.
+		 *
+		 * Block holds the count and slot indices of removed Entities, destroyed or parked, followed by the count and
+		 * records of changed Entities, laid out like in SerializeAllEntitiesToBinary. Changed Entities are saved
+		 * whole: their Components are written by SerializeComponentChangesToBinary. Entities whose Active flag
+		 * changed are marked first, with a scan of the flags. Other than that, only changed Entities are visited.
+		 * @param out Writer of the block.
+		 */
+		void SerializeEntityChangesToBinary(Utils::BinaryWriter& out);
+
+		/**
+		 * @brief Apply a block written by SerializeEntityChangesToBinary.
+		 *
+		 * Entities in slots of removed Entities are destroyed. Changed Entities are created under their Ids, or
+		 * stripped of their Components if they exist, so the Component blocks that follow recreate them with their
+		 * saved state.
+		 * @param in Reader of the block.
+		 * @return True if deserialization was successful, false otherwise.
+		 */
+		bool DeserializeEntityChangesFromBinary(Utils::BinaryReader& in);
+
+		/**
+		 * @brief Serialize Components of provided type owned by Entities changed since ClearChanges.
+		 *
+		 * Layout is the one of SerializeComponentsToBinary, so blocks are read by DeserializeComponentsFromBinary.
+		 * @param typeId Id of the Component type. Type must have a pool.
+		 * @param out Writer of the block.
+		 */
+		void SerializeComponentChangesToBinary(ComponentTypeId typeId, Utils::BinaryWriter& out);
+
+		/**
+		 * @brief Write binary snapshot of simulation state of Components of provided types.
+		 *
+		 * Snapshot holds state written by Components' WriteSnapshot, keyed by Entity Id. It's meant for rollback
+		 * and replays within the same Memory, not for saving: layout depends on the build and type ids.
+		 * @param[out] out Buffer for the snapshot. Previous content is replaced, capacity is reused.
+		 * @param typeIds Ids of Component types to include. Types must support snapshots.
+		 * @return True if snapshot was written.
+		 */
+		bool WriteSnapshot(std::vector<std::byte>& out, std::span<const ComponentTypeId> typeIds);
+
+		/**
+		 * @brief Restore simulation state of Components from snapshot written by WriteSnapshot.
+		 *
+		 * Only state of Components is restored, Entities and Components are not created or destroyed. Snapshot
+		 * is rejected, without restoring anything, if Components of a captured type were created or destroyed
+		 * since it was taken.
+		 * @param snapshot Snapshot data.
+		 * @return True if snapshot was valid, matched existing Components and was restored.
+		 */
+		bool ReadSnapshot(std::span<const std::byte> snapshot);
+
 		/**
 		 * @brief Collect all drawables from active components into the provided collection.
 		 *
+		 * Only pools of Component types that override Draw are visited.
 		 * @param[out] drawables Reference to collection that will be filled with drawables to render.
 		 */
 		void CollectDrawables(std::vector<SceneDrawable>& drawables);
 
 		/**
-		 * @brief Call DrawDirect on all active components across all pools.
+		 * @brief Call DrawDirect on all active components of types that override it.
 		 *
 		 * Invoked by Scene::Draw after the sprite pass to allow components
 		 * that manage their own GPU resources to draw directly to the render target.
@@ -375,17 +1242,262 @@ namespace LowEngine::Memory {
 		void Destroy();
 
 	protected:
-		/** @brief Counter for generating unique type IDs. */
-		static inline unsigned int _nextTypeId = 0;
+		/**
+		 * @brief State of a single slot in Entity storage.
+		 */
+		struct EntitySlot {
+			/** @brief Generation of the slot. Increased every time the slot is freed. */
+			uint32_t Generation = 0;
+			/** @brief Prefab the Entity was spawned from, see SpawnEntity. */
+			NameId Prefab = INVALID_NAME_ID;
+			/** @brief Interned name of the Entity. Parked Entity keeps it for its next spawn, see _parkedNameUses. */
+			NameId Name = INVALID_NAME_ID;
+			/** @brief Position of the Entity in the list of Entities with the same name. */
+			uint32_t NamePosition = 0;
+			/** @brief Position of the parked Entity in its prefab's pool. */
+			uint32_t PoolPosition = 0;
+			/** @brief Is the slot occupied by an existing Entity? */
+			bool Alive = false;
+			/** @brief Is the Entity parked in its prefab's pool? */
+			bool Parked = false;
+			/** @brief Is the slot listed in _changedEntities? Set for removed Entities as well. */
+			bool Changed = false;
+		};
+
+		/**
+		 * @brief Arena that Entity storage and Component Pools allocate from.
+		 *
+		 * Declared first, so it outlives every collection allocated from it.
+		 */
+		ArenaResource _arena;
+
+		/**
+		 * @brief Entity records, indexed by slot index.
+		 *
+		 * Stored by value in a deque, so records never move and pointers to Entities stay valid while they exist.
+		 */
+		std::pmr::deque<ECS::Entity> _entities{&_arena};
+
+		/** @brief State of every Entity slot, parallel to _entities. */
+		std::pmr::vector<EntitySlot> _entitySlots{&_arena};
+
+		/** @brief Component types attached to every Entity, parallel to _entities. */
+		std::pmr::vector<ComponentSignature> _entitySignatures{&_arena};
+
+		/** @brief Indices of free Entity slots, reused in LIFO order. */
+		std::pmr::vector<uint32_t> _freeEntitySlots{&_arena};
+
+		/** @brief Names of existing Entities. A name is kept while at least one Entity uses it, parked ones included. */
+		NameTable _names{&_arena};
+
+		/** @brief Ids of Entities using every name, indexed by name id. Parked Entities aren't listed. */
+		std::pmr::vector<std::pmr::vector<size_t>> _entitiesByName{&_arena};
+
+		/**
+		 * @brief Number of parked Entities keeping every name, indexed by name id, parallel to _entitiesByName.
+		 *
+		 * Parked Entities aren't found by their name, but keep it, so spawning them again with the same name
+		 * neither interns it nor grows its list of Entities.
+		 */
+		std::pmr::vector<uint32_t> _parkedNameUses{&_arena};
+
+		/** @brief Names of prefabs with an Entity pool. Prefab's name id indexes its pool. */
+		NameTable _prefabNames{&_arena};
+
+		/** @brief Slot indices of parked Entities, indexed by prefab. */
+		std::pmr::vector<std::pmr::vector<uint32_t>> _parkedEntities{&_arena};
+
+		/** @brief Maximal number of parked Entities, indexed by prefab. */
+		std::pmr::vector<size_t> _entityPoolCapacities{&_arena};
+
+		/** @brief Number of parked Entities of all prefabs. */
+		size_t _parkedEntityCount = 0;
+
+		/** @brief Component pools indexed by their type id. Types without a pool hold nullptr. */
+		std::pmr::vector<std::unique_ptr<IComponentPool>> _components{&_arena};
+
+		/** @brief Type information indexed by type id. Types not registered in this Memory are left default. */
+		std::vector<TypeInfo> _typeInfos;
+
+		/** @brief Map of type ids of registered types, for lookups by std::type_index. */
+		std::unordered_map<std::type_index, ComponentTypeId> _typeIdsByIndex;
+
+		/** @brief Order of pool updates. */
+		UpdateSchedule _updateSchedule;
+
+		/** @brief Order of pool fixed updates. */
+		UpdateSchedule _fixedUpdateSchedule;
+
+		/** @brief Type ids of pools taking part in Draw, in order of type ids. */
+		std::vector<ComponentTypeId> _drawPools;
+
+		/** @brief Type ids of pools taking part in DrawDirect, in order of type ids. */
+		std::vector<ComponentTypeId> _drawDirectPools;
+
+		/** @brief Was a pool added or removed since schedules and draw lists were built? */
+		bool _updateScheduleDirty = true;
+
+		/** @brief Worker pool used for updates. Not owned. */
+		Threading::WorkerPool* _workerPool = nullptr;
+
+		/** @brief Are Components being updated right now? Structural changes are deferred while true. */
+		bool _isUpdating = false;
+
+		/** @brief Current tick, see GetTick. */
+		uint64_t _tick = 0;
+
+		/**
+		 * @brief Slot indices of Entities changed, destroyed or parked since ClearChanges, see MarkEntityChanged.
+		 *
+		 * Every slot is listed once, so the list doesn't grow while Entities are spawned and despawned. Reserved
+		 * for every slot before updates, see RunScheduled.
+		 */
+		std::pmr::vector<uint32_t> _changedEntities{&_arena};
+
+		/** @brief Guards _changedEntities and change logs of pools while Components change on worker threads. */
+		std::mutex _changedEntitiesMutex;
+
+		/** @brief Tick started by the last ClearChanges, see GetChangesTick. */
+		uint64_t _changesTick = 0;
+
+		/** @brief Command buffers of threads that requested deferred changes, in order of creation. */
+		std::vector<std::pair<std::thread::id, std::unique_ptr<CommandBuffer>>> _commandBuffers;
+
+		/** @brief Guards _commandBuffers. */
+		std::mutex _commandBuffersMutex;
+
+		/**
+		 * @brief Rebuild schedules and draw lists if the set of pools changed.
+		 */
+		void RebuildPhases();
+
+		/**
+		 * @brief Call function for every pool, following provided schedule.
+		 * @param schedule Schedule to follow.
+		 * @param callback Function to call for each pool.
+		 */
+		void RunScheduled(const UpdateSchedule& schedule, const std::function<void(IComponentPool&)>& callback);
+
+		/**
+		 * @brief Mark slot as occupied and initialize Entity record stored in it.
+		 * @param index Slot index. Slot must exist and be free.
+		 * @param name Name of the Entity.
+		 * @return Pointer to Entity.
+		 */
+		ECS::Entity* ActivateEntitySlot(uint32_t index, std::string_view name);
+
+		/**
+		 * @brief Mark slot as occupied and initialize Entity record stored in it.
+		 * @param index Slot index. Slot must exist and be free.
+		 * @param nameId Id of the Entity's name in the name table.
+		 * @return Pointer to Entity.
+		 */
+		ECS::Entity* ActivateEntitySlot(uint32_t index, NameId nameId);
+
+		/**
+		 * @brief Add Entity in provided slot to the changes saved by SerializeEntityChangesToBinary.
+		 * @param index Slot index.
+		 */
+		void MarkSlotChanged(uint32_t index) {
+			EntitySlot& slot = _entitySlots[index];
+			if (!slot.Changed) {
+				slot.Changed = true;
+				_changedEntities.push_back(index);
+			}
+		}
+
+		/**
+		 * @brief Assign name to Entity in provided slot and add it to name lookups.
+		 * @param index Slot index. Slot must hold an existing Entity without a name.
+		 * @param name Name of the Entity.
+		 */
+		void LinkEntityName(uint32_t index, std::string_view name);
+
+		/**
+		 * @brief Assign interned name to Entity in provided slot and add it to name lookups.
+		 * @param index Slot index. Slot must hold an existing Entity without a name.
+		 * @param nameId Id of the name in the name table.
+		 */
+		void LinkEntityName(uint32_t index, NameId nameId);
 
-		/** @brief Collection of all entities in the system. */
-		std::vector<std::unique_ptr<ECS::IEntity>> _entities;
+		/**
+		 * @brief Remove Entity in provided slot from name lookups. Name is released if no other Entity uses it.
+		 * @param index Slot index. Slot must hold an existing Entity with a name.
+		 */
+		void UnlinkEntityName(uint32_t index);
+
+		/**
+		 * @brief Remove Entity in provided slot from the list of Entities with its name. Slot keeps the name.
+		 * @param index Slot index. Slot must hold an existing Entity with a name.
+		 */
+		void RemoveFromNameList(uint32_t index);
+
+		/**
+		 * @brief Erase name from the name table if no Entity uses it, parked ones included.
+		 * @param nameId Id of the name.
+		 */
+		void ReleaseEntityName(NameId nameId);
 
-		/** @brief Map of component pools indexed by their type. */
-		std::unordered_map<std::type_index, std::unique_ptr<IComponentPool>> _components;
+		/**
+		 * @brief Make name lookups large enough for provided name id.
+		 * @param nameId Id of the name.
+		 */
+		void GrowNameLookups(NameId nameId);
+
+		/**
+		 * @brief Retrieve id of the prefab's Entity pool, creating an empty pool if needed.
+		 * @param prefab Name of the prefab.
+		 * @return Id of the pool.
+		 */
+		NameId GetEntityPoolId(std::string_view prefab);
 
-		/** @brief Map of type information for registered component types. */
-		std::unordered_map<std::type_index, TypeInfo> _typeInfos;
+		/**
+		 * @brief Take parked Entity out of the prefab's pool, reset and activate its Components.
+		 * @param prefab Name of the prefab.
+		 * @param name New name of the Entity.
+		 * @return Pointer to Entity. Returns nullptr if no Entity of the prefab is parked.
+		 */
+		ECS::Entity* ReuseParkedEntity(std::string_view prefab, std::string_view name);
+
+		/**
+		 * @brief Remove parked Entity in provided slot from its prefab's pool, releasing its name.
+		 *
+		 * Its Components are left as they are.
+		 * @param index Slot index. Slot must hold a parked Entity.
+		 */
+		void TakeParkedEntity(uint32_t index);
+
+		/**
+		 * @brief Create Entity with explicitly provided Id.
+		 *
+		 * Used during deserialization to restore Entities under the Ids they were saved with.
+		 * @param entityId Id the Entity should have.
+		 * @param name Name of the Entity.
+		 * @return Pointer to Entity. Returns nullptr if slot is already taken or its index exceeds
+		 * Config::MAX_ENTITY_COUNT.
+		 */
+		ECS::Entity* CreateEntityWithId(size_t entityId, std::string_view name);
+
+		/**
+		 * @brief Find component pool for a specific type.
+		 *
+		 * @tparam T The component type for the pool.
+		 * @return Pointer to the component pool for type T. Returns nullptr if pool doesn't exist.
+		 */
+		template <typename T>
+		ComponentPool<T>* FindPool() {
+			return static_cast<ComponentPool<T>*>(GetPool(GetComponentTypeId<T>()));
+		}
+
+		/**
+		 * @brief Find component pool for a type id.
+		 *
+		 * @param typeId Id of the component type.
+		 * @return Pointer to the component pool. Returns nullptr if pool doesn't exist.
+		 */
+		IComponentPool* GetPool(ComponentTypeId typeId) const {
+			return typeId < _components.size() ? _components[typeId].get() : nullptr;
+		}
 
 		/**
 		 * @brief Get or create a component pool for a specific type.
@@ -395,15 +1507,16 @@ namespace LowEngine::Memory {
 		 */
 		template <typename T>
 		ComponentPool<T>& GetOrCreatePool() {
-			auto typeIdx = std::type_index(typeid(T));
-			auto it = _components.find(typeIdx);
-			if (it == _components.end()) {
-				auto newPool = std::make_unique<ComponentPool<T>>();
-				auto ptr = newPool.get();
-				_components[typeIdx] = std::move(newPool);
-				return *ptr;
+			// makes sure there's a slot for the pool
+			RegisterComponentType<T>();
+
+			std::unique_ptr<IComponentPool>& pool = _components[GetComponentTypeId<T>()];
+			if (pool == nullptr) {
+				pool = std::make_unique<ComponentPool<T>>(Config::COMPONENT_POOL_CHUNK_SIZE, &_arena);
+				pool->SetWorkerPool(_workerPool);
+				_updateScheduleDirty = true;
 			}
-			return *static_cast<ComponentPool<T>*>(it->second.get());
+			return *static_cast<ComponentPool<T>*>(pool.get());
 		}
 
 		/**
@@ -416,18 +1529,106 @@ namespace LowEngine::Memory {
 		 */
 		template <typename T>
 		bool DeserializeComponentFromJSON(size_t entityId, const nlohmann::ordered_json& jsonData) {
-			T* comp = static_cast<T*>(this->GetComponent(entityId, std::type_index(typeid(T))));
+			T* comp = this->GetComponent<T>(entityId);
 			if (comp == nullptr) {
 				comp = this->CreateComponent<T>(entityId);
 			}
 
 			if (comp != nullptr) {
 				comp->DeserializeFromJSON(jsonData);
+				GetOrCreatePool<T>().SetActive(entityId, jsonData.value("Active", true));
 				return true;
 			}
 			_log->error("Failed to deserialize component of type '{}' for entity with id '{}'",
-			            Utils::GetCleanTypeName<T>(), entityId);
+			            ComponentTypeName<T>, entityId);
 			return false;
 		}
+
+		/**
+		 * @brief Recreate Components of type T from records written by IComponentPool::WriteBinary.
+		 *
+		 * @tparam T The component type to deserialize.
+		 * @param in Reader positioned at the record count.
+		 * @return True if all Components were recreated, false otherwise.
+		 */
+		template <typename T>
+		bool DeserializePoolFromBinary(Utils::BinaryReader& in) {
+			uint64_t count = 0;
+			uint32_t binarySize = 0;
+			if (!in.Read(count) || !in.Read(binarySize)) {
+				_log->error("Components of type '{}' are truncated", ComponentTypeName<T>);
+				return false;
+			}
+			if (binarySize != T::BinarySize) {
+				_log->error("Components of type '{}' were saved with {} bytes of state, {} expected",
+				            ComponentTypeName<T>, binarySize, T::BinarySize);
+				return false;
+			}
+
+			if constexpr (T::BinarySize > 0) {
+				constexpr size_t headerSize = sizeof(uint64_t) + sizeof(uint8_t);
+				constexpr size_t recordSize = headerSize + T::BinarySize;
+				const std::byte* records = count <= in.GetRemaining() / recordSize
+					                           ? in.ReadBytes(count * recordSize)
+					                           : nullptr;
+				if (records == nullptr) {
+					_log->error("Components of type '{}' are truncated", ComponentTypeName<T>);
+					return false;
+				}
+
+				std::vector<size_t> entityIds(count);
+				for (size_t record = 0; record < count; ++record) {
+					uint64_t entityId;
+					std::memcpy(&entityId, records + record * recordSize, sizeof(uint64_t));
+					entityIds[record] = entityId;
+				}
+
+				// Components are created in record order, records of skipped Entities are passed over
+				const std::byte* record = records;
+				size_t created = CreateComponents<T>(entityIds, [&record, recordSize](T& component) {
+					uint64_t entityId;
+					for (std::memcpy(&entityId, record, sizeof(uint64_t)); entityId != component.EntityId;
+					     std::memcpy(&entityId, record, sizeof(uint64_t))) {
+						record += recordSize;
+					}
+					component.ReadBinary(record + headerSize);
+				});
+				if (created < count) {
+					return false;
+				}
+
+				ComponentPool<T>& pool = GetOrCreatePool<T>();
+				for (size_t index = 0; index < count; ++index) {
+					if (records[index * recordSize + sizeof(uint64_t)] == std::byte{0}) {
+						pool.SetActive(entityIds[index], false);
+					}
+				}
+				return true;
+			} else {
+				for (uint64_t record = 0; record < count; ++record) {
+					uint64_t entityId = 0;
+					uint8_t active = 0;
+					uint32_t size = 0;
+					const std::byte* packed = nullptr;
+					if (!in.Read(entityId) || !in.Read(active) || !in.Read(size)
+					    || (packed = in.ReadBytes(size)) == nullptr) {
+						_log->error("Components of type '{}' are truncated", ComponentTypeName<T>);
+						return false;
+					}
+
+					auto bytes = reinterpret_cast<const uint8_t*>(packed);
+					nlohmann::ordered_json json = nlohmann::ordered_json::from_msgpack(bytes, bytes + size, true, false);
+					if (json.is_discarded()) {
+						_log->error("Component of type '{}' for entity with id '{}' is corrupted",
+						            ComponentTypeName<T>, entityId);
+						return false;
+					}
+					if (!DeserializeComponentFromJSON<T>(entityId, json)) {
+						return false;
+					}
+				}
+				return true;
+			}
+		}
 	};
 }
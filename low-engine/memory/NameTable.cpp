@@ -0,0 +1,85 @@
+#include "NameTable.h"
+
+#include <algorithm>
+
+namespace LowEngine::Memory {
+	NameTable::NameTable(std::pmr::memory_resource* resource) : _names(resource),
+	                                                           _used(resource),
+	                                                           _freeIds(resource),
+	                                                           _ids(resource) {
+	}
+
+	NameTable::NameTable(const NameTable& other, std::pmr::memory_resource* resource)
+		: _names(other._names, resource),
+		  _used(other._used, resource),
+		  _freeIds(other._freeIds, resource),
+		  _ids(resource) {
+		// keys must view strings owned by this table
+		_ids.reserve(other._ids.size());
+		for (NameId id = 0; id < _names.size(); ++id) {
+			if (_used[id]) {
+				_ids.emplace(_names[id], id);
+			}
+		}
+	}
+
+	NameId NameTable::Intern(std::string_view name) {
+		auto it = _ids.find(name);
+		if (it != _ids.end()) {
+			return it->second;
+		}
+
+		NameId id;
+		if (!_freeIds.empty()) {
+			id = _freeIds.back();
+			_freeIds.pop_back();
+			_names[id].assign(name);
+			_used[id] = true;
+		} else {
+			id = static_cast<NameId>(_names.size());
+			_names.emplace_back(name);
+			_used.push_back(true);
+		}
+
+		_ids.emplace(_names[id], id);
+		return id;
+	}
+
+	NameId NameTable::Find(std::string_view name) const {
+		auto it = _ids.find(name);
+		return it != _ids.end() ? it->second : INVALID_NAME_ID;
+	}
+
+	std::string_view NameTable::GetName(NameId id) const {
+		if (id >= _names.size() || !_used[id]) {
+			return {};
+		}
+		return _names[id];
+	}
+
+	void NameTable::Erase(NameId id) {
+		if (id >= _names.size() || !_used[id]) {
+			return;
+		}
+
+		_ids.erase(_names[id]);
+		// release heap storage of long names, the slot may not be reused soon
+		_names[id].clear();
+		_names[id].shrink_to_fit();
+		_used[id] = false;
+		_freeIds.push_back(id);
+	}
+
+	void NameTable::Reserve(size_t additional) {
+		size_t reused = std::min(additional, _freeIds.size());
+		_used.reserve(_used.size() + additional - reused);
+		_ids.reserve(_ids.size() + additional);
+	}
+
+	void NameTable::Clear() {
+		_ids.clear();
+		_names.clear();
+		_used.clear();
+		_freeIds.clear();
+	}
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace LowEngine::Memory {
+	/**
+	 * @brief Identifier of a string interned in a NameTable.
+	 *
+	 * Ids are dense, so they can be used to index arrays. Ids of erased strings are reused.
+	 */
+	using NameId = uint32_t;
+
+	/**
+	 * @brief Value used for "no name".
+	 */
+	inline constexpr NameId INVALID_NAME_ID = std::numeric_limits<NameId>::max();
+
+	/**
+	 * @brief Table of interned strings, owning a single copy of every distinct string.
+	 *
+	 * Strings are compared and stored as ids, lookups of ids by string are hashed. Strings never move,
+	 * so views returned by GetName stay valid until the string is erased.
+	 * Storage is allocated from the memory resource provided on construction.
+	 */
+	class NameTable {
+	public:
+		explicit NameTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		NameTable(const NameTable& other, std::pmr::memory_resource* resource);
+
+		NameTable(const NameTable&) = delete;
+		NameTable& operator=(const NameTable&) = delete;
+
+		/**
+		 * @brief Retrieve id of provided string, adding it to the table if needed.
+		 * @param name String to intern.
+		 * @return Id of the string.
+		 */
+		NameId Intern(std::string_view name);
+
+		/**
+		 * @brief Retrieve id of provided string without adding it.
+		 * @param name String to look up.
+		 * @return Id of the string. INVALID_NAME_ID if string isn't in the table.
+		 */
+		[[nodiscard]] NameId Find(std::string_view name) const;
+
+		/**
+		 * @brief Retrieve string with provided id.
+		 * @param id Id of the string.
+		 * @return View of the string. Empty if id isn't used.
+		 */
+		[[nodiscard]] std::string_view GetName(NameId id) const;
+
+		/**
+		 * @brief Remove string from the table. Its id will be reused by one of the following strings.
+		 * @param id Id of the string.
+		 */
+		void Erase(NameId id);
+
+		/**
+		 * @brief Retrieve number of strings in the table.
+		 * @return Number of strings.
+		 */
+		[[nodiscard]] size_t GetCount() const {
+			return _ids.size();
+		}
+
+		/**
+		 * @brief Make sure that provided number of new strings can be added without rehashing the lookup.
+		 * @param additional Number of strings that will be added.
+		 */
+		void Reserve(size_t additional);
+
+		/**
+		 * @brief Remove all strings.
+		 */
+		void Clear();
+
+	protected:
+		/**
+		 * @brief Strings indexed by their id. Deque keeps strings in place, so views into them stay valid.
+		 */
+		std::pmr::deque<std::pmr::string> _names;
+
+		/** @brief Is the id used? Parallel to _names. */
+		std::pmr::vector<bool> _used;
+
+		/** @brief Ids of erased strings, reused in LIFO order. */
+		std::pmr::vector<NameId> _freeIds;
+
+		/** @brief Ids of strings, keyed by views into _names. */
+		std::pmr::unordered_map<std::string_view, NameId> _ids;
+	};
+}
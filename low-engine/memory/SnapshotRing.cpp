@@ -0,0 +1,199 @@
+#include "SnapshotRing.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "memory/Memory.h"
+
+namespace LowEngine::Memory {
+	SnapshotRing::SnapshotRing(Memory& memory, std::vector<ComponentTypeId> typeIds, size_t capacity,
+	                           size_t keyframeInterval) : _memory(memory),
+	                                                      _typeIds(std::move(typeIds)),
+	                                                      _keyframeInterval(std::max<size_t>(keyframeInterval, 1)),
+	                                                      _frames(std::max<size_t>(capacity, 1)) {
+	}
+
+	bool SnapshotRing::Capture(uint64_t tick) {
+		if (_count > 0 && tick <= GetNewestTick()) {
+			// re-simulating after restore, this and newer ticks are no longer valid
+			_count = LowerBound(tick);
+			// newest state isn't kept anymore, next tick is stored in full
+			_previous.clear();
+		}
+
+		if (!_memory.WriteSnapshot(_current, _typeIds)) {
+			return false;
+		}
+
+		// reuse storage of the oldest tick once the ring is full
+		if (_count == _frames.size()) {
+			_first = (_first + 1) % _frames.size();
+			_count--;
+		}
+
+		Frame& frame = FrameAt(_count);
+		frame.Tick = tick;
+		frame.IsKeyframe = _count == 0 || _previous.size() != _current.size()
+		                   || _deltasSinceKeyframe + 1 >= _keyframeInterval;
+		if (!frame.IsKeyframe) {
+			EncodeDelta(_current, _previous, frame.Data);
+			// delta of a mostly changed state isn't worth decoding
+			frame.IsKeyframe = frame.Data.size() >= _current.size();
+		}
+
+		if (frame.IsKeyframe) {
+			frame.Data.assign(_current.begin(), _current.end());
+			_deltasSinceKeyframe = 0;
+		} else {
+			_deltasSinceKeyframe++;
+		}
+
+		_count++;
+		std::swap(_previous, _current);
+		return true;
+	}
+
+	bool SnapshotRing::Restore(uint64_t tick) {
+		size_t position = FindPosition(tick);
+		if (position == _count) {
+			_log->error("Snapshot for tick {} not found", tick);
+			return false;
+		}
+
+		size_t keyframe = FindKeyframe(position);
+		if (keyframe == _count) {
+			_log->error("Snapshot for tick {} can't be restored: its full snapshot was dropped", tick);
+			return false;
+		}
+
+		const Frame& base = FrameAt(keyframe);
+		_current.assign(base.Data.begin(), base.Data.end());
+		for (size_t i = keyframe + 1; i <= position; ++i) {
+			ApplyDelta(_current, FrameAt(i).Data);
+		}
+
+		if (!_memory.ReadSnapshot(_current)) {
+			return false;
+		}
+
+		// newer ticks are dropped, following captures continue from the restored one
+		_count = position + 1;
+		_deltasSinceKeyframe = position - keyframe;
+		std::swap(_previous, _current);
+		return true;
+	}
+
+	bool SnapshotRing::Contains(uint64_t tick) const {
+		size_t position = FindPosition(tick);
+		return position < _count && FindKeyframe(position) < _count;
+	}
+
+	uint64_t SnapshotRing::GetNewestTick() const {
+		return _count > 0 ? FrameAt(_count - 1).Tick : 0;
+	}
+
+	size_t SnapshotRing::GetStoredBytes() const {
+		size_t bytes = 0;
+		for (size_t i = 0; i < _count; ++i) {
+			bytes += FrameAt(i).Data.size();
+		}
+		return bytes;
+	}
+
+	void SnapshotRing::Clear() {
+		_first = 0;
+		_count = 0;
+		_deltasSinceKeyframe = 0;
+		_previous.clear();
+	}
+
+	size_t SnapshotRing::FindPosition(uint64_t tick) const {
+		size_t position = LowerBound(tick);
+		return position < _count && FrameAt(position).Tick == tick ? position : _count;
+	}
+
+	size_t SnapshotRing::LowerBound(uint64_t tick) const {
+		// ticks grow from the oldest frame to the newest one
+		size_t low = 0;
+		size_t high = _count;
+		while (low < high) {
+			size_t middle = low + (high - low) / 2;
+			if (FrameAt(middle).Tick < tick) {
+				low = middle + 1;
+			} else {
+				high = middle;
+			}
+		}
+
+		return low;
+	}
+
+	size_t SnapshotRing::FindKeyframe(size_t position) const {
+		for (size_t i = position + 1; i > 0; --i) {
+			if (FrameAt(i - 1).IsKeyframe) {
+				return i - 1;
+			}
+		}
+		return _count;
+	}
+
+	void SnapshotRing::EncodeDelta(const std::vector<std::byte>& current, const std::vector<std::byte>& previous,
+	                               std::vector<std::byte>& out) {
+		// layout: repeated unchanged byte count, changed byte count and changed bytes
+		out.clear();
+		auto append = [&out](const void* data, size_t size) {
+			size_t offset = out.size();
+			out.resize(offset + size);
+			std::memcpy(out.data() + offset, data, size);
+		};
+
+		const size_t size = current.size();
+		size_t i = 0;
+		while (i < size) {
+			size_t unchangedStart = i;
+			// skip unchanged words first, most of the state doesn't change between ticks
+			while (i + sizeof(uint64_t) <= size
+			       && std::memcmp(current.data() + i, previous.data() + i, sizeof(uint64_t)) == 0) {
+				i += sizeof(uint64_t);
+			}
+			while (i < size && current[i] == previous[i]) {
+				i++;
+			}
+			if (i == size) {
+				break;
+			}
+
+			size_t changedStart = i;
+			size_t changedEnd = i + 1;
+			for (size_t j = i + 1; j < size && j - changedEnd < MIN_UNCHANGED_RUN; ++j) {
+				if (current[j] != previous[j]) {
+					changedEnd = j + 1;
+				}
+			}
+
+			auto unchanged = static_cast<uint32_t>(changedStart - unchangedStart);
+			auto changed = static_cast<uint32_t>(changedEnd - changedStart);
+			append(&unchanged, sizeof(unchanged));
+			append(&changed, sizeof(changed));
+			append(current.data() + changedStart, changed);
+			i = changedEnd;
+		}
+	}
+
+	void SnapshotRing::ApplyDelta(std::vector<std::byte>& state, const std::vector<std::byte>& delta) {
+		size_t offset = 0;
+		size_t position = 0;
+		while (offset < delta.size()) {
+			uint32_t unchanged = 0;
+			uint32_t changed = 0;
+			std::memcpy(&unchanged, delta.data() + offset, sizeof(unchanged));
+			std::memcpy(&changed, delta.data() + offset + sizeof(unchanged), sizeof(changed));
+			offset += sizeof(unchanged) + sizeof(changed);
+
+			position += unchanged;
+			std::memcpy(state.data() + position, delta.data() + offset, changed);
+			position += changed;
+			offset += changed;
+		}
+	}
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "EngineConfig.h"
+#include "memory/ComponentTypeId.h"
+
+namespace LowEngine::Memory {
+	class Memory;
+
+	/**
+	 * @brief Ring buffer of per-tick snapshots of Component state, for rewind, rollback and replays.
+	 *
+	 * Every captured tick holds the state of Components of selected types, see Memory::WriteSnapshot.
+	 * Most ticks are stored as a delta against the previous tick: only runs of bytes that changed are stored,
+	 * together with offsets of the runs. Every Config::SNAPSHOT_KEYFRAME_INTERVAL ticks, and whenever
+	 * the layout changes, a full snapshot is stored instead.
+	 *
+	 * Storage of all ticks is reused once the ring wrapped around, so capturing at a steady rate doesn't allocate.
+	 * Deltas stored before the oldest full snapshot can't be restored, see Contains.
+	 *
+	 * Structural changes are not rolled back: only state of Components is captured, not which Entities and
+	 * Components exist. A tick can't be restored once Components of a captured type were created or destroyed
+	 * after it, so spawning and despawning have to be re-simulated by the caller.
+	 */
+	class SnapshotRing {
+	public:
+		/**
+		 * @brief Create ring buffer for snapshots of provided Memory manager.
+		 * @param memory Memory manager to capture and restore. Must outlive the ring.
+		 * @param typeIds Ids of Component types to capture. Types must support snapshots.
+		 * @param capacity Number of ticks to keep.
+		 * @param keyframeInterval Number of ticks between full snapshots.
+		 */
+		SnapshotRing(Memory& memory, std::vector<ComponentTypeId> typeIds,
+		             size_t capacity = Config::SNAPSHOT_RING_CAPACITY,
+		             size_t keyframeInterval = Config::SNAPSHOT_KEYFRAME_INTERVAL);
+
+		/**
+		 * @brief Capture state of the Memory manager as provided tick.
+		 *
+		 * Ticks are expected to grow. Capturing a tick that is not newer than the newest one drops it and all newer
+		 * ticks first, which is what re-simulating after a restore does. Oldest tick is dropped if the ring is full.
+		 * @param tick Tick the state belongs to.
+		 * @return True if state was captured.
+		 */
+		bool Capture(uint64_t tick);
+
+		/**
+		 * @brief Restore state of the Memory manager captured as provided tick.
+		 *
+		 * Ticks newer than the restored one are dropped, so the simulation can continue from it. Restore fails and
+		 * keeps all ticks if Components of captured types were created or destroyed since the tick was captured.
+		 * @param tick Tick to restore.
+		 * @return True if state was restored.
+		 */
+		bool Restore(uint64_t tick);
+
+		/**
+		 * @brief Check if provided tick can be restored.
+		 * @param tick Tick to check.
+		 * @return True if tick is stored and its full snapshot wasn't dropped.
+		 */
+		[[nodiscard]] bool Contains(uint64_t tick) const;
+
+		/**
+		 * @brief Retrieve number of stored ticks.
+		 * @return Number of ticks.
+		 */
+		[[nodiscard]] size_t GetSize() const {
+			return _count;
+		}
+
+		/**
+		 * @brief Retrieve maximal number of stored ticks.
+		 * @return Number of ticks.
+		 */
+		[[nodiscard]] size_t GetCapacity() const {
+			return _frames.size();
+		}
+
+		/**
+		 * @brief Retrieve newest stored tick.
+		 * @return Newest tick. 0 if ring is empty.
+		 */
+		[[nodiscard]] uint64_t GetNewestTick() const;
+
+		/**
+		 * @brief Retrieve number of bytes used by stored ticks.
+		 * @return Number of bytes.
+		 */
+		[[nodiscard]] size_t GetStoredBytes() const;
+
+		/**
+		 * @brief Drop all stored ticks. Storage is kept for reuse.
+		 */
+		void Clear();
+
+	protected:
+		/**
+		 * @brief Minimal number of unchanged bytes that ends a run of changed bytes in a delta.
+		 *
+		 * Shorter runs are cheaper to keep in the changed bytes than to encode as a separate run.
+		 */
+		static constexpr size_t MIN_UNCHANGED_RUN = 8;
+
+		/**
+		 * @brief Single stored tick.
+		 */
+		struct Frame {
+			uint64_t Tick = 0;
+			/** @brief Is Data a full snapshot, rather than a delta against the previous tick? */
+			bool IsKeyframe = false;
+			std::vector<std::byte> Data;
+		};
+
+		Memory& _memory;
+		std::vector<ComponentTypeId> _typeIds;
+		size_t _keyframeInterval;
+
+		/** @brief Ring of stored ticks, oldest at _first. */
+		std::vector<Frame> _frames;
+		size_t _first = 0;
+		size_t _count = 0;
+
+		/** @brief Number of deltas stored since the last full snapshot. */
+		size_t _deltasSinceKeyframe = 0;
+
+		/** @brief Full snapshot of the newest tick, base for the next delta. */
+		std::vector<std::byte> _previous;
+
+		/** @brief Full snapshot being captured or decoded. */
+		std::vector<std::byte> _current;
+
+		/**
+		 * @brief Retrieve frame at provided position, counted from the oldest one.
+		 */
+		Frame& FrameAt(size_t position) {
+			return _frames[(_first + position) % _frames.size()];
+		}
+
+		[[nodiscard]] const Frame& FrameAt(size_t position) const {
+			return _frames[(_first + position) % _frames.size()];
+		}
+
+		/**
+		 * @brief Find position of the frame with provided tick.
+		 * @return Position counted from the oldest frame. _count if tick isn't stored.
+		 */
+		[[nodiscard]] size_t FindPosition(uint64_t tick) const;
+
+		/**
+		 * @brief Find position of the oldest frame with tick not older than provided one.
+		 * @return Position counted from the oldest frame. _count if all ticks are older.
+		 */
+		[[nodiscard]] size_t LowerBound(uint64_t tick) const;
+
+		/**
+		 * @brief Find position of the full snapshot that frame at provided position is decoded from.
+		 * @return Position counted from the oldest frame. _count if it was dropped.
+		 */
+		[[nodiscard]] size_t FindKeyframe(size_t position) const;
+
+		/**
+		 * @brief Encode current state as delta against previous one.
+		 * @param[out] out Buffer for the delta.
+		 */
+		static void EncodeDelta(const std::vector<std::byte>& current, const std::vector<std::byte>& previous,
+		                        std::vector<std::byte>& out);
+
+		/**
+		 * @brief Apply delta to the previous state, turning it into the state the delta was encoded from.
+		 * @param[in,out] state Previous state.
+		 * @param delta Delta written by EncodeDelta.
+		 */
+		static void ApplyDelta(std::vector<std::byte>& state, const std::vector<std::byte>& delta);
+	};
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+
+#include "EngineConfig.h"
+
+namespace LowEngine::Memory {
+	/**
+	 * @brief Growable array of trivially copyable values, building block of structure-of-arrays Component storage.
+	 *
+	 * Data starts on a cache line, so loops over whole arrays can use aligned vector loads. Storage is allocated
+	 * from the memory resource provided on construction.
+	 * @tparam T Type of values.
+	 */
+	template <typename T>
+	class SoAArray {
+		static_assert(std::is_trivially_copyable_v<T>, "SoAArray only holds trivially copyable values");
+
+	public:
+		/**
+		 * @brief Alignment of the data.
+		 */
+		static constexpr size_t ALIGNMENT = std::max(Config::CACHE_LINE_SIZE, alignof(T));
+
+		explicit SoAArray(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			: _resource(resource) {
+		}
+
+		SoAArray(const SoAArray& other, std::pmr::memory_resource* resource) : _resource(resource) {
+			Reserve(other._size);
+			if (other._size > 0) {
+				std::memcpy(_data, other._data, other._size * sizeof(T));
+			}
+			_size = other._size;
+		}
+
+		SoAArray(const SoAArray&) = delete;
+		SoAArray& operator=(const SoAArray&) = delete;
+
+		~SoAArray() {
+			if (_data != nullptr) {
+				_resource->deallocate(_data, _capacity * sizeof(T), ALIGNMENT);
+			}
+		}
+
+		T& operator[](size_t index) {
+			return _data[index];
+		}
+
+		const T& operator[](size_t index) const {
+			return _data[index];
+		}
+
+		/**
+		 * @brief Retrieve number of values.
+		 * @return Number of values.
+		 */
+		[[nodiscard]] size_t GetSize() const {
+			return _size;
+		}
+
+		/**
+		 * @brief Retrieve number of values that fit without reallocating.
+		 * @return Number of values.
+		 */
+		[[nodiscard]] size_t GetCapacity() const {
+			return _capacity;
+		}
+
+		/**
+		 * @brief Retrieve all values as a span. Span is invalidated when the array grows or shrinks.
+		 * @return Span over all values.
+		 */
+		[[nodiscard]] std::span<T> GetSpan() {
+			return {_data, _size};
+		}
+
+		[[nodiscard]] std::span<const T> GetSpan() const {
+			return {_data, _size};
+		}
+
+		/**
+		 * @brief Append value, growing the storage if needed.
+		 * @param value Value to append.
+		 */
+		void PushBack(T value) {
+			if (_size == _capacity) {
+				Reallocate(std::max<size_t>(_capacity * 2, Config::CACHE_LINE_SIZE / sizeof(T)));
+			}
+			_data[_size++] = value;
+		}
+
+		/**
+		 * @brief Remove the last value.
+		 */
+		void PopBack() {
+			_size--;
+		}
+
+		/**
+		 * @brief Swap two values.
+		 */
+		void Swap(size_t first, size_t second) {
+			std::swap(_data[first], _data[second]);
+		}
+
+		/**
+		 * @brief Make sure that provided number of values fits without reallocating.
+		 * @param capacity Total number of values.
+		 */
+		void Reserve(size_t capacity) {
+			if (capacity > _capacity) {
+				Reallocate(capacity);
+			}
+		}
+
+		/**
+		 * @brief Release storage not used by current values.
+		 */
+		void ShrinkToFit() {
+			if (_size < _capacity) {
+				Reallocate(_size);
+			}
+		}
+
+	protected:
+		std::pmr::memory_resource* _resource;
+		T* _data = nullptr;
+		size_t _size = 0;
+		size_t _capacity = 0;
+
+		void Reallocate(size_t capacity) {
+			T* data = capacity > 0 ? static_cast<T*>(_resource->allocate(capacity * sizeof(T), ALIGNMENT)) : nullptr;
+			if (_size > 0) {
+				std::memcpy(data, _data, _size * sizeof(T));
+			}
+			if (_data != nullptr) {
+				_resource->deallocate(_data, _capacity * sizeof(T), ALIGNMENT);
+			}
+			_data = data;
+			_capacity = capacity;
+		}
+	};
+}
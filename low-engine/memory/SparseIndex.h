@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "EngineConfig.h"
+
+namespace LowEngine::Memory {
+	/**
+	 * @brief Paged sparse array mapping Entity Id to a dense slot.
+	 *
+	 * Sparse half of the sparse-set used by Component Pools. Keys are split into a page number and an offset
+	 * inside that page. Pages are allocated only when a key falling into them is first assigned, so
+	 * large Entity Ids don't force allocation of the whole key range.
+	 *
+	 * Lookup is two array reads, without hashing. Pages are allocated from the memory resource provided on
+	 * construction.
+	 */
+	class SparseIndex {
+	public:
+		/**
+		 * @brief Number of keys stored in a single page. Must be a power of two.
+		 */
+		static constexpr size_t PAGE_SIZE = 4096;
+		static_assert((PAGE_SIZE & (PAGE_SIZE - 1)) == 0, "SparseIndex::PAGE_SIZE must be a power of two");
+
+		/**
+		 * @brief Value returned for keys that are not present in the index.
+		 */
+		static constexpr size_t NOT_FOUND = Config::INVALID_ID;
+
+		explicit SparseIndex(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			: _pages(resource) {
+		}
+
+		SparseIndex(const SparseIndex& other, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+			: _pages(other._pages.size(), nullptr, resource) {
+			for (size_t i = 0; i < other._pages.size(); ++i) {
+				if (other._pages[i] != nullptr) {
+					_pages[i] = AllocatePage();
+					std::copy_n(other._pages[i], PAGE_SIZE, _pages[i]);
+				}
+			}
+		}
+
+		SparseIndex(SparseIndex&& other) noexcept : _pages(std::move(other._pages)) {
+			other._pages.clear();
+		}
+
+		SparseIndex& operator=(SparseIndex&& other) noexcept {
+			if (this != &other) {
+				// pages belong to the resource of their index, so they can only be taken over from the same one
+				if (_pages.get_allocator() == other._pages.get_allocator()) {
+					Clear();
+					std::swap(_pages, other._pages);
+				} else {
+					*this = SparseIndex(other, _pages.get_allocator().resource());
+					other.Clear();
+				}
+			}
+			return *this;
+		}
+
+		~SparseIndex() {
+			Clear();
+		}
+
+		/**
+		 * @brief Retrieve value stored for the key.
+		 * @param key Key to look up.
+		 * @return Stored value. Returns NOT_FOUND if key is not present.
+		 */
+		[[nodiscard]] size_t Get(size_t key) const {
+			size_t page = key / PAGE_SIZE;
+			if (page >= _pages.size() || _pages[page] == nullptr) {
+				return NOT_FOUND;
+			}
+			return _pages[page][key & (PAGE_SIZE - 1)];
+		}
+
+		/**
+		 * @brief Check if key is present in the index.
+		 * @param key Key to look up.
+		 * @return True if key has a value assigned.
+		 */
+		[[nodiscard]] bool Contains(size_t key) const {
+			return Get(key) != NOT_FOUND;
+		}
+
+		/**
+		 * @brief Assign value to the key. Allocates the page if needed.
+		 * @param key Key to assign.
+		 * @param value Value to store. Must be different from NOT_FOUND.
+		 */
+		void Set(size_t key, size_t value) {
+			size_t page = key / PAGE_SIZE;
+			if (page >= _pages.size()) {
+				_pages.resize(page + 1);
+			}
+			if (_pages[page] == nullptr) {
+				_pages[page] = AllocatePage();
+				std::fill_n(_pages[page], PAGE_SIZE, NOT_FOUND);
+			}
+			_pages[page][key & (PAGE_SIZE - 1)] = value;
+		}
+
+		/**
+		 * @brief Remove key from the index. Pages are kept for future reuse.
+		 * @param key Key to remove.
+		 */
+		void Erase(size_t key) {
+			size_t page = key / PAGE_SIZE;
+			if (page < _pages.size() && _pages[page] != nullptr) {
+				_pages[page][key & (PAGE_SIZE - 1)] = NOT_FOUND;
+			}
+		}
+
+		/**
+		 * @brief Retrieve number of bytes allocated by the index.
+		 * @return Size of allocated pages and of the page table.
+		 */
+		[[nodiscard]] size_t GetReservedBytes() const {
+			size_t pages = std::count_if(_pages.begin(), _pages.end(), [](const size_t* page) {
+				return page != nullptr;
+			});
+			return pages * PAGE_SIZE * sizeof(size_t) + _pages.capacity() * sizeof(size_t*);
+		}
+
+		/**
+		 * @brief Release pages without any key and trim the page table.
+		 */
+		void ShrinkToFit() {
+			std::pmr::memory_resource* resource = _pages.get_allocator().resource();
+			for (size_t*& page: _pages) {
+				if (page != nullptr && std::all_of(page, page + PAGE_SIZE, [](size_t value) {
+					return value == NOT_FOUND;
+				})) {
+					resource->deallocate(page, PAGE_SIZE * sizeof(size_t), alignof(size_t));
+					page = nullptr;
+				}
+			}
+
+			while (!_pages.empty() && _pages.back() == nullptr) {
+				_pages.pop_back();
+			}
+			_pages.shrink_to_fit();
+		}
+
+		/**
+		 * @brief Remove all keys and release all pages.
+		 */
+		void Clear() {
+			std::pmr::memory_resource* resource = _pages.get_allocator().resource();
+			for (size_t* page: _pages) {
+				if (page != nullptr) {
+					resource->deallocate(page, PAGE_SIZE * sizeof(size_t), alignof(size_t));
+				}
+			}
+			_pages.clear();
+		}
+
+	protected:
+		/**
+		 * @brief Collection of pages. Page that was never used is nullptr.
+		 */
+		std::pmr::vector<size_t*> _pages;
+
+		/**
+		 * @brief Allocate uninitialized page from the memory resource of the index.
+		 */
+		size_t* AllocatePage() {
+			return static_cast<size_t*>(
+				_pages.get_allocator().resource()->allocate(PAGE_SIZE * sizeof(size_t), alignof(size_t)));
+		}
+	};
+}
@@ -0,0 +1,100 @@
+#include "UpdateSchedule.h"
+
+#include <algorithm>
+
+namespace LowEngine::Memory {
+	namespace {
+		bool Contains(const std::vector<ComponentTypeId>& types, ComponentTypeId typeId) {
+			return std::find(types.begin(), types.end(), typeId) != types.end();
+		}
+
+		bool IsWriting(const UpdateSchedule::PoolAccess& pool, ComponentTypeId typeId) {
+			if (pool.TypeId == typeId || Contains(pool.Writes, typeId)) {
+				return true;
+			}
+			return !pool.DependenciesReadOnly && Contains(pool.Dependencies, typeId);
+		}
+
+		bool IsAccessing(const UpdateSchedule::PoolAccess& pool, ComponentTypeId typeId) {
+			return IsWriting(pool, typeId) || Contains(pool.Dependencies, typeId) || Contains(pool.Reads, typeId);
+		}
+
+		bool IsWritingAnyAccessedBy(const UpdateSchedule::PoolAccess& writer, const UpdateSchedule::PoolAccess& other) {
+			auto isWrittenAndAccessed = [&writer, &other](ComponentTypeId typeId) {
+				return IsWriting(writer, typeId) && IsAccessing(other, typeId);
+			};
+			if (isWrittenAndAccessed(writer.TypeId)) {
+				return true;
+			}
+			return std::any_of(writer.Writes.begin(), writer.Writes.end(), isWrittenAndAccessed) ||
+			       std::any_of(writer.Dependencies.begin(), writer.Dependencies.end(), isWrittenAndAccessed);
+		}
+	}
+
+	bool UpdateSchedule::IsConflicting(const PoolAccess& a, const PoolAccess& b) {
+		return IsWritingAnyAccessedBy(a, b) || IsWritingAnyAccessedBy(b, a);
+	}
+
+	void UpdateSchedule::Build(const std::vector<PoolAccess>& pools) {
+		_stages.clear();
+
+		// order pools so that dependencies come first, ties broken by name
+		std::vector<const PoolAccess*> ordered;
+		ordered.reserve(pools.size());
+		std::vector<bool> placed(pools.size(), false);
+
+		while (ordered.size() < pools.size()) {
+			const PoolAccess* next = nullptr;
+			size_t nextIndex = 0;
+			for (size_t i = 0; i < pools.size(); ++i) {
+				if (placed[i]) continue;
+
+				bool ready = std::none_of(pools[i].Dependencies.begin(), pools[i].Dependencies.end(),
+				                          [&](ComponentTypeId dependency) {
+					                          for (size_t j = 0; j < pools.size(); ++j) {
+						                          if (!placed[j] && pools[j].TypeId == dependency) return true;
+					                          }
+					                          return false;
+				                          });
+				if (ready && (next == nullptr || pools[i].TypeName < next->TypeName)) {
+					next = &pools[i];
+					nextIndex = i;
+				}
+			}
+
+			if (next == nullptr) {
+				// dependency cycle, can't happen with template dependencies. Place remaining pools by name.
+				for (size_t i = 0; i < pools.size(); ++i) {
+					if (!placed[i] && (next == nullptr || pools[i].TypeName < next->TypeName)) {
+						next = &pools[i];
+						nextIndex = i;
+					}
+				}
+			}
+
+			placed[nextIndex] = true;
+			ordered.push_back(next);
+		}
+
+		// each pool goes to the stage right after the last pool it conflicts with
+		std::vector<size_t> stageOf(ordered.size(), 0);
+		for (size_t i = 0; i < ordered.size(); ++i) {
+			for (size_t j = 0; j < i; ++j) {
+				if (IsConflicting(*ordered[i], *ordered[j])) {
+					stageOf[i] = std::max(stageOf[i], stageOf[j] + 1);
+				}
+			}
+
+			if (stageOf[i] >= _stages.size()) {
+				_stages.resize(stageOf[i] + 1);
+			}
+
+			Stage& stage = _stages[stageOf[i]];
+			if (ordered[i]->WorkerThreadSafe) {
+				stage.Workers.push_back(ordered[i]->TypeId);
+			} else {
+				stage.MainThread.push_back(ordered[i]->TypeId);
+			}
+		}
+	}
+}
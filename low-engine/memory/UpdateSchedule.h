@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "memory/ComponentTypeId.h"
+
+namespace LowEngine::Memory {
+	/**
+	 * @brief Order in which Component Pools are updated.
+	 *
+	 * Pools are grouped into stages. Pools in the same stage don't conflict with each other and can be updated
+	 * concurrently. Stages run one after another. Two pools conflict if one of them writes a Component type the other
+	 * one reads or writes. Every pool writes its own type and types it depends on, unless it declares its dependencies
+	 * as read-only.
+	 *
+	 * Pools are ordered by their dependencies first, then by type name, so the schedule doesn't depend
+	 * on the order in which pools were created.
+	 */
+	class UpdateSchedule {
+	public:
+		/**
+		 * @brief Description of what pool's Update and FixedUpdate access.
+		 */
+		struct PoolAccess {
+			ComponentTypeId TypeId = INVALID_COMPONENT_TYPE_ID;
+			std::string_view TypeName;
+			std::vector<ComponentTypeId> Dependencies;
+			std::vector<ComponentTypeId> Reads;
+			std::vector<ComponentTypeId> Writes;
+			bool DependenciesReadOnly = false;
+			bool WorkerThreadSafe = false;
+		};
+
+		/**
+		 * @brief Set of pools that can be updated at the same time.
+		 */
+		struct Stage {
+			/** @brief Pools that must be updated on the main thread, in order. */
+			std::vector<ComponentTypeId> MainThread;
+			/** @brief Pools that can be updated on worker threads. */
+			std::vector<ComponentTypeId> Workers;
+		};
+
+		/**
+		 * @brief Build schedule for provided pools.
+		 * @param pools Access description of every pool to schedule.
+		 */
+		void Build(const std::vector<PoolAccess>& pools);
+
+		/**
+		 * @brief Retrieve stages of the schedule, in order of execution.
+		 * @return Reference to collection of stages.
+		 */
+		[[nodiscard]] const std::vector<Stage>& GetStages() const {
+			return _stages;
+		}
+
+		/**
+		 * @brief Check if two pools can't be updated at the same time.
+		 * @param a Access description of the first pool.
+		 * @param b Access description of the second pool.
+		 * @return True if one of the pools writes a type the other one reads or writes.
+		 */
+		static bool IsConflicting(const PoolAccess& a, const PoolAccess& b);
+
+	protected:
+		std::vector<Stage> _stages;
+	};
+}
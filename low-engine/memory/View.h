@@ -0,0 +1,182 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+#include "memory/ComponentPool.h"
+#include "memory/ComponentSignature.h"
+#include "memory/ComponentTypeId.h"
+#include "ecs/EntityId.h"
+
+namespace LowEngine::Memory {
+	/**
+	 * @brief Iterable join of several Component Pools.
+	 *
+	 * View iterates Entities of the smallest of the joined pools and looks up the remaining components
+	 * directly through the other pools' sparse indices. Only Entities that own all requested components are visited.
+	 * When View is given Entity signatures, Entities missing any of the components are rejected with a signature
+	 * test, before any pool lookup.
+	 *
+	 * Each step yields a tuple of Entity Id and references to the components, so it can be used with
+	 * structured bindings:
+	 * @code
+	 * for (auto [entityId, transform, sprite] : memory.View<TransformComponent, SpriteComponent>()) { ... }
+	 * @endcode
+	 *
+	 * View doesn't own any data. Creating or destroying components of the viewed types while iterating
+	 * invalidates the View.
+	 * @tparam Ts Types of the Components to join.
+	 */
+	template <typename... Ts>
+	class ComponentView {
+		static_assert(sizeof...(Ts) > 0, "ComponentView requires at least one Component type");
+
+	public:
+		/**
+		 * @brief Value produced by each iteration step: Entity Id followed by references to its components.
+		 */
+		using Value = std::tuple<size_t, Ts&...>;
+
+		class Iterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = Value;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = Value;
+
+			Iterator() = default;
+
+			Iterator(const ComponentView* view, size_t position) : _view(view), _position(position) {
+				SkipIncomplete();
+			}
+
+			Value operator*() const {
+				return std::apply([this](Ts*... components) {
+					return Value((*_view->_driver)[_position], *components...);
+				}, _current);
+			}
+
+			Iterator& operator++() {
+				++_position;
+				SkipIncomplete();
+				return *this;
+			}
+
+			Iterator operator++(int) {
+				Iterator copy = *this;
+				++*this;
+				return copy;
+			}
+
+			bool operator==(const Iterator& other) const {
+				return _position == other._position;
+			}
+
+		private:
+			const ComponentView* _view = nullptr;
+			size_t _position = 0;
+			std::tuple<Ts*...> _current{};
+
+			/**
+			 * @brief Advance position to the first Entity that owns all joined components.
+			 */
+			void SkipIncomplete() {
+				const size_t end = _view->_driver->size();
+				for (; _position < end; ++_position) {
+					size_t entityId = (*_view->_driver)[_position];
+					if (_view->Resolve(entityId, _current)) {
+						return;
+					}
+				}
+			}
+		};
+
+		/**
+		 * @brief Create View over provided pools.
+		 * @param pools Pointers to joined pools. Any nullptr makes the View empty.
+		 */
+		explicit ComponentView(ComponentPool<Ts>*... pools) : ComponentView(nullptr, pools...) {
+		}
+
+		/**
+		 * @brief Create View over provided pools, pre-filtering Entities on their signatures.
+		 * @param signatures Pointer to Entity signatures, indexed by Entity's slot index. Can be nullptr.
+		 * @param pools Pointers to joined pools. Any nullptr makes the View empty.
+		 */
+		ComponentView(const std::pmr::vector<ComponentSignature>* signatures, ComponentPool<Ts>*... pools)
+			: _pools(pools...), _signatures(signatures) {
+			(_mask.Set(GetComponentTypeId<Ts>()), ...);
+
+			bool anyMissing = ((pools == nullptr) || ...);
+			if (anyMissing) {
+				return;
+			}
+
+			// drive iteration with the smallest pool
+			std::array<const std::pmr::vector<size_t>*, sizeof...(Ts)> candidates = {&pools->GetEntityIds()...};
+			_driver = candidates[0];
+			for (const auto* candidate : candidates) {
+				if (candidate->size() < _driver->size()) {
+					_driver = candidate;
+				}
+			}
+		}
+
+		Iterator begin() const {
+			return _driver == nullptr ? Iterator() : Iterator(this, 0);
+		}
+
+		Iterator end() const {
+			return _driver == nullptr ? Iterator() : Iterator(this, _driver->size());
+		}
+
+		/**
+		 * @brief Upper bound of the number of Entities visited by this View.
+		 * @return Number of components in the smallest joined pool.
+		 */
+		[[nodiscard]] size_t SizeHint() const {
+			return _driver == nullptr ? 0 : _driver->size();
+		}
+
+		/**
+		 * @brief Call function for every Entity in this View.
+		 * @tparam Callback Type of a callback. Signature: void(size_t entityId, Ts&... components)
+		 * @param callback Reference to a function that will be called.
+		 */
+		template <typename Callback>
+		void Each(Callback&& callback) const {
+			for (auto&& value : *this) {
+				std::apply(callback, value);
+			}
+		}
+
+	private:
+		std::tuple<ComponentPool<Ts>*...> _pools;
+		const std::pmr::vector<size_t>* _driver = nullptr;
+		/** @brief Entity signatures used for pre-filtering. Not owned. */
+		const std::pmr::vector<ComponentSignature>* _signatures = nullptr;
+		/** @brief Signature of joined Component types. */
+		ComponentSignature _mask;
+
+		/**
+		 * @brief Look up all joined components for the Entity.
+		 * @param entityId Id of the Entity.
+		 * @param[out] out Pointers to found components.
+		 * @return True if Entity owns all joined components.
+		 */
+		bool Resolve(size_t entityId, std::tuple<Ts*...>& out) const {
+			if (_signatures != nullptr && !(*_signatures)[ECS::GetEntityIndex(entityId)].Contains(_mask)) {
+				return false;
+			}
+
+			return std::apply([entityId, &out](ComponentPool<Ts>*... pools) {
+				out = std::tuple<Ts*...>(pools->TryGetComponent(entityId)...);
+				return ((std::get<Ts*>(out) != nullptr) && ...);
+			}, _pools);
+		}
+	};
+}
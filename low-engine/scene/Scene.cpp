@@ -1,10 +1,14 @@
 #include "Scene.h"
 
 #include <algorithm>
+#include <atomic>
+#include <optional>
 #include <variant>
 
 #include "ecs/ECSHeaders.h"
 #include "graphics/Drawables.h"
+#include "scene/SceneFile.h"
+#include "utils/JsonStream.h"
 
 namespace LowEngine {
 	Scene::Scene(): Name(""), _memory() {
@@ -14,6 +18,7 @@ namespace LowEngine {
         _box2dWorldId = b2CreateWorld(&worldDef);
 
 		_memory.Box2dWorldId = _box2dWorldId;
+		_memory.SetWorkerPool(&Threading::WorkerPool::GetShared());
 	}
 
     Scene::Scene(const std::string& name): Name(name), _memory() {
@@ -23,6 +28,7 @@ namespace LowEngine {
         _box2dWorldId = b2CreateWorld(&worldDef);
 
         _memory.Box2dWorldId = _box2dWorldId;
+        _memory.SetWorkerPool(&Threading::WorkerPool::GetShared());
     }
 
     Scene::Scene(Scene const& other, const std::string& nameSufix): Initialized(false) // don’t auto-activate the clone
@@ -40,18 +46,9 @@ namespace LowEngine {
 	    Terrain.CopyLayersFrom(other.Terrain);
 
         _memory.Box2dWorldId = _box2dWorldId;
-        auto entities = _memory.GetAllEntities();
-        for (const auto& entityPtr : *entities) {
-            if (entityPtr) {
-                auto entity = static_cast<ECS::Entity*>(entityPtr.get());
-                if (entity->HasComponent(std::type_index(typeid(ECS::ColliderComponent)))) {
-                    auto colliderComp = _memory.GetComponent<ECS::ColliderComponent>(entity->Id);
-                    if (colliderComp) {
-                        colliderComp->CopyColliderToB2World(_box2dWorldId);
-                    }
-                }
-            }
-		}
+        for (auto [entityId, colliderComp] : _memory.View<ECS::ColliderComponent>()) {
+            colliderComp.CopyColliderToB2World(_box2dWorldId);
+        }
 
     }
 
@@ -117,6 +114,237 @@ namespace LowEngine {
 		return true;
 	}
 
+    bool Scene::DeserializeFromJSONStream(std::string_view json) {
+        bool hasName = false;
+        bool hasSpriteSortingMethod = false;
+        std::optional<size_t> cameraEntityId;
+
+        Utils::JsonStreamParser parser;
+        parser.OnValue("/name", [this, &hasName](std::string_view, nlohmann::ordered_json& value) {
+            Name = value.get<std::string>();
+            hasName = true;
+            return true;
+        });
+        parser.OnValue("/spriteSortingMethod", [this, &hasSpriteSortingMethod](std::string_view,
+                                                                              nlohmann::ordered_json& value) {
+            _spriteSortingMethod = value.get<SpriteSortingMethod>();
+            hasSpriteSortingMethod = true;
+            return true;
+        });
+        parser.OnValue("/currentCameraEntityId", [&cameraEntityId](std::string_view, nlohmann::ordered_json& value) {
+            cameraEntityId = value.get<std::size_t>();
+            return true;
+        });
+        Terrain.AddJSONStreamRoutes(parser, "/terrain");
+        parser.OnValue("/entities/*", [this](std::string_view, nlohmann::ordered_json& entityJson) {
+            return _memory.DeserializeEntityFromJSON<ECS::Entity>(entityJson);
+        });
+        parser.OnValue("/components/*/*", [this](std::string_view, nlohmann::ordered_json& componentJson) {
+            return _memory.DeserializeComponentFromJSON(componentJson);
+        });
+
+        if (!parser.Parse(json)) {
+            _log->error("Failed to deserialize scene '{}' from JSON: {}", Name, parser.GetError());
+            return false;
+        }
+        if (!hasName) {
+            _log->error("Provided json data don't contain 'name' field for scene deserialization.");
+            return false;
+        }
+        if (!hasSpriteSortingMethod) {
+            _log->error("Provided json data don't contain 'spriteSortingMethod' field for scene deserialization.");
+            return false;
+        }
+        if (!cameraEntityId.has_value()) {
+            _log->error("Provided json data don't contain 'currentCameraEntityId' field for scene deserialization.");
+            return false;
+        }
+        // camera is set once its Entity exists
+        SetCurrentCamera(*cameraEntityId);
+
+        return true;
+    }
+
+    void Scene::SerializeToBinary(std::vector<std::byte>& out, uint64_t saveId) {
+        SceneFileSnapshot snapshot;
+        SerializeToBinary(snapshot, saveId);
+        snapshot.Encode(out);
+    }
+
+    void Scene::SerializeToBinary(SceneFileSnapshot& out, uint64_t saveId) {
+        if (saveId != 0) {
+            out.BeginBlock(SceneFileFormat::BlockType::SaveInfo).Write(saveId);
+            out.EndBlock();
+        }
+
+        // settings and terrain keep their JSON layout
+        nlohmann::ordered_json sceneJson;
+        sceneJson["name"] = Name;
+        sceneJson["spriteSortingMethod"] = _spriteSortingMethod;
+        sceneJson["currentCameraEntityId"] = _cameraEntityId;
+        out.AddMessagePackBlock(SceneFileFormat::BlockType::Scene, std::move(sceneJson));
+        out.AddMessagePackBlock(SceneFileFormat::BlockType::Terrain, Terrain.SerializeToJSON());
+
+        _memory.SerializeAllEntitiesToBinary(out.BeginBlock(SceneFileFormat::BlockType::Entities));
+        out.EndBlock();
+
+        for (Memory::ComponentTypeId typeId : _memory.GetSerializationOrder()) {
+            _memory.SerializeComponentsToBinary(typeId, out.BeginBlock(SceneFileFormat::BlockType::Components));
+            out.EndBlock();
+        }
+    }
+
+    bool Scene::DeserializeFromBinary(std::span<const std::byte> data) {
+        SceneFileReader file;
+        if (!file.Open(data)) {
+            return false;
+        }
+
+        auto unpack = [](std::span<const std::byte> block) {
+            auto bytes = reinterpret_cast<const uint8_t*>(block.data());
+            return nlohmann::ordered_json::from_msgpack(bytes, bytes + block.size(), true, false);
+        };
+
+        std::optional<size_t> cameraEntityId;
+        for (const SceneFileReader::Block& block : file.GetBlocks()) {
+            Utils::BinaryReader in(block.Data);
+            switch (block.Type) {
+                case SceneFileFormat::BlockType::Scene: {
+                    nlohmann::ordered_json sceneJson = unpack(block.Data);
+                    if (!sceneJson.is_object() || !sceneJson.contains("name")
+                        || !sceneJson.contains("spriteSortingMethod")
+                        || !sceneJson.contains("currentCameraEntityId")) {
+                        _log->error("Scene file doesn't contain valid scene settings.");
+                        return false;
+                    }
+                    Name = sceneJson["name"].get<std::string>();
+                    _spriteSortingMethod = sceneJson["spriteSortingMethod"].get<SpriteSortingMethod>();
+                    cameraEntityId = sceneJson["currentCameraEntityId"].get<std::size_t>();
+                    break;
+                }
+                case SceneFileFormat::BlockType::Terrain:
+                    if (!Terrain.DeserializeFromJSON(unpack(block.Data))) {
+                        _log->error("Failed to deserialize terrain for scene '{}'", Name);
+                        return false;
+                    }
+                    break;
+                case SceneFileFormat::BlockType::Entities:
+                    if (!_memory.DeserializeAllEntitiesFromBinary(in)) {
+                        _log->error("Failed to deserialize entities for scene '{}'", Name);
+                        return false;
+                    }
+                    break;
+                case SceneFileFormat::BlockType::Components:
+                    if (!_memory.DeserializeComponentsFromBinary(in)) {
+                        _log->error("Failed to deserialize components for scene '{}'", Name);
+                        return false;
+                    }
+                    break;
+                case SceneFileFormat::BlockType::SaveInfo:
+                    // read by SceneJournalReader::ReadSaveId
+                    break;
+                default:
+                    _log->debug("Unknown block of type {} in scene file skipped", static_cast<uint32_t>(block.Type));
+                    break;
+            }
+        }
+
+        if (!cameraEntityId.has_value()) {
+            _log->error("Scene file doesn't contain scene settings.");
+            return false;
+        }
+        SetCurrentCamera(*cameraEntityId);
+
+        return true;
+    }
+
+    void Scene::SerializeChangesToBinary(std::vector<std::byte>& out) {
+        SceneFileWriter file(out);
+        std::vector<uint8_t> packed;
+
+        nlohmann::ordered_json sceneJson;
+        sceneJson["name"] = Name;
+        sceneJson["spriteSortingMethod"] = _spriteSortingMethod;
+        sceneJson["currentCameraEntityId"] = _cameraEntityId;
+        nlohmann::ordered_json::to_msgpack(sceneJson, packed);
+        file.BeginBlock(SceneFileFormat::BlockType::Scene).WriteBytes(packed.data(), packed.size());
+        file.EndBlock();
+
+        packed.clear();
+        nlohmann::ordered_json::to_msgpack(Terrain.SerializeChangesToJSON(), packed);
+        file.BeginBlock(SceneFileFormat::BlockType::TerrainChanges).WriteBytes(packed.data(), packed.size());
+        file.EndBlock();
+
+        _memory.SerializeEntityChangesToBinary(file.BeginBlock(SceneFileFormat::BlockType::EntityChanges));
+        file.EndBlock();
+
+        for (Memory::ComponentTypeId typeId : _memory.GetSerializationOrder()) {
+            _memory.SerializeComponentChangesToBinary(typeId, file.BeginBlock(SceneFileFormat::BlockType::Components));
+            file.EndBlock();
+        }
+
+        file.Finish();
+    }
+
+    bool Scene::DeserializeChangesFromBinary(std::span<const std::byte> data) {
+        SceneFileReader file;
+        if (!file.Open(data)) {
+            return false;
+        }
+
+        std::optional<size_t> cameraEntityId;
+        for (const SceneFileReader::Block& block : file.GetBlocks()) {
+            Utils::BinaryReader in(block.Data);
+            auto bytes = reinterpret_cast<const uint8_t*>(block.Data.data());
+            switch (block.Type) {
+                case SceneFileFormat::BlockType::Scene: {
+                    auto sceneJson = nlohmann::ordered_json::from_msgpack(bytes, bytes + block.Data.size(), true,
+                                                                          false);
+                    if (!sceneJson.is_object() || !sceneJson.contains("name")
+                        || !sceneJson.contains("spriteSortingMethod")
+                        || !sceneJson.contains("currentCameraEntityId")) {
+                        _log->error("Scene changes don't contain valid scene settings.");
+                        return false;
+                    }
+                    Name = sceneJson["name"].get<std::string>();
+                    _spriteSortingMethod = sceneJson["spriteSortingMethod"].get<SpriteSortingMethod>();
+                    cameraEntityId = sceneJson["currentCameraEntityId"].get<std::size_t>();
+                    break;
+                }
+                case SceneFileFormat::BlockType::TerrainChanges: {
+                    auto terrainJson = nlohmann::ordered_json::from_msgpack(bytes, bytes + block.Data.size(), true,
+                                                                            false);
+                    if (!terrainJson.is_object() || !Terrain.DeserializeChangesFromJSON(terrainJson)) {
+                        _log->error("Failed to apply terrain changes for scene '{}'", Name);
+                        return false;
+                    }
+                    break;
+                }
+                case SceneFileFormat::BlockType::EntityChanges:
+                    if (!_memory.DeserializeEntityChangesFromBinary(in)) {
+                        _log->error("Failed to apply entity changes for scene '{}'", Name);
+                        return false;
+                    }
+                    break;
+                case SceneFileFormat::BlockType::Components:
+                    if (!_memory.DeserializeComponentsFromBinary(in)) {
+                        _log->error("Failed to apply component changes for scene '{}'", Name);
+                        return false;
+                    }
+                    break;
+                default:
+                    _log->debug("Unknown block of type {} in scene changes skipped", static_cast<uint32_t>(block.Type));
+                    break;
+            }
+        }
+
+        if (cameraEntityId.has_value()) {
+            SetCurrentCamera(*cameraEntityId);
+        }
+
+        return true;
+    }
+
 	void Scene::Update(float deltaTime) {
 	    Terrain.Update(deltaTime);
         _memory.UpdateAllComponents(IsPaused ? 0.0f : deltaTime);
@@ -215,7 +443,7 @@ namespace LowEngine {
     }
 
 
-    ECS::Entity* Scene::GetEntity(unsigned int entityId) {
+    ECS::Entity* Scene::GetEntity(size_t entityId) {
         return _memory.GetEntity<ECS::Entity>(entityId);
     }
 
@@ -223,10 +451,6 @@ namespace LowEngine {
         return _memory.FindEntity<ECS::Entity>(name);
     }
 
-    std::vector<std::unique_ptr<ECS::IEntity> >* Scene::GetEntities() {
-        return _memory.GetAllEntities();
-    }
-
     void* Scene::GetComponent(size_t entityId, std::type_index typeIndex) {
         return _memory.GetComponent(entityId, typeIndex);
     }
@@ -303,4 +527,9 @@ namespace LowEngine {
 
         return worldDef;
 	}
+
+	uint64_t Scene::NewInstanceId() {
+		static std::atomic<uint64_t> nextInstanceId = 1;
+		return nextInstanceId++;
+	}
 }
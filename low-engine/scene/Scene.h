@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <span>
 #include <string>
 #include <typeindex>
 #include <nlohmann/json_fwd.hpp>
@@ -17,6 +19,8 @@ namespace LowEngine {
 		class Entity;
 	}
 
+	class SceneFileSnapshot;
+
 	/**
      * @brief Represents a scene containing entities.
      *
@@ -110,6 +114,90 @@ namespace LowEngine {
 		 */
         bool DeserializeFromJSON(const nlohmann::ordered_json& jsonData);
 
+        /**
+         * @brief Deserialize this scene from JSON text, creating Entities, Components and tiles while parsing.
+         *
+         * Unlike DeserializeFromJSON, the document is never held as a whole: only a single Entity, Component
+         * or tile is materialized at a time. Entities must come before Components, as written by SerializeToJSON.
+         * @param json JSON text, e.g. a memory-mapped file.
+         * @return True if successful. False otherwise.
+         */
+        bool DeserializeFromJSONStream(std::string_view json);
+
+        /**
+         * @brief Serialize this scene to a binary scene file, see SceneFileFormat.
+         *
+         * Components with binary state are stored as fixed-size records, others as MessagePack encoded JSON.
+         * @param[out] out Buffer for the file. Previous content is replaced, capacity is reused.
+         * @param saveId Id of the save, matched by journals written on top of the file. 0 if there's none.
+         */
+        void SerializeToBinary(std::vector<std::byte>& out, uint64_t saveId = 0);
+
+        /**
+         * @brief Take this scene as a binary scene file, to be encoded later, e.g. on the thread writing the file.
+         *
+         * Only fixed-size records are written now; JSON of other Components, settings and terrain is kept and
+         * MessagePack encoded by SceneFileSnapshot::Encode.
+         * @param[out] out Snapshot to take the scene into. Must be empty.
+         * @param saveId Id of the save, matched by journals written on top of the file. 0 if there's none.
+         */
+        void SerializeToBinary(SceneFileSnapshot& out, uint64_t saveId = 0);
+
+        /**
+         * @brief Deserialize this scene from a binary scene file written by SerializeToBinary.
+         * @param data File content, e.g. a memory-mapped file.
+         * @return True if successful. False otherwise.
+         */
+        bool DeserializeFromBinary(std::span<const std::byte> data);
+
+        /**
+         * @brief Serialize changes since ClearChanges to a binary scene file, for a scene journal record.
+         *
+         * Written are scene settings, terrain with only its changed tile chunks, removed Entities and changed
+         * Entities with all their Components. Cost follows the size of the changes, not of the scene, except for
+         * scans of Transforms, which track their own changes, and of Entities' Active flags. Only valid if
+         * CanSerializeChanges is true.
+         * @param[out] out Buffer for the file. Previous content is replaced, capacity is reused.
+         */
+        void SerializeChangesToBinary(std::vector<std::byte>& out);
+
+        /**
+         * @brief Apply changes written by SerializeChangesToBinary on top of the loaded scene.
+         * @param data Content of the changes, e.g. a record of a memory-mapped journal.
+         * @return True if successful. False otherwise.
+         */
+        bool DeserializeChangesFromBinary(std::span<const std::byte> data);
+
+        /**
+         * @brief Forget changes of Entities and terrain, e.g. once they are saved.
+         */
+        void ClearChanges() {
+            _memory.ClearChanges();
+            Terrain.ClearChanges();
+        }
+
+        /**
+         * @brief Check if every change since ClearChanges is seen by SerializeChangesToBinary.
+         *
+         * False while the scene holds Components of types that don't track their changes, see
+         * Memory::CanSerializeChanges. Such scenes have to be saved whole.
+         * @return True if changes can be saved.
+         */
+        [[nodiscard]] bool CanSerializeChanges() const {
+            return _memory.CanSerializeChanges();
+        }
+
+        /**
+         * @brief Retrieve id of this scene instance.
+         *
+         * Ids are unique within the process and never reused, unlike addresses of destroyed scenes, so they tell
+         * whether saved state belongs to this very scene. Copies get their own id.
+         * @return Id of the scene instance.
+         */
+        [[nodiscard]] uint64_t GetInstanceId() const {
+            return _instanceId;
+        }
+
         /**
          * @brief Update all Entities and Components.
          * @param deltaTime Time passed since last updae, in seconds.
@@ -135,6 +223,46 @@ namespace LowEngine {
          */
         ECS::Entity* AddEntity(const std::string& name = "Entity");
 
+        /**
+         * @brief Add many Entities to this scene at once.
+         * @param count Number of Entities to add.
+         * @param name Name given to every new Entity.
+         * @return Ids of new Entities. Empty in case of error.
+         */
+        std::vector<size_t> AddEntities(size_t count, const std::string& name = "Entity") {
+            return _memory.CreateEntities(count, name);
+        }
+
+        /**
+         * @brief Spawn Entity of a prefab, reusing a despawned one if the prefab's pool has any.
+         * @tparam Build Type of function attaching Components. Signature: void(Memory::Memory&, ECS::Entity&)
+         * @param prefab Name of the prefab.
+         * @param name Name of the Entity.
+         * @param build Function attaching Components to a new Entity. Not called for reused Entities.
+         * @return Pointer to Entity. Returns nullptr in case of error.
+         */
+        template<typename Build>
+        ECS::Entity* SpawnEntity(std::string_view prefab, const std::string& name, Build&& build) {
+            return _memory.SpawnEntity<ECS::Entity>(prefab, name, std::forward<Build>(build));
+        }
+
+        /**
+         * @brief Despawn Entity, keeping it for reuse by SpawnEntity if its prefab's pool has room.
+         * @param entityId Id of the Entity.
+         */
+        void DespawnEntity(size_t entityId) {
+            _memory.DespawnEntity(entityId);
+        }
+
+        /**
+         * @brief Set number of despawned Entities of a prefab kept for reuse.
+         * @param prefab Name of the prefab.
+         * @param capacity Maximal number of kept Entities.
+         */
+        void SetEntityPoolCapacity(std::string_view prefab, size_t capacity) {
+            _memory.SetEntityPoolCapacity(prefab, capacity);
+        }
+
         /**
          * @brief Check if Entity with provided Id is safe to destroy.
          * @param entityId Id of the Entity to check.
@@ -155,22 +283,37 @@ namespace LowEngine {
          * @param entityId Id of the Entity.
          * @return Pointer to Entity. Return nullptr if Entity not found.
          */
-        ECS::Entity* GetEntity(unsigned int entityId);
+        ECS::Entity* GetEntity(size_t entityId);
 
         /**
          * @brief Find pointer to Entity with provided Name.
          *
-         * If there's multiple Entities with the same name, the first one found will be retrieved.
+         * Lookup is hashed. If there's multiple Entities with the same name, one of them is retrieved.
          * @param name Name of the Entity.
          * @return Pointer to Entity. Return nullptr if Entity not found.
          */
         ECS::Entity* FindEntity(const std::string& name);
 
         /**
-         * @brief Retreieve pointer to collection of all Entities in this scene.
-         * @return Pointer to Entities' collection.
+         * @brief Retrieve Ids of all Entities with provided Name.
+         * @param name Name of the Entities.
+         * @return Ids of Entities. Span is invalidated when any Entity is created, renamed or destroyed.
+         */
+        std::span<const size_t> FindEntities(std::string_view name) const {
+            return _memory.FindEntities(name);
+        }
+
+        /**
+         * @brief Call function for all Entities in this scene.
+         *
+         * Callback must not create or destroy Entities.
+         * @tparam Callback Type of a callback to be executed. Signature: void(ECS::Entity&)
+         * @param callback Reference to a function that will be called.
          */
-        std::vector<std::unique_ptr<ECS::IEntity> >* GetEntities();
+        template<typename Callback>
+        void ForEachEntity(Callback&& callback) {
+            _memory.ForEachEntity(std::forward<Callback>(callback));
+        }
 
         /**
          * @brief Add new Component to the Entity in this scene.
@@ -185,6 +328,19 @@ namespace LowEngine {
             return _memory.CreateComponent<T>(entityId, std::forward<Args>(args)...);
         }
 
+        /**
+         * @brief Add Components of the same type to many Entities in this scene at once.
+         * @tparam T Type of the component to add.
+         * @tparam Init Type of initialization callback. Signature: void(T&)
+         * @param entityIds Ids of the Entities that should own new Components.
+         * @param init Function called for every new Component, before its Initialize() method.
+         * @return Number of added Components.
+         */
+        template<typename T, typename Init>
+        size_t AddComponents(std::span<const size_t> entityIds, Init&& init) {
+            return _memory.CreateComponents<T>(entityIds, std::forward<Init>(init));
+        }
+
         /**
          * @brief Check if Component of given type is safe to destroy.
          * @param entityId Id of the Entity that owns Component.
@@ -207,6 +363,17 @@ namespace LowEngine {
             _memory.DestroyComponent<T>(entityId);
         }
 
+        /**
+         * @brief Activate or deactivate Component owned by Entity in this scene.
+         * @tparam T Type of the component.
+         * @param entityId Id of the Entity that owns Component.
+         * @param active New state of the Component. Inactive Components skip their Update and Draw calls.
+         */
+        template<typename T>
+        void SetComponentActive(size_t entityId, bool active) {
+            _memory.SetComponentActive<T>(entityId, active);
+        }
+
         /**
          * @brief Retrieve pointer to Component owned by provided Entity.
          * @tparam T Type of component to retrieve.
@@ -218,6 +385,17 @@ namespace LowEngine {
             return _memory.GetComponent<T>(entityId);
         }
 
+        /**
+         * @brief Retrieve structure-of-arrays storage of a Component type, for batch work over its hot data.
+         * @tparam T Type of Component. Must declare SoAStorage, e.g. TransformComponent.
+         * @param[out] activeCount Number of leading entries that belong to active Components.
+         * @return Pointer to storage. Returns nullptr if there are no Components of this type.
+         */
+        template<typename T> requires Memory::HasSoAStorage<T>
+        Memory::SoAStorageOf<T>* GetSoAStorage(size_t& activeCount) {
+            return _memory.GetSoAStorage<T>(activeCount);
+        }
+
         /**
          * @brief Retrieve pointer to Component owned by provided Entity.
          * @param entityId Id of the Entity.
@@ -226,6 +404,29 @@ namespace LowEngine {
          */
         void* GetComponent(size_t entityId, std::type_index typeIndex);
 
+        /**
+         * @brief Retrieve allocation statistics of the arena holding this scene's Entities and Components.
+         * @return Current statistics.
+         */
+        const Memory::ArenaStats& GetArenaStats() const {
+            return _memory.GetArenaStats();
+        }
+
+        /**
+         * @brief Retrieve memory usage of every Component Pool in this scene.
+         * @return Statistics of existing pools.
+         */
+        std::vector<Memory::PoolStats> GetPoolStats() const {
+            return _memory.GetPoolStats();
+        }
+
+        /**
+         * @brief Release memory that isn't needed by existing Entities and Components, e.g. after a spike.
+         */
+        void ShrinkToFit() {
+            _memory.ShrinkToFit();
+        }
+
         /**
          * @brief Set provided Entity as one that manages current View.
          *
@@ -266,6 +467,7 @@ namespace LowEngine {
         void Destroy();
 
     protected:
+        uint64_t _instanceId = NewInstanceId();
 		b2WorldId _box2dWorldId = b2_nullWorldId;
         size_t _cameraEntityId = Config::INVALID_ID;
         SpriteSortingMethod _spriteSortingMethod = SpriteSortingMethod::DrawOrder;
@@ -277,5 +479,10 @@ namespace LowEngine {
 		void RegisterDefaultComponentTypes();
 
         b2WorldDef GetB2WorldDef();
+
+        /**
+         * @brief Retrieve id for a new scene instance, see GetInstanceId.
+         */
+        static uint64_t NewInstanceId();
     };
 }
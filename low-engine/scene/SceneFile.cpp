@@ -0,0 +1,126 @@
+#include "SceneFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "log/Log.h"
+
+namespace LowEngine {
+	SceneFileWriter::SceneFileWriter(std::vector<std::byte>& out) : _writer(out) {
+		out.clear();
+		// completed by Finish
+		_writer.Write(SceneFileFormat::Header{});
+	}
+
+	Utils::BinaryWriter& SceneFileWriter::BeginBlock(SceneFileFormat::BlockType type) {
+		SceneFileFormat::BlockEntry& block = _blocks.emplace_back();
+		block.Type = type;
+		block.Offset = _writer.GetSize();
+		return _writer;
+	}
+
+	void SceneFileWriter::EndBlock() {
+		SceneFileFormat::BlockEntry& block = _blocks.back();
+		block.Size = _writer.GetSize() - block.Offset;
+	}
+
+	void SceneFileWriter::Finish() {
+		SceneFileFormat::Header header;
+		header.BlockCount = static_cast<uint32_t>(_blocks.size());
+		header.TableOffset = _writer.GetSize();
+
+		_writer.WriteBytes(_blocks.data(), _blocks.size() * sizeof(SceneFileFormat::BlockEntry));
+		_writer.WriteAt(0, header);
+	}
+
+	Utils::BinaryWriter& SceneFileSnapshot::BeginBlock(SceneFileFormat::BlockType type) {
+		Block& block = _blocks.emplace_back();
+		block.Type = type;
+		return _writer.emplace(block.Data, &block.Values);
+	}
+
+	void SceneFileSnapshot::EndBlock() {
+		_writer.reset();
+	}
+
+	void SceneFileSnapshot::AddMessagePackBlock(SceneFileFormat::BlockType type, nlohmann::ordered_json value) {
+		Block& block = _blocks.emplace_back();
+		block.Type = type;
+		block.Values.push_back({0, std::move(value)});
+		block.SingleValue = true;
+	}
+
+	size_t SceneFileSnapshot::GetBinarySize() const {
+		size_t size = 0;
+		for (const Block& block: _blocks) {
+			size += block.Data.size();
+		}
+		return size;
+	}
+
+	void SceneFileSnapshot::Encode(std::vector<std::byte>& out) const {
+		SceneFileWriter file(out);
+		std::vector<uint8_t> packed;
+		for (const Block& block: _blocks) {
+			Utils::BinaryWriter& writer = file.BeginBlock(block.Type);
+			if (block.SingleValue) {
+				packed.clear();
+				nlohmann::ordered_json::to_msgpack(block.Values.front().Value, packed);
+				writer.WriteBytes(packed.data(), packed.size());
+			} else {
+				size_t offset = 0;
+				for (const Utils::BinaryWriter::DeferredValue& value: block.Values) {
+					writer.WriteBytes(block.Data.data() + offset, value.Offset - offset);
+					writer.WriteMessagePack(value.Value);
+					offset = value.Offset;
+				}
+				writer.WriteBytes(block.Data.data() + offset, block.Data.size() - offset);
+			}
+			file.EndBlock();
+		}
+		file.Finish();
+	}
+
+	bool SceneFileReader::IsSceneFile(std::span<const std::byte> data) {
+		return data.size() >= SceneFileFormat::MAGIC.size()
+		       && std::memcmp(data.data(), SceneFileFormat::MAGIC.data(), SceneFileFormat::MAGIC.size()) == 0;
+	}
+
+	bool SceneFileReader::Open(std::span<const std::byte> data) {
+		_blocks.clear();
+
+		SceneFileFormat::Header header;
+		Utils::BinaryReader in(data);
+		if (!IsSceneFile(data) || !in.Read(header)) {
+			_log->error("Data is not a binary scene file");
+			return false;
+		}
+		if (header.Version != SceneFileFormat::VERSION) {
+			_log->error("Scene file version {} is not supported, expected {}", header.Version,
+			            SceneFileFormat::VERSION);
+			return false;
+		}
+
+		constexpr size_t entrySize = sizeof(SceneFileFormat::BlockEntry);
+		if (header.TableOffset > data.size()
+		    || header.BlockCount > (data.size() - header.TableOffset) / entrySize) {
+			_log->error("Scene file is truncated: block table is missing");
+			return false;
+		}
+
+		_blocks.reserve(header.BlockCount);
+		const std::byte* table = data.data() + header.TableOffset;
+		for (uint32_t i = 0; i < header.BlockCount; ++i) {
+			SceneFileFormat::BlockEntry entry;
+			std::memcpy(&entry, table + i * entrySize, entrySize);
+			if (entry.Offset > header.TableOffset || entry.Size > header.TableOffset - entry.Offset) {
+				_log->error("Scene file is corrupted: block {} is out of bounds", i);
+				_blocks.clear();
+				return false;
+			}
+			_blocks.push_back({entry.Type, data.subspan(entry.Offset, entry.Size)});
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+#include "utils/BinaryStream.h"
+
+namespace LowEngine {
+	/**
+	 * @brief Layout of binary scene files.
+	 *
+	 * File starts with a Header, followed by blocks and ends with a table of BlockEntry, one per block.
+	 * Blocks are independent, so readers can skip blocks they don't know and newer writers can add block types
+	 * without breaking older files. All values are little-endian and unaligned.
+	 */
+	struct SceneFileFormat {
+		static constexpr std::array<char, 8> MAGIC = {'L', 'O', 'W', 'S', 'C', 'E', 'N', 'E'};
+
+		/** @brief Version of the layout. Files of other versions are rejected. */
+		static constexpr uint32_t VERSION = 1;
+
+		enum class BlockType : uint32_t {
+			/** @brief Scene settings, MessagePack encoded. */
+			Scene = 1,
+			/** @brief Terrain, MessagePack encoded. */
+			Terrain = 2,
+			/** @brief All Entities, see Memory::SerializeAllEntitiesToBinary. */
+			Entities = 3,
+			/** @brief Components of a single type, see Memory::SerializeComponentsToBinary. */
+			Components = 4,
+			/** @brief Id of the save, matched by journals written on top of the file, see SceneJournalFormat. */
+			SaveInfo = 5,
+			/** @brief Changes of terrain, MessagePack encoded, see TerrainManager::SerializeChangesToJSON. */
+			TerrainChanges = 6,
+			/** @brief Removed and changed Entities, see Memory::SerializeEntityChangesToBinary. */
+			EntityChanges = 7
+		};
+
+		struct Header {
+			std::array<char, 8> Magic = MAGIC;
+			uint32_t Version = VERSION;
+			uint32_t BlockCount = 0;
+			/** @brief Offset of the block table from the start of the file. */
+			uint64_t TableOffset = 0;
+		};
+
+		struct BlockEntry {
+			BlockType Type = BlockType::Scene;
+			uint32_t Reserved = 0;
+			/** @brief Offset of the block from the start of the file. */
+			uint64_t Offset = 0;
+			uint64_t Size = 0;
+		};
+	};
+
+	/**
+	 * @brief Writes binary scene file into a byte buffer, block by block.
+	 */
+	class SceneFileWriter {
+	public:
+		/**
+		 * @brief Start new file.
+		 * @param out Buffer for the file. Previous content is replaced, capacity is reused.
+		 */
+		explicit SceneFileWriter(std::vector<std::byte>& out);
+
+		/**
+		 * @brief Start new block. Previous block must be ended.
+		 * @param type Type of the block.
+		 * @return Writer to write block's content with. Valid until the file is finished.
+		 */
+		Utils::BinaryWriter& BeginBlock(SceneFileFormat::BlockType type);
+
+		/**
+		 * @brief End current block.
+		 */
+		void EndBlock();
+
+		/**
+		 * @brief Append block table and complete the header. No blocks can be written after.
+		 */
+		void Finish();
+
+	protected:
+		Utils::BinaryWriter _writer;
+		std::vector<SceneFileFormat::BlockEntry> _blocks;
+	};
+
+	/**
+	 * @brief Binary scene file taken block by block, to be encoded later, e.g. on the thread writing the file.
+	 *
+	 * Blocks are written like with SceneFileWriter, except for MessagePack values: they are kept as JSON (see
+	 * Utils::BinaryWriter::WriteMessagePack) and only encoded by Encode, which produces the same file
+	 * SceneFileWriter would. Taken snapshot doesn't refer to the written state.
+	 */
+	class SceneFileSnapshot {
+	public:
+		SceneFileSnapshot() = default;
+		SceneFileSnapshot(const SceneFileSnapshot&) = delete;
+		SceneFileSnapshot& operator=(const SceneFileSnapshot&) = delete;
+
+		/**
+		 * @brief Start new block. Previous block must be ended.
+		 * @param type Type of the block.
+		 * @return Writer to write block's content with. Valid until the block is ended.
+		 */
+		Utils::BinaryWriter& BeginBlock(SceneFileFormat::BlockType type);
+
+		/**
+		 * @brief End current block.
+		 */
+		void EndBlock();
+
+		/**
+		 * @brief Add block that holds a single MessagePack encoded value, e.g. scene settings.
+		 * @param type Type of the block.
+		 * @param value Content of the block.
+		 */
+		void AddMessagePackBlock(SceneFileFormat::BlockType type, nlohmann::ordered_json value);
+
+		/**
+		 * @brief Retrieve size of the binary content taken so far, without the values left for encoding.
+		 * @return Size in bytes.
+		 */
+		[[nodiscard]] size_t GetBinarySize() const;
+
+		/**
+		 * @brief Encode the file. Can run on any thread, but only one at a time.
+		 * @param out Buffer for the file. Previous content is replaced.
+		 */
+		void Encode(std::vector<std::byte>& out) const;
+
+	protected:
+		struct Block {
+			SceneFileFormat::BlockType Type = SceneFileFormat::BlockType::Scene;
+			std::vector<std::byte> Data;
+			/** @brief Values encoded in between Data, in order of their offsets. */
+			std::vector<Utils::BinaryWriter::DeferredValue> Values;
+			/** @brief Is the block a single value, without size prefix? See AddMessagePackBlock. */
+			bool SingleValue = false;
+		};
+
+		/** @brief Blocks in order of writing. Deque keeps them in place while the current one is written. */
+		std::deque<Block> _blocks;
+
+		/** @brief Writer of the current block. */
+		std::optional<Utils::BinaryWriter> _writer;
+	};
+
+	/**
+	 * @brief Reads binary scene file written by SceneFileWriter, without copying it.
+	 */
+	class SceneFileReader {
+	public:
+		struct Block {
+			SceneFileFormat::BlockType Type;
+			/** @brief Content of the block, pointing into the read data. */
+			std::span<const std::byte> Data;
+		};
+
+		/**
+		 * @brief Check if data starts like a binary scene file, e.g. to tell it apart from a JSON scene.
+		 * @param data File content.
+		 * @return True if data starts with the magic of scene files.
+		 */
+		static bool IsSceneFile(std::span<const std::byte> data);
+
+		/**
+		 * @brief Validate the file and read its block table.
+		 * @param data File content. Must outlive the reader.
+		 * @return True if file is valid.
+		 */
+		bool Open(std::span<const std::byte> data);
+
+		/**
+		 * @brief Retrieve blocks of the file, in the order they were written.
+		 * @return Blocks of the file.
+		 */
+		[[nodiscard]] const std::vector<Block>& GetBlocks() const {
+			return _blocks;
+		}
+
+	protected:
+		std::vector<Block> _blocks;
+	};
+}
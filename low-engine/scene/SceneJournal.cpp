@@ -0,0 +1,88 @@
+#include "SceneJournal.h"
+
+#include <cstring>
+
+#include "log/Log.h"
+#include "scene/SceneFile.h"
+#include "utils/BinaryStream.h"
+
+namespace LowEngine {
+	namespace {
+		uint32_t HashContent(std::span<const std::byte> content) {
+			uint32_t hash = 2166136261u;
+			for (std::byte byte : content) {
+				hash = (hash ^ std::to_integer<uint32_t>(byte)) * 16777619u;
+			}
+			return hash;
+		}
+	}
+
+	void SceneJournalWriter::WriteHeader(uint64_t saveId, std::vector<std::byte>& out) {
+		SceneJournalFormat::Header header;
+		header.SaveId = saveId;
+		Utils::BinaryWriter(out).Write(header);
+	}
+
+	void SceneJournalWriter::WriteRecord(std::span<const std::byte> content, std::vector<std::byte>& out) {
+		SceneJournalFormat::RecordHeader header;
+		header.Size = content.size();
+		header.Checksum = HashContent(content);
+
+		Utils::BinaryWriter writer(out);
+		writer.Write(header);
+		writer.WriteBytes(content.data(), content.size());
+	}
+
+	uint64_t SceneJournalReader::ReadSaveId(std::span<const std::byte> sceneFile) {
+		SceneFileReader file;
+		if (!file.Open(sceneFile)) {
+			return 0;
+		}
+
+		uint64_t saveId = 0;
+		for (const SceneFileReader::Block& block : file.GetBlocks()) {
+			if (block.Type == SceneFileFormat::BlockType::SaveInfo) {
+				Utils::BinaryReader in(block.Data);
+				if (!in.Read(saveId)) {
+					return 0;
+				}
+			}
+		}
+		return saveId;
+	}
+
+	bool SceneJournalReader::Open(std::span<const std::byte> data) {
+		_saveId = 0;
+		_records.clear();
+		_truncated = false;
+
+		SceneJournalFormat::Header header;
+		Utils::BinaryReader in(data);
+		if (!in.Read(header) || header.Magic != SceneJournalFormat::MAGIC) {
+			_log->warn("Data is not a scene journal");
+			return false;
+		}
+		if (header.Version != SceneJournalFormat::VERSION) {
+			_log->warn("Scene journal version {} is not supported, expected {}", header.Version,
+			           SceneJournalFormat::VERSION);
+			return false;
+		}
+		_saveId = header.SaveId;
+
+		while (in.GetRemaining() > 0) {
+			SceneJournalFormat::RecordHeader record;
+			const std::byte* content = nullptr;
+			if (!in.Read(record) || record.Size > in.GetRemaining()
+			    || (content = in.ReadBytes(record.Size)) == nullptr
+			    || HashContent({content, record.Size}) != record.Checksum) {
+				// anything after a torn record can't be trusted
+				_log->warn("Scene journal is truncated after {} records", _records.size());
+				_truncated = true;
+				break;
+			}
+			_records.emplace_back(content, record.Size);
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace LowEngine {
+	/**
+	 * @brief Layout of scene journals: changes saved on top of a binary scene file, one record per save.
+	 *
+	 * Journal of a scene file is stored next to it, with Config::SCENE_JOURNAL_FILE_EXTENSION appended. It starts
+	 * with a Header naming the save of the scene file it belongs to (see SceneFileFormat::BlockType::SaveInfo),
+	 * followed by records appended one after another. Every record is a RecordHeader followed by a binary scene
+	 * file holding only the changes, see Scene::SerializeChangesToBinary. Records are checksummed, so a record
+	 * torn by an interrupted append is detected and dropped together with anything after it.
+	 */
+	struct SceneJournalFormat {
+		static constexpr std::array<char, 8> MAGIC = {'L', 'O', 'W', 'J', 'R', 'N', 'A', 'L'};
+
+		/** @brief Version of the layout. Journals of other versions are ignored. */
+		static constexpr uint32_t VERSION = 1;
+
+		struct Header {
+			std::array<char, 8> Magic = MAGIC;
+			uint32_t Version = VERSION;
+			uint32_t Reserved = 0;
+			/** @brief Id of the save of the scene file this journal belongs to. */
+			uint64_t SaveId = 0;
+		};
+
+		struct RecordHeader {
+			/** @brief Size of the record's content, without this header. */
+			uint64_t Size = 0;
+			/** @brief FNV-1a hash of the record's content. */
+			uint32_t Checksum = 0;
+			uint32_t Reserved = 0;
+		};
+	};
+
+	/**
+	 * @brief Writes scene journals, see SceneJournalFormat.
+	 */
+	class SceneJournalWriter {
+	public:
+		/**
+		 * @brief Append journal header.
+		 * @param saveId Id of the save of the scene file the journal belongs to.
+		 * @param out Buffer to append to.
+		 */
+		static void WriteHeader(uint64_t saveId, std::vector<std::byte>& out);
+
+		/**
+		 * @brief Append a single record.
+		 * @param content Binary scene file holding changes, see Scene::SerializeChangesToBinary.
+		 * @param out Buffer to append to.
+		 */
+		static void WriteRecord(std::span<const std::byte> content, std::vector<std::byte>& out);
+	};
+
+	/**
+	 * @brief Reads scene journal written by SceneJournalWriter, without copying it.
+	 */
+	class SceneJournalReader {
+	public:
+		/**
+		 * @brief Retrieve id of the save of a binary scene file.
+		 * @param sceneFile Content of the scene file.
+		 * @return Id of the save. 0 if the file isn't a valid scene file or wasn't saved with an id.
+		 */
+		static uint64_t ReadSaveId(std::span<const std::byte> sceneFile);
+
+		/**
+		 * @brief Validate the header and collect records, up to the first one that is torn or corrupted.
+		 * @param data Journal content. Must outlive the reader.
+		 * @return True if data starts with a valid journal header.
+		 */
+		bool Open(std::span<const std::byte> data);
+
+		/**
+		 * @brief Retrieve id of the save of the scene file the journal belongs to.
+		 * @return Id of the save.
+		 */
+		[[nodiscard]] uint64_t GetSaveId() const {
+			return _saveId;
+		}
+
+		/**
+		 * @brief Retrieve content of valid records, in the order they were appended.
+		 * @return Records of the journal, pointing into the read data.
+		 */
+		[[nodiscard]] const std::vector<std::span<const std::byte>>& GetRecords() const {
+			return _records;
+		}
+
+		/**
+		 * @brief Check if the journal ends with data that isn't a valid record, e.g. after an interrupted append.
+		 * @return True if some data was dropped.
+		 */
+		[[nodiscard]] bool IsTruncated() const {
+			return _truncated;
+		}
+
+	protected:
+		uint64_t _saveId = 0;
+		std::vector<std::span<const std::byte>> _records;
+		bool _truncated = false;
+	};
+}
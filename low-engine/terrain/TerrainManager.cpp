@@ -1,5 +1,7 @@
 #include "TerrainManager.h"
 
+#include <algorithm>
+
 #include "box2d/box2d.h"
 #include "box2d/types.h"
 
@@ -51,13 +53,110 @@ namespace LowEngine::Terrain {
         return true;
     }
 
-    void TerrainManager::CopyLayersFrom(const TerrainManager& terrain) {
-        for (auto& layer: terrain._layers) {
-            _layers.emplace_back(layer);
+    nlohmann::ordered_json TerrainManager::SerializeChangesToJSON() {
+        nlohmann::ordered_json json;
+        json["navBounds"] = {
+            {"x", NavBounds.position.x},
+            {"y", NavBounds.position.y},
+            {"w", NavBounds.size.x},
+            {"h", NavBounds.size.y}
+        };
+
+        nlohmann::ordered_json layersJson = nlohmann::ordered_json::array();
+        for (auto& layer: _layers) {
+            layersJson.emplace_back(layer.SerializeChangesToJSON());
+        }
+        json["layers"] = layersJson;
+        return json;
+    }
+
+    bool TerrainManager::DeserializeChangesFromJSON(const nlohmann::ordered_json& json) {
+        if (json.contains("navBounds")) {
+            auto& b = json["navBounds"];
+            NavBounds = sf::IntRect(
+                {b["x"].get<int>(), b["y"].get<int>()},
+                {b["w"].get<int>(), b["h"].get<int>()}
+            );
+        }
+        if (json.contains("layers")) {
+            std::vector<LowEngine::TileMap::TileMapLayer> layers;
+            layers.reserve(json["layers"].size());
+            for (auto& layerJson: json["layers"]) {
+                const auto& id = layerJson["id"].get_ref<const std::string&>();
+                auto existing = std::find_if(_layers.begin(), _layers.end(), [&id](const auto& layer) {
+                    return layer.Id == id;
+                });
+                if (existing != _layers.end()) {
+                    layers.push_back(std::move(*existing));
+                    _layers.erase(existing);
+                } else {
+                    layers.emplace_back();
+                }
+                if (!layers.back().DeserializeFromJSON(layerJson)) {
+                    return false;
+                }
+            }
+            _layers = std::move(layers);
         }
-        NavBounds = terrain.NavBounds;
         _navigationDirty = true;
         _collisionsDirty = true;
+        return true;
+    }
+
+    void TerrainManager::ClearChanges() {
+        for (auto& layer: _layers) {
+            layer.ClearTileChanges();
+        }
+    }
+
+    void TerrainManager::AddJSONStreamRoutes(Utils::JsonStreamParser& parser, const std::string& route) {
+        parser.OnValue(route + "/navBounds", [this](std::string_view, nlohmann::ordered_json& b) {
+            NavBounds = sf::IntRect(
+                {b["x"].get<int>(), b["y"].get<int>()},
+                {b["w"].get<int>(), b["h"].get<int>()}
+            );
+            return true;
+        });
+        parser.OnContainer(route + "/layers/*", [this](std::string_view) {
+            _layers.emplace_back();
+            return true;
+        }, [this](std::string_view) {
+            _layers.back().FinishDeserialization();
+            return true;
+        });
+        parser.OnContainer(route + "/layers/*/tiles", nullptr, nullptr);
+        parser.OnValue(route + "/layers/*/tiles/*", [this](std::string_view, nlohmann::ordered_json& tileJson) {
+            return _layers.back().DeserializeTileFromJSON(tileJson);
+        });
+        parser.OnContainer(route + "/layers/*/tileChunks", nullptr, nullptr);
+        parser.OnValue(route + "/layers/*/tileChunks/*", [this](std::string_view, nlohmann::ordered_json& chunkJson) {
+            return _layers.back().DeserializeTileChunkFromJSON(chunkJson);
+        });
+        parser.OnValue(route + "/layers/*/*", [this](std::string_view key, nlohmann::ordered_json& value) {
+            return _layers.back().DeserializePropertyFromJSON(key, value);
+        });
+        parser.OnContainer(route, nullptr, [this](std::string_view) {
+            _navigationDirty = true;
+            _collisionsDirty = true;
+            return true;
+        });
+    }
+
+    void TerrainManager::CopyLayersFrom(const TerrainManager& terrain) {
+        // layers share their tiles with the source until either side edits them
+        _layers.insert(_layers.end(), terrain._layers.begin(), terrain._layers.end());
+        NavBounds = terrain.NavBounds;
+
+        // navigation grid depends only on layers, so a baked grid stays valid for the copy
+        if (_layers.size() == terrain._layers.size() && !terrain._navigationDirty) {
+            _navGrid = terrain._navGrid;
+            _navigationDirty = false;
+        } else {
+            _navigationDirty = true;
+        }
+
+        // collision bodies live in the Box2D world of the source scene and have to be baked again
+        _collisionsDirty = true;
     }
 
     nlohmann::ordered_json TerrainManager::SerializeToJSON() {
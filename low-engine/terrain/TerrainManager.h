@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <vector>
 
 #include "SFML/Graphics/Rect.hpp"
@@ -9,6 +10,7 @@
 #include "TileMapLayer.h"
 #include "box2d/id.h"
 #include "navigation/NavigationGrid.h"
+#include "utils/JsonStream.h"
 
 namespace LowEngine::Terrain {
 
@@ -49,6 +51,39 @@ namespace LowEngine::Terrain {
 
 		bool DeserializeFromJSON(const nlohmann::ordered_json& json);
 
+		/**
+		 * @brief Serialize terrain with only tile chunks changed since ClearChanges.
+		 *
+		 * Layers are written by TileMapLayer::SerializeChangesToJSON.
+		 * Every layer is listed, in order, so added, removed and reordered layers are saved too.
+		 * @return JSON of the changes, read by DeserializeChangesFromJSON.
+		 */
+		nlohmann::ordered_json SerializeChangesToJSON();
+
+		/**
+		 * @brief Apply changes written by SerializeChangesToJSON.
+		 *
+		 * Existing layers are matched by their Id and keep tiles outside of the changed chunks. Layers that are
+		 * not listed are removed.
+		 * @param json JSON of the changes.
+		 * @return True if successful. False otherwise.
+		 */
+		bool DeserializeChangesFromJSON(const nlohmann::ordered_json& json);
+
+		/**
+		 * @brief Forget changed tile chunks of all layers, e.g. once they are saved.
+		 */
+		void ClearChanges();
+
+		/**
+		 * @brief Register routes that deserialize terrain while a scene is streamed, see Utils::JsonStreamParser.
+		 *
+		 * Layers are filled tile by tile. Vertex arrays of a layer are built once, after all its tiles are read.
+		 * @param parser Parser of the scene.
+		 * @param route Route of the terrain object in the scene, e.g. "/terrain".
+		 */
+		void AddJSONStreamRoutes(Utils::JsonStreamParser& parser, const std::string& route);
+
 		void CopyLayersFrom(const TerrainManager& terrain);
 
 		/**
@@ -1,78 +1,93 @@
 #include "TileMapLayer.h"
 
+#include <map>
+#include <tuple>
+#include <utility>
+
+#include "log/Log.h"
+#include "utils/Base64.h"
+#include "utils/RunLength.h"
+
 namespace LowEngine::TileMap {
-	TileMapLayer::TileMapLayer(const TileMapLayer& other)
-		: Id(other.Id), Name(other.Name), IsVisible(other.IsVisible),
-		  ContributesToNavigation(other.ContributesToNavigation),
-		  ContributesToCollision(other.ContributesToCollision),
-		  _drawOrder(other._drawOrder), TileSize(other.TileSize),
-		  _textureId(other._textureId), _tiles(other._tiles),
-		  _staticVertices(other._staticVertices), _staticVertexIndex(other._staticVertexIndex),
-		  _animVertices(other._animVertices), _animVertexIndex(other._animVertexIndex) {
-	}
+	namespace {
+		int FloorDiv(int value, int divisor) {
+			return value / divisor - (value % divisor < 0 ? 1 : 0);
+		}
 
-	TileMapLayer& TileMapLayer::operator=(const TileMapLayer& other) {
-		if (this != &other) {
-			Id = other.Id;
-			Name = other.Name;
-			IsVisible = other.IsVisible;
-			ContributesToNavigation = other.ContributesToNavigation;
-			ContributesToCollision = other.ContributesToCollision;
-			_drawOrder = other._drawOrder;
-			TileSize = other.TileSize;
-			_textureId = other._textureId;
-			_tiles = other._tiles;
-			_staticVertices = other._staticVertices;
-			_staticVertexIndex = other._staticVertexIndex;
-			_animVertices = other._animVertices;
-			_animVertexIndex = other._animVertexIndex;
+		/**
+		 * @brief Read everything about a tile except its position: legacy tiles and palette entries share this.
+		 */
+		void ReadTileFromJSON(const nlohmann::ordered_json& tileJson, Tile& tile) {
+			tile.Type = static_cast<TileType>(tileJson["type"].get<std::uint8_t>());
+			if (tile.Type == TileType::Animated) {
+				tile.AnimationClipName = tileJson["animClipName"].get<std::string>();
+			} else {
+				const auto& rectJson = tileJson["spriteRect"];
+				tile.SpriteRect = sf::IntRect(
+					{rectJson["x"].get<int>(), rectJson["y"].get<int>()},
+					{rectJson["w"].get<int>(), rectJson["h"].get<int>()}
+				);
+			}
+			if (tileJson.contains("hasCollision")) {
+				tile.HasCollision = tileJson["hasCollision"].get<bool>();
+			}
+			if (tileJson.contains("traversalMask")) {
+				tile.TraversalMask = tileJson["traversalMask"].get<std::uint8_t>();
+			}
+			if (tileJson.contains("entryCost")) {
+				tile.EntryCost = tileJson["entryCost"].get<std::uint8_t>();
+			}
 		}
-		return *this;
-	}
 
-	TileMapLayer::TileMapLayer(TileMapLayer&& other) noexcept
-		: Id(std::move(other.Id)), Name(std::move(other.Name)), IsVisible(other.IsVisible),
-		  ContributesToNavigation(other.ContributesToNavigation), ContributesToCollision(other.ContributesToCollision),
-		  _drawOrder(other._drawOrder), TileSize(other.TileSize),
-		  _textureId(other._textureId), _tiles(std::move(other._tiles)),
-		  _staticVertices(std::move(other._staticVertices)), _staticVertexIndex(std::move(other._staticVertexIndex)),
-		  _animVertices(std::move(other._animVertices)), _animVertexIndex(std::move(other._animVertexIndex)) {
+		nlohmann::ordered_json WriteTileToJSON(const Tile& tile) {
+			nlohmann::ordered_json tileJson;
+			tileJson["type"] = static_cast<std::uint8_t>(tile.Type);
+			if (tile.Type == TileType::Animated) {
+				// sprite rect of animated tiles is their current frame
+				tileJson["animClipName"] = tile.AnimationClipName;
+			} else {
+				tileJson["spriteRect"] = {
+					{"x", tile.SpriteRect.position.x},
+					{"y", tile.SpriteRect.position.y},
+					{"w", tile.SpriteRect.size.x},
+					{"h", tile.SpriteRect.size.y}
+				};
+			}
+			tileJson["hasCollision"] = tile.HasCollision;
+			tileJson["traversalMask"] = tile.TraversalMask;
+			tileJson["entryCost"] = tile.EntryCost;
+			return tileJson;
+		}
 	}
 
-	TileMapLayer& TileMapLayer::operator=(TileMapLayer&& other) noexcept {
-		if (this != &other) {
-			Id = std::move(other.Id);
-			Name = std::move(other.Name);
-			IsVisible = other.IsVisible;
-			ContributesToNavigation = other.ContributesToNavigation;
-			ContributesToCollision = other.ContributesToCollision;
-			_drawOrder = other._drawOrder;
-			TileSize = other.TileSize;
-			_textureId = other._textureId;
-			_tiles = std::move(other._tiles);
-			_staticVertices = std::move(other._staticVertices);
-			_staticVertexIndex = std::move(other._staticVertexIndex);
-			_animVertices = std::move(other._animVertices);
-			_animVertexIndex = std::move(other._animVertexIndex);
+	TileMapLayer::TileStore& TileMapLayer::MutableStore() {
+		if (_store.use_count() > 1) {
+			_store = std::make_shared<TileStore>(*_store);
 		}
-		return *this;
+		return *_store;
 	}
 
 	const Tile* TileMapLayer::FindTile(sf::Vector2i cellCoords) const {
-		auto it = _tiles.find(cellCoords);
-		return it == _tiles.end() ? nullptr : &it->second;
+		auto it = _store->Tiles.find(cellCoords);
+		return it == _store->Tiles.end() ? nullptr : &it->second;
 	}
 
 	Tile* TileMapLayer::FindTile(sf::Vector2i cellCoords) {
-		auto it = _tiles.find(cellCoords);
-		return it == _tiles.end() ? nullptr : &it->second;
+		// caller can modify the tile, so don't search shared storage if the tile isn't there
+		if (!std::as_const(*this).FindTile(cellCoords)) {
+			return nullptr;
+		}
+
+		MarkCellChanged(cellCoords);
+		return &MutableStore().Tiles.find(cellCoords)->second;
 	}
 
 	bool TileMapLayer::DeleteTile(sf::Vector2i cellCoords) {
-		const auto erased = _tiles.erase(cellCoords);
-		if (erased == 0) {
+		if (!_store->Tiles.contains(cellCoords)) {
 			return false;
 		}
+		MutableStore().Tiles.erase(cellCoords);
+		MarkCellChanged(cellCoords);
 
 		RebuildStaticVertices();
 		RebuildAnimVertices();
@@ -98,33 +113,49 @@ namespace LowEngine::TileMap {
 	}
 
 	void TileMapLayer::AddTile(sf::Vector2i cellCoords, sf::IntRect spritesheetCoords, bool skipRebuild) {
-		_tiles[cellCoords].Type = TileType::Static;
-		_tiles[cellCoords].SpriteRect = spritesheetCoords;
+		Tile& tile = MutableStore().Tiles[cellCoords];
+		MarkCellChanged(cellCoords);
+		tile.Type = TileType::Static;
+		tile.SpriteRect = spritesheetCoords;
 		if (!skipRebuild) RebuildStaticVertices();
 	}
 
-	void TileMapLayer::AddTile(sf::Vector2i cellCoords, std::string& animClipName) {
-		_tiles[cellCoords].Type = TileType::Animated;
-		_tiles[cellCoords].AnimationClipName = animClipName;
+	void TileMapLayer::AddTile(sf::Vector2i cellCoords, std::string& animClipName, bool skipRebuild) {
+		Tile& tile = MutableStore().Tiles[cellCoords];
+		MarkCellChanged(cellCoords);
+		tile.Type = TileType::Animated;
+		tile.AnimationClipName = animClipName;
+		if (!skipRebuild) RebuildAnimVertices();
+	}
+
+	void TileMapLayer::MarkCellChanged(sf::Vector2i cellCoords) {
+		if (!_allTilesChanged) {
+			const int chunkSize = Config::TILE_CHUNK_SIZE;
+			_changedChunks.insert({FloorDiv(cellCoords.x, chunkSize), FloorDiv(cellCoords.y, chunkSize)});
+		}
+	}
+
+	void TileMapLayer::RebuildVertices() {
+		RebuildStaticVertices();
 		RebuildAnimVertices();
 	}
 
 	void TileMapLayer::CollectDrawables(std::vector<SceneDrawable>& drawables) {
-		if (!IsVisible || _tiles.empty()) return;
+		if (!IsVisible || _store->Tiles.empty()) return;
 
 		const sf::Texture& texture = Assets::GetTexture(_textureId);
 
-		if (_staticVertices.getVertexCount() > 0) {
+		if (_store->StaticVertices.getVertexCount() > 0) {
 			drawables.emplace_back(VertexArrayDrawable{
-				&_staticVertices,
+				&_store->StaticVertices,
 				&texture,
 				_drawOrder
 			});
 		}
 
-		if (_animVertices.getVertexCount() > 0) {
+		if (_store->AnimVertices.getVertexCount() > 0) {
 			drawables.emplace_back(VertexArrayDrawable{
-				&_animVertices,
+				&_store->AnimVertices,
 				&texture,
 				_drawOrder
 			});
@@ -132,7 +163,11 @@ namespace LowEngine::TileMap {
 	}
 
 	void TileMapLayer::Update(float deltaTime, Animation::SpriteSheet& spriteSheet) {
-		for (auto& [coords, tile] : _tiles) {
+		// layers without animated tiles have nothing to update and stay shared
+		if (_store->AnimVertexIndex.empty()) return;
+
+		TileStore& store = MutableStore();
+		for (auto& [coords, tile] : store.Tiles) {
 			if (tile.Type != TileType::Animated) continue;
 			if (!spriteSheet.HasAnimationClip(tile.AnimationClipName)) continue;
 
@@ -143,74 +178,139 @@ namespace LowEngine::TileMap {
 				tile.AnimSpriteCurrentFrame = (tile.AnimSpriteCurrentFrame + 1) % clip.FrameCount;
 				tile.SpriteRect = clip.Frames[tile.AnimSpriteCurrentFrame];
 
-				auto it = _animVertexIndex.find(coords);
-				if (it != _animVertexIndex.end()) {
+				auto it = store.AnimVertexIndex.find(coords);
+				if (it != store.AnimVertexIndex.end()) {
 					UpdateAnimVertexUVs(it->second, tile.SpriteRect);
 				}
 			}
 		}
 	}
 
+	void TileMapLayer::FinishDeserialization() {
+		RebuildVertices();
+		_packedTiles = PackedTiles();
+	}
+
 	bool TileMapLayer::DeserializeFromJSON(const nlohmann::ordered_json& json) {
-		if (json.contains("id")) {
-			Id = json["id"].get<std::string>();
-		}
-		if (json.contains("name")) {
-			Name = json["name"].get<std::string>();
-		}
-		if (json.contains("isVisible")) {
-			IsVisible = json["isVisible"].get<bool>();
-		}
-		if (json.contains("contributesToNavigation")) {
-			ContributesToNavigation = json["contributesToNavigation"].get<bool>();
+		for (const auto& [key, value] : json.items()) {
+			// legacy: raw numeric texture ID is used only if there's no alias
+			if (key == "tiles" || key == "tileChunks" || (key == "textureId" && json.contains("textureAlias"))) continue;
+
+			if (!DeserializePropertyFromJSON(key, value)) {
+				return false;
+			}
 		}
-		if (json.contains("contributesToCollision")) {
-			ContributesToCollision = json["contributesToCollision"].get<bool>();
+		if (json.contains("tiles")) {
+			const auto& tilesJson = json["tiles"];
+			MutableStore().Tiles.reserve(_store->Tiles.size() + tilesJson.size());
+			for (const auto& tileJson : tilesJson) {
+				if (!DeserializeTileFromJSON(tileJson)) {
+					return false;
+				}
+			}
 		}
-		if (json.contains("tileSize")) {
-			TileSize.x = json["tileSize"]["x"].get<std::size_t>();
-			TileSize.y = json["tileSize"]["y"].get<std::size_t>();
+		if (json.contains("tileChunks")) {
+			for (const auto& chunkJson : json["tileChunks"]) {
+				if (!DeserializeTileChunkFromJSON(chunkJson)) {
+					return false;
+				}
+			}
 		}
-		if (json.contains("textureAlias")) {
-			SetTextureId(Assets::GetTextureId(json["textureAlias"].get<std::string>()));
-		} else if (json.contains("textureId")) {
+		FinishDeserialization();
+		return true;
+	}
+
+	bool TileMapLayer::DeserializePropertyFromJSON(std::string_view key, const nlohmann::ordered_json& value) {
+		if (key == "id") {
+			Id = value.get<std::string>();
+		} else if (key == "name") {
+			Name = value.get<std::string>();
+		} else if (key == "isVisible") {
+			IsVisible = value.get<bool>();
+		} else if (key == "contributesToNavigation") {
+			ContributesToNavigation = value.get<bool>();
+		} else if (key == "contributesToCollision") {
+			ContributesToCollision = value.get<bool>();
+		} else if (key == "tileSize") {
+			TileSize.x = value["x"].get<std::size_t>();
+			TileSize.y = value["y"].get<std::size_t>();
+		} else if (key == "textureAlias") {
+			SetTextureId(Assets::GetTextureId(value.get<std::string>()));
+		} else if (key == "textureId") {
 			// legacy: fallback to raw numeric ID (may assign wrong texture if load order changed)
-			SetTextureId(json["textureId"].get<std::size_t>());
+			SetTextureId(value.get<std::size_t>());
+		} else if (key == "drawOrder") {
+			SetDrawOrder(value.get<int>());
+		} else if (key == "tileCount") {
+			MutableStore().Tiles.reserve(_store->Tiles.size() + value.get<std::size_t>());
+		} else if (key == "chunkSize") {
+			_packedTiles.ChunkSize = value.get<int>();
+			if (_packedTiles.ChunkSize <= 0 || _packedTiles.ChunkSize > 1024) {
+				_log->error("Invalid tile chunk size {} of layer '{}'", _packedTiles.ChunkSize, Name);
+				return false;
+			}
+		} else if (key == "replacesChunks") {
+			_packedTiles.ReplacesChunks = value.get<bool>();
+		} else if (key == "tilePalette") {
+			_packedTiles.Palette.resize(value.size());
+			for (std::size_t i = 0; i < value.size(); ++i) {
+				ReadTileFromJSON(value[i], _packedTiles.Palette[i]);
+			}
 		}
-		if (json.contains("drawOrder")) {
-			SetDrawOrder(json["drawOrder"].get<int>());
+		return true;
+	}
+
+	bool TileMapLayer::DeserializeTileFromJSON(const nlohmann::ordered_json& tileJson) {
+		sf::Vector2i coords = {tileJson["cellX"].get<int>(), tileJson["cellY"].get<int>()};
+		Tile tile;
+		ReadTileFromJSON(tileJson, tile);
+		MutableStore().Tiles.insert_or_assign(coords, std::move(tile));
+		return true;
+	}
+
+	bool TileMapLayer::DeserializeTileChunkFromJSON(const nlohmann::ordered_json& chunkJson) {
+		const int chunkSize = _packedTiles.ChunkSize;
+		const sf::Vector2i chunk = {chunkJson["x"].get<int>(), chunkJson["y"].get<int>()};
+
+		auto& cells = _packedTiles.Cells;
+		cells.resize(static_cast<std::size_t>(chunkSize) * chunkSize);
+		if (!Utils::DecodeBase64(chunkJson["cells"].get_ref<const std::string&>(), _packedTiles.Bytes)
+		    || !Utils::DecodeRunLength(_packedTiles.Bytes, cells)) {
+			_log->error("Tile chunk ({}, {}) of layer '{}' is corrupted", chunk.x, chunk.y, Name);
+			return false;
 		}
-		if (json.contains("tiles")) {
-			for (auto& tileJson : json["tiles"]) {
-				sf::Vector2i coords = {tileJson["cellX"].get<int>(), tileJson["cellY"].get<int>()};
-				auto type = static_cast<TileType>(tileJson["type"].get<std::uint8_t>());
-				if (type == TileType::Animated) {
-					auto clipName = tileJson["animClipName"].get<std::string>();
-					AddTile(coords, clipName);
-				} else {
-					sf::IntRect rect(
-						{tileJson["spriteRect"]["x"].get<int>(), tileJson["spriteRect"]["y"].get<int>()},
-						{tileJson["spriteRect"]["w"].get<int>(), tileJson["spriteRect"]["h"].get<int>()}
-					);
-					AddTile(coords, rect, true);
-				}
-				auto& tile = _tiles[coords];
-				if (tileJson.contains("hasCollision")) {
-					tile.HasCollision = tileJson["hasCollision"].get<bool>();
-				}
-				if (tileJson.contains("traversalMask")) {
-					tile.TraversalMask = tileJson["traversalMask"].get<std::uint8_t>();
+
+		const auto& palette = _packedTiles.Palette;
+		auto& tiles = MutableStore().Tiles;
+		for (int y = 0; y < chunkSize; ++y) {
+			for (int x = 0; x < chunkSize; ++x) {
+				const std::uint32_t index = cells[static_cast<std::size_t>(y) * chunkSize + x];
+				if (index == 0) {
+					if (_packedTiles.ReplacesChunks) {
+						tiles.erase(sf::Vector2i(chunk.x * chunkSize + x, chunk.y * chunkSize + y));
+					}
+					continue;
 				}
-				if (tileJson.contains("entryCost")) {
-					tile.EntryCost = tileJson["entryCost"].get<std::uint8_t>();
+				if (index > palette.size()) {
+					_log->error("Tile chunk ({}, {}) of layer '{}' refers to missing palette entry {}",
+					            chunk.x, chunk.y, Name, index - 1);
+					return false;
 				}
+				tiles.insert_or_assign(sf::Vector2i(chunk.x * chunkSize + x, chunk.y * chunkSize + y), palette[index - 1]);
 			}
 		}
-		RebuildStaticVertices();
 		return true;
 	}
 
 	nlohmann::ordered_json TileMapLayer::SerializeToJSON() {
+		return SerializeLayerToJSON(false);
+	}
+
+	nlohmann::ordered_json TileMapLayer::SerializeChangesToJSON() {
+		return SerializeLayerToJSON(!_allTilesChanged);
+	}
+
+	nlohmann::ordered_json TileMapLayer::SerializeLayerToJSON(bool changesOnly) {
 		nlohmann::ordered_json json;
 		json["id"] = Id;
 		json["name"] = Name;
@@ -221,90 +321,144 @@ namespace LowEngine::TileMap {
 		json["drawOrder"] = _drawOrder;
 		json["textureAlias"] = Assets::GetTextureAlias(_textureId);
 
-		nlohmann::ordered_json tilesJson = nlohmann::ordered_json::array();
-		for (auto& [coords, tile] : _tiles) {
-			nlohmann::ordered_json tileJson;
-			tileJson["cellX"] = coords.x;
-			tileJson["cellY"] = coords.y;
-			tileJson["type"] = static_cast<std::uint8_t>(tile.Type);
-			tileJson["spriteRect"] = {
-				{"x", tile.SpriteRect.position.x},
-				{"y", tile.SpriteRect.position.y},
-				{"w", tile.SpriteRect.size.x},
-				{"h", tile.SpriteRect.size.y}
-			};
-			tileJson["animClipName"] = tile.AnimationClipName;
-			tileJson["hasCollision"] = tile.HasCollision;
-			tileJson["traversalMask"] = tile.TraversalMask;
-			tileJson["entryCost"] = tile.EntryCost;
-			tilesJson.emplace_back(tileJson);
+		// distinct tiles, by everything that is saved; animation state is not
+		using PaletteKey = std::tuple<std::uint8_t, int, int, int, int, std::string, bool, std::uint8_t, std::uint8_t>;
+		std::map<PaletteKey, std::uint32_t> paletteIndices;
+		nlohmann::ordered_json paletteJson = nlohmann::ordered_json::array();
+
+		// ordered, so saving the same tiles always gives the same file
+		const int chunkSize = Config::TILE_CHUNK_SIZE;
+		const std::size_t chunkCellCount = static_cast<std::size_t>(chunkSize) * chunkSize;
+		std::map<std::pair<int, int>, std::vector<std::uint32_t>> chunks;
+
+		auto addTile = [&](sf::Vector2i coords, const Tile& tile) {
+			const bool animated = tile.Type == TileType::Animated;
+			const sf::IntRect rect = animated ? sf::IntRect() : tile.SpriteRect;
+			PaletteKey key(static_cast<std::uint8_t>(tile.Type), rect.position.x, rect.position.y,
+			               rect.size.x, rect.size.y, animated ? tile.AnimationClipName : std::string(),
+			               tile.HasCollision, tile.TraversalMask, tile.EntryCost);
+
+			auto [entry, added] = paletteIndices.try_emplace(std::move(key),
+			                                                   static_cast<std::uint32_t>(paletteJson.size() + 1));
+			if (added) {
+				paletteJson.emplace_back(WriteTileToJSON(tile));
+			}
+
+			const sf::Vector2i chunk = {FloorDiv(coords.x, chunkSize), FloorDiv(coords.y, chunkSize)};
+			auto& cells = chunks[{chunk.x, chunk.y}];
+			cells.resize(chunkCellCount);
+			const sf::Vector2i cell = coords - chunk * chunkSize;
+			cells[static_cast<std::size_t>(cell.y) * chunkSize + cell.x] = entry->second;
+		};
+
+		if (changesOnly) {
+			for (const sf::Vector2i& chunk : _changedChunks) {
+				// emptied chunks are written too, so their tiles are removed when the changes are applied
+				chunks[{chunk.x, chunk.y}].resize(chunkCellCount);
+				for (int y = 0; y < chunkSize; ++y) {
+					for (int x = 0; x < chunkSize; ++x) {
+						const sf::Vector2i coords = {chunk.x * chunkSize + x, chunk.y * chunkSize + y};
+						if (const Tile* tile = std::as_const(*this).FindTile(coords)) {
+							addTile(coords, *tile);
+						}
+					}
+				}
+			}
+		} else {
+			for (const auto& [coords, tile] : _store->Tiles) {
+				addTile(coords, tile);
+			}
+		}
+
+		json["chunkSize"] = chunkSize;
+		if (changesOnly) {
+			json["replacesChunks"] = true;
+		} else {
+			json["tileCount"] = _store->Tiles.size();
+		}
+		json["tilePalette"] = std::move(paletteJson);
+
+		nlohmann::ordered_json chunksJson = nlohmann::ordered_json::array();
+		std::vector<std::byte> bytes;
+		for (const auto& [chunk, cells] : chunks) {
+			bytes.clear();
+			Utils::EncodeRunLength(cells, bytes);
+			chunksJson.push_back({
+				{"x", chunk.first},
+				{"y", chunk.second},
+				{"cells", Utils::EncodeBase64(bytes)}
+			});
 		}
-		json["tiles"] = tilesJson;
+		json["tileChunks"] = std::move(chunksJson);
 
 		return json;
 	}
 
 	void TileMapLayer::RebuildStaticVertices() {
-		_staticVertices.clear();
-		_staticVertexIndex.clear();
+		TileStore& store = MutableStore();
+		sf::VertexArray& vertices = store.StaticVertices;
+		vertices.clear();
+		store.StaticVertexIndex.clear();
 
 		std::size_t idx = 0;
-		for (auto& [coords, tile] : _tiles) {
+		for (auto& [coords, tile] : store.Tiles) {
 			if (tile.Type != TileType::Static) continue;
 
-			_staticVertexIndex[coords] = idx;
-			_staticVertices.resize(idx + 6);
+			store.StaticVertexIndex[coords] = idx;
+			vertices.resize(idx + 6);
 
 			float x = static_cast<float>(coords.x) * static_cast<float>(TileSize.x);
 			float y = static_cast<float>(coords.y) * static_cast<float>(TileSize.y);
 			float w = static_cast<float>(TileSize.x);
 			float h = static_cast<float>(TileSize.y);
 
-			_staticVertices[idx + 0].position = {x, y};
-			_staticVertices[idx + 1].position = {x + w, y};
-			_staticVertices[idx + 2].position = {x, y + h};
-			_staticVertices[idx + 3].position = {x + w, y};
-			_staticVertices[idx + 4].position = {x + w, y + h};
-			_staticVertices[idx + 5].position = {x, y + h};
+			vertices[idx + 0].position = {x, y};
+			vertices[idx + 1].position = {x + w, y};
+			vertices[idx + 2].position = {x, y + h};
+			vertices[idx + 3].position = {x + w, y};
+			vertices[idx + 4].position = {x + w, y + h};
+			vertices[idx + 5].position = {x, y + h};
 
 			float u0 = static_cast<float>(tile.SpriteRect.position.x);
 			float v0 = static_cast<float>(tile.SpriteRect.position.y);
 			float u1 = u0 + static_cast<float>(tile.SpriteRect.size.x);
 			float v1 = v0 + static_cast<float>(tile.SpriteRect.size.y);
 
-			_staticVertices[idx + 0].texCoords = {u0, v0};
-			_staticVertices[idx + 1].texCoords = {u1, v0};
-			_staticVertices[idx + 2].texCoords = {u0, v1};
-			_staticVertices[idx + 3].texCoords = {u1, v0};
-			_staticVertices[idx + 4].texCoords = {u1, v1};
-			_staticVertices[idx + 5].texCoords = {u0, v1};
+			vertices[idx + 0].texCoords = {u0, v0};
+			vertices[idx + 1].texCoords = {u1, v0};
+			vertices[idx + 2].texCoords = {u0, v1};
+			vertices[idx + 3].texCoords = {u1, v0};
+			vertices[idx + 4].texCoords = {u1, v1};
+			vertices[idx + 5].texCoords = {u0, v1};
 
 			idx += 6;
 		}
 	}
 
 	void TileMapLayer::RebuildAnimVertices() {
-		_animVertices.clear();
-		_animVertexIndex.clear();
+		TileStore& store = MutableStore();
+		sf::VertexArray& vertices = store.AnimVertices;
+		vertices.clear();
+		store.AnimVertexIndex.clear();
 
 		std::size_t idx = 0;
-		for (auto& [coords, tile] : _tiles) {
+		for (auto& [coords, tile] : store.Tiles) {
 			if (tile.Type != TileType::Animated) continue;
 
-			_animVertexIndex[coords] = idx;
-			_animVertices.resize(idx + 6);
+			store.AnimVertexIndex[coords] = idx;
+			vertices.resize(idx + 6);
 
 			float x = static_cast<float>(coords.x) * static_cast<float>(TileSize.x);
 			float y = static_cast<float>(coords.y) * static_cast<float>(TileSize.y);
 			float w = static_cast<float>(TileSize.x);
 			float h = static_cast<float>(TileSize.y);
 
-			_animVertices[idx + 0].position = {x, y};
-			_animVertices[idx + 1].position = {x + w, y};
-			_animVertices[idx + 2].position = {x, y + h};
-			_animVertices[idx + 3].position = {x + w, y};
-			_animVertices[idx + 4].position = {x + w, y + h};
-			_animVertices[idx + 5].position = {x, y + h};
+			vertices[idx + 0].position = {x, y};
+			vertices[idx + 1].position = {x + w, y};
+			vertices[idx + 2].position = {x, y + h};
+			vertices[idx + 3].position = {x + w, y};
+			vertices[idx + 4].position = {x + w, y + h};
+			vertices[idx + 5].position = {x, y + h};
 
 			UpdateAnimVertexUVs(idx, tile.SpriteRect);
 			idx += 6;
@@ -312,16 +466,17 @@ namespace LowEngine::TileMap {
 	}
 
 	void TileMapLayer::UpdateAnimVertexUVs(std::size_t idx, const sf::IntRect& rect) {
+		sf::VertexArray& vertices = MutableStore().AnimVertices;
 		float u0 = static_cast<float>(rect.position.x);
 		float v0 = static_cast<float>(rect.position.y);
 		float u1 = u0 + static_cast<float>(rect.size.x);
 		float v1 = v0 + static_cast<float>(rect.size.y);
 
-		_animVertices[idx + 0].texCoords = {u0, v0};
-		_animVertices[idx + 1].texCoords = {u1, v0};
-		_animVertices[idx + 2].texCoords = {u0, v1};
-		_animVertices[idx + 3].texCoords = {u1, v0};
-		_animVertices[idx + 4].texCoords = {u1, v1};
-		_animVertices[idx + 5].texCoords = {u0, v1};
+		vertices[idx + 0].texCoords = {u0, v0};
+		vertices[idx + 1].texCoords = {u1, v0};
+		vertices[idx + 2].texCoords = {u0, v1};
+		vertices[idx + 3].texCoords = {u1, v0};
+		vertices[idx + 4].texCoords = {u1, v1};
+		vertices[idx + 5].texCoords = {u0, v1};
 	}
 }
@@ -1,8 +1,12 @@
 #pragma once
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "EngineConfig.h"
 #include "Tile.h"
 #include "assets/Assets.h"
 #include "graphics/Sprite.h"
@@ -11,15 +15,22 @@
 #include "utils/Uuid.h"
 
 namespace LowEngine::TileMap {
+    /**
+     * @brief Single layer of tiles drawn with one texture.
+     *
+     * Tiles and their vertex arrays are shared copy-on-write: copying a layer only shares them with the source,
+     * and whichever copy changes its tiles first makes its own copy. Copying scenes for play mode doesn't
+     * duplicate terrain that is never edited.
+     */
     class TileMapLayer {
     public:
         TileMapLayer() = default;
 
-        TileMapLayer(const TileMapLayer& other);
-        TileMapLayer& operator=(const TileMapLayer& other);
+        TileMapLayer(const TileMapLayer& other) = default;
+        TileMapLayer& operator=(const TileMapLayer& other) = default;
 
-        TileMapLayer(TileMapLayer&& other) noexcept;
-        TileMapLayer& operator=(TileMapLayer&& other) noexcept;
+        TileMapLayer(TileMapLayer&& other) noexcept = default;
+        TileMapLayer& operator=(TileMapLayer&& other) noexcept = default;
 
         std::string Id = Utils::GetNewUuidV4();
 
@@ -57,7 +68,18 @@ namespace LowEngine::TileMap {
 
         void AddTile(sf::Vector2i cellCoords, sf::IntRect spritesheetCoords, bool skipRebuild = false);
 
-        void AddTile(sf::Vector2i cellCoords, std::string& animClipName);
+        void AddTile(sf::Vector2i cellCoords, std::string& animClipName, bool skipRebuild = false);
+
+        /**
+         * @brief Rebuild vertex arrays of all tiles, e.g. after adding many tiles with skipRebuild.
+         */
+        void RebuildVertices();
+
+        /**
+         * @brief Finish deserialization done property by property: rebuild vertex arrays and drop the palette
+         * of packed tiles.
+         */
+        void FinishDeserialization();
 
         /**
          * @brief Look up the tile at the given cell coordinates.
@@ -72,7 +94,15 @@ namespace LowEngine::TileMap {
         bool DeleteTile(sf::Vector2i cellCoords);
 
         [[nodiscard]] const std::unordered_map<sf::Vector2i, Tile, Utils::Vector2iHash>& GetTiles() const {
-            return _tiles;
+            return _store->Tiles;
+        }
+
+        /**
+         * @brief Check if tiles of this layer are shared with a copy of it.
+         * @return True if tile storage is shared.
+         */
+        [[nodiscard]] bool IsTileStoreShared() const {
+            return _store.use_count() > 1;
         }
 
         void CollectDrawables(std::vector<SceneDrawable>& drawables);
@@ -81,8 +111,57 @@ namespace LowEngine::TileMap {
 
         nlohmann::ordered_json SerializeToJSON();
 
+        /**
+         * @brief Serialize the layer with only tile chunks changed since ClearTileChanges.
+         *
+         * Layout is the one of SerializeToJSON, with "replacesChunks" set: chunks replace all tiles in their area,
+         * so chunks emptied since the last save are written too. Only cells of changed chunks are visited.
+         * Layers that were never saved are written whole.
+         * @return JSON of the layer, read by DeserializeFromJSON.
+         */
+        nlohmann::ordered_json SerializeChangesToJSON();
+
+        /**
+         * @brief Forget changed tile chunks, e.g. once they are saved.
+         */
+        void ClearTileChanges() {
+            _changedChunks.clear();
+            _allTilesChanged = false;
+        }
+
         bool DeserializeFromJSON(const nlohmann::ordered_json& json);
 
+        /**
+         * @brief Deserialize a single property of the layer, e.g. while streaming a scene. Unknown keys are ignored.
+         * @param key Key of the property in JSON representation of the layer.
+         * @param value Value of the property.
+         * @return True if successful. False otherwise.
+         */
+        bool DeserializePropertyFromJSON(std::string_view key, const nlohmann::ordered_json& value);
+
+        /**
+         * @brief Add a single tile from its JSON representation, without rebuilding vertex arrays.
+         *
+         * Layers saved before tiles were packed list their tiles like this. Call FinishDeserialization once all
+         * tiles are added.
+         * @param tileJson JSON object representing the tile.
+         * @return True if successful. False otherwise.
+         */
+        bool DeserializeTileFromJSON(const nlohmann::ordered_json& tileJson);
+
+        /**
+         * @brief Add tiles of a single packed chunk, without rebuilding vertex arrays.
+         *
+         * Layers are saved with their tiles packed: distinct tiles are listed once in "tilePalette", and
+         * "tileChunks" holds square chunks of "chunkSize" cells per side. Cells of a chunk are indices into
+         * the palette, starting from 1, with 0 for an empty cell. They are stored row by row, run-length encoded
+         * and base64 encoded. The palette and chunk size have to be deserialized first, as properties.
+         * Call FinishDeserialization once all chunks are added.
+         * @param chunkJson JSON object representing the chunk.
+         * @return True if successful. False otherwise.
+         */
+        bool DeserializeTileChunkFromJSON(const nlohmann::ordered_json& chunkJson);
+
     protected:
         /**
          * @brief The draw order of all sprites in this layer.
@@ -95,24 +174,79 @@ namespace LowEngine::TileMap {
         std::size_t _textureId = 0;
 
         /**
-         * @brief Tiles on this layer.
-         *
-         * Key: grid cell coordinates (col, row)
-         * Value: tile data
+         * @brief Tiles of the layer together with vertex arrays built from them.
+         */
+        struct TileStore {
+            /**
+             * @brief Tiles on this layer.
+             *
+             * Key: grid cell coordinates (col, row)
+             * Value: tile data
+             */
+            std::unordered_map<sf::Vector2i, Tile, Utils::Vector2iHash> Tiles;
+
+            /**
+             * @brief Vertex array for static tiles. Built once on tile placement, never updated per-frame.
+             */
+            sf::VertexArray StaticVertices{sf::PrimitiveType::Triangles};
+            std::unordered_map<sf::Vector2i, std::size_t, Utils::Vector2iHash> StaticVertexIndex;
+
+            /**
+             * @brief Vertex array for animated tiles. UVs updated each frame as animation advances.
+             */
+            sf::VertexArray AnimVertices{sf::PrimitiveType::Triangles};
+            std::unordered_map<sf::Vector2i, std::size_t, Utils::Vector2iHash> AnimVertexIndex;
+        };
+
+        /**
+         * @brief Tile storage, possibly shared with copies of this layer. Never modified while shared.
+         */
+        std::shared_ptr<TileStore> _store = std::make_shared<TileStore>();
+
+        /**
+         * @brief Get tile storage for modification. Makes a private copy first if storage is shared.
+         * @return Reference to tile storage owned only by this layer.
+         */
+        TileStore& MutableStore();
+
+        /**
+         * @brief State kept while packed tiles are deserialized, see DeserializeTileChunkFromJSON.
+         */
+        struct PackedTiles {
+            int ChunkSize = Config::TILE_CHUNK_SIZE;
+            std::vector<Tile> Palette;
+
+            /** @brief Do chunks replace all tiles in their area? Set for changes, see SerializeChangesToJSON. */
+            bool ReplacesChunks = false;
+
+            /** @brief Buffers reused by all chunks. */
+            std::vector<std::byte> Bytes;
+            std::vector<std::uint32_t> Cells;
+        };
+
+        PackedTiles _packedTiles;
+
+        /**
+         * @brief Chunks, see Config::TILE_CHUNK_SIZE, with tiles changed since ClearTileChanges.
+         */
+        std::unordered_set<sf::Vector2i, Utils::Vector2iHash> _changedChunks;
+
+        /**
+         * @brief Were tiles of the layer never saved? Such layers are saved whole.
          */
-        std::unordered_map<sf::Vector2i, Tile, Utils::Vector2iHash> _tiles;
+        bool _allTilesChanged = true;
 
         /**
-         * @brief Vertex array for static tiles. Built once on tile placement, never updated per-frame.
+         * @brief Mark the chunk holding provided cell as changed.
+         * @param cellCoords Grid cell coordinates (col, row).
          */
-        sf::VertexArray _staticVertices{sf::PrimitiveType::Triangles};
-        std::unordered_map<sf::Vector2i, std::size_t, Utils::Vector2iHash> _staticVertexIndex;
+        void MarkCellChanged(sf::Vector2i cellCoords);
 
         /**
-         * @brief Vertex array for animated tiles. UVs updated each frame as animation advances.
+         * @brief Serialize the layer, see SerializeToJSON and SerializeChangesToJSON.
+         * @param changesOnly Should only changed chunks be written?
          */
-        sf::VertexArray _animVertices{sf::PrimitiveType::Triangles};
-        std::unordered_map<sf::Vector2i, std::size_t, Utils::Vector2iHash> _animVertexIndex;
+        nlohmann::ordered_json SerializeLayerToJSON(bool changesOnly);
 
         void RebuildStaticVertices();
         void RebuildAnimVertices();
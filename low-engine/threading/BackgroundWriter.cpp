@@ -0,0 +1,239 @@
+#include "BackgroundWriter.h"
+
+#include <exception>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "log/Log.h"
+
+namespace LowEngine::Threading {
+	namespace {
+		/**
+		 * @brief Flush written content of a file from OS caches to the disk.
+		 * @param path Path to the file.
+		 * @return True if successful. False otherwise.
+		 */
+		bool SyncFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+			HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+			                          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE) {
+				return false;
+			}
+			bool synced = FlushFileBuffers(file) != 0;
+			CloseHandle(file);
+			return synced;
+#else
+			int descriptor = open(path.c_str(), O_WRONLY);
+			if (descriptor < 0) {
+				return false;
+			}
+			bool synced = fsync(descriptor) == 0;
+			close(descriptor);
+			return synced;
+#endif
+		}
+
+		/**
+		 * @brief Flush directory entries, e.g. after a rename, to the disk. Windows flushes them with the file.
+		 * @param path Path to the directory.
+		 * @return True if successful. False otherwise.
+		 */
+		bool SyncDirectory(const std::filesystem::path& path) {
+#ifdef _WIN32
+			return true;
+#else
+			int descriptor = open(path.empty() ? "." : path.c_str(), O_RDONLY | O_DIRECTORY);
+			if (descriptor < 0) {
+				return false;
+			}
+			bool synced = fsync(descriptor) == 0;
+			close(descriptor);
+			return synced;
+#endif
+		}
+	}
+
+	BackgroundWriter::BackgroundWriter() {
+		// started once all members are constructed
+		_thread = std::thread(&BackgroundWriter::WriterLoop, this);
+	}
+
+	BackgroundWriter::~BackgroundWriter() {
+		{
+			std::lock_guard lock(_mutex);
+			_stopping = true;
+		}
+		_queuedCondition.notify_all();
+		_thread.join();
+	}
+
+	void BackgroundWriter::Write(std::filesystem::path path, Encoder encode, Callback onDone) {
+		Job job;
+		job.Files.push_back({std::move(path), std::move(encode)});
+		job.OnDone = std::move(onDone);
+		Queue(std::move(job));
+	}
+
+	void BackgroundWriter::WriteAll(std::vector<File> files, Callback onDone) {
+		Job job;
+		job.Files = std::move(files);
+		job.OnDone = std::move(onDone);
+		Queue(std::move(job));
+	}
+
+	void BackgroundWriter::Append(std::filesystem::path path, Encoder encode, Callback onDone) {
+		Job job;
+		job.Files.push_back({std::move(path), std::move(encode)});
+		job.OnDone = std::move(onDone);
+		job.Append = true;
+		Queue(std::move(job));
+	}
+
+	void BackgroundWriter::Queue(Job job) {
+		{
+			std::lock_guard lock(_mutex);
+			_queued.push_back(std::move(job));
+			_pending++;
+		}
+		_queuedCondition.notify_one();
+	}
+
+	void BackgroundWriter::Poll() {
+		std::vector<Job> finished;
+		{
+			std::lock_guard lock(_mutex);
+			if (_finished.empty()) return;
+			finished.swap(_finished);
+		}
+
+		for (Job& job : finished) {
+			if (!job.Error.empty()) {
+				_log->error("Failed to write file {}: {}", job.FailedPath.string(), job.Error);
+			}
+			if (job.OnDone) {
+				job.OnDone(job.Success);
+			}
+		}
+	}
+
+	void BackgroundWriter::Flush() {
+		{
+			std::unique_lock lock(_mutex);
+			_finishedCondition.wait(lock, [this] { return _pending == 0; });
+		}
+		Poll();
+	}
+
+	bool BackgroundWriter::IsWriting() const {
+		std::lock_guard lock(_mutex);
+		return _pending > 0;
+	}
+
+	bool BackgroundWriter::WriteFileAtomically(const std::filesystem::path& path, std::span<const std::byte> content,
+	                                           std::string& error) {
+		std::filesystem::path tempPath = path;
+		tempPath += ".tmp";
+
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			error = "cannot open temporary file " + tempPath.string();
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+		file.close();
+
+		// content has to reach the disk before the rename does, or a crash can leave an empty file behind
+		std::error_code errorCode;
+		if (file.fail()) {
+			error = "cannot write temporary file " + tempPath.string();
+		} else if (!SyncFile(tempPath)) {
+			error = "cannot flush temporary file " + tempPath.string();
+		} else {
+			std::filesystem::rename(tempPath, path, errorCode);
+			if (!errorCode) {
+				if (!SyncDirectory(path.parent_path())) {
+					_log->warn("Cannot flush directory of {}, file may not survive a crash", path.string());
+				}
+				return true;
+			}
+			error = "cannot replace the file: " + errorCode.message();
+		}
+
+		std::filesystem::remove(tempPath, errorCode);
+		return false;
+	}
+
+	bool BackgroundWriter::AppendToFile(const std::filesystem::path& path, std::span<const std::byte> content,
+	                                    std::string& error) {
+		std::ofstream file(path, std::ios::binary | std::ios::app);
+		if (!file.is_open()) {
+			error = "cannot open file " + path.string();
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+		file.close();
+
+		if (file.fail()) {
+			error = "cannot append to file " + path.string();
+			return false;
+		}
+		if (!SyncFile(path)) {
+			error = "cannot flush file " + path.string();
+			return false;
+		}
+		return true;
+	}
+
+	void BackgroundWriter::WriterLoop() {
+		std::unique_lock lock(_mutex);
+		while (true) {
+			_queuedCondition.wait(lock, [this] { return _stopping || !_queued.empty(); });
+			if (_queued.empty()) {
+				return; // stopping, and nothing left to write
+			}
+
+			Job job = std::move(_queued.front());
+			_queued.pop_front();
+			lock.unlock();
+
+			std::vector<std::byte> content;
+			job.Success = true;
+			for (File& file : job.Files) {
+				bool written = false;
+				try {
+					content.clear();
+					if (file.Encode(content)) {
+						written = job.Append
+							          ? AppendToFile(file.Path, content, job.Error)
+							          : WriteFileAtomically(file.Path, content, job.Error);
+					} else {
+						job.Error = "encoding failed";
+					}
+				} catch (const std::exception& e) {
+					job.Error = std::string("encoding failed: ") + e.what();
+				}
+				if (!written) {
+					job.Success = false;
+					job.FailedPath = file.Path;
+					break;
+				}
+			}
+			// release the snapshots before the job waits for Poll
+			job.Files.clear();
+
+			lock.lock();
+			_finished.push_back(std::move(job));
+			_pending--;
+			_finishedCondition.notify_all();
+		}
+	}
+}
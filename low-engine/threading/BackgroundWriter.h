@@ -0,0 +1,157 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace LowEngine::Threading {
+	/**
+	 * @brief Writes files on a dedicated thread, so saving doesn't stall the frame.
+	 *
+	 * The caller takes a snapshot of whatever it saves and hands it over in an encoder, which runs on the writer
+	 * thread together with the file I/O. The snapshot must not refer to live engine state.
+	 *
+	 * Files are replaced atomically: content goes to a temporary file next to the target, which is flushed to the
+	 * disk and then renamed over it, so neither an interrupted save nor a crash right after it leaves
+	 * a half-written file. Appends (see Append) are the exception.
+	 * Files are written one at a time, in the order they were queued. Completion callbacks and error logging
+	 * happen on the thread calling Poll, usually the main thread, so callbacks can safely touch engine state.
+	 */
+	class BackgroundWriter {
+	public:
+		/**
+		 * @brief Produces content of the file. Runs on the writer thread.
+		 */
+		using Encoder = std::function<bool(std::vector<std::byte>& content)>;
+
+		/**
+		 * @brief Called with the result of a write. Runs on the thread calling Poll.
+		 */
+		using Callback = std::function<void(bool success)>;
+
+		/**
+		 * @brief File written by WriteAll.
+		 */
+		struct File {
+			std::filesystem::path Path;
+			Encoder Encode;
+		};
+
+		BackgroundWriter();
+
+		/**
+		 * @brief Finish queued writes and stop the writer thread. Callbacks of unpolled writes are not called.
+		 */
+		~BackgroundWriter();
+
+		BackgroundWriter(const BackgroundWriter&) = delete;
+		BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+
+		/**
+		 * @brief Queue a file write.
+		 * @param path Path of the file. Existing file is replaced once the new content is written.
+		 * @param encode Function producing content of the file. Returning false cancels the write.
+		 * @param onDone Function called by Poll once the write finished. Can be empty.
+		 */
+		void Write(std::filesystem::path path, Encoder encode, Callback onDone = nullptr);
+
+		/**
+		 * @brief Queue writes of several files, done in order as a single write. Files after a failed one are skipped.
+		 *
+		 * Used when a file may only be replaced once another one is, e.g. a journal after its scene file.
+		 * @param files Files to write. Each of them is replaced like by Write.
+		 * @param onDone Function called by Poll once all files were written or one of them failed. Can be empty.
+		 */
+		void WriteAll(std::vector<File> files, Callback onDone = nullptr);
+
+		/**
+		 * @brief Queue appending to a file, e.g. a journal. Writes queued before are finished first.
+		 *
+		 * Appending isn't atomic: an interrupted append can leave a partial tail, so content should be
+		 * verifiable by its reader.
+		 * @param path Path of the file. File is created if it doesn't exist.
+		 * @param encode Function producing appended content. Returning false cancels the append.
+		 * @param onDone Function called by Poll once the append finished. Can be empty.
+		 */
+		void Append(std::filesystem::path path, Encoder encode, Callback onDone = nullptr);
+
+		/**
+		 * @brief Log errors and call callbacks of finished writes.
+		 */
+		void Poll();
+
+		/**
+		 * @brief Block until all queued writes finished, then Poll.
+		 */
+		void Flush();
+
+		/**
+		 * @brief Check if any write is queued or running.
+		 * @return True if the writer is busy.
+		 */
+		[[nodiscard]] bool IsWriting() const;
+
+		/**
+		 * @brief Replace file with new content, through a temporary file flushed to the disk and renamed over the target.
+		 * @param path Path of the file.
+		 * @param content New content of the file.
+		 * @param[out] error Description of the failure, if any.
+		 * @return True if successful. False otherwise, the target file is left intact.
+		 */
+		static bool WriteFileAtomically(const std::filesystem::path& path, std::span<const std::byte> content,
+		                                std::string& error);
+
+		/**
+		 * @brief Append content to the end of a file and flush it to the disk.
+		 * @param path Path of the file. File is created if it doesn't exist.
+		 * @param content Appended content.
+		 * @param[out] error Description of the failure, if any.
+		 * @return True if successful.
+		 */
+		static bool AppendToFile(const std::filesystem::path& path, std::span<const std::byte> content,
+		                         std::string& error);
+
+	protected:
+		struct Job {
+			std::vector<File> Files;
+			Callback OnDone;
+			/** @brief Is content appended instead of replacing the file? */
+			bool Append = false;
+			bool Success = false;
+			/** @brief File that failed to be written, if any. */
+			std::filesystem::path FailedPath;
+			std::string Error;
+		};
+
+		std::thread _thread;
+
+		std::deque<Job> _queued;
+		/** @brief Writes waiting for Poll. */
+		std::vector<Job> _finished;
+		/** @brief Number of queued and running writes. */
+		size_t _pending = 0;
+		bool _stopping = false;
+
+		mutable std::mutex _mutex;
+		std::condition_variable _queuedCondition;
+		std::condition_variable _finishedCondition;
+
+		/**
+		 * @brief Add job to the queue and wake the writer thread.
+		 * @param job Job to queue.
+		 */
+		void Queue(Job job);
+
+		/**
+		 * @brief Main loop of the writer thread.
+		 */
+		void WriterLoop();
+	};
+}
@@ -0,0 +1,93 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+
+#include "EngineConfig.h"
+
+namespace LowEngine::Threading {
+	void WorkerPool::Batch::RunJobs() {
+		for (size_t index = _next.fetch_add(1, std::memory_order_relaxed);
+		     index < _count;
+		     index = _next.fetch_add(1, std::memory_order_relaxed)) {
+			_job(index);
+
+			if (_done.fetch_add(1, std::memory_order_acq_rel) + 1 == _count) {
+				std::lock_guard lock(_doneMutex);
+				_doneCondition.notify_all();
+			}
+		}
+	}
+
+	WorkerPool::WorkerPool(size_t threadCount) {
+		_threads.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; ++i) {
+			_threads.emplace_back(&WorkerPool::WorkerLoop, this);
+		}
+	}
+
+	WorkerPool::~WorkerPool() {
+		{
+			std::lock_guard lock(_batchesMutex);
+			_stopping = true;
+		}
+		_batchesCondition.notify_all();
+
+		for (auto& thread: _threads) {
+			thread.join();
+		}
+	}
+
+	std::shared_ptr<WorkerPool::Batch> WorkerPool::Submit(size_t count, std::function<void(size_t)> job) {
+		std::shared_ptr<Batch> batch(new Batch(count, std::move(job)));
+		if (count == 0 || _threads.empty()) {
+			return batch; // nothing to share, waiting thread runs everything
+		}
+
+		{
+			std::lock_guard lock(_batchesMutex);
+			_batches.push_back(batch);
+		}
+		_batchesCondition.notify_all();
+		return batch;
+	}
+
+	void WorkerPool::Wait(const std::shared_ptr<Batch>& batch) {
+		batch->RunJobs();
+		Retire(batch);
+
+		std::unique_lock lock(batch->_doneMutex);
+		batch->_doneCondition.wait(lock, [&batch] { return batch->IsDone(); });
+	}
+
+	WorkerPool& WorkerPool::GetShared() {
+		static WorkerPool shared(Config::WORKER_THREAD_COUNT > 0
+			                         ? Config::WORKER_THREAD_COUNT
+			                         : std::max(1u, std::thread::hardware_concurrency()) - 1);
+		return shared;
+	}
+
+	void WorkerPool::WorkerLoop() {
+		while (true) {
+			std::shared_ptr<Batch> batch;
+			{
+				std::unique_lock lock(_batchesMutex);
+				_batchesCondition.wait(lock, [this] { return _stopping || !_batches.empty(); });
+				if (_batches.empty()) {
+					return; // stopping, and nothing left to do
+				}
+				batch = _batches.front();
+			}
+
+			batch->RunJobs();
+			Retire(batch);
+		}
+	}
+
+	void WorkerPool::Retire(const std::shared_ptr<Batch>& batch) {
+		std::lock_guard lock(_batchesMutex);
+		auto it = std::find(_batches.begin(), _batches.end(), batch);
+		if (it != _batches.end()) {
+			_batches.erase(it);
+		}
+	}
+}
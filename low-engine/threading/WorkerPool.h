@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LowEngine::Threading {
+	/**
+	 * @brief Fixed set of worker threads executing batches of indexed jobs.
+	 *
+	 * Work is submitted as a batch: a job function and number of indices to run it for. Workers claim indices one by
+	 * one, so uneven jobs are balanced automatically. Thread waiting for a batch takes part in running it,
+	 * which also makes submitting a batch from inside another batch's job safe.
+	 */
+	class WorkerPool {
+	public:
+		/**
+		 * @brief Batch of jobs submitted to the pool.
+		 */
+		class Batch {
+		public:
+			/**
+			 * @brief Check if all jobs in this batch finished.
+			 * @return True if all jobs finished.
+			 */
+			[[nodiscard]] bool IsDone() const {
+				return _done.load(std::memory_order_acquire) == _count;
+			}
+
+		protected:
+			friend class WorkerPool;
+
+			Batch(size_t count, std::function<void(size_t)> job) : _count(count), _job(std::move(job)) {}
+
+			/**
+			 * @brief Claim and run jobs until there's nothing left to claim.
+			 */
+			void RunJobs();
+
+			size_t _count;
+			std::function<void(size_t)> _job;
+			std::atomic<size_t> _next = 0;
+			std::atomic<size_t> _done = 0;
+			std::mutex _doneMutex;
+			std::condition_variable _doneCondition;
+		};
+
+		/**
+		 * @brief Create a pool of worker threads.
+		 * @param threadCount Number of worker threads. Pool with 0 threads runs everything on the waiting thread.
+		 */
+		explicit WorkerPool(size_t threadCount);
+
+		~WorkerPool();
+
+		WorkerPool(const WorkerPool&) = delete;
+		WorkerPool& operator=(const WorkerPool&) = delete;
+
+		/**
+		 * @brief Retrieve number of worker threads, not counting the threads waiting for batches.
+		 * @return Number of worker threads.
+		 */
+		[[nodiscard]] size_t GetThreadCount() const {
+			return _threads.size();
+		}
+
+		/**
+		 * @brief Submit a batch of jobs. Workers start running it immediately.
+		 * @param count Number of jobs in the batch.
+		 * @param job Function called for every index in [0, count).
+		 * @return Handle to the batch. Must be passed to Wait before job's captures go out of scope.
+		 */
+		std::shared_ptr<Batch> Submit(size_t count, std::function<void(size_t)> job);
+
+		/**
+		 * @brief Block until all jobs of the batch finished. Calling thread runs jobs that were not claimed yet.
+		 * @param batch Handle returned by Submit.
+		 */
+		void Wait(const std::shared_ptr<Batch>& batch);
+
+		/**
+		 * @brief Run job for every index in [0, count) and wait for all of them to finish.
+		 * @param count Number of jobs.
+		 * @param job Function called for every index.
+		 */
+		void ParallelFor(size_t count, std::function<void(size_t)> job) {
+			Wait(Submit(count, std::move(job)));
+		}
+
+		/**
+		 * @brief Retrieve worker pool shared by the whole engine.
+		 *
+		 * Pool is created on first use with Config::WORKER_THREAD_COUNT threads.
+		 * @return Reference to the shared worker pool.
+		 */
+		static WorkerPool& GetShared();
+
+	protected:
+		std::vector<std::thread> _threads;
+
+		/** @brief Batches that still have unclaimed jobs. */
+		std::deque<std::shared_ptr<Batch>> _batches;
+		std::mutex _batchesMutex;
+		std::condition_variable _batchesCondition;
+		bool _stopping = false;
+
+		/**
+		 * @brief Main loop of the worker thread.
+		 */
+		void WorkerLoop();
+
+		/**
+		 * @brief Remove batch from the queue once all its jobs are claimed.
+		 * @param batch Batch to remove.
+		 */
+		void Retire(const std::shared_ptr<Batch>& batch);
+	};
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LowEngine::Utils {
+	/**
+	 * @brief Encode bytes as base64 text (RFC 4648, with padding), e.g. to store binary data in JSON.
+	 * @param data Bytes to encode.
+	 * @return Base64 text.
+	 */
+	inline std::string EncodeBase64(std::span<const std::byte> data) {
+		static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+		std::string text;
+		text.reserve((data.size() + 2) / 3 * 4);
+		size_t i = 0;
+		for (; i + 3 <= data.size(); i += 3) {
+			uint32_t bits = std::to_integer<uint32_t>(data[i]) << 16
+			                | std::to_integer<uint32_t>(data[i + 1]) << 8
+			                | std::to_integer<uint32_t>(data[i + 2]);
+			text += alphabet[bits >> 18 & 0x3F];
+			text += alphabet[bits >> 12 & 0x3F];
+			text += alphabet[bits >> 6 & 0x3F];
+			text += alphabet[bits & 0x3F];
+		}
+
+		const size_t rest = data.size() - i;
+		if (rest > 0) {
+			uint32_t bits = std::to_integer<uint32_t>(data[i]) << 16;
+			if (rest == 2) {
+				bits |= std::to_integer<uint32_t>(data[i + 1]) << 8;
+			}
+			text += alphabet[bits >> 18 & 0x3F];
+			text += alphabet[bits >> 12 & 0x3F];
+			text += rest == 2 ? alphabet[bits >> 6 & 0x3F] : '=';
+			text += '=';
+		}
+		return text;
+	}
+
+	/**
+	 * @brief Decode base64 text written by EncodeBase64.
+	 * @param text Base64 text, with padding.
+	 * @param[out] out Decoded bytes. Previous content is replaced, capacity is reused.
+	 * @return True if successful. False if the text is not valid base64.
+	 */
+	inline bool DecodeBase64(std::string_view text, std::vector<std::byte>& out) {
+		static constexpr std::array<int8_t, 256> values = [] {
+			std::array<int8_t, 256> table{};
+			table.fill(-1);
+			constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			for (size_t i = 0; i < alphabet.size(); ++i) {
+				table[static_cast<unsigned char>(alphabet[i])] = static_cast<int8_t>(i);
+			}
+			return table;
+		}();
+
+		out.clear();
+		if (text.size() % 4 != 0) {
+			return false;
+		}
+		out.reserve(text.size() / 4 * 3);
+
+		for (size_t i = 0; i < text.size(); i += 4) {
+			const bool last = i + 4 == text.size();
+			const size_t padding = last ? (text[i + 3] == '=') + (text[i + 2] == '=') : 0;
+
+			uint32_t bits = 0;
+			for (size_t j = 0; j < 4; ++j) {
+				int8_t value = j < 4 - padding ? values[static_cast<unsigned char>(text[i + j])] : 0;
+				if (value < 0) {
+					return false;
+				}
+				bits = bits << 6 | static_cast<uint32_t>(value);
+			}
+
+			out.push_back(static_cast<std::byte>(bits >> 16));
+			if (padding < 2) out.push_back(static_cast<std::byte>(bits >> 8));
+			if (padding < 1) out.push_back(static_cast<std::byte>(bits));
+		}
+		return true;
+	}
+}
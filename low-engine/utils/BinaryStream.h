@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace LowEngine::Utils {
+	/**
+	 * @brief Appends binary values to a byte buffer.
+	 *
+	 * Values are written in native byte order, without padding. All supported platforms are little-endian.
+	 */
+	class BinaryWriter {
+	public:
+		/**
+		 * @brief JSON value that belongs at an offset of the buffer, MessagePack encoded, see WriteMessagePack.
+		 */
+		struct DeferredValue {
+			size_t Offset = 0;
+			nlohmann::ordered_json Value;
+		};
+
+		/**
+		 * @brief Start appending to a buffer.
+		 * @param out Buffer to append to.
+		 * @param deferred List that receives values of WriteMessagePack instead of encoding them. Can be null.
+		 */
+		explicit BinaryWriter(std::vector<std::byte>& out, std::vector<DeferredValue>* deferred = nullptr)
+			: _out(out), _deferred(deferred) {
+		}
+
+		/**
+		 * @brief Append trivially copyable value.
+		 * @param value Value to append.
+		 */
+		template <typename T>
+		void Write(const T& value) {
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written");
+			WriteBytes(&value, sizeof(T));
+		}
+
+		/**
+		 * @brief Overwrite value written before, e.g. a count that wasn't known yet.
+		 * @param offset Offset of the value in the buffer.
+		 * @param value New value.
+		 */
+		template <typename T>
+		void WriteAt(size_t offset, const T& value) {
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written");
+			std::memcpy(_out.data() + offset, &value, sizeof(T));
+		}
+
+		/**
+		 * @brief Append raw bytes.
+		 * @param data Pointer to bytes.
+		 * @param size Number of bytes.
+		 */
+		void WriteBytes(const void* data, size_t size) {
+			if (size > 0) {
+				std::memcpy(Extend(size), data, size);
+			}
+		}
+
+		/**
+		 * @brief Append string as its length followed by its characters.
+		 * @param text String to append.
+		 */
+		void WriteString(std::string_view text) {
+			Write(static_cast<uint32_t>(text.size()));
+			WriteBytes(text.data(), text.size());
+		}
+
+		/**
+		 * @brief Append JSON value, MessagePack encoded and prefixed with its size in bytes as uint32_t.
+		 *
+		 * Writers with a list of deferred values only add the value to the list, to be encoded later, possibly on
+		 * another thread, see SceneFileSnapshot.
+		 * @param value Value to append.
+		 */
+		void WriteMessagePack(nlohmann::ordered_json&& value) {
+			if (_deferred != nullptr) {
+				_deferred->push_back({_out.size(), std::move(value)});
+				return;
+			}
+			WriteMessagePack(static_cast<const nlohmann::ordered_json&>(value));
+		}
+
+		/**
+		 * @brief Append JSON value, MessagePack encoded and prefixed with its size in bytes as uint32_t.
+		 * @param value Value to append. Copied if the writer defers values.
+		 */
+		void WriteMessagePack(const nlohmann::ordered_json& value) {
+			if (_deferred != nullptr) {
+				_deferred->push_back({_out.size(), value});
+				return;
+			}
+			_packed.clear();
+			nlohmann::ordered_json::to_msgpack(value, _packed);
+			Write(static_cast<uint32_t>(_packed.size()));
+			WriteBytes(_packed.data(), _packed.size());
+		}
+
+		/**
+		 * @brief Append uninitialized bytes, to be filled in by the caller.
+		 * @param size Number of bytes.
+		 * @return Pointer to the bytes. Invalidated by the next write.
+		 */
+		std::byte* Extend(size_t size) {
+			size_t offset = _out.size();
+			_out.resize(offset + size);
+			return _out.data() + offset;
+		}
+
+		/**
+		 * @brief Retrieve number of bytes in the buffer, which is the offset of the next written value.
+		 * @return Number of bytes.
+		 */
+		[[nodiscard]] size_t GetSize() const {
+			return _out.size();
+		}
+
+	protected:
+		std::vector<std::byte>& _out;
+
+		/** @brief Values left for later encoding, see WriteMessagePack. Not owned. */
+		std::vector<DeferredValue>* _deferred = nullptr;
+
+		/** @brief Buffer reused for MessagePack encoding. */
+		std::vector<uint8_t> _packed;
+	};
+
+	/**
+	 * @brief Reads binary values written by BinaryWriter from a byte span, without copying the data.
+	 *
+	 * Reading past the end fails without touching the output and marks the reader as failed.
+	 */
+	class BinaryReader {
+	public:
+		explicit BinaryReader(std::span<const std::byte> data) : _data(data) {
+		}
+
+		/**
+		 * @brief Read trivially copyable value.
+		 * @param[out] value Read value.
+		 * @return True if value was read.
+		 */
+		template <typename T>
+		bool Read(T& value) {
+			static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read");
+			const std::byte* bytes = ReadBytes(sizeof(T));
+			if (bytes == nullptr) {
+				return false;
+			}
+			std::memcpy(&value, bytes, sizeof(T));
+			return true;
+		}
+
+		/**
+		 * @brief Read string written by BinaryWriter::WriteString.
+		 * @param[out] text View of the string, pointing into the read data.
+		 * @return True if string was read.
+		 */
+		bool ReadString(std::string_view& text) {
+			uint32_t size = 0;
+			if (!Read(size)) {
+				return false;
+			}
+			const std::byte* bytes = ReadBytes(size);
+			if (bytes == nullptr) {
+				return false;
+			}
+			text = {reinterpret_cast<const char*>(bytes), size};
+			return true;
+		}
+
+		/**
+		 * @brief Read raw bytes.
+		 * @param size Number of bytes.
+		 * @return Pointer to the bytes in the read data. Returns nullptr if there's not enough data.
+		 */
+		const std::byte* ReadBytes(size_t size) {
+			if (size > GetRemaining()) {
+				_failed = true;
+				return nullptr;
+			}
+			const std::byte* bytes = _data.data() + _offset;
+			_offset += size;
+			return bytes;
+		}
+
+		/**
+		 * @brief Retrieve number of bytes left to read.
+		 * @return Number of bytes.
+		 */
+		[[nodiscard]] size_t GetRemaining() const {
+			return _data.size() - _offset;
+		}
+
+		/**
+		 * @brief Check if any read failed because of missing data.
+		 * @return True if a read failed.
+		 */
+		[[nodiscard]] bool HasFailed() const {
+			return _failed;
+		}
+
+	protected:
+		std::span<const std::byte> _data;
+		size_t _offset = 0;
+		bool _failed = false;
+	};
+}
@@ -0,0 +1,261 @@
+#include "JsonStream.h"
+
+namespace LowEngine::Utils {
+	namespace {
+		std::vector<std::string> SplitRoute(std::string_view route) {
+			std::vector<std::string> segments;
+			while (!route.empty()) {
+				if (route.front() == '/') {
+					route.remove_prefix(1);
+				}
+				size_t end = route.find('/');
+				segments.emplace_back(route.substr(0, end));
+				route.remove_prefix(end == std::string_view::npos ? route.size() : end);
+			}
+			return segments;
+		}
+
+		bool SegmentMatches(const std::string& routeSegment, std::string_view segment) {
+			return routeSegment == "*" || routeSegment == segment;
+		}
+	}
+
+	void JsonStreamParser::OnValue(std::string_view route, ValueHandler handler) {
+		_routes.push_back({SplitRoute(route), std::move(handler), nullptr, nullptr});
+	}
+
+	void JsonStreamParser::OnContainer(std::string_view route, ContainerHandler begin, ContainerHandler end) {
+		_routes.push_back({SplitRoute(route), nullptr, std::move(begin), std::move(end)});
+	}
+
+	bool JsonStreamParser::Parse(std::string_view text) {
+		Reset();
+		bool parsed = nlohmann::ordered_json::sax_parse(text.begin(), text.end(), this);
+		if (parsed) {
+			_error.clear();
+		}
+		return parsed;
+	}
+
+	bool JsonStreamParser::Parse(std::istream& input) {
+		Reset();
+		bool parsed = nlohmann::ordered_json::sax_parse(input, this);
+		if (parsed) {
+			_error.clear();
+		}
+		return parsed;
+	}
+
+	void JsonStreamParser::Reset() {
+		_frames.clear();
+		_key.clear();
+		_skipDepth = 0;
+		_captureRoute = nullptr;
+		_captured = nullptr;
+		_captureStack.clear();
+		_error = "Unexpected end of input";
+	}
+
+	const JsonStreamParser::Route* JsonStreamParser::MatchRoute(bool& onTheWay) const {
+		// path of the value: keys of open containers, followed by the value's own key
+		const size_t depth = _frames.size();
+		const std::string_view key = GetCurrentKey();
+		auto segmentAt = [this, depth, key](size_t index) -> std::string_view {
+			// root container has no key
+			return index + 1 < depth ? std::string_view(_frames[index + 1].Key) : key;
+		};
+
+		onTheWay = false;
+		for (const Route& route : _routes) {
+			if (route.Segments.size() < depth) continue;
+
+			bool matches = true;
+			for (size_t i = 0; i < depth && matches; ++i) {
+				matches = SegmentMatches(route.Segments[i], segmentAt(i));
+			}
+			if (!matches) continue;
+
+			if (route.Segments.size() == depth) {
+				return &route;
+			}
+			onTheWay = true;
+		}
+		return nullptr;
+	}
+
+	bool JsonStreamParser::Scalar(nlohmann::ordered_json&& value) {
+		if (_skipDepth > 0) {
+			return true;
+		}
+		if (_captureRoute != nullptr) {
+			AddCaptured(std::move(value));
+			return true;
+		}
+		if (_frames.empty()) {
+			// document is a single scalar
+			return true;
+		}
+
+		bool onTheWay;
+		const Route* route = MatchRoute(onTheWay);
+		if (route == nullptr || !route->Value) {
+			return true;
+		}
+		if (!route->Value(GetCurrentKey(), value)) {
+			return Fail(GetCurrentKey());
+		}
+		return true;
+	}
+
+	bool JsonStreamParser::StartContainer(bool isArray) {
+		if (_skipDepth > 0) {
+			_skipDepth++;
+			return true;
+		}
+
+		nlohmann::ordered_json container = isArray ? nlohmann::ordered_json::array() : nlohmann::ordered_json::object();
+		if (_captureRoute != nullptr) {
+			_captureStack.push_back(AddCaptured(std::move(container)));
+			return true;
+		}
+
+		if (_frames.empty()) {
+			// root is always descended into
+			_frames.push_back({"", isArray, nullptr});
+			return true;
+		}
+
+		bool onTheWay;
+		const Route* route = MatchRoute(onTheWay);
+		std::string key(GetCurrentKey());
+		if (route != nullptr && route->Value) {
+			_captureRoute = route;
+			_captureKey = std::move(key);
+			_captured = std::move(container);
+			_captureStack.push_back(&_captured);
+		} else if (route != nullptr) {
+			if (route->Begin && !route->Begin(key)) {
+				return Fail(key);
+			}
+			_frames.push_back({std::move(key), isArray, route});
+		} else if (onTheWay) {
+			_frames.push_back({std::move(key), isArray, nullptr});
+		} else {
+			_skipDepth = 1;
+		}
+		return true;
+	}
+
+	bool JsonStreamParser::EndContainer() {
+		if (_skipDepth > 0) {
+			_skipDepth--;
+			return true;
+		}
+
+		if (_captureRoute != nullptr) {
+			_captureStack.pop_back();
+			return _captureStack.empty() ? FinishCapture() : true;
+		}
+
+		Frame frame = std::move(_frames.back());
+		_frames.pop_back();
+		if (frame.ContainerRoute != nullptr && frame.ContainerRoute->End && !frame.ContainerRoute->End(frame.Key)) {
+			return Fail(frame.Key);
+		}
+		return true;
+	}
+
+	nlohmann::ordered_json* JsonStreamParser::AddCaptured(nlohmann::ordered_json&& value) {
+		// containers of the materialized value are open, so pointers to them stay valid
+		nlohmann::ordered_json& parent = *_captureStack.back();
+		if (parent.is_array()) {
+			parent.push_back(std::move(value));
+			return &parent.back();
+		}
+		nlohmann::ordered_json& member = parent[_captureInnerKey];
+		member = std::move(value);
+		return &member;
+	}
+
+	bool JsonStreamParser::FinishCapture() {
+		const Route* route = _captureRoute;
+		_captureRoute = nullptr;
+
+		bool handled = route->Value(_captureKey, _captured);
+		_captured = nullptr;
+		return handled ? true : Fail(_captureKey);
+	}
+
+	bool JsonStreamParser::Fail(std::string_view what) {
+		std::string path;
+		for (size_t i = 1; i < _frames.size(); ++i) {
+			path += '/';
+			path += _frames[i].Key.empty() ? "*" : _frames[i].Key;
+		}
+		path += '/';
+		path += what.empty() ? "*" : what;
+		_error = "Handler of '" + path + "' failed";
+		return false;
+	}
+
+	bool JsonStreamParser::null() {
+		return Scalar(nullptr);
+	}
+
+	bool JsonStreamParser::boolean(bool value) {
+		return Scalar(value);
+	}
+
+	bool JsonStreamParser::number_integer(number_integer_t value) {
+		return Scalar(value);
+	}
+
+	bool JsonStreamParser::number_unsigned(number_unsigned_t value) {
+		return Scalar(value);
+	}
+
+	bool JsonStreamParser::number_float(number_float_t value, const string_t&) {
+		return Scalar(value);
+	}
+
+	bool JsonStreamParser::string(string_t& value) {
+		return Scalar(std::move(value));
+	}
+
+	bool JsonStreamParser::binary(binary_t& value) {
+		return Scalar(nlohmann::ordered_json::binary(std::move(value)));
+	}
+
+	bool JsonStreamParser::start_object(std::size_t) {
+		return StartContainer(false);
+	}
+
+	bool JsonStreamParser::key(string_t& value) {
+		if (_skipDepth > 0) {
+			return true;
+		}
+		if (_captureRoute != nullptr) {
+			_captureInnerKey = std::move(value);
+		} else {
+			_key = std::move(value);
+		}
+		return true;
+	}
+
+	bool JsonStreamParser::end_object() {
+		return EndContainer();
+	}
+
+	bool JsonStreamParser::start_array(std::size_t) {
+		return StartContainer(true);
+	}
+
+	bool JsonStreamParser::end_array() {
+		return EndContainer();
+	}
+
+	bool JsonStreamParser::parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& exception) {
+		_error = exception.what();
+		return false;
+	}
+}
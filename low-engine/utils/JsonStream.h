@@ -0,0 +1,179 @@
+#pragma once
+
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nlohmann/json.hpp"
+
+namespace LowEngine::Utils {
+	/**
+	 * @brief Streaming JSON parser that hands out parts of a document while it is being parsed.
+	 *
+	 * Built on the SAX interface of nlohmann::json. Only values matched by a route are materialized, one at a time,
+	 * and dropped once their handler returns, so memory use is bounded by the largest matched value instead of
+	 * the size of the document.
+	 *
+	 * Routes are paths from the root, with segments separated by '/', e.g. "/terrain/navBounds". Segments name
+	 * object keys, a '*' segment matches any key or array element, e.g. every Entity of a scene is matched by
+	 * "/entities" followed by a '*' segment. For every value, the first registered route that matches its path
+	 * wins:
+	 * - value routes (OnValue) materialize the value and pass it to their handler,
+	 * - container routes (OnContainer) call their handlers when an object or array starts and ends, and let
+	 *   the parser descend into it.
+	 *
+	 * Containers on the way to a route are descended into, all other values are skipped without being stored.
+	 * Handlers run in document order. Returning false from a handler stops parsing.
+	 */
+	class JsonStreamParser final : public nlohmann::json_sax<nlohmann::ordered_json> {
+	public:
+		/**
+		 * @brief Handler of a value. Key is the object key of the value, empty for array elements.
+		 */
+		using ValueHandler = std::function<bool(std::string_view key, nlohmann::ordered_json& value)>;
+
+		/**
+		 * @brief Handler of a container start or end. Key is the object key of the container, empty for array elements.
+		 */
+		using ContainerHandler = std::function<bool(std::string_view key)>;
+
+		/**
+		 * @brief Materialize values matching the route and pass them to the handler.
+		 * @param route Path of the values.
+		 * @param handler Function called with every matching value.
+		 */
+		void OnValue(std::string_view route, ValueHandler handler);
+
+		/**
+		 * @brief Descend into objects and arrays matching the route, calling handlers on their start and end.
+		 * @param route Path of the containers.
+		 * @param begin Function called when a container starts. Can be empty.
+		 * @param end Function called when a container ends. Can be empty.
+		 */
+		void OnContainer(std::string_view route, ContainerHandler begin, ContainerHandler end);
+
+		/**
+		 * @brief Parse JSON text.
+		 * @param text JSON text.
+		 * @return True if the document is valid and no handler failed.
+		 */
+		bool Parse(std::string_view text);
+
+		/**
+		 * @brief Parse JSON read from a stream.
+		 * @param input Stream to read from.
+		 * @return True if the document is valid and no handler failed.
+		 */
+		bool Parse(std::istream& input);
+
+		/**
+		 * @brief Retrieve description of the error that stopped the last Parse.
+		 * @return Error message. Empty if parsing succeeded.
+		 */
+		[[nodiscard]] const std::string& GetError() const {
+			return _error;
+		}
+
+		bool null() override;
+		bool boolean(bool value) override;
+		bool number_integer(number_integer_t value) override;
+		bool number_unsigned(number_unsigned_t value) override;
+		bool number_float(number_float_t value, const string_t& text) override;
+		bool string(string_t& value) override;
+		bool binary(binary_t& value) override;
+		bool start_object(std::size_t elements) override;
+		bool key(string_t& value) override;
+		bool end_object() override;
+		bool start_array(std::size_t elements) override;
+		bool end_array() override;
+		bool parse_error(std::size_t position, const std::string& lastToken,
+		                 const nlohmann::detail::exception& exception) override;
+
+	protected:
+		struct Route {
+			std::vector<std::string> Segments;
+			ValueHandler Value;
+			ContainerHandler Begin;
+			ContainerHandler End;
+		};
+
+		/**
+		 * @brief Container the parser descended into.
+		 */
+		struct Frame {
+			/** @brief Path segment of the container: its key, or empty for array elements. */
+			std::string Key;
+			bool IsArray = false;
+			/** @brief Container route matching the container, nullptr if it's only on the way to a route. */
+			const Route* ContainerRoute = nullptr;
+		};
+
+		std::vector<Route> _routes;
+
+		/** @brief Containers the parser descended into, root first. Their keys form the current path. */
+		std::vector<Frame> _frames;
+
+		/** @brief Key of the next value, if the innermost container is an object. */
+		std::string _key;
+
+		/** @brief Number of open containers inside a skipped value. */
+		size_t _skipDepth = 0;
+
+		/** @brief Route of the value being materialized, nullptr if no value is. */
+		const Route* _captureRoute = nullptr;
+		std::string _captureKey;
+		nlohmann::ordered_json _captured;
+		/** @brief Open containers of the materialized value, outermost first. */
+		std::vector<nlohmann::ordered_json*> _captureStack;
+		/** @brief Key of the next value inside the materialized value. */
+		std::string _captureInnerKey;
+
+		std::string _error;
+
+		void Reset();
+
+		/**
+		 * @brief Find route for a value that is about to start in the innermost container.
+		 * @param[out] onTheWay Set to true if no route matches, but the value is on the way to one.
+		 * @return Matching route, nullptr if there's none.
+		 */
+		const Route* MatchRoute(bool& onTheWay) const;
+
+		/**
+		 * @brief Handle scalar value.
+		 */
+		bool Scalar(nlohmann::ordered_json&& value);
+
+		/**
+		 * @brief Handle start of object or array.
+		 */
+		bool StartContainer(bool isArray);
+
+		/**
+		 * @brief Handle end of object or array.
+		 */
+		bool EndContainer();
+
+		/**
+		 * @brief Add value to the materialized value.
+		 * @return Pointer to the added value.
+		 */
+		nlohmann::ordered_json* AddCaptured(nlohmann::ordered_json&& value);
+
+		/**
+		 * @brief Pass the materialized value to its handler.
+		 */
+		bool FinishCapture();
+
+		/**
+		 * @brief Key of the value that is about to start in the innermost container.
+		 */
+		[[nodiscard]] std::string_view GetCurrentKey() const {
+			return _frames.empty() || _frames.back().IsArray ? std::string_view() : std::string_view(_key);
+		}
+
+		bool Fail(std::string_view what);
+	};
+}
@@ -0,0 +1,115 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LowEngine::Utils {
+#ifdef _WIN32
+	bool MappedFile::Open(const std::filesystem::path& path) {
+		Close();
+
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+		_file = file;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size)) {
+			Close();
+			return false;
+		}
+
+		_isOpen = true;
+		_size = static_cast<size_t>(size.QuadPart);
+		if (_size == 0) {
+			// empty files can't be mapped
+			return true;
+		}
+
+		_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (_mapping == nullptr) {
+			Close();
+			return false;
+		}
+
+		_data = static_cast<const std::byte*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (_data == nullptr) {
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	void MappedFile::Close() {
+		if (_data != nullptr) {
+			UnmapViewOfFile(_data);
+		}
+		if (_mapping != nullptr) {
+			CloseHandle(_mapping);
+		}
+		if (_file != nullptr) {
+			CloseHandle(_file);
+		}
+		_data = nullptr;
+		_mapping = nullptr;
+		_file = nullptr;
+		_size = 0;
+		_isOpen = false;
+	}
+#else
+	bool MappedFile::Open(const std::filesystem::path& path) {
+		Close();
+
+		_descriptor = open(path.c_str(), O_RDONLY);
+		if (_descriptor < 0) {
+			return false;
+		}
+
+		struct stat status{};
+		if (fstat(_descriptor, &status) != 0) {
+			Close();
+			return false;
+		}
+
+		_isOpen = true;
+		_size = static_cast<size_t>(status.st_size);
+		if (_size == 0) {
+			// empty files can't be mapped
+			return true;
+		}
+
+		void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _descriptor, 0);
+		if (data == MAP_FAILED) {
+			Close();
+			return false;
+		}
+		// files are decoded front to back
+		madvise(data, _size, MADV_SEQUENTIAL);
+		_data = static_cast<const std::byte*>(data);
+		return true;
+	}
+
+	void MappedFile::Close() {
+		if (_data != nullptr) {
+			munmap(const_cast<std::byte*>(_data), _size);
+		}
+		if (_descriptor >= 0) {
+			close(_descriptor);
+		}
+		_data = nullptr;
+		_descriptor = -1;
+		_size = 0;
+		_isOpen = false;
+	}
+#endif
+}
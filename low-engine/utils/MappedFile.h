@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace LowEngine::Utils {
+	/**
+	 * @brief Read-only view of a whole file, mapped into memory.
+	 *
+	 * Pages are loaded by the OS when they are first touched, so nothing is copied into a buffer up front.
+	 */
+	class MappedFile {
+	public:
+		MappedFile() = default;
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		~MappedFile() {
+			Close();
+		}
+
+		/**
+		 * @brief Map file into memory. Previously mapped file is closed first.
+		 * @param path Path to the file.
+		 * @return True if file was mapped.
+		 */
+		bool Open(const std::filesystem::path& path);
+
+		/**
+		 * @brief Unmap the file. Data retrieved before is no longer valid.
+		 */
+		void Close();
+
+		/**
+		 * @brief Check if a file is mapped.
+		 * @return True if a file is mapped.
+		 */
+		[[nodiscard]] bool IsOpen() const {
+			return _isOpen;
+		}
+
+		/**
+		 * @brief Retrieve content of the file.
+		 * @return Span over the whole file. Empty if no file is mapped or file is empty.
+		 */
+		[[nodiscard]] std::span<const std::byte> GetData() const {
+			return {_data, _size};
+		}
+
+	protected:
+		bool _isOpen = false;
+		const std::byte* _data = nullptr;
+		size_t _size = 0;
+
+#ifdef _WIN32
+		void* _file = nullptr;
+		void* _mapping = nullptr;
+#else
+		int _descriptor = -1;
+#endif
+	};
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace LowEngine::Utils {
+	/**
+	 * @brief Append unsigned value as a variable-length integer: 7 bits per byte, high bit set on all but the last.
+	 * @param value Value to append.
+	 * @param out Buffer to append to.
+	 */
+	inline void WriteVarUInt(uint32_t value, std::vector<std::byte>& out) {
+		while (value >= 0x80) {
+			out.push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+		out.push_back(static_cast<std::byte>(value));
+	}
+
+	/**
+	 * @brief Read variable-length integer written by WriteVarUInt.
+	 * @param in Bytes to read from. Read bytes are removed from the front.
+	 * @param[out] value Read value.
+	 * @return True if successful. False if the input ends early or the value doesn't fit 32 bits.
+	 */
+	inline bool ReadVarUInt(std::span<const std::byte>& in, uint32_t& value) {
+		value = 0;
+		for (uint32_t shift = 0; shift < 35 && !in.empty(); shift += 7) {
+			const auto byte = std::to_integer<uint32_t>(in.front());
+			in = in.subspan(1);
+			value |= (byte & 0x7F) << shift;
+			if ((byte & 0x80) == 0) {
+				return shift < 28 || byte < 0x10;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Run-length encode values as pairs of variable-length integers: length of the run, then its value.
+	 * @param values Values to encode.
+	 * @param out Buffer to append encoded runs to.
+	 */
+	inline void EncodeRunLength(std::span<const uint32_t> values, std::vector<std::byte>& out) {
+		for (size_t i = 0; i < values.size();) {
+			size_t end = i + 1;
+			while (end < values.size() && values[end] == values[i]) {
+				++end;
+			}
+			WriteVarUInt(static_cast<uint32_t>(end - i), out);
+			WriteVarUInt(values[i], out);
+			i = end;
+		}
+	}
+
+	/**
+	 * @brief Decode runs written by EncodeRunLength.
+	 * @param in Encoded runs.
+	 * @param[out] values Decoded values. Runs must fill it exactly.
+	 * @return True if successful. False if the input is malformed or doesn't decode to values.size() values.
+	 */
+	inline bool DecodeRunLength(std::span<const std::byte> in, std::span<uint32_t> values) {
+		size_t count = 0;
+		while (!in.empty()) {
+			uint32_t length, value;
+			if (!ReadVarUInt(in, length) || !ReadVarUInt(in, value) || length == 0
+			    || length > values.size() - count) {
+				return false;
+			}
+			std::fill_n(values.begin() + static_cast<std::ptrdiff_t>(count), length, value);
+			count += length;
+		}
+		return count == values.size();
+	}
+}
@@ -0,0 +1,349 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <spdlog/sinks/null_sink.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log/Log.h"
+#include "memory/ComponentPool.h"
+#include "memory/Memory.h"
+#include "ecs/Entity.h"
+#include "ecs/IComponent.h"
+#include "ecs/Components/TransformComponent.h"
+#include "memory/SnapshotRing.h"
+#include "scene/SceneFile.h"
+#include "utils/JsonStream.h"
+#include "threading/WorkerPool.h"
+
+// Benchmarks are hidden from the default run. Execute them explicitly with:
+//   LOWEngineTests "[benchmark]"
+//
+// Reference numbers (10'000 components, g++ 12 -O2, x86-64 Linux, mean per run):
+//
+//                                  | unordered_map index | paged sparse set | + chunked storage
+//   -------------------------------+---------------------+------------------+------------------
+//   CreateComponent x10k           |             1.00 ms |          0.16 ms |           0.18 ms
+//   GetComponentPtr x10k (random)  |              130 us |            33 us |             50 us
+//   DestroyComponent x10k (random) |             1.18 ms |          0.14 ms |           0.18 ms
+//
+// "Memory - spawn benchmark" spawns 10'000 Entities with one Component each, one by one through CreateEntity and
+// CreateComponent, and in bulk through CreateEntities and CreateComponents. Bulk creation interns the name once,
+// grows every lookup once, fills new Entity slots directly and takes Component storage from reserved chunks.
+// The baseline row is the same one-by-one loop built from the engine before generational Ids and the arena, where
+// every Entity and Component was a separate heap allocation; it isn't part of this file, build that revision to
+// reproduce it. Cold runs start from a fresh Memory, warm runs from one that created and destroyed the same
+// Entities before. Reference numbers (g++ 12 -O2, single core VM, range of medians over 5 x 200 runs):
+//
+//                                           |        cold |        warm
+//   ----------------------------------------+-------------+------------
+//   Baseline CreateEntity + CreateComponent |  3.4-5.6 ms |  2.6-4.0 ms
+//   CreateEntity + CreateComponent          |  1.9-2.3 ms |  0.7-1.4 ms
+//   CreateEntities + CreateComponents       |  1.1-1.5 ms |  0.5-0.8 ms
+//
+// Bulk creation is 3x to 5x faster than the baseline, short of the 10x that was aimed for, at 100'000 Entities as
+// well. Every Entity with its Component writes about 150 bytes: slot, record, signature, name and change lists,
+// Component with its pointer, Id and index entry. Cold runs fault in about 360 fresh pages, which alone costs
+// 0.55 ms on the VM above, more than a tenth of the baseline. Warm runs still pay 0.13 ms just for the writes.
+//
+// "ComponentPool - parallel update benchmark" updates 50'000 components with a ParallelSafeUpdate component
+// on worker pools of growing size. 1 thread is the calling thread only; N threads is the calling thread plus
+// N-1 workers. Thread counts double up to std::thread::hardware_concurrency(), so run it on a machine with at least
+// as many idle cores as the counts you want to see:
+//   LOWEngineTests "ComponentPool - parallel update benchmark" --benchmark-samples 100
+// Speedup at N threads is the mean at 1 thread divided by the mean at N threads; ideal is N. Only the 1 thread
+// number is recorded (g++ 12 -O2, single core VM): 7.0 ms. No scaling numbers are recorded, because no machine
+// with more than one core has been available to measure them.
+//
+// "SnapshotRing - benchmark" captures and restores Transforms of 1'000, 10'000 and 100'000 Entities. Every
+// captured tick moves 1% of them, the rest stays still, so most ticks are stored as small deltas. Restore
+// decodes the newest tick, which is 7 deltas away from its full snapshot. Reference numbers (g++ 12 -O2):
+//
+//              |   1'000 |  10'000 |  100'000
+//   -----------+---------+---------+---------
+//   Capture    |   15 us |  109 us |  1.44 ms
+//   Restore    |   12 us |  124 us |  1.40 ms
+//
+// "Scene file - load benchmark" loads Entities with a Transform and a BenchComponent each, from JSON text and from
+// a binary scene file held in memory. Transforms are decoded from fixed-size records, BenchComponents have no
+// binary state and go through MessagePack. JSON is loaded both as a whole document and streamed, one Entity or
+// Component at a time. Streaming costs about the same time, but peak memory no longer grows with the document:
+// loading 200'000 Entities from a 48 MB file peaks at 85 MB instead of 310 MB. Reference numbers (g++ 12 -O2):
+//
+//                     |  10'000 |  100'000
+//   ------------------+---------+---------
+//   JSON load         |  106 ms |  1.13 s
+//   JSON stream load  |  114 ms |  1.14 s
+//   Binary load       |   25 ms |   251 ms
+//   JSON size         |  3.4 MB |   34 MB
+//   Binary size       |  1.5 MB |   15 MB
+
+namespace {
+    struct LogGuard {
+        LogGuard() {
+            if (!LowEngine::_log) {
+                LowEngine::_log = std::make_shared<spdlog::logger>(
+                    "test", std::make_shared<spdlog::sinks::null_sink_mt>());
+            }
+        }
+    };
+    static LogGuard logGuard;
+
+    struct BenchComponent : LowEngine::ECS::IComponent<BenchComponent> {
+        int Value = 0;
+
+        explicit BenchComponent(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        BenchComponent(LowEngine::Memory::Memory* memory, BenchComponent const* other)
+            : IComponent(memory, other), Value(other->Value) {}
+
+        void Initialize() override {}
+    };
+
+    using BenchPool = LowEngine::Memory::ComponentPool<BenchComponent>;
+
+    // Roughly the cost of an animated sprite update: a bit of math over own data.
+    struct ParallelBenchComponent : LowEngine::ECS::IComponent<ParallelBenchComponent> {
+        static constexpr bool WorkerThreadSafe = true;
+        static constexpr bool ParallelSafeUpdate = true;
+
+        float Angle = 0.0f;
+        float X = 0.0f;
+        float Y = 0.0f;
+
+        explicit ParallelBenchComponent(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        ParallelBenchComponent(LowEngine::Memory::Memory* memory, ParallelBenchComponent const* other)
+            : IComponent(memory, other), Angle(other->Angle), X(other->X), Y(other->Y) {}
+
+        void Initialize() override {}
+
+        void Update(float deltaTime) override {
+            for (int i = 0; i < 16; ++i) {
+                Angle += deltaTime;
+                X += std::cos(Angle) * deltaTime;
+                Y += std::sin(Angle) * deltaTime;
+            }
+        }
+    };
+
+    using ParallelBenchPool = LowEngine::Memory::ComponentPool<ParallelBenchComponent>;
+
+    constexpr size_t PARALLEL_BENCH_COMPONENT_COUNT = 50'000;
+
+    constexpr size_t BENCH_COMPONENT_COUNT = 10'000;
+
+    std::vector<size_t> ShuffledEntityIds(size_t count) {
+        std::vector<size_t> ids(count);
+        std::iota(ids.begin(), ids.end(), 0);
+        std::shuffle(ids.begin(), ids.end(), std::mt19937(1234));
+        return ids;
+    }
+
+    std::unique_ptr<BenchPool> MakeFilledPool(size_t count) {
+        auto pool = std::make_unique<BenchPool>();
+        for (size_t i = 0; i < count; ++i) {
+            pool->CreateComponent(nullptr, i);
+        }
+        return pool;
+    }
+}
+
+TEST_CASE("ComponentPool - benchmark", "[.][benchmark][pool]") {
+    const auto shuffled = ShuffledEntityIds(BENCH_COMPONENT_COUNT);
+
+    BENCHMARK_ADVANCED("CreateComponent x10k")(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<BenchPool>> pools(meter.runs());
+        for (auto& pool : pools) pool = std::make_unique<BenchPool>();
+
+        meter.measure([&](int run) {
+            for (size_t i = 0; i < BENCH_COMPONENT_COUNT; ++i) {
+                pools[run]->CreateComponent(nullptr, i);
+            }
+            return pools[run].get();
+        });
+    };
+
+    BENCHMARK_ADVANCED("GetComponentPtr x10k (random)")(Catch::Benchmark::Chronometer meter) {
+        auto pool = MakeFilledPool(BENCH_COMPONENT_COUNT);
+
+        meter.measure([&] {
+            size_t sum = 0;
+            for (size_t entityId : shuffled) {
+                sum += reinterpret_cast<BenchComponent*>(pool->GetComponentPtr(entityId))->EntityId;
+            }
+            return sum;
+        });
+    };
+
+    BENCHMARK_ADVANCED("DestroyComponent x10k (random)")(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<BenchPool>> pools(meter.runs());
+        for (auto& pool : pools) pool = MakeFilledPool(BENCH_COMPONENT_COUNT);
+
+        meter.measure([&](int run) {
+            for (size_t entityId : shuffled) {
+                pools[run]->DestroyComponent(entityId);
+            }
+            return pools[run].get();
+        });
+    };
+}
+
+TEST_CASE("ComponentPool - parallel update benchmark", "[.][benchmark][pool][parallel]") {
+    ParallelBenchPool pool;
+    for (size_t i = 0; i < PARALLEL_BENCH_COMPONENT_COUNT; ++i) {
+        pool.CreateComponent(nullptr, i);
+    }
+
+    const size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        LowEngine::Threading::WorkerPool workers(threads - 1);
+        pool.SetWorkerPool(&workers);
+
+        BENCHMARK("Update x50k, " + std::to_string(threads) + " thread(s)") {
+            pool.Update(0.016f);
+            return &pool;
+        };
+
+        pool.SetWorkerPool(nullptr);
+    }
+}
+
+TEST_CASE("Memory - spawn benchmark", "[.][benchmark][memory]") {
+    BENCHMARK_ADVANCED("CreateEntity + CreateComponent x10k")(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<LowEngine::Memory::Memory>> memories(meter.runs());
+        for (auto& memory : memories) memory = std::make_unique<LowEngine::Memory::Memory>();
+
+        meter.measure([&](int run) {
+            auto& memory = *memories[run];
+            for (size_t i = 0; i < BENCH_COMPONENT_COUNT; ++i) {
+                auto* entity = memory.CreateEntity<LowEngine::ECS::Entity>("Entity");
+                memory.CreateComponent<BenchComponent>(entity->Id);
+            }
+            return &memory;
+        });
+    };
+
+    BENCHMARK_ADVANCED("CreateEntities + CreateComponents x10k")(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::unique_ptr<LowEngine::Memory::Memory>> memories(meter.runs());
+        for (auto& memory : memories) memory = std::make_unique<LowEngine::Memory::Memory>();
+
+        meter.measure([&](int run) {
+            auto& memory = *memories[run];
+            auto entityIds = memory.CreateEntities(BENCH_COMPONENT_COUNT);
+            memory.CreateComponents<BenchComponent>(entityIds);
+            return &memory;
+        });
+    };
+}
+
+TEST_CASE("SnapshotRing - benchmark", "[.][benchmark][memory][snapshot]") {
+    using LowEngine::ECS::TransformComponent;
+
+    for (size_t count : {1'000, 10'000, 100'000}) {
+        LowEngine::Memory::Memory memory;
+        auto entityIds = memory.CreateEntities(count);
+        memory.CreateComponents<TransformComponent>(entityIds);
+        LowEngine::Memory::SnapshotRing ring(memory, {LowEngine::Memory::GetComponentTypeId<TransformComponent>()});
+
+        uint64_t tick = 0;
+        auto simulateTick = [&] {
+            tick++;
+            for (size_t i = tick % 100; i < count; i += 100) {
+                memory.GetComponent<TransformComponent>(entityIds[i])->Move({1.0f, 0.0f});
+            }
+        };
+
+        BENCHMARK("Capture x" + std::to_string(count)) {
+            simulateTick();
+            return ring.Capture(tick);
+        };
+
+        // newest tick ends up 7 deltas after its full snapshot
+        while (tick % LowEngine::Config::SNAPSHOT_KEYFRAME_INTERVAL != 0) {
+            simulateTick();
+            ring.Capture(tick);
+        }
+
+        BENCHMARK("Restore x" + std::to_string(count)) {
+            return ring.Restore(tick);
+        };
+    }
+}
+
+TEST_CASE("Scene file - load benchmark", "[.][benchmark][memory][binary]") {
+    using LowEngine::ECS::TransformComponent;
+    using LowEngine::SceneFileFormat;
+
+    for (size_t count : {10'000, 100'000}) {
+        LowEngine::Memory::Memory original;
+        auto entityIds = original.CreateEntities(count, "Entity");
+        original.CreateComponents<TransformComponent>(entityIds);
+        original.CreateComponents<BenchComponent>(entityIds);
+
+        std::string json = nlohmann::ordered_json{
+            {"entities", original.SerializeAllEntitiesToJSON()},
+            {"components", original.SerializeAllComponentsToJSON()}
+        }.dump();
+
+        std::vector<std::byte> binary;
+        LowEngine::SceneFileWriter writer(binary);
+        original.SerializeAllEntitiesToBinary(writer.BeginBlock(SceneFileFormat::BlockType::Entities));
+        writer.EndBlock();
+        for (LowEngine::Memory::ComponentTypeId typeId : original.GetSerializationOrder()) {
+            original.SerializeComponentsToBinary(typeId, writer.BeginBlock(SceneFileFormat::BlockType::Components));
+            writer.EndBlock();
+        }
+        writer.Finish();
+
+        BENCHMARK("JSON load x" + std::to_string(count)) {
+            LowEngine::Memory::Memory loaded;
+            loaded.RegisterComponentType<TransformComponent>();
+            loaded.RegisterComponentType<BenchComponent>();
+            auto sceneJson = nlohmann::ordered_json::parse(json);
+            loaded.DeserializeAllEntitiesFromJSON<LowEngine::ECS::Entity>(sceneJson["entities"]);
+            loaded.DeserializeAllComponentsFromJSON(sceneJson["components"]);
+            return loaded.GetEntityCount();
+        };
+
+        BENCHMARK("JSON stream load x" + std::to_string(count)) {
+            LowEngine::Memory::Memory loaded;
+            loaded.RegisterComponentType<TransformComponent>();
+            loaded.RegisterComponentType<BenchComponent>();
+            LowEngine::Utils::JsonStreamParser parser;
+            parser.OnValue("/entities/*", [&loaded](std::string_view, nlohmann::ordered_json& entityJson) {
+                return loaded.DeserializeEntityFromJSON<LowEngine::ECS::Entity>(entityJson);
+            });
+            parser.OnValue("/components/*/*", [&loaded](std::string_view, nlohmann::ordered_json& componentJson) {
+                return loaded.DeserializeComponentFromJSON(componentJson);
+            });
+            parser.Parse(json);
+            return loaded.GetEntityCount();
+        };
+
+        BENCHMARK("Binary load x" + std::to_string(count)) {
+            LowEngine::Memory::Memory loaded;
+            loaded.RegisterComponentType<TransformComponent>();
+            loaded.RegisterComponentType<BenchComponent>();
+            LowEngine::SceneFileReader reader;
+            reader.Open(binary);
+            for (const auto& block : reader.GetBlocks()) {
+                LowEngine::Utils::BinaryReader in(block.Data);
+                if (block.Type == SceneFileFormat::BlockType::Entities) {
+                    loaded.DeserializeAllEntitiesFromBinary(in);
+                } else {
+                    loaded.DeserializeComponentsFromBinary(in);
+                }
+            }
+            return loaded.GetEntityCount();
+        };
+    }
+}
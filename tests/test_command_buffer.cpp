@@ -0,0 +1,265 @@
+#include <catch2/catch_test_macros.hpp>
+#include <spdlog/sinks/null_sink.h>
+
+#include <vector>
+
+#include "log/Log.h"
+#include "memory/Memory.h"
+#include "ecs/Entity.h"
+#include "ecs/IComponent.h"
+
+namespace {
+    struct LogGuard {
+        LogGuard() {
+            if (!LowEngine::_log) {
+                LowEngine::_log = std::make_shared<spdlog::logger>(
+                    "test", std::make_shared<spdlog::sinks::null_sink_mt>());
+            }
+        }
+    };
+    static LogGuard logGuard;
+
+    template <typename T>
+    size_t CountComponents(LowEngine::Memory::Memory& memory) {
+        size_t count = 0;
+        memory.ForEachComponent<T>([&count](T&) { count++; });
+        return count;
+    }
+}
+
+// ─── Test components ──────────────────────────────────────────────────────────
+
+namespace {
+    struct PayloadComp : LowEngine::ECS::IComponent<PayloadComp> {
+        int Value = 0;
+
+        explicit PayloadComp(LowEngine::Memory::Memory* memory, int value = 0)
+            : IComponent(memory), Value(value) {}
+
+        PayloadComp(LowEngine::Memory::Memory* memory, PayloadComp const* other)
+            : IComponent(memory, other), Value(other->Value) {}
+
+        void Initialize() override {}
+    };
+
+    // Destroys its own Entity during update and spawns a replacement through the command buffer.
+    struct ShortLivedComp : LowEngine::ECS::IComponent<ShortLivedComp> {
+        static constexpr bool WorkerThreadSafe = true;
+        static constexpr bool ParallelSafeUpdate = true;
+
+        int Lifetime = 0;
+
+        explicit ShortLivedComp(LowEngine::Memory::Memory* memory, int lifetime = 1)
+            : IComponent(memory), Lifetime(lifetime) {}
+
+        ShortLivedComp(LowEngine::Memory::Memory* memory, ShortLivedComp const* other)
+            : IComponent(memory, other), Lifetime(other->Lifetime) {}
+
+        void Initialize() override {}
+
+        void Update(float) override {
+            if (--Lifetime > 0) return;
+
+            auto& commands = _memory->GetCommandBuffer();
+            int nextLifetime = static_cast<int>(EntityId % 3) + 1;
+            commands.CreateEntity("spawned", [nextLifetime](LowEngine::Memory::Memory& memory, LowEngine::ECS::Entity& entity) {
+                memory.CreateComponent<ShortLivedComp>(entity.Id, nextLifetime);
+                memory.CreateComponent<PayloadComp>(entity.Id, nextLifetime);
+            });
+            _memory->DestroyEntity(_memory->GetEntity<LowEngine::ECS::Entity>(EntityId));
+        }
+    };
+
+    // Tries to create Entities and Components directly during update.
+    struct SpawnerComp : LowEngine::ECS::IComponent<SpawnerComp> {
+        bool Refused = false;
+
+        explicit SpawnerComp(LowEngine::Memory::Memory* memory) : IComponent(memory) {}
+        SpawnerComp(LowEngine::Memory::Memory* memory, SpawnerComp const* other) : IComponent(memory, other) {}
+
+        void Initialize() override {}
+
+        void Update(float) override {
+            Refused = _memory->CreateEntity<LowEngine::ECS::Entity>("direct") == nullptr
+                      && _memory->CreateComponent<PayloadComp>(EntityId) == nullptr;
+        }
+    };
+
+    // Deactivates itself after a number of updates.
+    struct SleeperComp : LowEngine::ECS::IComponent<SleeperComp> {
+        int Updates = 0;
+        bool ActiveDuringUpdate = false;
+
+        explicit SleeperComp(LowEngine::Memory::Memory* memory) : IComponent(memory) {}
+        SleeperComp(LowEngine::Memory::Memory* memory, SleeperComp const* other)
+            : IComponent(memory, other), Updates(other->Updates) {}
+
+        void Initialize() override {}
+
+        void Update(float) override {
+            if (++Updates < 2) return;
+
+            _memory->SetComponentActive<SleeperComp>(EntityId, false);
+            ActiveDuringUpdate = IsActive();
+        }
+    };
+}
+
+// ─── Playback ─────────────────────────────────────────────────────────────────
+
+TEST_CASE("CommandBuffer - playback applies commands in order", "[memory][commands]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    size_t id = e->Id;
+
+    auto& commands = mem.GetCommandBuffer();
+    commands.AddComponent<PayloadComp>(id, 42);
+    commands.CreateEntity("spawned", [](LowEngine::Memory::Memory& memory, LowEngine::ECS::Entity& entity) {
+        memory.CreateComponent<PayloadComp>(entity.Id, 7);
+    });
+    REQUIRE(commands.GetSize() == 2);
+    REQUIRE(mem.GetComponent<PayloadComp>(id) == nullptr);
+
+    mem.PlaybackCommands();
+    REQUIRE(commands.IsEmpty());
+    REQUIRE(mem.GetComponent<PayloadComp>(id)->Value == 42);
+    REQUIRE(mem.GetEntityCount() == 2);
+    REQUIRE(mem.FindEntity<LowEngine::ECS::Entity>("spawned") != nullptr);
+
+    commands.DestroyComponent<PayloadComp>(id);
+    commands.DestroyEntity(id);
+    commands.DestroyEntity(id); // second destroy of the same Entity is a no-op
+    mem.PlaybackCommands();
+    REQUIRE_FALSE(mem.IsEntityValid(id));
+    REQUIRE(mem.GetEntityCount() == 1);
+}
+
+TEST_CASE("CommandBuffer - clear drops recorded commands", "[memory][commands]") {
+    LowEngine::Memory::Memory mem;
+    auto& commands = mem.GetCommandBuffer();
+    commands.CreateEntity("never");
+    commands.Clear();
+    mem.PlaybackCommands();
+    REQUIRE(mem.GetEntityCount() == 0);
+}
+
+TEST_CASE("CommandBuffer - playback of many spawns", "[memory][commands]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    mem.CreateComponent<PayloadComp>(e->Id);
+
+    auto& commands = mem.GetCommandBuffer();
+    for (int i = 0; i < 1000; ++i) {
+        commands.CreateEntity("e", [i](LowEngine::Memory::Memory& memory, LowEngine::ECS::Entity& entity) {
+            memory.CreateComponent<PayloadComp>(entity.Id, i);
+        });
+    }
+    mem.PlaybackCommands();
+
+    REQUIRE(mem.GetEntityCount() == 1001);
+    REQUIRE(CountComponents<PayloadComp>(mem) == 1001);
+}
+
+// ─── Deferred changes during update ───────────────────────────────────────────
+
+TEST_CASE("CommandBuffer - destroy during update is deferred to the end of update", "[memory][commands]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids;
+    for (int i = 0; i < 10; ++i) {
+        auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+        mem.CreateComponent<ShortLivedComp>(e->Id, 1);
+        ids.push_back(e->Id);
+    }
+
+    mem.UpdateAllComponents(0.016f);
+
+    REQUIRE_FALSE(mem.IsUpdating());
+    for (size_t id : ids) {
+        REQUIRE_FALSE(mem.IsEntityValid(id));
+    }
+    REQUIRE(mem.GetEntityCount() == 10);
+    REQUIRE(CountComponents<ShortLivedComp>(mem) == 10);
+    REQUIRE(CountComponents<PayloadComp>(mem) == 10);
+}
+
+TEST_CASE("CommandBuffer - direct creation during update is refused", "[memory][commands]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    auto* spawner = mem.CreateComponent<SpawnerComp>(e->Id);
+
+    mem.UpdateAllComponents(0.016f);
+    REQUIRE(spawner->Refused);
+    REQUIRE(mem.GetEntityCount() == 1);
+}
+
+TEST_CASE("CommandBuffer - deactivation during update is deferred to the end of update", "[memory][commands]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    auto* sleeper = mem.CreateComponent<SleeperComp>(e->Id);
+
+    mem.UpdateAllComponents(0.016f);
+    mem.UpdateAllComponents(0.016f);
+    REQUIRE(sleeper->ActiveDuringUpdate);
+    REQUIRE_FALSE(sleeper->IsActive());
+
+    mem.UpdateAllComponents(0.016f);
+    REQUIRE(sleeper->Updates == 2);
+
+    mem.SetComponentActive<SleeperComp>(e->Id, true);
+    mem.UpdateAllComponents(0.016f);
+    REQUIRE(sleeper->Updates == 3);
+}
+
+TEST_CASE("CommandBuffer - churn from worker threads", "[memory][commands]") {
+    LowEngine::Threading::WorkerPool workers(3);
+    LowEngine::Memory::Memory mem;
+    mem.SetWorkerPool(&workers);
+
+    constexpr size_t population = 2000;
+    for (size_t i = 0; i < population; ++i) {
+        auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+        mem.CreateComponent<ShortLivedComp>(e->Id, static_cast<int>(i % 4) + 1);
+        mem.CreateComponent<PayloadComp>(e->Id);
+    }
+
+    for (int frame = 0; frame < 50; ++frame) {
+        mem.UpdateAllComponents(0.016f);
+
+        REQUIRE(mem.GetEntityCount() == population);
+        REQUIRE(CountComponents<ShortLivedComp>(mem) == population);
+        REQUIRE(CountComponents<PayloadComp>(mem) == population);
+    }
+
+    size_t valid = 0;
+    mem.ForEachComponent<ShortLivedComp>([&mem, &valid](ShortLivedComp& component) {
+        if (mem.IsEntityValid(component.EntityId) && mem.GetComponent<PayloadComp>(component.EntityId) != nullptr) {
+            valid++;
+        }
+    });
+    REQUIRE(valid == population);
+}
+
+TEST_CASE("CommandBuffer - spawn and despawn during update are deferred", "[memory][commands]") {
+    LowEngine::Memory::Memory mem;
+    mem.SetEntityPoolCapacity("Spark", 1);
+
+    auto& buffer = mem.GetCommandBuffer();
+    buffer.SpawnEntity("Spark", "spark", [](LowEngine::Memory::Memory& memory, LowEngine::ECS::Entity& entity) {
+        memory.CreateComponent<PayloadComp>(entity.Id, 3);
+    });
+    mem.PlaybackCommands();
+
+    auto* spark = mem.FindEntity<LowEngine::ECS::Entity>("spark");
+    REQUIRE(spark != nullptr);
+    size_t sparkId = spark->Id;
+
+    buffer.DespawnEntity(sparkId);
+    buffer.DespawnEntity(sparkId);
+    mem.PlaybackCommands();
+    REQUIRE(mem.IsEntityParked(sparkId));
+
+    buffer.SpawnEntity("Spark", "spark", nullptr);
+    mem.PlaybackCommands();
+    REQUIRE_FALSE(mem.IsEntityParked(sparkId));
+    REQUIRE(mem.GetComponent<PayloadComp>(sparkId)->IsActive());
+}
@@ -1,9 +1,15 @@
 #include <catch2/catch_test_macros.hpp>
 #include <spdlog/sinks/null_sink.h>
 
+#include <thread>
+#include <vector>
+
 #include "log/Log.h"
+#include "memory/ArenaResource.h"
 #include "memory/ComponentPool.h"
+#include "memory/Memory.h"
 #include "ecs/IComponent.h"
+#include "threading/WorkerPool.h"
 
 // ComponentPool uses _log for error/debug output. Initialize it once to a null
 // sink so tests don't crash and produce no noise.
@@ -56,6 +62,48 @@ namespace {
     };
 }
 
+namespace {
+    struct ParallelComponent : LowEngine::ECS::IComponent<ParallelComponent> {
+        static constexpr bool WorkerThreadSafe = true;
+        static constexpr bool ParallelSafeUpdate = true;
+
+        int Updates = 0;
+        std::thread::id UpdatedBy;
+
+        explicit ParallelComponent(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        ParallelComponent(LowEngine::Memory::Memory* memory, ParallelComponent const* other)
+            : IComponent(memory, other), Updates(other->Updates) {}
+
+        void Initialize() override {}
+
+        void Update(float) override {
+            Updates++;
+            UpdatedBy = std::this_thread::get_id();
+        }
+        void FixedUpdate(float) override { Updates += 10; }
+    };
+}
+
+namespace {
+    struct PlainComponent : LowEngine::ECS::IComponent<PlainComponent> {
+        int Value = 0;
+
+        explicit PlainComponent(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        PlainComponent(LowEngine::Memory::Memory* memory, PlainComponent const* other)
+            : IComponent(memory, other), Value(other->Value) {}
+
+        void Initialize() override {}
+
+        void Update(float) override { Value++; }
+
+        [[nodiscard]] LowEngine::Memory::Memory* GetMemory() const { return _memory; }
+    };
+}
+
 using Pool      = LowEngine::Memory::ComponentPool<TestComponent>;
 using OtherPool = LowEngine::Memory::ComponentPool<OtherComponent>;
 
@@ -153,11 +201,10 @@ TEST_CASE("ComponentPool - ForEachComponent on empty pool does not crash", "[poo
 TEST_CASE("ComponentPool - Update only calls active components", "[pool]") {
     Pool pool;
 
-    TestComponent* active   = pool.CreateComponent(nullptr, 0);
-    TestComponent* inactive = pool.CreateComponent(nullptr, 1);
+    pool.CreateComponent(nullptr, 0);
+    pool.CreateComponent(nullptr, 1);
 
-    active->Active   = true;
-    inactive->Active = false;
+    pool.SetActive(1, false);
 
     pool.Update(0.016f);
 
@@ -168,11 +215,10 @@ TEST_CASE("ComponentPool - Update only calls active components", "[pool]") {
 TEST_CASE("ComponentPool - FixedUpdate only calls active components", "[pool]") {
     Pool pool;
 
-    TestComponent* active   = pool.CreateComponent(nullptr, 0);
-    TestComponent* inactive = pool.CreateComponent(nullptr, 1);
+    pool.CreateComponent(nullptr, 0);
+    pool.CreateComponent(nullptr, 1);
 
-    active->Active   = true;
-    inactive->Active = false;
+    pool.SetActive(1, false);
 
     pool.FixedUpdate(0.016f);
 
@@ -180,10 +226,143 @@ TEST_CASE("ComponentPool - FixedUpdate only calls active components", "[pool]")
     REQUIRE(reinterpret_cast<TestComponent*>(pool.GetComponentPtr(1))->Value == 0);
 }
 
+// ─── Active partition ─────────────────────────────────────────────────────────
+
+namespace {
+    // checks that active components come first and every component is reachable through the index
+    void RequirePartitioned(Pool& pool) {
+        const auto& entityIds = pool.GetEntityIds();
+        for (size_t index = 0; index < entityIds.size(); ++index) {
+            auto* component = reinterpret_cast<TestComponent*>(pool.GetComponentPtr(entityIds[index]));
+            REQUIRE(component != nullptr);
+            REQUIRE(component->IsActive() == (index < pool.GetActiveCount()));
+        }
+    }
+}
+
+TEST_CASE("ComponentPool - new components are active", "[pool][active]") {
+    Pool pool;
+    for (size_t i = 0; i < 4; ++i) {
+        REQUIRE(pool.CreateComponent(nullptr, i)->IsActive());
+    }
+
+    REQUIRE(pool.GetActiveCount() == 4);
+}
+
+TEST_CASE("ComponentPool - SetActive keeps active components in front", "[pool][active]") {
+    Pool pool;
+    for (size_t i = 0; i < 10; ++i) {
+        pool.CreateComponent(nullptr, i);
+    }
+
+    REQUIRE(pool.SetActive(2, false));
+    REQUIRE(pool.SetActive(7, false));
+    REQUIRE(pool.SetActive(0, false));
+    REQUIRE(pool.GetActiveCount() == 7);
+    RequirePartitioned(pool);
+
+    REQUIRE(pool.SetActive(7, true));
+    REQUIRE(pool.SetActive(7, true)); // no change
+    REQUIRE(pool.GetActiveCount() == 8);
+    RequirePartitioned(pool);
+
+    REQUIRE_FALSE(pool.SetActive(42, true));
+}
+
+TEST_CASE("ComponentPool - new component is active after inactive ones exist", "[pool][active]") {
+    Pool pool;
+    pool.CreateComponent(nullptr, 0);
+    pool.CreateComponent(nullptr, 1);
+    pool.SetActive(0, false);
+    pool.SetActive(1, false);
+
+    pool.CreateComponent(nullptr, 2);
+
+    REQUIRE(pool.GetActiveCount() == 1);
+    REQUIRE(pool.GetEntityIds()[0] == 2);
+    RequirePartitioned(pool);
+}
+
+TEST_CASE("ComponentPool - destroying keeps partition intact", "[pool][active]") {
+    Pool pool;
+    for (size_t i = 0; i < 20; ++i) {
+        pool.CreateComponent(nullptr, i);
+        if (i % 3 == 0) pool.SetActive(i, false);
+    }
+
+    // remove from both sides of the boundary
+    for (size_t i : {1, 3, 19, 10, 4, 0}) {
+        pool.DestroyComponent(i);
+        RequirePartitioned(pool);
+    }
+
+    REQUIRE(pool.GetSize() == 14);
+    REQUIRE(pool.GetActiveCount() == 9);
+}
+
+TEST_CASE("ComponentPool - Clone keeps active state", "[pool][active]") {
+    Pool pool;
+    for (size_t i = 0; i < 5; ++i) {
+        pool.CreateComponent(nullptr, i);
+    }
+    pool.SetActive(3, false);
+
+    auto clone = pool.Clone(nullptr, std::pmr::get_default_resource());
+    auto* clonedPool = static_cast<Pool*>(clone.get());
+
+    REQUIRE(clonedPool->GetActiveCount() == 4);
+    REQUIRE_FALSE(reinterpret_cast<TestComponent*>(clonedPool->GetComponentPtr(3))->IsActive());
+    RequirePartitioned(*clonedPool);
+}
+
+TEST_CASE("ComponentPool - Clone compacts storage and keeps every component", "[pool]") {
+    LowEngine::Memory::ComponentPool<PlainComponent> pool(16);
+    for (size_t i = 0; i < 100; ++i) {
+        pool.CreateComponent(nullptr, i)->Value = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < 100; i += 3) {
+        pool.DestroyComponent(i);
+    }
+    pool.SetActive(4, false);
+
+    LowEngine::Memory::Memory memory;
+    auto* newMemory = &memory;
+    auto clone = pool.Clone(newMemory, std::pmr::get_default_resource());
+    auto* clonedPool = static_cast<LowEngine::Memory::ComponentPool<PlainComponent>*>(clone.get());
+
+    REQUIRE(clonedPool->GetSize() == pool.GetSize());
+    REQUIRE(clonedPool->GetActiveCount() == pool.GetActiveCount());
+    for (size_t i = 0; i < 100; ++i) {
+        auto* copy = reinterpret_cast<PlainComponent*>(clonedPool->GetComponentPtr(i));
+        if (i % 3 == 0) {
+            REQUIRE(copy == nullptr);
+            continue;
+        }
+        REQUIRE(copy != pool.GetComponentPtr(i));
+        REQUIRE(copy->Value == static_cast<int>(i));
+        REQUIRE(copy->GetMemory() == newMemory);
+        REQUIRE(copy->IsActive() == (i != 4));
+    }
+
+    // storage freed in the original is not copied
+    REQUIRE(clonedPool->GetCapacity() < pool.GetCapacity());
+
+    // copies are independent and the copy keeps growing from where it is
+    clonedPool->Update(0.016f);
+    REQUIRE(reinterpret_cast<PlainComponent*>(pool.GetComponentPtr(1))->Value == 1);
+    REQUIRE(reinterpret_cast<PlainComponent*>(clonedPool->GetComponentPtr(1))->Value == 2);
+    for (size_t i = 0; i < 100; i += 3) {
+        clonedPool->CreateComponent(nullptr, i)->Value = -1;
+    }
+    for (size_t i = 0; i < 100; ++i) {
+        REQUIRE(reinterpret_cast<PlainComponent*>(clonedPool->GetComponentPtr(i))->Value != 0);
+    }
+}
+
 // ─── Capacity growth ──────────────────────────────────────────────────────────
 
 TEST_CASE("ComponentPool - grows beyond initial capacity", "[pool]") {
-    Pool pool(2); // start with capacity 2
+    Pool pool(2); // chunks of 2 components
 
     for (size_t i = 0; i < 5; ++i) {
         TestComponent* comp = pool.CreateComponent(nullptr, i);
@@ -191,7 +370,7 @@ TEST_CASE("ComponentPool - grows beyond initial capacity", "[pool]") {
         comp->Value = static_cast<int>(i);
     }
 
-    // All components must still be reachable after reallocation
+    // All components must still be reachable after allocating more chunks
     for (size_t i = 0; i < 5; ++i) {
         void* ptr = pool.GetComponentPtr(i);
         REQUIRE(ptr != nullptr);
@@ -199,6 +378,97 @@ TEST_CASE("ComponentPool - grows beyond initial capacity", "[pool]") {
     }
 }
 
+TEST_CASE("ComponentPool - growing does not move existing components", "[pool]") {
+    Pool pool(4);
+
+    std::vector<TestComponent*> created;
+    for (size_t i = 0; i < 64; ++i) {
+        created.push_back(pool.CreateComponent(nullptr, i));
+    }
+
+    REQUIRE(pool.GetCapacity() == 64);
+    for (size_t i = 0; i < 64; ++i) {
+        REQUIRE(pool.GetComponentPtr(i) == created[i]);
+    }
+}
+
+TEST_CASE("ComponentPool - destroying does not move remaining components", "[pool]") {
+    Pool pool(4);
+    TestComponent* first = pool.CreateComponent(nullptr, 0);
+    pool.CreateComponent(nullptr, 1);
+    TestComponent* last = pool.CreateComponent(nullptr, 2);
+
+    pool.DestroyComponent(1);
+
+    REQUIRE(pool.GetComponentPtr(0) == first);
+    REQUIRE(pool.GetComponentPtr(2) == last);
+}
+
+TEST_CASE("ComponentPool - storage of destroyed component is reused", "[pool]") {
+    Pool pool(2);
+    pool.CreateComponent(nullptr, 0);
+    TestComponent* destroyed = pool.CreateComponent(nullptr, 1);
+    pool.DestroyComponent(1);
+
+    TestComponent* reused = pool.CreateComponent(nullptr, 2);
+    REQUIRE(reused == destroyed);
+    REQUIRE(pool.GetCapacity() == 2);
+}
+
+TEST_CASE("ComponentPool - reserved storage is used without allocating", "[pool]") {
+    Pool pool(4);
+    pool.CreateComponent(nullptr, 0);
+    pool.Reserve(9);
+    REQUIRE(pool.GetCapacity() == 12);
+
+    TestComponent* first = pool.CreateComponent(nullptr, 1);
+    for (size_t i = 2; i < 10; ++i) {
+        REQUIRE(pool.CreateComponent(nullptr, i) != nullptr);
+    }
+
+    REQUIRE(pool.GetCapacity() == 12);
+    REQUIRE(pool.GetComponentPtr(1) == first);
+    REQUIRE(pool.GetSize() == 10);
+}
+
+TEST_CASE("ComponentPool - reserved chunks are handed out in address order", "[pool]") {
+    Pool pool(4);
+    pool.Reserve(10);
+    REQUIRE(pool.GetCapacity() == 12);
+
+    std::vector<TestComponent*> created;
+    for (size_t i = 0; i < 12; ++i) {
+        created.push_back(pool.CreateComponent(nullptr, i));
+    }
+    REQUIRE(pool.GetCapacity() == 12);
+    // components within a chunk follow each other
+    for (size_t i = 0; i < 12; ++i) {
+        if (i % 4 != 0) {
+            REQUIRE(created[i] == created[i - 1] + 1);
+        }
+    }
+
+    pool.CreateComponent(nullptr, 12);
+    REQUIRE(pool.GetCapacity() == 16);
+}
+
+TEST_CASE("ComponentPool - ShrinkToFit releases reserved chunks that were never used", "[pool][stats]") {
+    Pool pool(4);
+    TestComponent* first = pool.CreateComponent(nullptr, 0);
+    pool.Reserve(20);
+    REQUIRE(pool.GetCapacity() == 24);
+
+    pool.ShrinkToFit();
+    REQUIRE(pool.GetCapacity() == 4);
+    REQUIRE(pool.GetComponentPtr(0) == first);
+
+    // rest of the kept chunk is reused first
+    for (size_t i = 1; i < 4; ++i) {
+        pool.CreateComponent(nullptr, i);
+    }
+    REQUIRE(pool.GetCapacity() == 4);
+}
+
 // ─── Swap-and-pop correctness (middle removal) ────────────────────────────────
 
 TEST_CASE("ComponentPool - destroying middle component preserves all others", "[pool]") {
@@ -237,7 +507,7 @@ TEST_CASE("ComponentPool - Clone copies all components", "[pool]") {
     pool.CreateComponent(nullptr, 0)->Value = 11;
     pool.CreateComponent(nullptr, 1)->Value = 22;
 
-    auto cloned = pool.Clone(nullptr);
+    auto cloned = pool.Clone(nullptr, std::pmr::get_default_resource());
 
     REQUIRE(cloned->GetComponentPtr(0) != nullptr);
     REQUIRE(cloned->GetComponentPtr(1) != nullptr);
@@ -249,7 +519,7 @@ TEST_CASE("ComponentPool - Clone is independent from original", "[pool]") {
     Pool pool;
     pool.CreateComponent(nullptr, 0)->Value = 5;
 
-    auto cloned = pool.Clone(nullptr);
+    auto cloned = pool.Clone(nullptr, std::pmr::get_default_resource());
 
     // mutate original
     reinterpret_cast<TestComponent*>(pool.GetComponentPtr(0))->Value = 99;
@@ -274,7 +544,6 @@ TEST_CASE("ComponentPool - SerializeToJSON includes component values", "[pool]")
     Pool pool;
     TestComponent* comp = pool.CreateComponent(nullptr, 0);
     comp->Value  = 42;
-    comp->Active = true;
 
     auto json = pool.SerializeToJSON();
     REQUIRE(json[0]["Value"]  == 42);
@@ -296,4 +565,277 @@ TEST_CASE("ComponentPool - separate pools with same entity ids are independent",
     poolA.DestroyComponent(0);
     REQUIRE(poolA.GetComponentPtr(0) == nullptr);
     REQUIRE(poolB.GetComponentPtr(0) != nullptr); // poolB unaffected
-}
\ No newline at end of file
+}
+
+// ─── Sparse index ─────────────────────────────────────────────────────────────
+
+TEST_CASE("SparseIndex - Get returns NOT_FOUND for unknown key", "[pool][sparse]") {
+    LowEngine::Memory::SparseIndex index;
+    REQUIRE(index.Get(0) == LowEngine::Memory::SparseIndex::NOT_FOUND);
+    REQUIRE(index.Get(1'000'000) == LowEngine::Memory::SparseIndex::NOT_FOUND);
+    REQUIRE_FALSE(index.Contains(7));
+}
+
+TEST_CASE("SparseIndex - Set and Erase round-trip across pages", "[pool][sparse]") {
+    LowEngine::Memory::SparseIndex index;
+    constexpr size_t pageSize = LowEngine::Memory::SparseIndex::PAGE_SIZE;
+
+    index.Set(pageSize - 1, 1);
+    index.Set(pageSize, 2);
+    index.Set(pageSize * 10 + 3, 3);
+
+    REQUIRE(index.Get(pageSize - 1) == 1);
+    REQUIRE(index.Get(pageSize) == 2);
+    REQUIRE(index.Get(pageSize * 10 + 3) == 3);
+    REQUIRE_FALSE(index.Contains(pageSize * 5)); // page between used pages stays empty
+
+    index.Erase(pageSize);
+    REQUIRE_FALSE(index.Contains(pageSize));
+    REQUIRE(index.Get(pageSize - 1) == 1);
+}
+
+TEST_CASE("SparseIndex - move between resources keeps values", "[pool][sparse]") {
+    LowEngine::Memory::ArenaResource arena;
+    LowEngine::Memory::SparseIndex target;
+    {
+        LowEngine::Memory::SparseIndex source(&arena);
+        source.Set(5, 50);
+        target = std::move(source);
+        REQUIRE_FALSE(source.Contains(5));
+    }
+
+    REQUIRE(target.Get(5) == 50);
+    // pages of a different resource are copied, not taken over
+    REQUIRE(arena.GetStats().LiveAllocations == 0);
+}
+
+TEST_CASE("ComponentPool - handles sparse, large entity ids", "[pool][sparse]") {
+    Pool pool;
+    pool.CreateComponent(nullptr, 3)->Value = 3;
+    pool.CreateComponent(nullptr, 250'000)->Value = 250;
+    pool.CreateComponent(nullptr, 9'000'000)->Value = 9;
+
+    REQUIRE(reinterpret_cast<TestComponent*>(pool.GetComponentPtr(3))->Value == 3);
+    REQUIRE(reinterpret_cast<TestComponent*>(pool.GetComponentPtr(250'000))->Value == 250);
+    REQUIRE(reinterpret_cast<TestComponent*>(pool.GetComponentPtr(9'000'000))->Value == 9);
+    REQUIRE(pool.GetComponentPtr(250'001) == nullptr);
+}
+
+TEST_CASE("ComponentPool - entity id can be reused after destroy", "[pool][sparse]") {
+    Pool pool;
+    pool.CreateComponent(nullptr, 0)->Value = 1;
+    pool.CreateComponent(nullptr, 1)->Value = 2;
+
+    pool.DestroyComponent(0);
+    REQUIRE(pool.CreateComponent(nullptr, 0) != nullptr);
+    reinterpret_cast<TestComponent*>(pool.GetComponentPtr(0))->Value = 3;
+
+    REQUIRE(reinterpret_cast<TestComponent*>(pool.GetComponentPtr(0))->Value == 3);
+    REQUIRE(reinterpret_cast<TestComponent*>(pool.GetComponentPtr(1))->Value == 2);
+}
+
+TEST_CASE("ComponentPool - repeated swap-and-pop keeps index consistent", "[pool][sparse]") {
+    Pool pool;
+    for (size_t i = 0; i < 100; ++i) {
+        pool.CreateComponent(nullptr, i)->Value = static_cast<int>(i);
+    }
+
+    // destroy every even entity, front to back, so each removal swaps a different tail element
+    for (size_t i = 0; i < 100; i += 2) {
+        pool.DestroyComponent(i);
+    }
+
+    for (size_t i = 0; i < 100; ++i) {
+        void* ptr = pool.GetComponentPtr(i);
+        if (i % 2 == 0) {
+            REQUIRE(ptr == nullptr);
+        } else {
+            REQUIRE(ptr != nullptr);
+            REQUIRE(reinterpret_cast<TestComponent*>(ptr)->Value == static_cast<int>(i));
+        }
+    }
+
+    int count = 0;
+    pool.ForEachComponent([&](TestComponent&) { count++; });
+    REQUIRE(count == 50);
+}
+
+// ─── Parallel update ──────────────────────────────────────────────────────────
+
+TEST_CASE("ComponentPool - parallel update visits every active component once", "[pool][parallel]") {
+    LowEngine::Threading::WorkerPool workers(3);
+    LowEngine::Memory::ComponentPool<ParallelComponent> pool;
+    pool.SetWorkerPool(&workers);
+
+    constexpr size_t count = 10'000;
+    std::vector<ParallelComponent*> components;
+    for (size_t i = 0; i < count; ++i) {
+        components.push_back(pool.CreateComponent(nullptr, i));
+        pool.SetActive(i, (i % 7) != 0);
+    }
+
+    pool.Update(0.016f);
+    pool.FixedUpdate(0.02f);
+
+    for (size_t i = 0; i < count; ++i) {
+        REQUIRE(components[i]->Updates == ((i % 7) != 0 ? 11 : 0));
+    }
+}
+
+TEST_CASE("ComponentPool - parallel update keeps each chunk on a single thread", "[pool][parallel]") {
+    LowEngine::Threading::WorkerPool workers(3);
+    constexpr size_t chunkSize = 16;
+    LowEngine::Memory::ComponentPool<ParallelComponent> pool(chunkSize);
+    pool.SetWorkerPool(&workers);
+
+    // fresh pool hands out storage in order, so Entity i lives in chunk i / chunkSize
+    constexpr size_t count = 4096;
+    std::vector<ParallelComponent*> components;
+    for (size_t i = 0; i < count; ++i) {
+        components.push_back(pool.CreateComponent(nullptr, i));
+    }
+    // toggling activity reorders Components away from storage order
+    for (size_t i = 0; i < count; i += 3) {
+        pool.SetActive(i, false);
+    }
+    for (size_t i = 0; i < count; i += 6) {
+        pool.SetActive(i, true);
+    }
+
+    pool.Update(0.016f);
+
+    for (size_t chunk = 0; chunk < count / chunkSize; ++chunk) {
+        // first Entity of every chunk is even, so it is active whether or not it is a multiple of 3
+        std::thread::id thread = components[chunk * chunkSize]->UpdatedBy;
+        for (size_t i = chunk * chunkSize; i < (chunk + 1) * chunkSize; ++i) {
+            if (i % 3 != 0 || i % 6 == 0) {
+                REQUIRE(components[i]->Updates == 1);
+                REQUIRE(components[i]->UpdatedBy == thread);
+            } else {
+                REQUIRE(components[i]->Updates == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("ComponentPool - parallel update without worker pool runs sequentially", "[pool][parallel]") {
+    LowEngine::Memory::ComponentPool<ParallelComponent> pool;
+    for (size_t i = 0; i < 1000; ++i) {
+        pool.CreateComponent(nullptr, i);
+    }
+
+    pool.Update(0.016f);
+
+    int total = 0;
+    pool.ForEachComponent([&total](ParallelComponent& c) { total += c.Updates; });
+    REQUIRE(total == 1000);
+}
+
+// ─── Memory resource ──────────────────────────────────────────────────────────
+
+TEST_CASE("ComponentPool - allocates storage from provided resource", "[pool][arena]") {
+    LowEngine::Memory::ArenaResource arena;
+    {
+        LowEngine::Memory::ComponentPool<TestComponent> pool(16, &arena);
+        for (size_t i = 0; i < 40; ++i) {
+            pool.CreateComponent(nullptr, i);
+        }
+
+        const auto& stats = arena.GetStats();
+        REQUIRE(stats.BytesInUse >= 3 * 16 * sizeof(TestComponent));
+        REQUIRE(stats.BytesReserved >= stats.BytesInUse);
+        REQUIRE(stats.PeakBytesInUse >= stats.BytesInUse);
+    }
+
+    // everything is returned when the pool is destroyed
+    REQUIRE(arena.GetStats().BytesInUse == 0);
+    REQUIRE(arena.GetStats().LiveAllocations == 0);
+    REQUIRE(arena.GetStats().TotalAllocations > 0);
+}
+
+// ─── Statistics and shrinking ─────────────────────────────────────────────────
+
+namespace {
+    struct HeapComponent : LowEngine::ECS::IComponent<HeapComponent> {
+        std::vector<int> Buffer;
+
+        explicit HeapComponent(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        HeapComponent(LowEngine::Memory::Memory* memory, HeapComponent const* other)
+            : IComponent(memory, other), Buffer(other->Buffer) {}
+
+        void Initialize() override {}
+
+        size_t GetHeapSize() const { return Buffer.capacity() * sizeof(int); }
+
+        void ShrinkToFit() { Buffer.shrink_to_fit(); }
+    };
+}
+
+TEST_CASE("ComponentPool - stats track count, peak and growth", "[pool][stats]") {
+    Pool pool(16);
+    for (size_t i = 0; i < 40; ++i) {
+        pool.CreateComponent(nullptr, i);
+    }
+    for (size_t i = 0; i < 30; ++i) {
+        pool.DestroyComponent(i);
+    }
+
+    LowEngine::Memory::PoolStats stats = pool.GetStats();
+    REQUIRE(stats.Count == 10);
+    REQUIRE(stats.ActiveCount == 10);
+    REQUIRE(stats.PeakCount == 40);
+    REQUIRE(stats.Capacity == 48);
+    REQUIRE(stats.ChunkCount == 3);
+    REQUIRE(stats.GrowthEvents == 3);
+    REQUIRE(stats.BytesUsed < stats.BytesReserved);
+}
+
+TEST_CASE("ComponentPool - stats include heap memory of components", "[pool][stats]") {
+    LowEngine::Memory::ComponentPool<HeapComponent> pool;
+    pool.CreateComponent(nullptr, 0)->Buffer.reserve(100);
+
+    REQUIRE(pool.GetStats().ComponentHeapBytes >= 100 * sizeof(int));
+}
+
+TEST_CASE("ComponentPool - ShrinkToFit releases empty chunks and keeps live components", "[pool][stats]") {
+    Pool pool(16);
+    for (size_t i = 0; i < 64; ++i) {
+        pool.CreateComponent(nullptr, i)->Value = static_cast<int>(i);
+    }
+    // keep one component in the second chunk only
+    auto* survivor = reinterpret_cast<TestComponent*>(pool.GetComponentPtr(20));
+    for (size_t i = 0; i < 64; ++i) {
+        if (i != 20) {
+            pool.DestroyComponent(i);
+        }
+    }
+
+    pool.ShrinkToFit();
+
+    LowEngine::Memory::PoolStats stats = pool.GetStats();
+    REQUIRE(stats.ChunkCount == 1);
+    REQUIRE(stats.Capacity == 16);
+    REQUIRE(pool.GetComponentPtr(20) == survivor);
+    REQUIRE(survivor->Value == 20);
+
+    // pool keeps working: free slots of the kept chunk are reused before a new chunk is allocated
+    for (size_t i = 100; i < 115; ++i) {
+        pool.CreateComponent(nullptr, i);
+    }
+    REQUIRE(pool.GetStats().ChunkCount == 1);
+    pool.CreateComponent(nullptr, 115);
+    REQUIRE(pool.GetStats().ChunkCount == 2);
+    REQUIRE(pool.GetSize() == 17);
+}
+
+TEST_CASE("ComponentPool - ShrinkToFit lets components release heap memory", "[pool][stats]") {
+    LowEngine::Memory::ComponentPool<HeapComponent> pool;
+    auto* component = pool.CreateComponent(nullptr, 0);
+    component->Buffer.reserve(100);
+    component->Buffer.push_back(1);
+
+    pool.ShrinkToFit();
+    REQUIRE(pool.GetStats().ComponentHeapBytes < 100 * sizeof(int));
+}
@@ -1,10 +1,22 @@
 #include <catch2/catch_test_macros.hpp>
 #include <spdlog/sinks/null_sink.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
 #include "log/Log.h"
 #include "memory/Memory.h"
 #include "ecs/Entity.h"
 #include "ecs/IComponent.h"
+#include "ecs/Components/TransformComponent.h"
+#include "memory/SnapshotRing.h"
+#include "scene/SceneFile.h"
+#include "scene/SceneJournal.h"
+#include "threading/BackgroundWriter.h"
+#include "utils/JsonStream.h"
+#include "utils/MappedFile.h"
 
 namespace {
     struct LogGuard {
@@ -38,6 +50,11 @@ namespace {
             j["Value"] = Value;
             return j;
         }
+
+        bool DeserializeFromJSON(const nlohmann::ordered_json& jsonData) override {
+            Value = jsonData.value("Value", 0);
+            return IComponent::DeserializeFromJSON(jsonData);
+        }
     };
 
     // Depends on TestComp — must be created after TestComp
@@ -63,8 +80,8 @@ TEST_CASE("Memory - CreateEntity returns non-null", "[memory]") {
 TEST_CASE("Memory - CreateEntity sets Name and Active", "[memory]") {
     LowEngine::Memory::Memory mem;
     auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("hero");
-    REQUIRE(e->Name   == "hero");
-    REQUIRE(e->Active == true);
+    REQUIRE(e->GetName() == "hero");
+    REQUIRE(e->IsActive());
 }
 
 TEST_CASE("Memory - CreateEntity assigns sequential Ids", "[memory]") {
@@ -82,7 +99,7 @@ TEST_CASE("Memory - GetEntity returns correct entity", "[memory]") {
     mem.CreateEntity<LowEngine::ECS::Entity>("x");
     auto* e = mem.GetEntity<LowEngine::ECS::Entity>(0);
     REQUIRE(e != nullptr);
-    REQUIRE(e->Name == "x");
+    REQUIRE(e->GetName() == "x");
 }
 
 TEST_CASE("Memory - GetEntity returns nullptr for out-of-range id", "[memory]") {
@@ -95,7 +112,7 @@ TEST_CASE("Memory - FindEntity finds by name", "[memory]") {
     mem.CreateEntity<LowEngine::ECS::Entity>("target");
     auto* e = mem.FindEntity<LowEngine::ECS::Entity>("target");
     REQUIRE(e != nullptr);
-    REQUIRE(e->Name == "target");
+    REQUIRE(e->GetName() == "target");
 }
 
 TEST_CASE("Memory - FindEntity returns nullptr for missing name", "[memory]") {
@@ -128,7 +145,7 @@ TEST_CASE("Memory - CreateComponent sets EntityId and Active", "[memory]") {
     auto* c = mem.CreateComponent<TestComp>(e->Id);
     REQUIRE(c != nullptr);
     REQUIRE(c->EntityId == e->Id);
-    REQUIRE(c->Active   == true);
+    REQUIRE(c->IsActive() == true);
 }
 
 TEST_CASE("Memory - CreateComponent calls Initialize", "[memory]") {
@@ -212,7 +229,7 @@ TEST_CASE("Memory - copy clones entities", "[memory]") {
     LowEngine::Memory::Memory copy(original);
     auto* e = copy.GetEntity<LowEngine::ECS::Entity>(0);
     REQUIRE(e != nullptr);
-    REQUIRE(e->Name == "hero");
+    REQUIRE(e->GetName() == "hero");
 }
 
 TEST_CASE("Memory - copy clones component data", "[memory]") {
@@ -246,4 +263,1930 @@ TEST_CASE("Memory - Destroy clears all entities and components", "[memory]") {
     mem.Destroy();
     REQUIRE(mem.GetEntity<LowEngine::ECS::Entity>(0)  == nullptr);
     REQUIRE(mem.GetComponent<TestComp>(0)             == nullptr);
-}
\ No newline at end of file
+}
+
+// ─── Generational Entity Ids ──────────────────────────────────────────────────
+
+TEST_CASE("Memory - destroyed entity slot is reused with new generation", "[memory][entity]") {
+    LowEngine::Memory::Memory mem;
+    auto* a = mem.CreateEntity<LowEngine::ECS::Entity>("a");
+    size_t oldId = a->Id;
+    mem.DestroyEntity(a);
+
+    auto* b = mem.CreateEntity<LowEngine::ECS::Entity>("b");
+    REQUIRE(LowEngine::ECS::GetEntityIndex(b->Id) == LowEngine::ECS::GetEntityIndex(oldId));
+    REQUIRE(LowEngine::ECS::GetEntityGeneration(b->Id) == LowEngine::ECS::GetEntityGeneration(oldId) + 1);
+    REQUIRE(b->Id != oldId);
+}
+
+TEST_CASE("Memory - stale entity id is rejected", "[memory][entity]") {
+    LowEngine::Memory::Memory mem;
+    auto* a = mem.CreateEntity<LowEngine::ECS::Entity>("a");
+    size_t staleId = a->Id;
+    mem.CreateComponent<TestComp>(staleId)->Value = 1;
+    mem.DestroyEntity(a);
+
+    auto* b = mem.CreateEntity<LowEngine::ECS::Entity>("b");
+    mem.CreateComponent<TestComp>(b->Id)->Value = 2;
+
+    REQUIRE_FALSE(mem.IsEntityValid(staleId));
+    REQUIRE(mem.GetEntity<LowEngine::ECS::Entity>(staleId) == nullptr);
+    REQUIRE(mem.GetComponent<TestComp>(staleId) == nullptr);
+    REQUIRE(mem.CreateComponent<TestComp>(staleId) == nullptr);
+    REQUIRE(mem.GetComponent<TestComp>(b->Id)->Value == 2);
+}
+
+TEST_CASE("Memory - entity storage stays flat under churn", "[memory][entity]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids;
+
+    for (int frame = 0; frame < 100; ++frame) {
+        for (int i = 0; i < 50; ++i) {
+            auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("bullet");
+            mem.CreateComponent<TestComp>(e->Id);
+            ids.push_back(e->Id);
+        }
+        for (size_t id : ids) {
+            mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(id));
+        }
+        ids.clear();
+    }
+
+    auto* last = mem.CreateEntity<LowEngine::ECS::Entity>("last");
+    REQUIRE(LowEngine::ECS::GetEntityIndex(last->Id) < 50);
+    REQUIRE(mem.GetEntityCount() == 1);
+}
+
+TEST_CASE("Memory - entity pointers stay valid when more entities are created", "[memory][entity]") {
+    LowEngine::Memory::Memory mem;
+    auto* first = mem.CreateEntity<LowEngine::ECS::Entity>("first");
+    for (int i = 0; i < 1000; ++i) {
+        mem.CreateEntity<LowEngine::ECS::Entity>("filler");
+    }
+    REQUIRE(first->GetName() == "first");
+    REQUIRE(mem.GetEntity<LowEngine::ECS::Entity>(first->Id) == first);
+}
+
+TEST_CASE("Memory - ForEachEntity skips destroyed entities", "[memory][entity]") {
+    LowEngine::Memory::Memory mem;
+    mem.CreateEntity<LowEngine::ECS::Entity>("a");
+    auto* b = mem.CreateEntity<LowEngine::ECS::Entity>("b");
+    mem.CreateEntity<LowEngine::ECS::Entity>("c");
+    mem.DestroyEntity(b);
+
+    std::string names;
+    mem.ForEachEntity([&](LowEngine::ECS::Entity& e) { names += e.GetName(); });
+    REQUIRE(names == "ac");
+}
+
+TEST_CASE("Memory - entities deserialize with their saved ids", "[memory][entity]") {
+    LowEngine::Memory::Memory original;
+    auto* a = original.CreateEntity<LowEngine::ECS::Entity>("a");
+    auto* b = original.CreateEntity<LowEngine::ECS::Entity>("b");
+    original.DestroyEntity(a);
+    auto* c = original.CreateEntity<LowEngine::ECS::Entity>("c"); // reuses slot 0, generation 1
+    size_t bId = b->Id;
+    size_t cId = c->Id;
+
+    LowEngine::Memory::Memory loaded;
+    REQUIRE(loaded.DeserializeAllEntitiesFromJSON<LowEngine::ECS::Entity>(original.SerializeAllEntitiesToJSON()));
+
+    REQUIRE(loaded.GetEntity<LowEngine::ECS::Entity>(bId)->GetName() == "b");
+    REQUIRE(loaded.GetEntity<LowEngine::ECS::Entity>(cId)->GetName() == "c");
+    REQUIRE(loaded.GetEntityCount() == 2);
+}
+
+TEST_CASE("Memory - copy keeps entity ids", "[memory][entity]") {
+    LowEngine::Memory::Memory original;
+    auto* a = original.CreateEntity<LowEngine::ECS::Entity>("a");
+    auto* b = original.CreateEntity<LowEngine::ECS::Entity>("b");
+    original.CreateComponent<TestComp>(b->Id)->Value = 7;
+    original.DestroyEntity(a);
+
+    LowEngine::Memory::Memory copy(original);
+    REQUIRE(copy.GetEntity<LowEngine::ECS::Entity>(b->Id)->GetName() == "b");
+    REQUIRE(copy.GetComponent<TestComp>(b->Id)->Value == 7);
+
+    auto* reused = copy.CreateEntity<LowEngine::ECS::Entity>("reused");
+    REQUIRE(LowEngine::ECS::GetEntityIndex(reused->Id) == 0);
+}
+
+// ─── View ─────────────────────────────────────────────────────────────────────
+
+TEST_CASE("Memory - View visits entities owning all components", "[memory][view]") {
+    LowEngine::Memory::Memory mem;
+    auto* a = mem.CreateEntity<LowEngine::ECS::Entity>("a");
+    auto* b = mem.CreateEntity<LowEngine::ECS::Entity>("b");
+    auto* c = mem.CreateEntity<LowEngine::ECS::Entity>("c");
+    mem.CreateComponent<TestComp>(a->Id)->Value = 1;
+    mem.CreateComponent<TestComp>(b->Id)->Value = 2;
+    mem.CreateComponent<TestComp>(c->Id)->Value = 3;
+    mem.CreateComponent<DependentComp>(b->Id);
+    mem.CreateComponent<DependentComp>(c->Id);
+
+    int sum = 0;
+    size_t visited = 0;
+    for (auto [entityId, test, dependent] : mem.View<TestComp, DependentComp>()) {
+        REQUIRE(test.EntityId == entityId);
+        REQUIRE(dependent.EntityId == entityId);
+        sum += test.Value;
+        ++visited;
+    }
+    REQUIRE(visited == 2);
+    REQUIRE(sum == 5);
+}
+
+TEST_CASE("Memory - View skips entities missing a component", "[memory][view]") {
+    LowEngine::Memory::Memory mem;
+    auto* a = mem.CreateEntity<LowEngine::ECS::Entity>("a");
+    auto* b = mem.CreateEntity<LowEngine::ECS::Entity>("b");
+    mem.CreateComponent<TestComp>(a->Id);
+    mem.CreateComponent<TestComp>(b->Id);
+    mem.CreateComponent<DependentComp>(a->Id);
+    mem.CreateComponent<DependentComp>(b->Id);
+    mem.DestroyComponent<DependentComp>(a->Id);
+
+    std::vector<size_t> visited;
+    mem.View<TestComp, DependentComp>().Each([&](size_t entityId, TestComp&, DependentComp&) {
+        visited.push_back(entityId);
+    });
+    REQUIRE(visited == std::vector<size_t>{b->Id});
+}
+
+TEST_CASE("Memory - View is empty when a pool doesn't exist", "[memory][view]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    mem.CreateComponent<TestComp>(e->Id);
+
+    auto view = mem.View<TestComp, DependentComp>();
+    REQUIRE(view.SizeHint() == 0);
+    REQUIRE(view.begin() == view.end());
+}
+
+TEST_CASE("Memory - View gives mutable access to components", "[memory][view]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    mem.CreateComponent<TestComp>(e->Id)->Value = 1;
+
+    for (auto [entityId, test] : mem.View<TestComp>()) {
+        test.Value = 42;
+    }
+    REQUIRE(mem.GetComponent<TestComp>(e->Id)->Value == 42);
+}
+
+// ─── Component type ids ───────────────────────────────────────────────────────
+
+TEST_CASE("Memory - component type ids are stable and distinct", "[memory][typeid]") {
+    using namespace LowEngine::Memory;
+
+    ComponentTypeId testId = GetComponentTypeId<TestComp>();
+    ComponentTypeId dependentId = GetComponentTypeId<DependentComp>();
+
+    REQUIRE(testId != dependentId);
+    REQUIRE(GetComponentTypeId<TestComp>() == testId);
+    REQUIRE(ComponentTypeRegistry::Find(ComponentTypeName<TestComp>) == testId);
+    REQUIRE(ComponentTypeRegistry::GetName(dependentId) == ComponentTypeName<DependentComp>);
+    REQUIRE(ComponentTypeRegistry::Find("NotAComponent") == INVALID_COMPONENT_TYPE_ID);
+}
+
+TEST_CASE("Memory - serialized component type is the compile-time type name", "[memory][typeid]") {
+    static_assert(!LowEngine::Memory::ComponentTypeName<TestComp>.empty());
+
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    auto* comp = mem.CreateComponent<TestComp>(e->Id);
+
+    REQUIRE(comp->SerializeToJSON()["Type"] == std::string(LowEngine::Memory::ComponentTypeName<TestComp>));
+}
+
+TEST_CASE("Memory - components round-trip through JSON", "[memory][typeid]") {
+    LowEngine::Memory::Memory original;
+    auto* a = original.CreateEntity<LowEngine::ECS::Entity>("a");
+    auto* b = original.CreateEntity<LowEngine::ECS::Entity>("b");
+    original.CreateComponent<TestComp>(a->Id)->Value = 3;
+    original.CreateComponent<TestComp>(b->Id)->Value = 4;
+    original.CreateComponent<DependentComp>(b->Id);
+
+    auto entitiesJson = original.SerializeAllEntitiesToJSON();
+    auto componentsJson = original.SerializeAllComponentsToJSON();
+
+    LowEngine::Memory::Memory loaded;
+    loaded.RegisterComponentType<TestComp>();
+    loaded.RegisterComponentType<DependentComp>();
+    REQUIRE(loaded.DeserializeAllEntitiesFromJSON<LowEngine::ECS::Entity>(entitiesJson));
+    REQUIRE(loaded.DeserializeAllComponentsFromJSON(componentsJson));
+
+    REQUIRE(loaded.GetComponent<TestComp>(a->Id)->Value == 3);
+    REQUIRE(loaded.GetComponent<TestComp>(b->Id)->Value == 4);
+    REQUIRE(loaded.GetComponent<DependentComp>(b->Id) != nullptr);
+    REQUIRE(loaded.GetComponent<DependentComp>(a->Id) == nullptr);
+}
+
+TEST_CASE("Memory - components stream from JSON one at a time", "[memory][typeid]") {
+    LowEngine::Memory::Memory original;
+    auto* a = original.CreateEntity<LowEngine::ECS::Entity>("a");
+    auto* b = original.CreateEntity<LowEngine::ECS::Entity>("b");
+    original.CreateComponent<TestComp>(a->Id)->Value = 3;
+    original.CreateComponent<TestComp>(b->Id)->Value = 4;
+    original.CreateComponent<DependentComp>(b->Id);
+    original.SetComponentActive<TestComp>(a->Id, false);
+
+    std::string json = nlohmann::ordered_json{
+        {"entities", original.SerializeAllEntitiesToJSON()},
+        {"components", original.SerializeAllComponentsToJSON()}
+    }.dump();
+
+    LowEngine::Memory::Memory loaded;
+    loaded.RegisterComponentType<TestComp>();
+    loaded.RegisterComponentType<DependentComp>();
+    LowEngine::Utils::JsonStreamParser parser;
+    parser.OnValue("/entities/*", [&loaded](std::string_view, nlohmann::ordered_json& entityJson) {
+        return loaded.DeserializeEntityFromJSON<LowEngine::ECS::Entity>(entityJson);
+    });
+    parser.OnValue("/components/*/*", [&loaded](std::string_view, nlohmann::ordered_json& componentJson) {
+        return loaded.DeserializeComponentFromJSON(componentJson);
+    });
+    REQUIRE(parser.Parse(json));
+
+    REQUIRE(loaded.GetEntity<LowEngine::ECS::Entity>(b->Id)->GetName() == "b");
+    REQUIRE(loaded.GetComponent<TestComp>(a->Id)->Value == 3);
+    REQUIRE_FALSE(loaded.GetComponent<TestComp>(a->Id)->IsActive());
+    REQUIRE(loaded.GetComponent<TestComp>(b->Id)->Value == 4);
+    REQUIRE(loaded.GetComponent<DependentComp>(b->Id) != nullptr);
+}
+
+TEST_CASE("Memory - unregistered component types are skipped on load", "[memory][typeid]") {
+    LowEngine::Memory::Memory original;
+    auto* e = original.CreateEntity<LowEngine::ECS::Entity>("e");
+    original.CreateComponent<TestComp>(e->Id);
+
+    auto entitiesJson = original.SerializeAllEntitiesToJSON();
+    auto componentsJson = original.SerializeAllComponentsToJSON();
+
+    LowEngine::Memory::Memory loaded;
+    REQUIRE(loaded.DeserializeAllEntitiesFromJSON<LowEngine::ECS::Entity>(entitiesJson));
+    REQUIRE(loaded.DeserializeAllComponentsFromJSON(componentsJson));
+    REQUIRE(loaded.GetComponent<TestComp>(e->Id) == nullptr);
+}
+
+// ─── Scheduled update ─────────────────────────────────────────────────────────
+
+namespace {
+    struct CounterComp : LowEngine::ECS::IComponent<CounterComp> {
+        static constexpr bool WorkerThreadSafe = true;
+
+        int Count = 0;
+
+        explicit CounterComp(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        CounterComp(LowEngine::Memory::Memory* memory, CounterComp const* other)
+            : IComponent(memory, other), Count(other->Count) {}
+
+        void Initialize() override {}
+
+        void Update(float) override { Count++; }
+    };
+
+    // Reads CounterComp during update. Must always see it already updated in the same frame.
+    struct CounterReaderComp : LowEngine::ECS::IComponent<CounterReaderComp, CounterComp> {
+        static constexpr bool WorkerThreadSafe = true;
+
+        int Seen = 0;
+
+        explicit CounterReaderComp(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        CounterReaderComp(LowEngine::Memory::Memory* memory, CounterReaderComp const* other)
+            : IComponent(memory, other), Seen(other->Seen) {}
+
+        void Initialize() override {}
+
+        void Update(float) override { Seen = _memory->GetComponent<CounterComp>(EntityId)->Count; }
+    };
+}
+
+TEST_CASE("Memory - scheduled update runs dependencies first", "[memory][schedule]") {
+    LowEngine::Threading::WorkerPool workers(3);
+    LowEngine::Memory::Memory mem;
+    mem.SetWorkerPool(&workers);
+
+    std::vector<size_t> ids;
+    for (int i = 0; i < 200; ++i) {
+        auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+        mem.CreateComponent<CounterComp>(e->Id);
+        mem.CreateComponent<CounterReaderComp>(e->Id);
+        mem.CreateComponent<TestComp>(e->Id);
+        ids.push_back(e->Id);
+    }
+
+    for (int frame = 1; frame <= 5; ++frame) {
+        mem.UpdateAllComponents(0.016f);
+        for (size_t id : ids) {
+            REQUIRE(mem.GetComponent<CounterReaderComp>(id)->Seen == frame);
+        }
+    }
+
+    const auto& stages = mem.GetUpdateSchedule().GetStages();
+    REQUIRE(stages.size() == 2);
+    REQUIRE(stages[0].MainThread.empty()); // TestComp has no Update, so it isn't scheduled
+}
+
+namespace {
+    // Modifies CounterComp it depends on from the main thread.
+    struct CounterBumperComp : LowEngine::ECS::IComponent<CounterBumperComp, CounterComp> {
+        explicit CounterBumperComp(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        CounterBumperComp(LowEngine::Memory::Memory* memory, CounterBumperComp const* other)
+            : IComponent(memory, other) {}
+
+        void Initialize() override {}
+
+        void Update(float) override { _memory->GetComponent<CounterComp>(EntityId)->Count++; }
+    };
+
+    // Only reads CounterComp on worker threads.
+    struct CounterWatcherComp : LowEngine::ECS::IComponent<CounterWatcherComp, CounterComp> {
+        static constexpr bool DependenciesReadOnly = true;
+        static constexpr bool WorkerThreadSafe = true;
+
+        int Seen = 0;
+
+        explicit CounterWatcherComp(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        CounterWatcherComp(LowEngine::Memory::Memory* memory, CounterWatcherComp const* other)
+            : IComponent(memory, other), Seen(other->Seen) {}
+
+        void Initialize() override {}
+
+        void Update(float) override { Seen = _memory->GetComponent<CounterComp>(EntityId)->Count; }
+    };
+}
+
+TEST_CASE("Memory - main thread pool writing a dependency doesn't overlap its worker readers", "[memory][schedule]") {
+    LowEngine::Threading::WorkerPool workers(3);
+    LowEngine::Memory::Memory mem;
+    mem.SetWorkerPool(&workers);
+
+    std::vector<size_t> ids;
+    for (int i = 0; i < 200; ++i) {
+        auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+        mem.CreateComponent<CounterComp>(e->Id);
+        mem.CreateComponent<CounterBumperComp>(e->Id);
+        mem.CreateComponent<CounterWatcherComp>(e->Id);
+        ids.push_back(e->Id);
+    }
+
+    using LowEngine::Memory::GetComponentTypeId;
+    for (const auto& stage : mem.GetUpdateSchedule().GetStages()) {
+        bool bumperInStage = std::find(stage.MainThread.begin(), stage.MainThread.end(),
+                                       GetComponentTypeId<CounterBumperComp>()) != stage.MainThread.end();
+        bool watcherInStage = std::find(stage.Workers.begin(), stage.Workers.end(),
+                                        GetComponentTypeId<CounterWatcherComp>()) != stage.Workers.end();
+        REQUIRE_FALSE((bumperInStage && watcherInStage));
+    }
+
+    for (int frame = 1; frame <= 5; ++frame) {
+        mem.UpdateAllComponents(0.016f);
+        for (size_t id : ids) {
+            REQUIRE(mem.GetComponent<CounterWatcherComp>(id)->Seen == frame * 2);
+        }
+    }
+}
+
+namespace {
+    // Overrides only FixedUpdate.
+    struct FixedOnlyComp : LowEngine::ECS::IComponent<FixedOnlyComp> {
+        int Steps = 0;
+
+        explicit FixedOnlyComp(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        FixedOnlyComp(LowEngine::Memory::Memory* memory, FixedOnlyComp const* other)
+            : IComponent(memory, other), Steps(other->Steps) {}
+
+        void Initialize() override {}
+
+        void FixedUpdate(float) override { Steps++; }
+    };
+
+    static_assert(!TestComp::OverridesUpdate());
+    static_assert(!FixedOnlyComp::OverridesUpdate());
+    static_assert(FixedOnlyComp::OverridesFixedUpdate());
+    static_assert(CounterComp::OverridesUpdate() && !CounterComp::OverridesDraw());
+}
+
+TEST_CASE("Memory - pools are scheduled only in phases their type overrides", "[memory][schedule]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    mem.CreateComponent<TestComp>(e->Id);
+    mem.CreateComponent<CounterComp>(e->Id);
+    auto* fixed = mem.CreateComponent<FixedOnlyComp>(e->Id);
+
+    auto scheduled = [](const LowEngine::Memory::UpdateSchedule& schedule) {
+        std::vector<LowEngine::Memory::ComponentTypeId> typeIds;
+        for (const auto& stage : schedule.GetStages()) {
+            typeIds.insert(typeIds.end(), stage.MainThread.begin(), stage.MainThread.end());
+            typeIds.insert(typeIds.end(), stage.Workers.begin(), stage.Workers.end());
+        }
+        return typeIds;
+    };
+
+    using LowEngine::Memory::GetComponentTypeId;
+    REQUIRE(scheduled(mem.GetUpdateSchedule()) == std::vector{GetComponentTypeId<CounterComp>()});
+    REQUIRE(scheduled(mem.GetFixedUpdateSchedule()) == std::vector{GetComponentTypeId<FixedOnlyComp>()});
+
+    mem.FixedUpdateAllComponents(0.02f);
+    mem.UpdateAllComponents(0.016f);
+    REQUIRE(fixed->Steps == 1);
+    REQUIRE(mem.GetComponent<CounterComp>(e->Id)->Count == 1);
+}
+
+// ─── Bulk creation ────────────────────────────────────────────────────────────
+
+TEST_CASE("Memory - CreateEntities reuses free slots first", "[memory][bulk]") {
+    LowEngine::Memory::Memory mem;
+    auto* a = mem.CreateEntity<LowEngine::ECS::Entity>("a");
+    mem.CreateEntity<LowEngine::ECS::Entity>("b");
+    mem.DestroyEntity(a);
+
+    auto ids = mem.CreateEntities(100, "bulk");
+    REQUIRE(ids.size() == 100);
+    REQUIRE(mem.GetEntityCount() == 101);
+    REQUIRE(LowEngine::ECS::GetEntityIndex(ids[0]) == 0);
+    for (size_t id : ids) {
+        REQUIRE(mem.GetEntity<LowEngine::ECS::Entity>(id)->GetName() == "bulk");
+    }
+
+    // name lookup stays consistent when Entities leave it
+    REQUIRE(mem.FindEntities("bulk").size() == 100);
+    REQUIRE(mem.RenameEntity(ids[50], "renamed"));
+    mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(ids[99]));
+    REQUIRE(mem.FindEntities("bulk").size() == 98);
+    REQUIRE(mem.FindEntities("renamed").size() == 1);
+    REQUIRE(mem.FindEntities("renamed")[0] == ids[50]);
+}
+
+TEST_CASE("Memory - CreateComponents initializes every component", "[memory][bulk]") {
+    LowEngine::Memory::Memory mem;
+    auto ids = mem.CreateEntities(500);
+
+    size_t created = mem.CreateComponents<TestComp>(ids, [](TestComp& component) {
+        component.Value = 3;
+    });
+    REQUIRE(created == 500);
+    for (size_t id : ids) {
+        auto* component = mem.GetComponent<TestComp>(id);
+        REQUIRE(component->EntityId == id);
+        REQUIRE(component->IsActive());
+        REQUIRE(component->InitCalled);
+        REQUIRE(component->Value == 3);
+    }
+}
+
+TEST_CASE("Memory - CreateComponents skips entities missing a dependency", "[memory][bulk]") {
+    LowEngine::Memory::Memory mem;
+    auto ids = mem.CreateEntities(10);
+    REQUIRE(mem.CreateComponents<DependentComp>(ids) == 0); // dependency not registered
+
+    mem.CreateComponents<TestComp>(std::span(ids).first(4));
+    REQUIRE(mem.CreateComponents<DependentComp>(ids) == 4);
+    REQUIRE(mem.GetComponent<DependentComp>(ids[3]) != nullptr);
+    REQUIRE(mem.GetComponent<DependentComp>(ids[4]) == nullptr);
+
+    // already owned or stale entity
+    size_t stale = ids[9];
+    mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(stale));
+    std::vector<size_t> again = { ids[0], stale };
+    REQUIRE(mem.CreateComponents<TestComp>(again) == 0);
+}
+
+// ─── Signature ────────────────────────────────────────────────────────────────
+
+TEST_CASE("ComponentSignature - set, reset and iterate across words", "[memory][signature]") {
+    LowEngine::Memory::ComponentSignature signature;
+    REQUIRE(signature.IsEmpty());
+
+    signature.Set(3);
+    signature.Set(64);
+    signature.Set(LowEngine::Config::MAX_COMPONENT_TYPES - 1);
+    REQUIRE(signature.Test(64));
+    REQUIRE_FALSE(signature.Test(4));
+    REQUIRE_FALSE(signature.Test(LowEngine::Memory::INVALID_COMPONENT_TYPE_ID));
+
+    std::vector<LowEngine::Memory::ComponentTypeId> visited;
+    signature.ForEach([&visited](LowEngine::Memory::ComponentTypeId typeId) { visited.push_back(typeId); });
+    REQUIRE(visited == std::vector<LowEngine::Memory::ComponentTypeId>{
+        3, 64, static_cast<LowEngine::Memory::ComponentTypeId>(LowEngine::Config::MAX_COMPONENT_TYPES - 1)
+    });
+
+    LowEngine::Memory::ComponentSignature mask;
+    mask.Set(3);
+    mask.Set(64);
+    REQUIRE(signature.Contains(mask));
+    signature.Reset(64);
+    REQUIRE_FALSE(signature.Contains(mask));
+}
+
+TEST_CASE("Memory - entity signature follows attached components", "[memory][signature]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    REQUIRE(mem.GetEntitySignature(e->Id).IsEmpty());
+
+    mem.CreateComponent<TestComp>(e->Id);
+    mem.CreateComponent<DependentComp>(e->Id);
+    REQUIRE(mem.HasComponent<TestComp>(e->Id));
+    REQUIRE(mem.HasComponent<DependentComp>(e->Id));
+    REQUIRE(e->HasComponent(std::type_index(typeid(TestComp))));
+
+    mem.DestroyComponent<DependentComp>(e->Id);
+    REQUIRE_FALSE(mem.HasComponent<DependentComp>(e->Id));
+    REQUIRE_FALSE(e->HasComponent(std::type_index(typeid(DependentComp))));
+    REQUIRE(mem.HasComponent<TestComp>(e->Id));
+}
+
+TEST_CASE("Memory - reused entity slot starts with empty signature", "[memory][signature]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    size_t staleId = e->Id;
+    mem.CreateComponent<TestComp>(staleId);
+    mem.DestroyEntity(e);
+
+    auto* reused = mem.CreateEntity<LowEngine::ECS::Entity>("reused");
+    REQUIRE(LowEngine::ECS::GetEntityIndex(reused->Id) == LowEngine::ECS::GetEntityIndex(staleId));
+    REQUIRE(mem.GetEntitySignature(reused->Id).IsEmpty());
+    REQUIRE_FALSE(mem.HasComponent<TestComp>(staleId));
+
+    // destroying through a stale id must not clear the new owner's signature
+    mem.CreateComponent<TestComp>(reused->Id);
+    mem.DestroyComponent<TestComp>(staleId);
+    REQUIRE(mem.HasComponent<TestComp>(reused->Id));
+}
+
+TEST_CASE("Memory - copy keeps entity signatures", "[memory][signature]") {
+    LowEngine::Memory::Memory original;
+    auto* e = original.CreateEntity<LowEngine::ECS::Entity>("e");
+    original.CreateComponent<TestComp>(e->Id);
+
+    LowEngine::Memory::Memory copy(original);
+    REQUIRE(copy.HasComponent<TestComp>(e->Id));
+    REQUIRE(copy.GetEntitySignature(e->Id) == original.GetEntitySignature(e->Id));
+}
+
+// ─── Change tracking ──────────────────────────────────────────────────────────
+
+TEST_CASE("Memory - tick advances with every update", "[memory][changes]") {
+    LowEngine::Memory::Memory mem;
+    REQUIRE(mem.GetTick() == 0);
+
+    mem.UpdateAllComponents(0.016f);
+    mem.UpdateAllComponents(0.016f);
+    REQUIRE(mem.GetTick() == 2);
+}
+
+TEST_CASE("Memory - Transform version changes only when value changes", "[memory][changes]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    auto* transform = mem.CreateComponent<LowEngine::ECS::TransformComponent>(e->Id);
+
+    uint64_t version = transform->GetVersion();
+    REQUIRE(version != 0);
+
+    transform->SetPosition(transform->GetPosition());
+    transform->SetScale({1.0f, 1.0f});
+    REQUIRE(transform->GetVersion() == version);
+
+    transform->Move({1.0f, 0.0f});
+    REQUIRE(transform->GetVersion() != version);
+    REQUIRE(transform->GetPosition() == sf::Vector2f(1.0f, 0.0f));
+}
+
+TEST_CASE("Memory - GetEntitiesChangedSince returns Entities with changed Transform", "[memory][changes]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(4);
+    mem.CreateComponents<LowEngine::ECS::TransformComponent>(ids);
+
+    mem.UpdateAllComponents(0.016f);
+    uint64_t tick = mem.GetTick();
+    REQUIRE(mem.GetEntitiesChangedSince<LowEngine::ECS::TransformComponent>(tick).empty());
+
+    mem.GetComponent<LowEngine::ECS::TransformComponent>(ids[1])->SetRotation(sf::degrees(90.0f));
+    mem.UpdateAllComponents(0.016f);
+    mem.GetComponent<LowEngine::ECS::TransformComponent>(ids[3])->SetPosition({5.0f, 5.0f});
+
+    auto changed = mem.GetEntitiesChangedSince<LowEngine::ECS::TransformComponent>(tick);
+    std::sort(changed.begin(), changed.end());
+    REQUIRE(changed == std::vector<size_t>{ids[1], ids[3]});
+
+    REQUIRE(mem.GetEntitiesChangedSince<LowEngine::ECS::TransformComponent>(mem.GetTick())
+            == std::vector<size_t>{ids[3]});
+}
+
+TEST_CASE("Memory - Transform added again never repeats a version", "[memory][changes]") {
+    using LowEngine::ECS::TransformComponent;
+
+    LowEngine::Memory::Memory mem;
+    size_t entityId = mem.CreateEntity<LowEngine::ECS::Entity>("e")->Id;
+    auto* transform = mem.CreateComponent<TransformComponent>(entityId);
+    transform->Move({1.0f, 0.0f});
+    // a dependent Component synced with this version
+    uint64_t synced = transform->GetVersion();
+
+    mem.DestroyComponent<TransformComponent>(entityId);
+    auto* added = mem.CreateComponent<TransformComponent>(entityId);
+    REQUIRE(added->GetVersion() != synced);
+    added->Move({1.0f, 0.0f});
+    REQUIRE(added->GetVersion() != synced);
+}
+
+TEST_CASE("Memory - GetEntitiesChangedSince skips destroyed and recycled Transforms", "[memory][changes]") {
+    using LowEngine::ECS::TransformComponent;
+
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(4);
+    mem.CreateComponents<TransformComponent>(ids);
+    mem.UpdateAllComponents(0.016f);
+    uint64_t tick = mem.GetTick();
+
+    // changed, then destroyed with its Entity; the slot is taken by a new Entity without a Transform
+    mem.GetComponent<TransformComponent>(ids[0])->Move({1.0f, 0.0f});
+    mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(ids[0]));
+    size_t recycled = mem.CreateEntity<LowEngine::ECS::Entity>("recycled")->Id;
+    REQUIRE(LowEngine::ECS::GetEntityIndex(recycled) == LowEngine::ECS::GetEntityIndex(ids[0]));
+
+    // destroyed and added again during one tick
+    mem.GetComponent<TransformComponent>(ids[1])->Move({1.0f, 0.0f});
+    mem.DestroyComponent<TransformComponent>(ids[1]);
+    mem.CreateComponent<TransformComponent>(ids[1]);
+
+    // changed during many ticks
+    for (int frame = 0; frame < 10; ++frame) {
+        mem.GetComponent<TransformComponent>(ids[2])->Move({1.0f, 0.0f});
+        mem.UpdateAllComponents(0.016f);
+    }
+
+    REQUIRE(mem.GetEntitiesChangedSince<TransformComponent>(tick) == std::vector<size_t>{ids[1], ids[2]});
+    REQUIRE(mem.GetEntitiesChangedSince<TransformComponent>(tick + 1) == std::vector<size_t>{ids[2]});
+    REQUIRE(mem.GetEntitiesChangedSince<TransformComponent>(mem.GetTick()).empty());
+
+    // copy keeps the records
+    LowEngine::Memory::Memory copy(mem);
+    REQUIRE(copy.GetEntitiesChangedSince<TransformComponent>(tick) == std::vector<size_t>{ids[1], ids[2]});
+}
+
+// ─── Snapshots ────────────────────────────────────────────────────────────────
+
+namespace {
+    std::vector<LowEngine::Memory::ComponentTypeId> TransformTypeIds() {
+        return {LowEngine::Memory::GetComponentTypeId<LowEngine::ECS::TransformComponent>()};
+    }
+}
+
+TEST_CASE("Memory - snapshot restores Transform state", "[memory][snapshot]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(3);
+    mem.CreateComponents<LowEngine::ECS::TransformComponent>(ids);
+    auto* transform = mem.GetComponent<LowEngine::ECS::TransformComponent>(ids[1]);
+    transform->SetPosition({1.0f, 2.0f});
+
+    std::vector<std::byte> snapshot;
+    REQUIRE(mem.WriteSnapshot(snapshot, TransformTypeIds()));
+
+    transform->SetPosition({7.0f, 7.0f});
+    transform->SetScale({2.0f, 2.0f});
+    uint64_t version = transform->GetVersion();
+
+    REQUIRE(mem.ReadSnapshot(snapshot));
+    REQUIRE(transform->GetPosition() == sf::Vector2f(1.0f, 2.0f));
+    REQUIRE(transform->GetScale() == sf::Vector2f(1.0f, 1.0f));
+    REQUIRE(transform->GetVersion() != version);
+}
+
+TEST_CASE("Memory - snapshot of type without snapshot support fails", "[memory][snapshot]") {
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    mem.CreateComponent<TestComp>(e->Id);
+
+    std::vector<std::byte> snapshot;
+    REQUIRE_FALSE(mem.WriteSnapshot(snapshot, std::vector{LowEngine::Memory::GetComponentTypeId<TestComp>()}));
+    REQUIRE_FALSE(mem.ReadSnapshot({}));
+}
+
+TEST_CASE("SnapshotRing - restores ticks stored as deltas", "[memory][snapshot]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(100);
+    mem.CreateComponents<LowEngine::ECS::TransformComponent>(ids);
+    LowEngine::Memory::SnapshotRing ring(mem, TransformTypeIds(), 16, 4);
+
+    // move a single Entity every tick
+    auto* moving = mem.GetComponent<LowEngine::ECS::TransformComponent>(ids[50]);
+    for (uint64_t tick = 1; tick <= 10; ++tick) {
+        moving->SetPosition({static_cast<float>(tick), 0.0f});
+        REQUIRE(ring.Capture(tick));
+    }
+
+    REQUIRE(ring.GetSize() == 10);
+    REQUIRE(ring.GetNewestTick() == 10);
+    // deltas of a single changed Transform are much smaller than full snapshots
+    std::vector<std::byte> full;
+    REQUIRE(mem.WriteSnapshot(full, TransformTypeIds()));
+    REQUIRE(ring.GetStoredBytes() < 4 * full.size());
+
+    REQUIRE(ring.Restore(7));
+    REQUIRE(moving->GetPosition() == sf::Vector2f(7.0f, 0.0f));
+    // newer ticks are dropped
+    REQUIRE(ring.GetNewestTick() == 7);
+    REQUIRE_FALSE(ring.Contains(8));
+
+    REQUIRE(ring.Restore(2));
+    REQUIRE(moving->GetPosition() == sf::Vector2f(2.0f, 0.0f));
+}
+
+TEST_CASE("SnapshotRing - capture after restore continues from restored tick", "[memory][snapshot]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(8);
+    mem.CreateComponents<LowEngine::ECS::TransformComponent>(ids);
+    LowEngine::Memory::SnapshotRing ring(mem, TransformTypeIds(), 16, 8);
+    auto* moving = mem.GetComponent<LowEngine::ECS::TransformComponent>(ids[0]);
+
+    for (uint64_t tick = 1; tick <= 5; ++tick) {
+        moving->SetPosition({static_cast<float>(tick), 0.0f});
+        REQUIRE(ring.Capture(tick));
+    }
+
+    REQUIRE(ring.Restore(3));
+    moving->SetPosition({30.0f, 0.0f});
+    REQUIRE(ring.Capture(4));
+    moving->SetPosition({40.0f, 0.0f});
+    REQUIRE(ring.Capture(5));
+
+    REQUIRE(ring.Restore(4));
+    REQUIRE(moving->GetPosition() == sf::Vector2f(30.0f, 0.0f));
+
+    // capturing an older tick drops it and newer ticks first
+    moving->SetPosition({20.0f, 0.0f});
+    REQUIRE(ring.Capture(2));
+    REQUIRE(ring.GetSize() == 2);
+    REQUIRE(ring.Restore(1));
+    REQUIRE(moving->GetPosition() == sf::Vector2f(1.0f, 0.0f));
+}
+
+TEST_CASE("SnapshotRing - restore fails when Components were created or destroyed", "[memory][snapshot]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(4);
+    mem.CreateComponents<LowEngine::ECS::TransformComponent>({ids.begin(), ids.begin() + 3});
+    LowEngine::Memory::SnapshotRing ring(mem, TransformTypeIds(), 8, 4);
+    auto* moving = mem.GetComponent<LowEngine::ECS::TransformComponent>(ids[0]);
+
+    REQUIRE(ring.Capture(1));
+    moving->SetPosition({5.0f, 0.0f});
+    REQUIRE(ring.Capture(2));
+
+    SECTION("created") {
+        mem.CreateComponent<LowEngine::ECS::TransformComponent>(ids[3]);
+    }
+    SECTION("destroyed") {
+        mem.DestroyComponent<LowEngine::ECS::TransformComponent>(ids[2]);
+    }
+    SECTION("replaced by another Entity") {
+        mem.DestroyComponent<LowEngine::ECS::TransformComponent>(ids[2]);
+        mem.CreateComponent<LowEngine::ECS::TransformComponent>(ids[3]);
+    }
+
+    REQUIRE_FALSE(ring.Restore(1));
+    // nothing was restored and no tick was dropped
+    REQUIRE(moving->GetPosition() == sf::Vector2f(5.0f, 0.0f));
+    REQUIRE(ring.GetNewestTick() == 2);
+}
+
+TEST_CASE("SnapshotRing - oldest ticks are dropped when full", "[memory][snapshot]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(4);
+    mem.CreateComponents<LowEngine::ECS::TransformComponent>(ids);
+    LowEngine::Memory::SnapshotRing ring(mem, TransformTypeIds(), 4, 2);
+    auto* moving = mem.GetComponent<LowEngine::ECS::TransformComponent>(ids[2]);
+
+    for (uint64_t tick = 1; tick <= 9; ++tick) {
+        moving->SetPosition({static_cast<float>(tick), 0.0f});
+        REQUIRE(ring.Capture(tick));
+    }
+
+    REQUIRE(ring.GetSize() == 4);
+    REQUIRE_FALSE(ring.Contains(5));
+    // tick 6 is a delta whose full snapshot, tick 5, was dropped
+    REQUIRE_FALSE(ring.Contains(6));
+    REQUIRE(ring.Contains(7));
+    REQUIRE(ring.Restore(8));
+    REQUIRE(moving->GetPosition() == sf::Vector2f(8.0f, 0.0f));
+}
+
+// ─── Arena ────────────────────────────────────────────────────────────────────
+
+TEST_CASE("Memory - Entities and Components are allocated from the arena", "[memory][arena]") {
+    LowEngine::Memory::Memory mem;
+    size_t initialBytes = mem.GetArenaStats().BytesInUse;
+
+    std::vector<size_t> ids = mem.CreateEntities(100);
+    mem.CreateComponents<LowEngine::ECS::TransformComponent>(ids);
+    REQUIRE(mem.GetArenaStats().BytesInUse > initialBytes + 100 * sizeof(LowEngine::ECS::TransformComponent));
+
+    size_t peak = mem.GetArenaStats().PeakBytesInUse;
+    mem.Destroy();
+    REQUIRE(mem.GetArenaStats().BytesInUse < peak);
+    REQUIRE(mem.GetArenaStats().PeakBytesInUse == peak);
+}
+
+TEST_CASE("Memory - copy allocates from its own arena", "[memory][arena]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(10);
+    mem.CreateComponents<TestComp>(ids);
+    size_t originalBytes = mem.GetArenaStats().BytesInUse;
+
+    LowEngine::Memory::Memory copy(mem);
+    REQUIRE(copy.GetArenaStats().BytesInUse > 0);
+    REQUIRE(mem.GetArenaStats().BytesInUse == originalBytes);
+
+    copy.DestroyEntity(copy.GetEntity<LowEngine::ECS::Entity>(ids[0]));
+    REQUIRE(mem.GetComponent<TestComp>(ids[0]) != nullptr);
+}
+
+TEST_CASE("Memory - copy of Transforms is independent of the original", "[memory][arena]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(600);
+    mem.CreateComponents<LowEngine::ECS::TransformComponent>(ids, [](LowEngine::ECS::TransformComponent& transform) {
+        transform.SetPosition({static_cast<float>(transform.EntityId), 1.0f});
+    });
+    mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(ids[7]));
+
+    LowEngine::Memory::Memory copy(mem);
+    auto* copied = copy.GetComponent<LowEngine::ECS::TransformComponent>(ids[300]);
+    REQUIRE(copied != mem.GetComponent<LowEngine::ECS::TransformComponent>(ids[300]));
+    REQUIRE(copied->GetPosition() == sf::Vector2f(static_cast<float>(ids[300]), 1.0f));
+    REQUIRE(copy.GetComponent<LowEngine::ECS::TransformComponent>(ids[7]) == nullptr);
+
+    copied->SetPosition({-1.0f, -1.0f});
+    REQUIRE(mem.GetComponent<LowEngine::ECS::TransformComponent>(ids[300])->GetPosition()
+            == sf::Vector2f(static_cast<float>(ids[300]), 1.0f));
+    // free storage of the copy is its own
+    std::vector<size_t> extra = copy.CreateEntities(1);
+    REQUIRE(copy.CreateComponent<LowEngine::ECS::TransformComponent>(extra[0]) != nullptr);
+    REQUIRE(mem.GetComponent<LowEngine::ECS::TransformComponent>(extra[0]) == nullptr);
+}
+
+TEST_CASE("Memory - ShrinkToFit hands pool storage back to the arena", "[memory][arena]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(5000);
+    mem.CreateComponents<TestComp>(ids);
+    for (size_t i = 10; i < ids.size(); ++i) {
+        mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(ids[i]));
+    }
+
+    size_t bytesBefore = mem.GetArenaStats().BytesInUse;
+    mem.ShrinkToFit();
+    REQUIRE(mem.GetArenaStats().BytesInUse < bytesBefore);
+
+    auto stats = mem.GetPoolStats();
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].TypeId == LowEngine::Memory::GetComponentTypeId<TestComp>());
+    REQUIRE(stats[0].Count == 10);
+    REQUIRE(stats[0].PeakCount == 5000);
+    REQUIRE(mem.GetComponent<TestComp>(ids[3]) != nullptr);
+}
+
+// ─── Structure-of-arrays storage ──────────────────────────────────────────────
+
+TEST_CASE("Memory - Transform data lives in pool storage in iteration order", "[memory][soa]") {
+    using LowEngine::ECS::TransformComponent;
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(4);
+    mem.CreateComponents<TransformComponent>(ids);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        mem.GetComponent<TransformComponent>(ids[i])->SetPosition({static_cast<float>(i), 10.0f});
+    }
+
+    size_t activeCount = 0;
+    auto* storage = mem.GetSoAStorage<TransformComponent>(activeCount);
+    REQUIRE(storage != nullptr);
+    REQUIRE(activeCount == 4);
+    REQUIRE(storage->PositionX.GetSize() == 4);
+    REQUIRE(reinterpret_cast<uintptr_t>(storage->PositionX.GetSpan().data()) % LowEngine::Config::CACHE_LINE_SIZE == 0);
+
+    // batch work over the arrays is visible through the components
+    for (float& y : storage->PositionY.GetSpan()) {
+        y += 1.0f;
+    }
+    REQUIRE(mem.GetComponent<TransformComponent>(ids[2])->GetPosition() == sf::Vector2f(2.0f, 11.0f));
+    REQUIRE(mem.GetComponent<TransformComponent>(ids[2])->GetScale() == sf::Vector2f(1.0f, 1.0f));
+}
+
+TEST_CASE("Memory - Transform keeps its data when pool reorders", "[memory][soa]") {
+    using LowEngine::ECS::TransformComponent;
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(5);
+    mem.CreateComponents<TransformComponent>(ids);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        mem.GetComponent<TransformComponent>(ids[i])->SetPosition({static_cast<float>(i), 0.0f});
+    }
+
+    mem.SetComponentActive<TransformComponent>(ids[0], false);
+    mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(ids[2]));
+
+    size_t activeCount = 0;
+    auto* storage = mem.GetSoAStorage<TransformComponent>(activeCount);
+    REQUIRE(activeCount == 3);
+    REQUIRE(storage->PositionX.GetSize() == 4);
+    // inactive component is past the active range
+    REQUIRE(storage->PositionX[3] == 0.0f);
+
+    for (size_t i : {0, 1, 3, 4}) {
+        REQUIRE(mem.GetComponent<TransformComponent>(ids[i])->GetPosition().x == static_cast<float>(i));
+    }
+
+    LowEngine::Memory::Memory copy(mem);
+    copy.GetComponent<TransformComponent>(ids[4])->Move({1.0f, 0.0f});
+    REQUIRE(copy.GetComponent<TransformComponent>(ids[4])->GetPosition().x == 5.0f);
+    REQUIRE(copy.GetComponent<TransformComponent>(ids[3])->GetPosition().x == 3.0f);
+    REQUIRE(mem.GetComponent<TransformComponent>(ids[4])->GetPosition().x == 4.0f);
+}
+
+// ─── Entity names ────────────────────────────────────────────────────────────
+
+TEST_CASE("NameTable - interns every distinct string once", "[memory][names]") {
+    LowEngine::Memory::NameTable names;
+    LowEngine::Memory::NameId player = names.Intern("Player");
+    LowEngine::Memory::NameId enemy = names.Intern("Enemy");
+
+    REQUIRE(player != enemy);
+    REQUIRE(names.Intern(std::string("Player")) == player);
+    REQUIRE(names.Find("Enemy") == enemy);
+    REQUIRE(names.Find("Ghost") == LowEngine::Memory::INVALID_NAME_ID);
+    REQUIRE(names.GetName(player) == "Player");
+    REQUIRE(names.GetCount() == 2);
+
+    names.Erase(player);
+    REQUIRE(names.Find("Player") == LowEngine::Memory::INVALID_NAME_ID);
+    REQUIRE(names.GetName(player).empty());
+    // erased id is reused
+    REQUIRE(names.Intern("Boss") == player);
+    REQUIRE(names.GetName(enemy) == "Enemy");
+}
+
+TEST_CASE("Memory - FindEntities returns all entities with a name", "[memory][names]") {
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> enemies = mem.CreateEntities(4, "Enemy");
+    auto* player = mem.CreateEntity<LowEngine::ECS::Entity>("Player");
+
+    REQUIRE(mem.FindEntity<LowEngine::ECS::Entity>("Player") == player);
+    REQUIRE(mem.FindEntities("Enemy").size() == 4);
+    REQUIRE(mem.GetEntityNameCount() == 2);
+
+    mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(enemies[0]));
+    mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(enemies[2]));
+    std::vector<size_t> found(mem.FindEntities("Enemy").begin(), mem.FindEntities("Enemy").end());
+    std::ranges::sort(found);
+    REQUIRE(found == std::vector<size_t>{enemies[1], enemies[3]});
+    REQUIRE(mem.FindEntity<LowEngine::ECS::Entity>("Enemy") != nullptr);
+
+    mem.DestroyEntity(player);
+    REQUIRE(mem.FindEntity<LowEngine::ECS::Entity>("Player") == nullptr);
+    REQUIRE(mem.FindEntities("Player").empty());
+    REQUIRE(mem.GetEntityNameCount() == 1);
+}
+
+TEST_CASE("Memory - renamed entity is found by its new name", "[memory][names]") {
+    LowEngine::Memory::Memory mem;
+    auto* a = mem.CreateEntity<LowEngine::ECS::Entity>("a");
+    auto* b = mem.CreateEntity<LowEngine::ECS::Entity>("a");
+
+    a->SetName("hero");
+    REQUIRE(a->GetName() == "hero");
+    REQUIRE(mem.FindEntity<LowEngine::ECS::Entity>("hero") == a);
+    REQUIRE(mem.FindEntity<LowEngine::ECS::Entity>("a") == b);
+
+    b->SetName("hero");
+    REQUIRE(mem.FindEntities("hero").size() == 2);
+    REQUIRE(mem.FindEntity<LowEngine::ECS::Entity>("a") == nullptr);
+    REQUIRE(mem.GetEntityNameCount() == 1);
+
+    REQUIRE_FALSE(mem.RenameEntity(LowEngine::Config::INVALID_ID, "ghost"));
+}
+
+TEST_CASE("Memory - copy keeps entity names in its own table", "[memory][names]") {
+    LowEngine::Memory::Memory original;
+    auto* a = original.CreateEntity<LowEngine::ECS::Entity>("a");
+    original.CreateEntity<LowEngine::ECS::Entity>("b");
+
+    LowEngine::Memory::Memory copy(original);
+    a->SetName("renamed");
+
+    auto* copied = copy.FindEntity<LowEngine::ECS::Entity>("a");
+    REQUIRE(copied != nullptr);
+    REQUIRE(copied->Id == a->Id);
+    REQUIRE(copy.FindEntity<LowEngine::ECS::Entity>("renamed") == nullptr);
+    REQUIRE(copy.FindEntities("b").size() == 1);
+
+    copied->SetName("c");
+    REQUIRE(original.FindEntity<LowEngine::ECS::Entity>("renamed") == a);
+    REQUIRE(original.FindEntity<LowEngine::ECS::Entity>("c") == nullptr);
+}
+
+// ─── Entity pooling ──────────────────────────────────────────────────────────
+
+namespace {
+    struct PooledComp : LowEngine::ECS::IComponent<PooledComp> {
+        int Value      = 0;
+        int ParkCount  = 0;
+        int ResetCount = 0;
+
+        explicit PooledComp(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        PooledComp(LowEngine::Memory::Memory* memory, PooledComp const* other)
+            : IComponent(memory, other), Value(other->Value) {}
+
+        void Initialize() override {}
+
+        void Park() { ParkCount++; }
+
+        void Reset() {
+            Value = 0;
+            ResetCount++;
+        }
+    };
+
+    LowEngine::ECS::Entity* SpawnBullet(LowEngine::Memory::Memory& mem, int& builds) {
+        return mem.SpawnEntity<LowEngine::ECS::Entity>("Bullet", "bullet",
+            [&builds](LowEngine::Memory::Memory& memory, LowEngine::ECS::Entity& entity) {
+                builds++;
+                memory.CreateComponent<PooledComp>(entity.Id);
+                memory.CreateComponent<TestComp>(entity.Id);
+            });
+    }
+}
+
+TEST_CASE("Memory - despawned entity is parked and reused by the next spawn", "[memory][pooling]") {
+    LowEngine::Memory::Memory mem;
+    mem.SetEntityPoolCapacity("Bullet", 4);
+    int builds = 0;
+
+    auto* bullet = SpawnBullet(mem, builds);
+    size_t bulletId = bullet->Id;
+    mem.GetComponent<PooledComp>(bulletId)->Value = 5;
+
+    mem.DespawnEntity(bulletId);
+    REQUIRE(mem.IsEntityParked(bulletId));
+    REQUIRE(mem.GetParkedEntityCount("Bullet") == 1);
+    REQUIRE_FALSE(bullet->IsActive());
+    REQUIRE_FALSE(mem.GetComponent<PooledComp>(bulletId)->IsActive());
+    REQUIRE(mem.GetComponent<PooledComp>(bulletId)->ParkCount == 1);
+    REQUIRE(mem.FindEntity<LowEngine::ECS::Entity>("bullet") == nullptr);
+
+    auto* reused = SpawnBullet(mem, builds);
+    REQUIRE(reused == bullet);
+    REQUIRE(reused->Id == bulletId);
+    REQUIRE(reused->IsActive());
+    REQUIRE(reused->GetName() == "bullet");
+    REQUIRE(builds == 1);
+    REQUIRE(mem.GetParkedEntityCount("Bullet") == 0);
+
+    auto* comp = mem.GetComponent<PooledComp>(bulletId);
+    REQUIRE(comp->IsActive());
+    REQUIRE(comp->ResetCount == 1);
+    REQUIRE(comp->Value == 0);
+    REQUIRE(mem.GetComponent<TestComp>(bulletId)->IsActive());
+}
+
+TEST_CASE("Memory - despawn destroys entities the pool has no room for", "[memory][pooling]") {
+    LowEngine::Memory::Memory mem;
+    mem.SetEntityPoolCapacity("Bullet", 1);
+    int builds = 0;
+
+    size_t first = SpawnBullet(mem, builds)->Id;
+    size_t second = SpawnBullet(mem, builds)->Id;
+    size_t plain = mem.CreateEntity<LowEngine::ECS::Entity>("plain")->Id;
+
+    mem.DespawnEntity(first);
+    mem.DespawnEntity(second);
+    mem.DespawnEntity(plain);
+    REQUIRE(mem.IsEntityParked(first));
+    REQUIRE_FALSE(mem.IsEntityValid(second));
+    REQUIRE_FALSE(mem.IsEntityValid(plain));
+
+    // lowering capacity destroys entities parked above it
+    mem.SetEntityPoolCapacity("Bullet", 0);
+    REQUIRE_FALSE(mem.IsEntityValid(first));
+    REQUIRE(mem.GetParkedEntityCount("Bullet") == 0);
+    REQUIRE(mem.GetEntityCount() == 0);
+}
+
+TEST_CASE("Memory - destroying a parked entity removes it from the pool", "[memory][pooling]") {
+    LowEngine::Memory::Memory mem;
+    mem.SetEntityPoolCapacity("Bullet", 2);
+    int builds = 0;
+
+    auto* bullet = SpawnBullet(mem, builds);
+    size_t bulletId = bullet->Id;
+    mem.DespawnEntity(bulletId);
+    mem.DestroyEntity(bullet);
+
+    REQUIRE(mem.GetParkedEntityCount("Bullet") == 0);
+    auto* fresh = SpawnBullet(mem, builds);
+    REQUIRE(fresh->Id != bulletId);
+    REQUIRE(builds == 2);
+}
+
+TEST_CASE("Memory - parked entity can't be renamed", "[memory][pooling]") {
+    LowEngine::Memory::Memory mem;
+    mem.SetEntityPoolCapacity("Bullet", 2);
+    int builds = 0;
+
+    auto* other = SpawnBullet(mem, builds);
+    auto* bullet = SpawnBullet(mem, builds);
+    size_t bulletId = bullet->Id;
+    mem.DespawnEntity(bulletId);
+
+    bullet->SetName("renamed");
+    REQUIRE_FALSE(mem.RenameEntity(bulletId, "renamed"));
+    REQUIRE(mem.FindEntity<LowEngine::ECS::Entity>("renamed") == nullptr);
+    REQUIRE(mem.FindEntities("bullet").size() == 1);
+    REQUIRE(mem.FindEntities("bullet")[0] == other->Id);
+
+    auto* reused = SpawnBullet(mem, builds);
+    REQUIRE(reused->Id == bulletId);
+    REQUIRE(reused->GetName() == "bullet");
+    REQUIRE(mem.FindEntities("bullet").size() == 2);
+}
+
+TEST_CASE("Memory - parked entities are not serialized", "[memory][pooling]") {
+    LowEngine::Memory::Memory mem;
+    mem.SetEntityPoolCapacity("Bullet", 2);
+    int builds = 0;
+
+    size_t parked = SpawnBullet(mem, builds)->Id;
+    size_t live = SpawnBullet(mem, builds)->Id;
+    mem.DespawnEntity(parked);
+
+    std::vector<size_t> visited;
+    mem.ForEachEntity([&visited](LowEngine::ECS::Entity& e) { visited.push_back(e.Id); });
+    REQUIRE(visited == std::vector<size_t>{live});
+
+    auto entities = mem.SerializeAllEntitiesToJSON();
+    auto components = mem.SerializeAllComponentsToJSON();
+    REQUIRE(entities.size() == 1);
+    for (const auto& pool : components) {
+        REQUIRE(pool.size() == 1);
+        REQUIRE(pool[0]["EntityId"].get<size_t>() == live);
+    }
+}
+
+TEST_CASE("Memory - steady-state spawning allocates nothing", "[memory][pooling]") {
+    LowEngine::Memory::Memory mem;
+    mem.SetEntityPoolCapacity("Bullet", 16);
+    int builds = 0;
+
+    // one bullet stays alive, so its name stays interned
+    SpawnBullet(mem, builds);
+    std::vector<size_t> ids;
+    for (int i = 0; i < 16; ++i) {
+        ids.push_back(SpawnBullet(mem, builds)->Id);
+    }
+    for (size_t id : ids) {
+        mem.DespawnEntity(id);
+    }
+
+    size_t allocations = mem.GetArenaStats().TotalAllocations;
+    for (int frame = 0; frame < 10; ++frame) {
+        ids.clear();
+        for (int i = 0; i < 16; ++i) {
+            ids.push_back(SpawnBullet(mem, builds)->Id);
+        }
+        for (size_t id : ids) {
+            mem.DespawnEntity(id);
+        }
+    }
+    REQUIRE(mem.GetArenaStats().TotalAllocations == allocations);
+    REQUIRE(builds == 17);
+}
+
+TEST_CASE("Memory - respawning after every named entity is despawned allocates nothing", "[memory][pooling]") {
+    LowEngine::Memory::Memory mem;
+    mem.SetEntityPoolCapacity("Bullet", 16);
+    int builds = 0;
+
+    std::vector<size_t> ids;
+    for (int i = 0; i < 16; ++i) {
+        ids.push_back(SpawnBullet(mem, builds)->Id);
+    }
+    for (size_t id : ids) {
+        mem.DespawnEntity(id);
+    }
+
+    // parked bullets keep the name, but aren't found by it
+    REQUIRE(mem.GetEntityNameCount() == 1);
+    REQUIRE(mem.FindEntity<LowEngine::ECS::Entity>("bullet") == nullptr);
+    REQUIRE(mem.FindEntities("bullet").empty());
+
+    size_t allocations = mem.GetArenaStats().TotalAllocations;
+    for (int frame = 0; frame < 10; ++frame) {
+        ids.clear();
+        for (int i = 0; i < 16; ++i) {
+            ids.push_back(SpawnBullet(mem, builds)->Id);
+        }
+        REQUIRE(mem.FindEntities("bullet").size() == 16);
+        for (size_t id : ids) {
+            mem.DespawnEntity(id);
+        }
+    }
+    REQUIRE(mem.GetArenaStats().TotalAllocations == allocations);
+    REQUIRE(builds == 16);
+}
+
+TEST_CASE("Memory - parked entity's name is released when it's no longer used", "[memory][pooling]") {
+    LowEngine::Memory::Memory mem;
+    mem.SetEntityPoolCapacity("Bullet", 2);
+    int builds = 0;
+
+    size_t bulletId = SpawnBullet(mem, builds)->Id;
+    mem.DespawnEntity(bulletId);
+
+    // spawning with another name releases the kept one
+    auto* renamed = mem.SpawnEntity<LowEngine::ECS::Entity>("Bullet", "shell",
+        [&builds](LowEngine::Memory::Memory&, LowEngine::ECS::Entity&) { builds++; });
+    REQUIRE(renamed->Id == bulletId);
+    REQUIRE(renamed->GetName() == "shell");
+    REQUIRE(mem.GetEntityNameCount() == 1);
+    REQUIRE(mem.FindEntities("bullet").empty());
+
+    // destroying the parked entity releases its name
+    mem.DespawnEntity(bulletId);
+    mem.SetEntityPoolCapacity("Bullet", 0);
+    REQUIRE(mem.GetEntityNameCount() == 0);
+    REQUIRE(mem.GetEntityCount() == 0);
+}
+
+TEST_CASE("Memory - lowering pool capacity keeps the remaining entities parked", "[memory][pooling]") {
+    LowEngine::Memory::Memory mem;
+    mem.SetEntityPoolCapacity("Bullet", 64);
+    int builds = 0;
+
+    std::vector<size_t> ids;
+    for (int i = 0; i < 64; ++i) {
+        ids.push_back(SpawnBullet(mem, builds)->Id);
+    }
+    for (size_t id : ids) {
+        mem.DespawnEntity(id);
+    }
+
+    // destroying parked entities out of order swaps the last one into their position
+    mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(ids[3]));
+    mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(ids[40]));
+    mem.SetEntityPoolCapacity("Bullet", 8);
+    REQUIRE(mem.GetParkedEntityCount("Bullet") == 8);
+    REQUIRE(mem.GetEntityCount() == 8);
+
+    std::vector<size_t> respawned;
+    for (int i = 0; i < 8; ++i) {
+        respawned.push_back(SpawnBullet(mem, builds)->Id);
+    }
+    REQUIRE(mem.GetParkedEntityCount("Bullet") == 0);
+    REQUIRE(builds == 64);
+    for (size_t id : respawned) {
+        REQUIRE(std::find(ids.begin(), ids.end(), id) != ids.end());
+        REQUIRE(mem.GetEntityName(id) == "bullet");
+    }
+}
+
+TEST_CASE("Memory - copy keeps parked entities in its pool", "[memory][pooling]") {
+    LowEngine::Memory::Memory original;
+    original.SetEntityPoolCapacity("Bullet", 2);
+    int builds = 0;
+
+    size_t bulletId = SpawnBullet(original, builds)->Id;
+    original.DespawnEntity(bulletId);
+
+    LowEngine::Memory::Memory copy(original);
+    REQUIRE(copy.IsEntityParked(bulletId));
+    REQUIRE(SpawnBullet(copy, builds)->Id == bulletId);
+    REQUIRE(builds == 1);
+    REQUIRE(original.IsEntityParked(bulletId));
+}
+
+// ─── Binary scene files ───────────────────────────────────────────────────────
+
+namespace {
+    using LowEngine::SceneFileFormat;
+
+    void WriteBinaryScene(LowEngine::Memory::Memory& mem, std::vector<std::byte>& out) {
+        LowEngine::SceneFileWriter file(out);
+        mem.SerializeAllEntitiesToBinary(file.BeginBlock(SceneFileFormat::BlockType::Entities));
+        file.EndBlock();
+        for (LowEngine::Memory::ComponentTypeId typeId : mem.GetSerializationOrder()) {
+            mem.SerializeComponentsToBinary(typeId, file.BeginBlock(SceneFileFormat::BlockType::Components));
+            file.EndBlock();
+        }
+        file.Finish();
+    }
+
+    bool ReadBinaryScene(LowEngine::Memory::Memory& mem, std::span<const std::byte> data) {
+        LowEngine::SceneFileReader file;
+        if (!file.Open(data)) return false;
+        for (const auto& block : file.GetBlocks()) {
+            if (block.Type != SceneFileFormat::BlockType::Entities
+                && block.Type != SceneFileFormat::BlockType::Components) continue;
+            LowEngine::Utils::BinaryReader in(block.Data);
+            bool read = block.Type == SceneFileFormat::BlockType::Entities
+                            ? mem.DeserializeAllEntitiesFromBinary(in)
+                            : mem.DeserializeComponentsFromBinary(in);
+            if (!read) return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("Memory - components round-trip through binary scene file", "[memory][binary]") {
+    using LowEngine::ECS::TransformComponent;
+
+    LowEngine::Memory::Memory original;
+    auto* a = original.CreateEntity<LowEngine::ECS::Entity>("a");
+    auto* gone = original.CreateEntity<LowEngine::ECS::Entity>("gone");
+    auto* b = original.CreateEntity<LowEngine::ECS::Entity>("b");
+    auto* c = original.CreateEntity<LowEngine::ECS::Entity>("c");
+    original.DestroyEntity(gone);
+    c->SetActive(false);
+
+    original.CreateComponent<TestComp>(a->Id)->Value = 3;
+    original.CreateComponent<TestComp>(b->Id)->Value = 4;
+    original.CreateComponent<DependentComp>(b->Id);
+    original.SetComponentActive<TestComp>(a->Id, false);
+    original.CreateComponent<TransformComponent>(a->Id)->SetPosition({1.0f, 2.0f});
+    auto* transform = original.CreateComponent<TransformComponent>(c->Id);
+    transform->SetRotation(sf::radians(0.5f));
+    transform->SetScale({2.0f, 3.0f});
+    original.SetComponentActive<TransformComponent>(c->Id, false);
+
+    std::vector<std::byte> data;
+    WriteBinaryScene(original, data);
+    REQUIRE(LowEngine::SceneFileReader::IsSceneFile(data));
+
+    LowEngine::Memory::Memory loaded;
+    loaded.RegisterComponentType<TestComp>();
+    loaded.RegisterComponentType<DependentComp>();
+    loaded.RegisterComponentType<TransformComponent>();
+    REQUIRE(ReadBinaryScene(loaded, data));
+
+    REQUIRE(loaded.GetEntityCount() == 3);
+    REQUIRE(loaded.GetEntity<LowEngine::ECS::Entity>(b->Id)->GetName() == "b");
+    REQUIRE_FALSE(loaded.GetEntity<LowEngine::ECS::Entity>(c->Id)->IsActive());
+    REQUIRE_FALSE(loaded.IsEntityValid(gone->Id));
+
+    REQUIRE(loaded.GetComponent<TestComp>(a->Id)->Value == 3);
+    REQUIRE(loaded.GetComponent<TestComp>(b->Id)->Value == 4);
+    REQUIRE_FALSE(loaded.GetComponent<TestComp>(a->Id)->IsActive());
+    REQUIRE(loaded.GetComponent<DependentComp>(b->Id) != nullptr);
+
+    REQUIRE(loaded.GetComponent<TransformComponent>(a->Id)->GetPosition() == sf::Vector2f{1.0f, 2.0f});
+    auto* loadedTransform = loaded.GetComponent<TransformComponent>(c->Id);
+    REQUIRE(loadedTransform->GetRotation().asRadians() == 0.5f);
+    REQUIRE(loadedTransform->GetScale() == sf::Vector2f{2.0f, 3.0f});
+    REQUIRE_FALSE(loadedTransform->IsActive());
+}
+
+TEST_CASE("Memory - binary scene file loads from mapped file", "[memory][binary]") {
+    LowEngine::Memory::Memory original;
+    for (int i = 0; i < 100; ++i) {
+        auto* e = original.CreateEntity<LowEngine::ECS::Entity>("e" + std::to_string(i));
+        original.CreateComponent<LowEngine::ECS::TransformComponent>(e->Id)->SetPosition({float(i), 0.0f});
+    }
+
+    std::vector<std::byte> data;
+    WriteBinaryScene(original, data);
+    auto path = std::filesystem::temp_directory_path() / "lowengine_test_scene.lowscene";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    }
+
+    LowEngine::Utils::MappedFile mapped;
+    REQUIRE(mapped.Open(path));
+    REQUIRE(mapped.GetData().size() == data.size());
+
+    LowEngine::Memory::Memory loaded;
+    loaded.RegisterComponentType<LowEngine::ECS::TransformComponent>();
+    REQUIRE(ReadBinaryScene(loaded, mapped.GetData()));
+    auto stats = loaded.GetPoolStats();
+    REQUIRE(stats.size() == 1);
+    REQUIRE(stats[0].Count == 100);
+    REQUIRE(loaded.GetComponent<LowEngine::ECS::TransformComponent>(
+        loaded.FindEntity<LowEngine::ECS::Entity>("e42")->Id)->GetPosition().x == 42.0f);
+
+    mapped.Close();
+    std::filesystem::remove(path);
+    REQUIRE_FALSE(mapped.Open(path));
+}
+
+TEST_CASE("Memory - invalid binary scene files are rejected", "[memory][binary]") {
+    LowEngine::Memory::Memory original;
+    original.CreateComponent<TestComp>(original.CreateEntity<LowEngine::ECS::Entity>("e")->Id);
+    std::vector<std::byte> data;
+    WriteBinaryScene(original, data);
+
+    LowEngine::SceneFileReader file;
+    REQUIRE(file.Open(data));
+    REQUIRE(file.GetBlocks().size() == 2);
+
+    SECTION("JSON is not a scene file") {
+        std::string json = "{\"name\": \"scene\"}";
+        auto bytes = std::as_bytes(std::span(json));
+        REQUIRE_FALSE(LowEngine::SceneFileReader::IsSceneFile(bytes));
+        REQUIRE_FALSE(file.Open(bytes));
+    }
+
+    SECTION("other version") {
+        uint32_t version = SceneFileFormat::VERSION + 1;
+        std::memcpy(data.data() + offsetof(SceneFileFormat::Header, Version), &version, sizeof(version));
+        REQUIRE_FALSE(file.Open(data));
+    }
+
+    SECTION("truncated file") {
+        data.resize(data.size() - 1);
+        REQUIRE_FALSE(file.Open(data));
+    }
+
+    SECTION("truncated block") {
+        auto block = file.GetBlocks()[0].Data;
+        LowEngine::Utils::BinaryReader in(block.first(block.size() - 1));
+        LowEngine::Memory::Memory loaded;
+        REQUIRE_FALSE(loaded.DeserializeAllEntitiesFromBinary(in));
+    }
+
+    SECTION("corrupted entity id") {
+        std::vector<std::byte> block;
+        LowEngine::Utils::BinaryWriter out(block);
+        out.Write(uint64_t{1});
+        out.Write(uint64_t{0x7FFFFFFF});
+        out.Write(uint8_t{1});
+        out.WriteString("e");
+
+        // rejected before any slot up to the index is allocated
+        LowEngine::Memory::Memory loaded;
+        LowEngine::Utils::BinaryReader in(block);
+        REQUIRE_FALSE(loaded.DeserializeAllEntitiesFromBinary(in));
+        REQUIRE_FALSE(loaded.DeserializeEntityFromJSON<LowEngine::ECS::Entity>({{"id", 0x7FFFFFFF}, {"name", "e"}}));
+        REQUIRE(loaded.GetEntityCount() == 0);
+        REQUIRE(LowEngine::ECS::GetEntityIndex(loaded.CreateEntity<LowEngine::ECS::Entity>("first")->Id) == 0);
+    }
+}
+
+TEST_CASE("Memory - unregistered component types are skipped on binary load", "[memory][binary]") {
+    LowEngine::Memory::Memory original;
+    auto* e = original.CreateEntity<LowEngine::ECS::Entity>("e");
+    original.CreateComponent<TestComp>(e->Id);
+    std::vector<std::byte> data;
+    WriteBinaryScene(original, data);
+
+    LowEngine::Memory::Memory loaded;
+    REQUIRE(ReadBinaryScene(loaded, data));
+    REQUIRE(loaded.IsEntityValid(e->Id));
+    REQUIRE(loaded.GetComponent<TestComp>(e->Id) == nullptr);
+}
+
+TEST_CASE("Memory - scene file snapshot encodes the same file later", "[memory][binary]") {
+    using LowEngine::ECS::TransformComponent;
+
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(50, "e");
+    mem.CreateComponents<TransformComponent>(ids);
+    mem.CreateComponents<TestComp>(ids);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        mem.GetComponent<TestComp>(ids[i])->Value = static_cast<int>(i);
+    }
+
+    std::vector<std::byte> direct;
+    WriteBinaryScene(mem, direct);
+
+    LowEngine::SceneFileSnapshot snapshot;
+    snapshot.AddMessagePackBlock(SceneFileFormat::BlockType::Scene, {{"name", "scene"}});
+    mem.SerializeAllEntitiesToBinary(snapshot.BeginBlock(SceneFileFormat::BlockType::Entities));
+    snapshot.EndBlock();
+    for (LowEngine::Memory::ComponentTypeId typeId : mem.GetSerializationOrder()) {
+        mem.SerializeComponentsToBinary(typeId, snapshot.BeginBlock(SceneFileFormat::BlockType::Components));
+        snapshot.EndBlock();
+    }
+
+    // JSON of TestComp is only encoded by Encode, but was taken with the snapshot
+    for (size_t id : ids) {
+        mem.GetComponent<TestComp>(id)->Value = -1;
+    }
+    std::vector<std::byte> encoded;
+    snapshot.Encode(encoded);
+
+    LowEngine::SceneFileReader file;
+    REQUIRE(file.Open(encoded));
+    REQUIRE(file.GetBlocks().front().Type == SceneFileFormat::BlockType::Scene);
+    auto bytes = reinterpret_cast<const uint8_t*>(file.GetBlocks().front().Data.data());
+    auto settings = nlohmann::ordered_json::from_msgpack(bytes, bytes + file.GetBlocks().front().Data.size());
+    REQUIRE(settings["name"] == "scene");
+
+    LowEngine::Memory::Memory loaded;
+    loaded.RegisterComponentType<TestComp>();
+    loaded.RegisterComponentType<TransformComponent>();
+    REQUIRE(ReadBinaryScene(loaded, encoded));
+    for (size_t i = 0; i < ids.size(); ++i) {
+        REQUIRE(loaded.GetComponent<TestComp>(ids[i])->Value == static_cast<int>(i));
+    }
+    // apart from the settings block, the file is the one written directly
+    std::vector<std::byte> reencoded;
+    WriteBinaryScene(loaded, reencoded);
+    REQUIRE(reencoded == direct);
+}
+
+// ─── Scene changes ────────────────────────────────────────────────────────────
+
+namespace {
+    void WriteSceneChanges(LowEngine::Memory::Memory& mem, std::vector<std::byte>& out) {
+        LowEngine::SceneFileWriter file(out);
+        mem.SerializeEntityChangesToBinary(file.BeginBlock(SceneFileFormat::BlockType::EntityChanges));
+        file.EndBlock();
+        for (LowEngine::Memory::ComponentTypeId typeId : mem.GetSerializationOrder()) {
+            mem.SerializeComponentChangesToBinary(typeId, file.BeginBlock(SceneFileFormat::BlockType::Components));
+            file.EndBlock();
+        }
+        file.Finish();
+    }
+
+    bool ReadSceneChanges(LowEngine::Memory::Memory& mem, std::span<const std::byte> data) {
+        LowEngine::SceneFileReader file;
+        if (!file.Open(data)) return false;
+        for (const auto& block : file.GetBlocks()) {
+            LowEngine::Utils::BinaryReader in(block.Data);
+            bool read = block.Type == SceneFileFormat::BlockType::EntityChanges
+                            ? mem.DeserializeEntityChangesFromBinary(in)
+                            : mem.DeserializeComponentsFromBinary(in);
+            if (!read) return false;
+        }
+        return true;
+    }
+
+    void LoadBinaryScene(LowEngine::Memory::Memory& loaded, std::span<const std::byte> data) {
+        loaded.RegisterComponentType<TestComp>();
+        loaded.RegisterComponentType<LowEngine::ECS::TransformComponent>();
+        REQUIRE(ReadBinaryScene(loaded, data));
+    }
+}
+
+TEST_CASE("Memory - changes applied on top of the saved scene restore it", "[memory][delta]") {
+    using LowEngine::ECS::TransformComponent;
+
+    LowEngine::Memory::Memory original;
+    std::vector<size_t> ids;
+    for (int i = 0; i < 10; ++i) {
+        auto* e = original.CreateEntity<LowEngine::ECS::Entity>("e" + std::to_string(i));
+        original.CreateComponent<TestComp>(e->Id)->Value = i;
+        original.CreateComponent<TransformComponent>(e->Id)->SetPosition({float(i), 0.0f});
+        ids.push_back(e->Id);
+    }
+
+    std::vector<std::byte> base;
+    WriteBinaryScene(original, base);
+    original.ClearChanges();
+
+    std::vector<std::byte> empty;
+    WriteSceneChanges(original, empty);
+
+    original.DestroyEntity(original.GetEntity<LowEngine::ECS::Entity>(ids[1]));
+    original.RenameEntity(ids[2], "renamed");
+    original.DestroyComponent<TestComp>(ids[3]);
+    original.SetComponentActive<TestComp>(ids[4], false);
+    original.GetComponent<TransformComponent>(ids[5])->SetPosition({50.0f, 5.0f});
+    original.GetComponent<TestComp>(ids[6])->Value = 60;
+    original.MarkEntityChanged(ids[6]);
+    auto* added = original.CreateEntity<LowEngine::ECS::Entity>("added");
+    original.CreateComponent<TestComp>(added->Id)->Value = 100;
+
+    std::vector<std::byte> changes;
+    WriteSceneChanges(original, changes);
+    REQUIRE(changes.size() > empty.size());
+    REQUIRE(changes.size() < base.size());
+
+    LowEngine::Memory::Memory loaded;
+    LoadBinaryScene(loaded, base);
+    REQUIRE(ReadSceneChanges(loaded, changes));
+
+    REQUIRE(loaded.GetEntityCount() == original.GetEntityCount());
+    REQUIRE_FALSE(loaded.IsEntityValid(ids[1]));
+    REQUIRE(loaded.GetEntity<LowEngine::ECS::Entity>(ids[2])->GetName() == "renamed");
+    REQUIRE(loaded.FindEntity<LowEngine::ECS::Entity>("e2") == nullptr);
+    REQUIRE(loaded.GetComponent<TestComp>(ids[3]) == nullptr);
+    REQUIRE(loaded.GetComponent<TransformComponent>(ids[3]) != nullptr);
+    REQUIRE_FALSE(loaded.GetComponent<TestComp>(ids[4])->IsActive());
+    REQUIRE(loaded.GetComponent<TransformComponent>(ids[5])->GetPosition() == sf::Vector2f{50.0f, 5.0f});
+    REQUIRE(loaded.GetComponent<TestComp>(ids[6])->Value == 60);
+    REQUIRE(loaded.GetEntity<LowEngine::ECS::Entity>(added->Id)->GetName() == "added");
+    REQUIRE(loaded.GetComponent<TestComp>(added->Id)->Value == 100);
+    REQUIRE(loaded.GetComponent<TestComp>(ids[9])->Value == 9);
+}
+
+TEST_CASE("Memory - unchanged entities are not saved with changes", "[memory][delta]") {
+    LowEngine::Memory::Memory original;
+    auto* a = original.CreateEntity<LowEngine::ECS::Entity>("a");
+    auto* b = original.CreateEntity<LowEngine::ECS::Entity>("b");
+    original.CreateComponent<TestComp>(a->Id)->Value = 1;
+    original.CreateComponent<TestComp>(b->Id)->Value = 2;
+
+    std::vector<std::byte> base;
+    WriteBinaryScene(original, base);
+    original.ClearChanges();
+
+    // not marked, so the edit of the field is not part of the changes
+    original.GetComponent<TestComp>(a->Id)->Value = 10;
+    original.GetComponent<TestComp>(b->Id)->Value = 20;
+    original.MarkEntityChanged(b->Id);
+
+    std::vector<std::byte> changes;
+    WriteSceneChanges(original, changes);
+    original.ClearChanges();
+
+    LowEngine::Memory::Memory loaded;
+    LoadBinaryScene(loaded, base);
+    REQUIRE(ReadSceneChanges(loaded, changes));
+    REQUIRE(loaded.GetComponent<TestComp>(a->Id)->Value == 1);
+    REQUIRE(loaded.GetComponent<TestComp>(b->Id)->Value == 20);
+
+    std::vector<std::byte> cleared;
+    WriteSceneChanges(original, cleared);
+    LowEngine::SceneFileReader file;
+    REQUIRE(file.Open(cleared));
+    LowEngine::Utils::BinaryReader in(file.GetBlocks()[0].Data);
+    uint64_t removed = 1;
+    uint64_t changed = 1;
+    REQUIRE(in.Read(removed));
+    REQUIRE(in.Read(changed));
+    REQUIRE(removed == 0);
+    REQUIRE(changed == 0);
+}
+
+TEST_CASE("Memory - changes replace entity reusing a destroyed slot", "[memory][delta]") {
+    LowEngine::Memory::Memory original;
+    auto* old = original.CreateEntity<LowEngine::ECS::Entity>("old");
+    original.CreateComponent<TestComp>(old->Id)->Value = 1;
+    size_t oldId = old->Id;
+
+    std::vector<std::byte> base;
+    WriteBinaryScene(original, base);
+    original.ClearChanges();
+
+    original.DestroyEntity(old);
+    auto* reused = original.CreateEntity<LowEngine::ECS::Entity>("new");
+    REQUIRE(LowEngine::ECS::GetEntityIndex(reused->Id) == LowEngine::ECS::GetEntityIndex(oldId));
+    REQUIRE(reused->Id != oldId);
+
+    std::vector<std::byte> changes;
+    WriteSceneChanges(original, changes);
+
+    LowEngine::Memory::Memory loaded;
+    LoadBinaryScene(loaded, base);
+    REQUIRE(ReadSceneChanges(loaded, changes));
+    REQUIRE_FALSE(loaded.IsEntityValid(oldId));
+    REQUIRE(loaded.GetEntity<LowEngine::ECS::Entity>(reused->Id)->GetName() == "new");
+    REQUIRE(loaded.GetComponent<TestComp>(reused->Id) == nullptr);
+    REQUIRE(loaded.GetEntityCount() == 1);
+}
+
+TEST_CASE("Memory - despawned entities are removed by changes", "[memory][delta]") {
+    LowEngine::Memory::Memory original;
+    original.SetEntityPoolCapacity("Bullet", 4);
+    int builds = 0;
+    auto* bullet = SpawnBullet(original, builds);
+    size_t bulletId = bullet->Id;
+
+    std::vector<std::byte> base;
+    WriteBinaryScene(original, base);
+    original.ClearChanges();
+
+    original.DespawnEntity(bulletId);
+    std::vector<std::byte> changes;
+    WriteSceneChanges(original, changes);
+
+    LowEngine::Memory::Memory loaded;
+    LoadBinaryScene(loaded, base);
+    REQUIRE(loaded.IsEntityValid(bulletId));
+    REQUIRE(ReadSceneChanges(loaded, changes));
+    REQUIRE_FALSE(loaded.IsEntityValid(bulletId));
+    REQUIRE(loaded.GetEntityCount() == 0);
+}
+
+TEST_CASE("Memory - changed Active flag is saved with changes", "[memory][delta]") {
+    using LowEngine::ECS::TransformComponent;
+
+    LowEngine::Memory::Memory original;
+    auto* a = original.CreateEntity<LowEngine::ECS::Entity>("a");
+    original.CreateComponent<TransformComponent>(a->Id);
+    auto* b = original.CreateEntity<LowEngine::ECS::Entity>("b");
+    original.CreateComponent<TransformComponent>(b->Id);
+
+    std::vector<std::byte> base;
+    WriteBinaryScene(original, base);
+    original.ClearChanges();
+
+    a->SetActive(false);
+    REQUIRE(original.CanSerializeChanges());
+    std::vector<std::byte> changes;
+    WriteSceneChanges(original, changes);
+
+    LowEngine::Memory::Memory loaded;
+    LoadBinaryScene(loaded, base);
+    REQUIRE(ReadSceneChanges(loaded, changes));
+    REQUIRE_FALSE(loaded.GetEntity<LowEngine::ECS::Entity>(a->Id)->IsActive());
+    REQUIRE(loaded.GetEntity<LowEngine::ECS::Entity>(b->Id)->IsActive());
+    REQUIRE(loaded.GetComponent<TransformComponent>(a->Id) != nullptr);
+}
+
+TEST_CASE("Memory - changes can't be serialized while a component doesn't track them", "[memory][delta]") {
+    using LowEngine::ECS::TransformComponent;
+
+    LowEngine::Memory::Memory mem;
+    auto* e = mem.CreateEntity<LowEngine::ECS::Entity>("e");
+    mem.CreateComponent<TransformComponent>(e->Id);
+    REQUIRE(mem.CanSerializeChanges());
+
+    // fields of TestComp are written directly, so the edit below can't be seen
+    mem.CreateComponent<TestComp>(e->Id);
+    mem.ClearChanges();
+    mem.GetComponent<TestComp>(e->Id)->Value = 5;
+    REQUIRE_FALSE(mem.CanSerializeChanges());
+
+    mem.DestroyComponent<TestComp>(e->Id);
+    REQUIRE(mem.CanSerializeChanges());
+}
+
+TEST_CASE("Memory - setters of tracked components mark only their Entity", "[memory][delta]") {
+    using LowEngine::ECS::TransformComponent;
+
+    LowEngine::Memory::Memory mem;
+    std::vector<size_t> ids = mem.CreateEntities(10);
+    mem.CreateComponents<TransformComponent>(ids);
+    mem.ClearChanges();
+    REQUIRE(mem.GetChangedEntityIds().empty());
+
+    mem.GetComponent<TransformComponent>(ids[3])->SetPosition({1.0f, 2.0f});
+    mem.GetComponent<TransformComponent>(ids[3])->SetRotation(sf::degrees(90.0f));
+    mem.GetEntity<LowEngine::ECS::Entity>(ids[7])->SetActive(false);
+    // setting the same value again isn't a change
+    mem.GetComponent<TransformComponent>(ids[5])->SetPosition({0.0f, 0.0f});
+    mem.GetEntity<LowEngine::ECS::Entity>(ids[8])->SetActive(true);
+
+    std::vector<size_t> changed = mem.GetChangedEntityIds();
+    std::ranges::sort(changed);
+    REQUIRE(changed == std::vector<size_t>{ids[3], ids[7]});
+    REQUIRE(mem.CanSerializeChanges());
+}
+
+TEST_CASE("Memory - creating entities marks only the new ones", "[memory][delta]") {
+    LowEngine::Memory::Memory mem;
+    size_t first = mem.CreateEntity<LowEngine::ECS::Entity>("first")->Id;
+    size_t freed = mem.CreateEntity<LowEngine::ECS::Entity>("freed")->Id;
+    mem.DestroyEntity(mem.GetEntity<LowEngine::ECS::Entity>(freed));
+    mem.ClearChanges();
+
+    // one Entity reuses the freed slot, the rest are appended
+    std::vector<size_t> ids = mem.CreateEntities(3);
+    size_t single = mem.CreateEntity<LowEngine::ECS::Entity>("single")->Id;
+    ids.push_back(single);
+
+    std::vector<size_t> changed = mem.GetChangedEntityIds();
+    std::ranges::sort(changed);
+    std::ranges::sort(ids);
+    REQUIRE(changed == ids);
+    REQUIRE(std::ranges::find(changed, first) == changed.end());
+}
+
+// ─── Scene journal ────────────────────────────────────────────────────────────
+
+TEST_CASE("Scene journal - records are read back in order", "[memory][delta]") {
+    std::vector<std::byte> journal;
+    LowEngine::SceneJournalWriter::WriteHeader(42, journal);
+    std::string first = "first";
+    std::string second = "second record";
+    LowEngine::SceneJournalWriter::WriteRecord(std::as_bytes(std::span(first)), journal);
+    LowEngine::SceneJournalWriter::WriteRecord(std::as_bytes(std::span(second)), journal);
+
+    LowEngine::SceneJournalReader reader;
+    REQUIRE(reader.Open(journal));
+    REQUIRE(reader.GetSaveId() == 42);
+    REQUIRE_FALSE(reader.IsTruncated());
+    REQUIRE(reader.GetRecords().size() == 2);
+    auto record = reader.GetRecords()[1];
+    REQUIRE(std::string(reinterpret_cast<const char*>(record.data()), record.size()) == second);
+
+    SECTION("torn record is dropped") {
+        journal.resize(journal.size() - 3);
+        REQUIRE(reader.Open(journal));
+        REQUIRE(reader.IsTruncated());
+        REQUIRE(reader.GetRecords().size() == 1);
+    }
+
+    SECTION("corrupted record is dropped") {
+        journal.back() = std::byte{'!'};
+        REQUIRE(reader.Open(journal));
+        REQUIRE(reader.IsTruncated());
+        REQUIRE(reader.GetRecords().size() == 1);
+    }
+
+    SECTION("scene file is not a journal") {
+        LowEngine::Memory::Memory mem;
+        std::vector<std::byte> scene;
+        WriteBinaryScene(mem, scene);
+        REQUIRE_FALSE(reader.Open(scene));
+    }
+}
+
+TEST_CASE("Scene journal - save id is read from scene file", "[memory][delta]") {
+    std::vector<std::byte> data;
+    {
+        LowEngine::SceneFileWriter file(data);
+        file.BeginBlock(SceneFileFormat::BlockType::SaveInfo).Write(uint64_t{7});
+        file.EndBlock();
+        file.Finish();
+    }
+    REQUIRE(LowEngine::SceneJournalReader::ReadSaveId(data) == 7);
+
+    LowEngine::Memory::Memory mem;
+    std::vector<std::byte> withoutId;
+    WriteBinaryScene(mem, withoutId);
+    REQUIRE(LowEngine::SceneJournalReader::ReadSaveId(withoutId) == 0);
+}
+
+TEST_CASE("Scene journal - failed scene write keeps the previous journal", "[memory][delta]") {
+    using LowEngine::Threading::BackgroundWriter;
+
+    auto directory = std::filesystem::temp_directory_path() / "lowengine_test_scene_journal";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    auto scenePath = directory / "level.lowscene";
+    auto journalPath = directory / "level.lowscene.journal";
+
+    LowEngine::Memory::Memory original;
+    auto* e = original.CreateEntity<LowEngine::ECS::Entity>("e");
+    original.CreateComponent<TestComp>(e->Id)->Value = 1;
+
+    std::vector<std::byte> scene;
+    {
+        LowEngine::SceneFileWriter file(scene);
+        file.BeginBlock(SceneFileFormat::BlockType::SaveInfo).Write(uint64_t{1});
+        file.EndBlock();
+        original.SerializeAllEntitiesToBinary(file.BeginBlock(SceneFileFormat::BlockType::Entities));
+        file.EndBlock();
+        for (LowEngine::Memory::ComponentTypeId typeId : original.GetSerializationOrder()) {
+            original.SerializeComponentsToBinary(typeId, file.BeginBlock(SceneFileFormat::BlockType::Components));
+            file.EndBlock();
+        }
+        file.Finish();
+    }
+    original.ClearChanges();
+    original.GetComponent<TestComp>(e->Id)->Value = 2;
+    original.MarkEntityChanged(e->Id);
+    std::vector<std::byte> changes;
+    WriteSceneChanges(original, changes);
+    std::vector<std::byte> journal;
+    LowEngine::SceneJournalWriter::WriteHeader(1, journal);
+    LowEngine::SceneJournalWriter::WriteRecord(changes, journal);
+
+    std::string error;
+    REQUIRE(BackgroundWriter::WriteFileAtomically(scenePath, scene, error));
+    REQUIRE(BackgroundWriter::WriteFileAtomically(journalPath, journal, error));
+
+    // next full save fails to write the scene file, its new journal must not replace the previous one
+    std::vector<bool> results;
+    {
+        BackgroundWriter writer;
+        std::vector<BackgroundWriter::File> files;
+        files.push_back({scenePath, [](std::vector<std::byte>&) { return false; }});
+        files.push_back({journalPath, [](std::vector<std::byte>& content) {
+            LowEngine::SceneJournalWriter::WriteHeader(2, content);
+            return true;
+        }});
+        writer.WriteAll(std::move(files), [&results](bool success) { results.push_back(success); });
+        writer.Flush();
+    }
+    REQUIRE(results == std::vector<bool>{false});
+
+    LowEngine::Utils::MappedFile sceneFile;
+    LowEngine::Utils::MappedFile journalFile;
+    REQUIRE(sceneFile.Open(scenePath));
+    REQUIRE(journalFile.Open(journalPath));
+    LowEngine::SceneJournalReader reader;
+    REQUIRE(reader.Open(journalFile.GetData()));
+    REQUIRE(reader.GetSaveId() == LowEngine::SceneJournalReader::ReadSaveId(sceneFile.GetData()));
+    REQUIRE(reader.GetRecords().size() == 1);
+
+    LowEngine::Memory::Memory loaded;
+    LoadBinaryScene(loaded, sceneFile.GetData());
+    REQUIRE(ReadSceneChanges(loaded, reader.GetRecords()[0]));
+    REQUIRE(loaded.GetComponent<TestComp>(e->Id)->Value == 2);
+
+    sceneFile.Close();
+    journalFile.Close();
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,463 @@
+#include <catch2/catch_test_macros.hpp>
+#include <spdlog/sinks/null_sink.h>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log/Log.h"
+#include "threading/BackgroundWriter.h"
+#include "threading/WorkerPool.h"
+#include "memory/Memory.h"
+#include "memory/UpdateSchedule.h"
+#include "ecs/IComponent.h"
+#include "ecs/Components/TransformComponent.h"
+
+using LowEngine::Threading::BackgroundWriter;
+using LowEngine::Threading::WorkerPool;
+using LowEngine::Memory::UpdateSchedule;
+
+namespace {
+    struct LogGuard {
+        LogGuard() {
+            if (!LowEngine::_log) {
+                LowEngine::_log = std::make_shared<spdlog::logger>(
+                    "test", std::make_shared<spdlog::sinks::null_sink_mt>());
+            }
+        }
+    };
+    static LogGuard logGuard;
+}
+
+namespace {
+    template <int Tag>
+    struct ParallelUpdateComponent : LowEngine::ECS::IComponent<ParallelUpdateComponent<Tag>> {
+        static constexpr bool WorkerThreadSafe = true;
+        static constexpr bool ParallelSafeUpdate = true;
+
+        int Updates = 0;
+
+        explicit ParallelUpdateComponent(LowEngine::Memory::Memory* memory)
+            : LowEngine::ECS::IComponent<ParallelUpdateComponent<Tag>>(memory) {}
+
+        ParallelUpdateComponent(LowEngine::Memory::Memory* memory, ParallelUpdateComponent const* other)
+            : LowEngine::ECS::IComponent<ParallelUpdateComponent<Tag>>(memory, other), Updates(other->Updates) {}
+
+        void Initialize() override {}
+
+        void Update(float) override { Updates++; }
+    };
+
+    struct TrackedUpdateComponent : LowEngine::ECS::IComponent<TrackedUpdateComponent> {
+        static constexpr bool WorkerThreadSafe = true;
+        static constexpr bool ParallelSafeUpdate = true;
+        static constexpr bool TracksChanges = true;
+
+        int Value = 0;
+
+        explicit TrackedUpdateComponent(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        TrackedUpdateComponent(LowEngine::Memory::Memory* memory, TrackedUpdateComponent const* other)
+            : IComponent(memory, other), Value(other->Value) {}
+
+        void Initialize() override {}
+
+        void Update(float) override {
+            if (LowEngine::ECS::GetEntityIndex(EntityId) % 2 == 0) {
+                Value++;
+                MarkChanged();
+            }
+        }
+    };
+
+    // Moves the Transform of its own Entity, every other Entity only.
+    struct MoverComponent : LowEngine::ECS::IComponent<MoverComponent> {
+        static constexpr bool WorkerThreadSafe = true;
+        static constexpr bool ParallelSafeUpdate = true;
+
+        LowEngine::ECS::TransformComponent* Transform = nullptr;
+
+        explicit MoverComponent(LowEngine::Memory::Memory* memory)
+            : IComponent(memory) {}
+
+        MoverComponent(LowEngine::Memory::Memory* memory, MoverComponent const* other)
+            : IComponent(memory, other) {}
+
+        void Initialize() override {
+            Transform = _memory->GetComponent<LowEngine::ECS::TransformComponent>(EntityId);
+        }
+
+        void Update(float deltaTime) override {
+            if (LowEngine::ECS::GetEntityIndex(EntityId) % 2 == 0) {
+                Transform->Move({deltaTime, 0.0f});
+            }
+        }
+    };
+}
+
+// ─── WorkerPool ───────────────────────────────────────────────────────────────
+
+TEST_CASE("WorkerPool - ParallelFor runs every index exactly once", "[threading]") {
+    WorkerPool pool(3);
+
+    std::vector<std::atomic<int>> hits(1000);
+    pool.ParallelFor(hits.size(), [&hits](size_t index) { hits[index]++; });
+
+    for (const auto& hit : hits) {
+        REQUIRE(hit.load() == 1);
+    }
+}
+
+TEST_CASE("WorkerPool - pool without threads runs on the waiting thread", "[threading]") {
+    WorkerPool pool(0);
+    REQUIRE(pool.GetThreadCount() == 0);
+
+    const auto caller = std::this_thread::get_id();
+    bool allOnCaller = true;
+    pool.ParallelFor(10, [&](size_t) { allOnCaller &= std::this_thread::get_id() == caller; });
+
+    REQUIRE(allOnCaller);
+}
+
+TEST_CASE("WorkerPool - empty batch is done immediately", "[threading]") {
+    WorkerPool pool(2);
+    auto batch = pool.Submit(0, [](size_t) {});
+    pool.Wait(batch);
+    REQUIRE(batch->IsDone());
+}
+
+TEST_CASE("WorkerPool - nested ParallelFor completes", "[threading]") {
+    WorkerPool pool(2);
+
+    std::atomic<int> total = 0;
+    pool.ParallelFor(8, [&](size_t) {
+        pool.ParallelFor(8, [&](size_t) { total++; });
+    });
+
+    REQUIRE(total.load() == 64);
+}
+
+// ─── UpdateSchedule ───────────────────────────────────────────────────────────
+
+namespace {
+    UpdateSchedule::PoolAccess Access(LowEngine::Memory::ComponentTypeId typeId, std::string_view name,
+                                      std::vector<LowEngine::Memory::ComponentTypeId> dependencies = {},
+                                      bool workerThreadSafe = true) {
+        UpdateSchedule::PoolAccess access;
+        access.TypeId = typeId;
+        access.TypeName = name;
+        access.Dependencies = std::move(dependencies);
+        access.WorkerThreadSafe = workerThreadSafe;
+        return access;
+    }
+}
+
+TEST_CASE("UpdateSchedule - independent pools share a stage", "[threading][schedule]") {
+    UpdateSchedule schedule;
+    schedule.Build({Access(0, "A"), Access(1, "B"), Access(2, "C")});
+
+    REQUIRE(schedule.GetStages().size() == 1);
+    REQUIRE(schedule.GetStages()[0].Workers == std::vector<LowEngine::Memory::ComponentTypeId>{0, 1, 2});
+}
+
+TEST_CASE("UpdateSchedule - dependant pool runs after its dependency", "[threading][schedule]") {
+    UpdateSchedule schedule;
+    // registered before its dependency, schedule must still put the dependency first
+    schedule.Build({Access(0, "Sprite", {1}), Access(1, "Transform"), Access(2, "Sound", {}, false)});
+
+    const auto& stages = schedule.GetStages();
+    REQUIRE(stages.size() == 2);
+    REQUIRE(stages[0].Workers == std::vector<LowEngine::Memory::ComponentTypeId>{1});
+    REQUIRE(stages[0].MainThread == std::vector<LowEngine::Memory::ComponentTypeId>{2});
+    REQUIRE(stages[1].Workers == std::vector<LowEngine::Memory::ComponentTypeId>{0});
+}
+
+TEST_CASE("UpdateSchedule - declared writes create conflicts", "[threading][schedule]") {
+    auto physics = Access(0, "Physics");
+    physics.Writes = {2};
+    auto camera = Access(1, "Camera");
+    camera.Reads = {2};
+    auto transform = Access(2, "Transform");
+
+    REQUIRE(UpdateSchedule::IsConflicting(physics, camera));
+    REQUIRE(UpdateSchedule::IsConflicting(physics, transform));
+    REQUIRE(UpdateSchedule::IsConflicting(camera, transform));
+
+    auto other = Access(3, "Other");
+    REQUIRE_FALSE(UpdateSchedule::IsConflicting(camera, other));
+}
+
+TEST_CASE("UpdateSchedule - dependencies are written unless declared read-only", "[threading][schedule]") {
+    auto transform = Access(0, "Transform");
+    auto player = Access(1, "Player", {0}, false);
+    auto sprite = Access(2, "Sprite", {0});
+    sprite.DependenciesReadOnly = true;
+    auto camera = Access(3, "Camera", {0});
+    camera.DependenciesReadOnly = true;
+
+    REQUIRE(UpdateSchedule::IsConflicting(player, sprite));
+    REQUIRE_FALSE(UpdateSchedule::IsConflicting(sprite, camera));
+
+    UpdateSchedule schedule;
+    schedule.Build({transform, player, sprite});
+
+    const auto& stages = schedule.GetStages();
+    REQUIRE(stages.size() == 3);
+    REQUIRE(stages[1].MainThread == std::vector<LowEngine::Memory::ComponentTypeId>{1});
+    REQUIRE(stages[1].Workers.empty());
+    REQUIRE(stages[2].Workers == std::vector<LowEngine::Memory::ComponentTypeId>{2});
+}
+
+TEST_CASE("UpdateSchedule - order doesn't depend on registration order", "[threading][schedule]") {
+    UpdateSchedule first;
+    first.Build({Access(0, "B", {}, false), Access(1, "A", {}, false)});
+    UpdateSchedule second;
+    second.Build({Access(1, "A", {}, false), Access(0, "B", {}, false)});
+
+    REQUIRE(first.GetStages()[0].MainThread == second.GetStages()[0].MainThread);
+    REQUIRE(first.GetStages()[0].MainThread == std::vector<LowEngine::Memory::ComponentTypeId>{1, 0});
+}
+
+// ─── BackgroundWriter ─────────────────────────────────────────────────────────
+
+namespace {
+    std::filesystem::path MakeTempDirectory() {
+        auto directory = std::filesystem::temp_directory_path() / "lowengine_test_background_writer";
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        return directory;
+    }
+
+    std::string ReadFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    BackgroundWriter::Encoder EncodeText(std::string text) {
+        return [text = std::move(text)](std::vector<std::byte>& content) {
+            auto bytes = std::as_bytes(std::span(text));
+            content.assign(bytes.begin(), bytes.end());
+            return true;
+        };
+    }
+}
+
+TEST_CASE("BackgroundWriter - writes run off the calling thread, callbacks on Poll", "[threading][writer]") {
+    auto directory = MakeTempDirectory();
+    BackgroundWriter writer;
+
+    const auto caller = std::this_thread::get_id();
+    std::thread::id encoderThread;
+    std::vector<int> finished;
+    writer.Write(directory / "a.txt", [&encoderThread](std::vector<std::byte>& content) {
+        encoderThread = std::this_thread::get_id();
+        content.assign(3, std::byte{'a'});
+        return true;
+    }, [&finished, caller](bool success) {
+        REQUIRE(success);
+        REQUIRE(std::this_thread::get_id() == caller);
+        finished.push_back(1);
+    });
+    writer.Write(directory / "b.txt", EncodeText("second"), [&finished](bool success) {
+        REQUIRE(success);
+        finished.push_back(2);
+    });
+    REQUIRE(finished.empty());
+
+    writer.Flush();
+    REQUIRE_FALSE(writer.IsWriting());
+    REQUIRE(finished == std::vector<int>{1, 2});
+    REQUIRE(encoderThread != caller);
+    REQUIRE(ReadFile(directory / "a.txt") == "aaa");
+    REQUIRE(ReadFile(directory / "b.txt") == "second");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("BackgroundWriter - failed write keeps the previous file", "[threading][writer]") {
+    auto directory = MakeTempDirectory();
+    auto path = directory / "scene.lowscene";
+    BackgroundWriter writer;
+
+    writer.Write(path, EncodeText("saved"));
+    writer.Flush();
+    REQUIRE(ReadFile(path) == "saved");
+
+    std::vector<bool> results;
+    auto onDone = [&results](bool success) { results.push_back(success); };
+    writer.Write(path, [](std::vector<std::byte>&) { return false; }, onDone);
+    writer.Write(path, [](std::vector<std::byte>&) -> bool { throw std::runtime_error("broken snapshot"); }, onDone);
+    writer.Write(directory / "missing" / "scene.lowscene", EncodeText("lost"), onDone);
+    writer.Flush();
+
+    REQUIRE(results == std::vector<bool>{false, false, false});
+    REQUIRE(ReadFile(path) == "saved");
+    REQUIRE_FALSE(std::filesystem::exists(directory / "scene.lowscene.tmp"));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("BackgroundWriter - file is replaced atomically", "[threading][writer]") {
+    auto directory = MakeTempDirectory();
+    auto path = directory / "project.lowproj";
+
+    std::string error;
+    std::vector<std::byte> content(1000, std::byte{'x'});
+    REQUIRE(BackgroundWriter::WriteFileAtomically(path, content, error));
+    content.resize(10);
+    REQUIRE(BackgroundWriter::WriteFileAtomically(path, content, error));
+    REQUIRE(error.empty());
+
+    REQUIRE(ReadFile(path) == std::string(10, 'x'));
+    REQUIRE(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()) == 1);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("BackgroundWriter - appends keep the existing content", "[threading][writer]") {
+    auto directory = MakeTempDirectory();
+    auto path = directory / "scene.lowscene.journal";
+    BackgroundWriter writer;
+
+    std::vector<bool> results;
+    auto onDone = [&results](bool success) { results.push_back(success); };
+    writer.Write(path, EncodeText("header"), onDone);
+    writer.Append(path, EncodeText("+one"), onDone);
+    writer.Append(path, EncodeText("+two"), onDone);
+    writer.Append(directory / "missing" / "scene.lowscene.journal", EncodeText("lost"), onDone);
+    writer.Flush();
+
+    REQUIRE(results == std::vector<bool>{true, true, true, false});
+    REQUIRE(ReadFile(path) == "header+one+two");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("BackgroundWriter - files written together stop at the first failure", "[threading][writer]") {
+    auto directory = MakeTempDirectory();
+    BackgroundWriter writer;
+    writer.Write(directory / "b.txt", EncodeText("old"));
+
+    std::vector<bool> results;
+    auto onDone = [&results](bool success) { results.push_back(success); };
+    std::vector<BackgroundWriter::File> files;
+    files.push_back({directory / "a.txt", EncodeText("first")});
+    files.push_back({directory / "b.txt", EncodeText("second")});
+    writer.WriteAll(std::move(files), onDone);
+
+    files.clear();
+    files.push_back({directory / "missing" / "a.txt", EncodeText("lost")});
+    files.push_back({directory / "b.txt", EncodeText("skipped")});
+    writer.WriteAll(std::move(files), onDone);
+    writer.Flush();
+
+    REQUIRE(results == std::vector<bool>{true, false});
+    REQUIRE(ReadFile(directory / "a.txt") == "first");
+    REQUIRE(ReadFile(directory / "b.txt") == "second");
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("BackgroundWriter - destruction finishes queued writes", "[threading][writer]") {
+    auto directory = MakeTempDirectory();
+    {
+        BackgroundWriter writer;
+        for (int i = 0; i < 20; ++i) {
+            writer.Write(directory / (std::to_string(i) + ".txt"), EncodeText(std::to_string(i)));
+        }
+    }
+    for (int i = 0; i < 20; ++i) {
+        REQUIRE(ReadFile(directory / (std::to_string(i) + ".txt")) == std::to_string(i));
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+// ─── Parallel pools ───────────────────────────────────────────────────────────
+
+TEST_CASE("Memory - pools updated in one stage don't allocate from the arena", "[threading][schedule]") {
+    using First = ParallelUpdateComponent<0>;
+    using Second = ParallelUpdateComponent<1>;
+
+    WorkerPool workers(3);
+    LowEngine::Memory::Memory mem;
+    mem.SetWorkerPool(&workers);
+
+    // enough components for both pools to split their update into batches
+    std::vector<size_t> ids = mem.CreateEntities(4000);
+    mem.CreateComponents<First>(ids);
+    mem.CreateComponents<Second>(ids);
+
+    // arena is not thread-safe, so pools running side by side on workers must not touch it
+    size_t allocations = mem.GetArenaStats().TotalAllocations;
+    for (int frame = 0; frame < 20; ++frame) {
+        mem.UpdateAllComponents(0.016f);
+    }
+    REQUIRE(mem.GetArenaStats().TotalAllocations == allocations);
+
+    for (size_t id : ids) {
+        REQUIRE(mem.GetComponent<First>(id)->Updates == 20);
+        REQUIRE(mem.GetComponent<Second>(id)->Updates == 20);
+    }
+}
+
+TEST_CASE("Memory - components updated on workers mark their Entities changed", "[threading][delta]") {
+    WorkerPool workers(3);
+    LowEngine::Memory::Memory mem;
+    mem.SetWorkerPool(&workers);
+
+    std::vector<size_t> ids = mem.CreateEntities(4000);
+    mem.CreateComponents<TrackedUpdateComponent>(ids);
+    mem.ClearChanges();
+
+    size_t allocations = mem.GetArenaStats().TotalAllocations;
+    for (int frame = 0; frame < 5; ++frame) {
+        mem.UpdateAllComponents(0.016f);
+    }
+    REQUIRE(mem.GetArenaStats().TotalAllocations == allocations);
+
+    std::vector<size_t> expected;
+    for (size_t id : ids) {
+        if (LowEngine::ECS::GetEntityIndex(id) % 2 == 0) expected.push_back(id);
+    }
+    std::vector<size_t> changed = mem.GetChangedEntityIds();
+    std::ranges::sort(expected);
+    std::ranges::sort(changed);
+    REQUIRE(changed == expected);
+}
+
+TEST_CASE("Memory - Transforms moved on workers are recorded as changed", "[threading][changes]") {
+    using LowEngine::ECS::TransformComponent;
+
+    WorkerPool workers(3);
+    LowEngine::Memory::Memory mem;
+    mem.SetWorkerPool(&workers);
+
+    std::vector<size_t> ids = mem.CreateEntities(4000);
+    mem.CreateComponents<TransformComponent>(ids);
+    mem.CreateComponents<MoverComponent>(ids);
+    mem.UpdateAllComponents(0.016f);
+
+    size_t allocations = mem.GetArenaStats().TotalAllocations;
+    for (int frame = 0; frame < 5; ++frame) {
+        mem.UpdateAllComponents(0.016f);
+    }
+    REQUIRE(mem.GetArenaStats().TotalAllocations == allocations);
+
+    std::vector<size_t> expected;
+    for (size_t id : ids) {
+        if (LowEngine::ECS::GetEntityIndex(id) % 2 == 0) expected.push_back(id);
+    }
+    std::ranges::sort(expected);
+    REQUIRE(mem.GetEntitiesChangedSince<TransformComponent>(mem.GetTick()) == expected);
+}
@@ -0,0 +1,205 @@
+#include <catch2/catch_test_macros.hpp>
+#include <spdlog/sinks/null_sink.h>
+
+#include <utility>
+
+#include "log/Log.h"
+#include "terrain/TileMapLayer.h"
+
+using LowEngine::TileMap::TileMapLayer;
+
+namespace {
+    struct LogGuard {
+        LogGuard() {
+            if (!LowEngine::_log) {
+                LowEngine::_log = std::make_shared<spdlog::logger>(
+                    "test", std::make_shared<spdlog::sinks::null_sink_mt>());
+            }
+        }
+    };
+    static LogGuard logGuard;
+
+    TileMapLayer MakeLayer() {
+        TileMapLayer layer;
+        layer.TileSize = {16, 16};
+        for (int x = 0; x < 4; ++x) {
+            layer.AddTile({x, 0}, sf::IntRect({x * 16, 0}, {16, 16}), true);
+        }
+        return layer;
+    }
+}
+
+// ─── Copy-on-write ────────────────────────────────────────────────────────────
+
+TEST_CASE("TileMapLayer - copy shares tiles until modified", "[terrain][cow]") {
+    TileMapLayer original = MakeLayer();
+    TileMapLayer copy = original;
+
+    REQUIRE(original.IsTileStoreShared());
+    REQUIRE(copy.IsTileStoreShared());
+    REQUIRE(&copy.GetTiles() == &original.GetTiles());
+
+    // reading doesn't detach
+    const TileMapLayer& constCopy = copy;
+    REQUIRE(constCopy.FindTile({1, 0}) != nullptr);
+    REQUIRE(copy.FindTile({9, 9}) == nullptr);
+    REQUIRE(copy.IsTileStoreShared());
+}
+
+TEST_CASE("TileMapLayer - modifying a copy leaves the original intact", "[terrain][cow]") {
+    TileMapLayer original = MakeLayer();
+    TileMapLayer copy = original;
+
+    REQUIRE(copy.DeleteTile({0, 0}));
+    copy.AddTile({5, 5}, sf::IntRect({0, 0}, {16, 16}));
+
+    REQUIRE_FALSE(original.IsTileStoreShared());
+    REQUIRE_FALSE(copy.IsTileStoreShared());
+    REQUIRE(original.GetTiles().size() == 4);
+    REQUIRE(original.FindTile({0, 0}) != nullptr);
+    REQUIRE(original.FindTile({5, 5}) == nullptr);
+    REQUIRE(copy.GetTiles().size() == 4);
+    REQUIRE(copy.FindTile({0, 0}) == nullptr);
+}
+
+TEST_CASE("TileMapLayer - mutable tile access detaches the copy", "[terrain][cow]") {
+    TileMapLayer original = MakeLayer();
+    TileMapLayer copy = original;
+
+    copy.FindTile({2, 0})->HasCollision = true;
+
+    REQUIRE(copy.FindTile({2, 0})->HasCollision);
+    REQUIRE_FALSE(std::as_const(original).FindTile({2, 0})->HasCollision);
+}
+
+// ─── Deserialization ──────────────────────────────────────────────────────────
+
+TEST_CASE("TileMapLayer - tiles deserialize in bulk", "[terrain][json]") {
+    nlohmann::ordered_json json = {
+        {"name", "Ground"},
+        {"tileSize", {{"x", 16}, {"y", 16}}},
+        {"drawOrder", 2},
+        {"tiles", nlohmann::ordered_json::array()}
+    };
+    for (int x = 0; x < 8; ++x) {
+        json["tiles"].push_back({
+            {"cellX", x}, {"cellY", 0}, {"type", 0},
+            {"spriteRect", {{"x", x * 16}, {"y", 0}, {"w", 16}, {"h", 16}}},
+            {"animClipName", ""}, {"hasCollision", x == 3}, {"traversalMask", 1}, {"entryCost", 2}
+        });
+    }
+    json["tiles"].push_back({
+        {"cellX", 0}, {"cellY", 1}, {"type", 1},
+        {"spriteRect", {{"x", 0}, {"y", 0}, {"w", 0}, {"h", 0}}},
+        {"animClipName", "water"}
+    });
+
+    TileMapLayer layer;
+    REQUIRE(layer.DeserializeFromJSON(json));
+
+    REQUIRE(layer.Name == "Ground");
+    REQUIRE(layer.GetDrawOrder() == 2);
+    REQUIRE(layer.GetTiles().size() == 9);
+    REQUIRE(layer.FindTile({3, 0})->HasCollision);
+    REQUIRE(layer.FindTile({3, 0})->SpriteRect == sf::IntRect({48, 0}, {16, 16}));
+    REQUIRE(layer.FindTile({0, 1})->AnimationClipName == "water");
+}
+
+TEST_CASE("TileMapLayer - packed tiles survive a round trip", "[terrain][json]") {
+    TileMapLayer original;
+    original.Name = "Ground";
+    original.TileSize = {16, 16};
+    for (int y = -40; y < 40; ++y) {
+        for (int x = -3; x < 70; ++x) {
+            original.AddTile({x, y}, sf::IntRect({(x & 1) * 16, 0}, {16, 16}), true);
+        }
+    }
+    original.FindTile({-3, -40})->HasCollision = true;
+    original.FindTile({69, 39})->TraversalMask = LowEngine::TileMap::Traversal::Fly;
+    original.FindTile({5, 5})->EntryCost = 9;
+    std::string clip = "water";
+    original.AddTile({100, -100}, clip, true);
+    REQUIRE(original.DeleteTile({0, 0}));
+
+    nlohmann::ordered_json json = original.SerializeToJSON();
+    json.erase("textureAlias");
+    REQUIRE_FALSE(json.contains("tiles"));
+    // two rects, plus the three changed tiles and the animated one
+    REQUIRE(json["tilePalette"].size() == 6);
+
+    TileMapLayer loaded;
+    REQUIRE(loaded.DeserializeFromJSON(json));
+
+    REQUIRE(loaded.GetTiles().size() == original.GetTiles().size());
+    for (const auto& [coords, tile] : original.GetTiles()) {
+        const auto* loadedTile = loaded.FindTile(coords);
+        REQUIRE(loadedTile != nullptr);
+        REQUIRE(loadedTile->Type == tile.Type);
+        REQUIRE(loadedTile->SpriteRect == tile.SpriteRect);
+        REQUIRE(loadedTile->AnimationClipName == tile.AnimationClipName);
+        REQUIRE(loadedTile->HasCollision == tile.HasCollision);
+        REQUIRE(loadedTile->TraversalMask == tile.TraversalMask);
+        REQUIRE(loadedTile->EntryCost == tile.EntryCost);
+    }
+    REQUIRE(loaded.FindTile({0, 0}) == nullptr);
+}
+
+TEST_CASE("TileMapLayer - corrupted tile chunk fails to load", "[terrain][json]") {
+    TileMapLayer original = MakeLayer();
+    nlohmann::ordered_json json = original.SerializeToJSON();
+    json.erase("textureAlias");
+
+    SECTION("Invalid cells") {
+        json["tileChunks"][0]["cells"] = "not base64";
+    }
+    SECTION("Missing palette entry") {
+        json["tilePalette"].erase(3);
+    }
+
+    TileMapLayer loaded;
+    REQUIRE_FALSE(loaded.DeserializeFromJSON(json));
+}
+
+// ─── Changes ──────────────────────────────────────────────────────────────────
+
+TEST_CASE("TileMapLayer - changes hold only modified chunks", "[terrain][delta]") {
+    TileMapLayer original;
+    original.Name = "Ground";
+    original.TileSize = {16, 16};
+    for (int x = 0; x < 100; ++x) {
+        original.AddTile({x, 0}, sf::IntRect({0, 0}, {16, 16}), true);
+    }
+    original.ClearTileChanges();
+
+    nlohmann::ordered_json unchanged = original.SerializeChangesToJSON();
+    REQUIRE(unchanged["tileChunks"].empty());
+
+    TileMapLayer loaded;
+    nlohmann::ordered_json full = original.SerializeToJSON();
+    full.erase("textureAlias");
+    REQUIRE(loaded.DeserializeFromJSON(full));
+
+    // clears the first chunk, edits the second one and adds a new one
+    for (int x = 0; x < LowEngine::Config::TILE_CHUNK_SIZE; ++x) {
+        REQUIRE(original.DeleteTile({x, 0}));
+    }
+    original.FindTile({40, 0})->EntryCost = 5;
+    original.AddTile({-1, -1}, sf::IntRect({16, 0}, {16, 16}), true);
+
+    nlohmann::ordered_json changes = original.SerializeChangesToJSON();
+    changes.erase("textureAlias");
+    REQUIRE(changes["replacesChunks"] == true);
+    REQUIRE(changes["tileChunks"].size() == 3);
+
+    REQUIRE(loaded.DeserializeFromJSON(changes));
+    REQUIRE(loaded.GetTiles().size() == original.GetTiles().size());
+    REQUIRE(loaded.FindTile({0, 0}) == nullptr);
+    REQUIRE(loaded.FindTile({40, 0})->EntryCost == 5);
+    REQUIRE(loaded.FindTile({-1, -1})->SpriteRect == sf::IntRect({16, 0}, {16, 16}));
+    REQUIRE(loaded.FindTile({99, 0}) != nullptr);
+
+    SECTION("New layer holds all tiles") {
+        TileMapLayer layer = MakeLayer();
+        REQUIRE_FALSE(layer.SerializeChangesToJSON().contains("replacesChunks"));
+    }
+}
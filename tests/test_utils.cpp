@@ -1,7 +1,15 @@
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <span>
+#include <sstream>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
+#include "utils/Base64.h"
 #include "utils/ColorUtils.h"
+#include "utils/JsonStream.h"
+#include "utils/RunLength.h"
 #include "utils/TypeHash.h"
 #include "utils/TypeName.h"
 
@@ -75,4 +83,166 @@ TEST_CASE("TypeName - different types produce different names", "[utils][typenam
 TEST_CASE("GetCleanTypeName - returns std::string", "[utils][typename]") {
     std::string name = GetCleanTypeName<int>();
     REQUIRE_FALSE(name.empty());
-}
\ No newline at end of file
+}
+// ─── JsonStreamParser ─────────────────────────────────────────────────────────
+
+TEST_CASE("JsonStreamParser - value routes receive matching values in order", "[utils][json]") {
+    JsonStreamParser parser;
+    std::string name;
+    std::vector<int> ids;
+    parser.OnValue("/name", [&name](std::string_view key, nlohmann::ordered_json& value) {
+        REQUIRE(key == "name");
+        name = value.get<std::string>();
+        return true;
+    });
+    parser.OnValue("/items/*", [&ids](std::string_view key, nlohmann::ordered_json& value) {
+        REQUIRE(key.empty());
+        ids.push_back(value["id"].get<int>());
+        return true;
+    });
+
+    REQUIRE(parser.Parse(R"({"name": "scene", "items": [{"id": 1, "tags": [1, 2]}, {"id": 2}], "other": {"id": 3}})"));
+    REQUIRE(parser.GetError().empty());
+    REQUIRE(name == "scene");
+    REQUIRE(ids == std::vector<int>{1, 2});
+}
+
+TEST_CASE("JsonStreamParser - wildcard matches object keys", "[utils][json]") {
+    JsonStreamParser parser;
+    std::vector<std::string> keys;
+    parser.OnValue("/settings/*", [&keys](std::string_view key, nlohmann::ordered_json&) {
+        keys.emplace_back(key);
+        return true;
+    });
+
+    std::istringstream input(R"({"settings": {"a": 1, "b": {"c": 2}, "d": [3]}})");
+    REQUIRE(parser.Parse(input));
+    REQUIRE(keys == std::vector<std::string>{"a", "b", "d"});
+}
+
+TEST_CASE("JsonStreamParser - first matching route wins", "[utils][json]") {
+    JsonStreamParser parser;
+    std::vector<std::string> events;
+    parser.OnContainer("/layers/*", [&events](std::string_view) {
+        events.emplace_back("begin");
+        return true;
+    }, [&events](std::string_view) {
+        events.emplace_back("end");
+        return true;
+    });
+    parser.OnContainer("/layers/*/tiles", nullptr, nullptr);
+    parser.OnValue("/layers/*/tiles/*", [&events](std::string_view, nlohmann::ordered_json& value) {
+        events.push_back("tile " + std::to_string(value.get<int>()));
+        return true;
+    });
+    parser.OnValue("/layers/*/*", [&events](std::string_view key, nlohmann::ordered_json&) {
+        events.push_back(std::string(key));
+        return true;
+    });
+
+    REQUIRE(parser.Parse(R"({"layers": [{"name": "a", "tiles": [1, 2], "size": 3}, {"tiles": []}]})"));
+    REQUIRE(events == std::vector<std::string>{
+        "begin", "name", "tile 1", "tile 2", "size", "end", "begin", "end"
+    });
+}
+
+TEST_CASE("JsonStreamParser - failing handler stops parsing", "[utils][json]") {
+    JsonStreamParser parser;
+    int calls = 0;
+    parser.OnValue("/items/*", [&calls](std::string_view, nlohmann::ordered_json& value) {
+        calls++;
+        return value.get<int>() != 2;
+    });
+
+    REQUIRE_FALSE(parser.Parse(R"({"items": [1, 2, 3]})"));
+    REQUIRE(calls == 2);
+    REQUIRE(parser.GetError() == "Handler of '/items/*' failed");
+}
+
+TEST_CASE("JsonStreamParser - invalid JSON is reported", "[utils][json]") {
+    JsonStreamParser parser;
+    parser.OnValue("/items/*", [](std::string_view, nlohmann::ordered_json&) { return true; });
+
+    REQUIRE_FALSE(parser.Parse(R"({"items": [1, 2)"));
+    REQUIRE_FALSE(parser.GetError().empty());
+    REQUIRE(parser.Parse(R"({"items": []})"));
+    REQUIRE(parser.GetError().empty());
+}
+
+// ─── Base64 ───────────────────────────────────────────────────────────────────
+
+namespace {
+    std::vector<std::byte> ToBytes(std::string_view text) {
+        std::vector<std::byte> bytes;
+        for (char c : text) {
+            bytes.push_back(static_cast<std::byte>(c));
+        }
+        return bytes;
+    }
+}
+
+TEST_CASE("Base64 - encodes with padding", "[utils][base64]") {
+    REQUIRE(EncodeBase64(ToBytes("")).empty());
+    REQUIRE(EncodeBase64(ToBytes("f")) == "Zg==");
+    REQUIRE(EncodeBase64(ToBytes("fo")) == "Zm8=");
+    REQUIRE(EncodeBase64(ToBytes("foo")) == "Zm9v");
+    REQUIRE(EncodeBase64(ToBytes("foobar")) == "Zm9vYmFy");
+}
+
+TEST_CASE("Base64 - decoding restores encoded bytes", "[utils][base64]") {
+    std::vector<std::byte> data;
+    for (int i = 0; i < 256; ++i) {
+        data.push_back(static_cast<std::byte>(i));
+    }
+
+    std::vector<std::byte> decoded;
+    for (size_t size = 0; size <= 6; ++size) {
+        auto part = std::span(data).first(size);
+        REQUIRE(DecodeBase64(EncodeBase64(part), decoded));
+        REQUIRE(std::ranges::equal(decoded, part));
+    }
+    REQUIRE(DecodeBase64(EncodeBase64(data), decoded));
+    REQUIRE(decoded == data);
+}
+
+TEST_CASE("Base64 - invalid text is rejected", "[utils][base64]") {
+    std::vector<std::byte> decoded;
+    REQUIRE_FALSE(DecodeBase64("Zm9", decoded));
+    REQUIRE_FALSE(DecodeBase64("Zm9*", decoded));
+    REQUIRE_FALSE(DecodeBase64("Zg==Zm9v", decoded));
+    REQUIRE_FALSE(DecodeBase64("Z=9v", decoded));
+}
+
+// ─── RunLength ────────────────────────────────────────────────────────────────
+
+TEST_CASE("RunLength - runs of equal values are stored once", "[utils][rle]") {
+    std::vector<uint32_t> values(1024, 0);
+    std::fill(values.begin() + 100, values.begin() + 600, 70000u);
+    values[1023] = 1;
+
+    std::vector<std::byte> encoded;
+    EncodeRunLength(values, encoded);
+    // four runs, each length and value fit at most three bytes
+    REQUIRE(encoded.size() <= 4 * 6);
+
+    std::vector<uint32_t> decoded(values.size());
+    REQUIRE(DecodeRunLength(encoded, decoded));
+    REQUIRE(decoded == values);
+}
+
+TEST_CASE("RunLength - malformed runs are rejected", "[utils][rle]") {
+    std::vector<uint32_t> values = {5, 5, 5, 0xFFFFFFFF};
+    std::vector<std::byte> encoded;
+    EncodeRunLength(values, encoded);
+
+    std::vector<uint32_t> tooMany(3);
+    REQUIRE_FALSE(DecodeRunLength(encoded, tooMany));
+
+    std::vector<uint32_t> tooFew(5);
+    REQUIRE_FALSE(DecodeRunLength(encoded, tooFew));
+
+    std::vector<uint32_t> decoded(4);
+    REQUIRE_FALSE(DecodeRunLength(std::span(encoded).first(encoded.size() - 1), decoded));
+    REQUIRE(DecodeRunLength(encoded, decoded));
+    REQUIRE(decoded == values);
+}